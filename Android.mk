@@ -21,18 +21,24 @@ SPVTOOLS_SRC_FILES := \
 		source/spirv_endian.cpp \
 		source/spirv_target_env.cpp \
 		source/spirv_validator_options.cpp \
+		source/struct_layout.cpp \
 		source/table.cpp \
 		source/text.cpp \
 		source/text_handler.cpp \
 		source/util/bit_stream.cpp \
 		source/util/bit_vector.cpp \
+		source/util/parallel.cpp \
 		source/util/parse_number.cpp \
+		source/util/sha256.cpp \
+		source/util/slab_pool.cpp \
 		source/util/string_utils.cpp \
+		source/util/text_buffer.cpp \
 		source/util/timer.cpp \
 		source/val/basic_block.cpp \
 		source/val/construct.cpp \
 		source/val/function.cpp \
 		source/val/instruction.cpp \
+		source/val/validation_cache.cpp \
 		source/val/validation_state.cpp \
 		source/validate.cpp \
 		source/validate_adjacency.cpp \
@@ -136,6 +142,7 @@ SPVTOOLS_OPT_SRC_FILES := \
 		source/opt/strength_reduction_pass.cpp \
 		source/opt/strip_debug_info_pass.cpp \
 		source/opt/strip_reflect_info_pass.cpp \
+		source/opt/struct_layout_analysis.cpp \
 		source/opt/type_manager.cpp \
 		source/opt/types.cpp \
 		source/opt/unify_const_pass.cpp \
@@ -479,6 +479,29 @@ SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetRelaxLogicalPointer(
 SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetRelaxBlockLayout(
     spv_validator_options options, bool val);
 
+// Records the number of threads the validator may use. The checks which are
+// independent for each instruction, and the dominator analysis of each
+// function, are then spread across that many threads. The control flow and
+// dominance checks themselves still run on the calling thread. The result
+// and the reported diagnostic are the same as with a single thread. A value
+// of 0 or 1 means the validator runs on the calling thread only, which is the
+// default.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetNumThreads(
+    spv_validator_options options, uint32_t num_threads);
+
+// Records a directory in which the validator caches the outcome of validating
+// each module. Validating the same module again, for the same target
+// environment, with the same options and the same version of this library,
+// then reports the recorded result and messages without repeating the checks.
+// Only spvValidateWithOptions uses the cache.
+//
+// The directory must already exist, and may be shared by several processes.
+// The cache keeps its files within max_size bytes, but always has room for
+// one outcome. A null or empty directory disables the cache, which is the
+// default.
+SPIRV_TOOLS_EXPORT void spvValidatorOptionsSetCache(
+    spv_validator_options options, const char* directory, size_t max_size);
+
 // Encodes the given SPIR-V assembly text to its binary representation. The
 // length parameter specifies the number of bytes for text. Encoded binary will
 // be stored into *binary. Any error will be written into *diagnostic if
@@ -497,6 +520,16 @@ SPIRV_TOOLS_EXPORT spv_result_t spvTextToBinaryWithOptions(
     const spv_const_context context, const char* text, const size_t length,
     const uint32_t options, spv_binary* binary, spv_diagnostic* diagnostic);
 
+// Encodes the given SPIR-V assembly text to its binary representation. Same as
+// spvTextToBinaryWithOptions, but the bodies of functions are encoded on up to
+// num_threads threads. The generated binary is the same as the one generated by
+// spvTextToBinaryWithOptions. Text which cannot be split into functions that
+// way, such as text with errors, is encoded on the calling thread.
+SPIRV_TOOLS_EXPORT spv_result_t spvTextToBinaryWithThreads(
+    const spv_const_context context, const char* text, const size_t length,
+    const uint32_t options, const uint32_t num_threads, spv_binary* binary,
+    spv_diagnostic* diagnostic);
+
 // Frees an allocated text stream. This is a no-op if the text parameter
 // is a null pointer.
 SPIRV_TOOLS_EXPORT void spvTextDestroy(spv_text text);
@@ -513,6 +546,16 @@ SPIRV_TOOLS_EXPORT spv_result_t spvBinaryToText(const spv_const_context context,
                                                 spv_text* text,
                                                 spv_diagnostic* diagnostic);
 
+// Decodes the given SPIR-V binary representation to its assembly text. Same as
+// spvBinaryToText, but the bodies of functions are decoded on up to
+// num_threads threads. The decoded text is the same as the one decoded by
+// spvBinaryToText. Binaries which are not in host byte order are decoded on
+// the calling thread.
+SPIRV_TOOLS_EXPORT spv_result_t spvBinaryToTextWithThreads(
+    const spv_const_context context, const uint32_t* binary,
+    const size_t word_count, const uint32_t options, const uint32_t num_threads,
+    spv_text* text, spv_diagnostic* diagnostic);
+
 // Frees a binary stream from memory. This is a no-op if binary is a null
 // pointer.
 SPIRV_TOOLS_EXPORT void spvBinaryDestroy(spv_binary binary);
@@ -586,6 +629,22 @@ SPIRV_TOOLS_EXPORT spv_result_t spvBinaryParse(
     const size_t num_words, spv_parsed_header_fn_t parse_header,
     spv_parsed_instruction_fn_t parse_instruction, spv_diagnostic* diagnostic);
 
+// Finds the word offset of each instruction in a SPIR-V binary, specified as
+// counted sequence of 32-bit words, by following the word count of each
+// instruction without decoding its operands.  This gives tools random access
+// to the instructions of a module.  Returns SPV_SUCCESS and writes the number
+// of instructions to *num_instructions if the header is valid and every
+// instruction has a non-zero word count that does not run past the end of the
+// binary.  If offsets is non-null, the offsets of the first max_offsets
+// instructions are also written to it, so the number of instructions can be
+// queried first with a null offsets.  Otherwise returns
+// SPV_ERROR_INVALID_BINARY, and if diagnostic is non-null also emits a
+// diagnostic.
+SPIRV_TOOLS_EXPORT spv_result_t spvBinaryIndexInstructions(
+    const spv_const_context context, const uint32_t* words,
+    const size_t num_words, size_t* offsets, const size_t max_offsets,
+    size_t* num_instructions, spv_diagnostic* diagnostic);
+
 #ifdef __cplusplus
 }
 #endif
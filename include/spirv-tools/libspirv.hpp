@@ -95,6 +95,19 @@ class ValidatorOptions {
     spvValidatorOptionsSetRelaxLogicalPointer(options_, val);
   }
 
+  // Records the number of threads the validator may use. A value of 0 or 1
+  // means the validator runs on the calling thread only.
+  void SetNumThreads(uint32_t num_threads) {
+    spvValidatorOptionsSetNumThreads(options_, num_threads);
+  }
+
+  // Records a directory, which must exist, in which the validator caches the
+  // outcome of validating each module, using at most |max_size| bytes. An
+  // empty directory disables the cache. See spvValidatorOptionsSetCache.
+  void SetCache(const std::string& directory, size_t max_size) {
+    spvValidatorOptionsSetCache(options_, directory.c_str(), max_size);
+  }
+
  private:
   spv_validator_options options_;
 };
@@ -137,6 +150,10 @@ class SpirvTools {
   // invoked once for each message communicated from the library.
   void SetMessageConsumer(MessageConsumer consumer);
 
+  // Sets the maximum number of threads used to assemble and disassemble the
+  // bodies of functions. The output does not depend on it. Defaults to 1.
+  void SetNumThreads(uint32_t num_threads);
+
   // Assembles the given assembly |text| and writes the result to |binary|.
   // Returns true on successful assembling. |binary| will be kept untouched if
   // assembling is unsuccessful.
@@ -168,6 +185,71 @@ class SpirvTools {
   bool Validate(const uint32_t* binary, size_t binary_size,
                 const ValidatorOptions& options) const;
 
+  // Finds the word offset of each instruction in the given SPIR-V |binary|
+  // without decoding the instructions, and writes them to |offsets|. Returns
+  // false if the header is invalid, or if an instruction has a zero word count
+  // or runs past the end of the binary, and reports the issue via the message
+  // consumer registered. |offsets| will be kept untouched in that case.
+  bool IndexInstructions(const std::vector<uint32_t>& binary,
+                         std::vector<size_t>* offsets) const;
+  // |binary_size| specifies the number of words in |binary|.
+  bool IndexInstructions(const uint32_t* binary, size_t binary_size,
+                         std::vector<size_t>* offsets) const;
+
+ private:
+  struct Impl;  // Opaque struct for holding the data fields used by this class.
+  std::unique_ptr<Impl> impl_;  // Unique pointer to implementation data.
+};
+
+// Assembles a SPIR-V module from text which arrives in pieces, and hands out
+// the binary as instructions are completed, so that neither the whole text nor
+// the whole binary has to be held in memory.
+//
+// An instruction is assembled once a later line is seen to start a new
+// instruction, or once the text is finished. The module header is handed out
+// first, with an id bound of 0. The actual bound is only known at the end, and
+// is returned by Finish(); it is up to the user to patch it into the fourth
+// word of the module.
+//
+// Numeric ids cannot be preserved, since that requires seeing the whole text
+// before assembling any of it.
+class IncrementalAssembler {
+ public:
+  // A function which receives |num_words| words of the binary, which follow
+  // the words it received before.
+  using WordConsumer =
+      std::function<void(const uint32_t* words, size_t num_words)>;
+
+  // Constructs an instance targeting the given environment |env|, which hands
+  // the binary to |consumer|.
+  IncrementalAssembler(spv_target_env env, WordConsumer consumer);
+
+  // Disables copy/move constructor/assignment operations.
+  IncrementalAssembler(const IncrementalAssembler&) = delete;
+  IncrementalAssembler(IncrementalAssembler&&) = delete;
+  IncrementalAssembler& operator=(const IncrementalAssembler&) = delete;
+  IncrementalAssembler& operator=(IncrementalAssembler&&) = delete;
+
+  // Destructs this instance.
+  ~IncrementalAssembler();
+
+  // Sets the message consumer to the given |consumer|. The |consumer| will be
+  // invoked once for each message communicated from the library.
+  void SetMessageConsumer(MessageConsumer consumer);
+
+  // Appends the given |text| of |text_size| characters to the text so far,
+  // and assembles the instructions it completes. Returns false if they cannot
+  // be assembled, or if assembly failed before, and communicates issues via
+  // the message consumer registered.
+  bool Write(const char* text, size_t text_size);
+
+  // Assembles the rest of the text, which ends the module, and writes the id
+  // bound of the module to |bound|. Returns false if the rest of the text
+  // cannot be assembled, or if assembly failed before, and communicates issues
+  // via the message consumer registered. No more text can be written after
+  // this call.
+  bool Finish(uint32_t* bound);
+
  private:
   struct Impl;  // Opaque struct for holding the data fields used by this class.
   std::unique_ptr<Impl> impl_;  // Unique pointer to implementation data.
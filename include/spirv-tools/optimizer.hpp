@@ -15,6 +15,7 @@
 #ifndef SPIRV_TOOLS_OPTIMIZER_HPP_
 #define SPIRV_TOOLS_OPTIMIZER_HPP_
 
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -139,6 +140,50 @@ class Optimizer {
   std::unique_ptr<Impl> impl_;  // Unique pointer to internal data.
 };
 
+// C++ interface for optimizing many SPIR-V modules with the same passes. The
+// modules are spread over a number of threads, and each is optimized by its
+// own Optimizer.
+class BatchOptimizer {
+ public:
+  // A function registering the passes to run on a module. It is called once
+  // for every module, on the thread optimizing that module, so it must create
+  // new passes each time and may be called concurrently.
+  using Recipe = std::function<void(Optimizer*)>;
+
+  // Constructs an instance optimizing modules for the |env| target
+  // environment with the passes registered by |recipe|.
+  BatchOptimizer(spv_target_env env, Recipe recipe);
+
+  // Disables copy/move constructor/assignment operations.
+  BatchOptimizer(const BatchOptimizer&) = delete;
+  BatchOptimizer(BatchOptimizer&&) = delete;
+  BatchOptimizer& operator=(const BatchOptimizer&) = delete;
+  BatchOptimizer& operator=(BatchOptimizer&&) = delete;
+
+  // Destructs this instance.
+  ~BatchOptimizer();
+
+  // Sets the message consumer to the given |consumer|. Messages are only
+  // passed to the |consumer| once every module is optimized, on the thread
+  // calling Run(), in the order of the modules.
+  void SetMessageConsumer(MessageConsumer consumer);
+
+  // Sets the number of threads the modules are optimized on. The default is
+  // 1.
+  BatchOptimizer& SetNumThreads(uint32_t num_threads);
+
+  // Optimizes each module in |binaries| and writes the optimized module into
+  // the element of |optimized_binaries| with the same index. Returns, for each
+  // module, whether Optimizer::Run() succeeded on it.
+  std::vector<bool> Run(const std::vector<std::vector<uint32_t>>& binaries,
+                        std::vector<std::vector<uint32_t>>* optimized_binaries)
+      const;
+
+ private:
+  struct Impl;                  // Opaque struct for holding internal data.
+  std::unique_ptr<Impl> impl_;  // Unique pointer to internal data.
+};
+
 // Creates a null pass.
 // A null pass does nothing to the SPIR-V module to be optimized.
 Optimizer::PassToken CreateNullPass();
@@ -17,9 +17,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <iterator>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 #include "assembly_grammar.h"
@@ -30,6 +28,7 @@
 #include "operand.h"
 #include "spirv_constant.h"
 #include "spirv_endian.h"
+#include "util/id_table.h"
 
 spv_result_t spvBinaryHeaderGet(const spv_const_binary binary,
                                 const spv_endianness_t endian,
@@ -70,8 +69,11 @@ class Parser {
   // Parses the specified binary SPIR-V module, issuing callbacks on a parsed
   // header and for each parsed instruction.  Returns SPV_SUCCESS on success.
   // Otherwise returns an error code and issues a diagnostic.
+  //
+  // A module of the other byte order is converted into |converted_words| if
+  // that is not null, and into storage of the parser otherwise.
   spv_result_t parse(const uint32_t* words, size_t num_words,
-                     spv_diagnostic* diagnostic);
+                     uint32_t* converted_words, spv_diagnostic* diagnostic);
 
  private:
   // All remaining methods work on the current module parse state.
@@ -88,18 +90,14 @@ class Parser {
   spv_result_t parseInstruction();
 
   // Parses an instruction operand with the given type, for an instruction
-  // starting at inst_offset words into the SPIR-V binary.
-  // If the SPIR-V binary is the same endianness as the host, then the
-  // endian_converted_inst_words parameter is ignored.  Otherwise, this method
-  // appends the words for this operand, converted to host native endianness,
-  // to the end of endian_converted_inst_words.  This method also updates the
-  // expected_operands parameter, and the scalar members of the inst parameter.
+  // starting at inst_offset words into the SPIR-V binary.  This method also
+  // updates the expected_operands parameter, and the scalar members of the
+  // inst parameter.
   // On success, returns SPV_SUCCESS, advances past the operand, and pushes a
   // new entry on to the operands vector.  Otherwise returns an error code and
   // issues a diagnostic.
   spv_result_t parseOperand(size_t inst_offset, spv_parsed_instruction_t* inst,
                             const spv_operand_type_t type,
-                            std::vector<uint32_t>* endian_converted_inst_words,
                             std::vector<spv_parsed_operand_t>* operands,
                             spv_operand_pattern_t* expected_operands);
 
@@ -152,7 +150,7 @@ class Parser {
   // Returns the endian-corrected word at the given position.
   uint32_t peekAt(size_t index) const {
     assert(index < _.num_words);
-    return spvFixWord(_.words[index], _.endian);
+    return _.words[index];
   }
 
   // Data members
@@ -170,11 +168,25 @@ class Parser {
     uint32_t bit_width;
   };
 
+  // Describes a result id seen so far.
+  struct IdInfo {
+    bool defined;      // Has the id been defined?
+    uint32_t type_id;  // The type id for the id, see |id_to_type_id|.
+  };
+
+  // Describes the number type for a type id.
+  struct TypeInfo {
+    bool is_type;       // Is the id a type?
+    NumberType number;  // The number type, if the type is a scalar number.
+  };
+
   // The state used to parse a single SPIR-V binary module.
   struct State {
     State(const uint32_t* words_arg, size_t num_words_arg,
-          spv_diagnostic* diagnostic_arg)
+          uint32_t* converted_words_arg, spv_diagnostic* diagnostic_arg)
         : words(words_arg),
+          raw_words(words_arg),
+          converted_words(converted_words_arg),
           num_words(num_words_arg),
           diagnostic(diagnostic_arg),
           word_index(0),
@@ -183,11 +195,28 @@ class Parser {
       // Temporary storage for parser state within a single instruction.
       // Most instructions require fewer than 25 words or operands.
       operands.reserve(25);
-      endian_converted_words.reserve(25);
       expected_operands.reserve(25);
     }
-    State() : State(0, 0, nullptr) {}
-    const uint32_t* words;       // Words in the binary SPIR-V module.
+    // Constructs an empty state, without allocating any storage.
+    State()
+        : words(nullptr),
+          raw_words(nullptr),
+          converted_words(nullptr),
+          num_words(0),
+          diagnostic(nullptr),
+          word_index(0),
+          endian(),
+          requires_endian_conversion(false) {}
+    // Words in the binary SPIR-V module, in host native endianness.
+    const uint32_t* words;
+    // Words in the binary SPIR-V module, as given.  Literal strings are read
+    // from these, since they are not subject to endian conversion.
+    const uint32_t* raw_words;
+    // Where the module is converted to host endianness, if it needs to be.
+    // The literal strings of each instruction are copied back from
+    // |raw_words| once it is parsed, so the instructions reported to the
+    // callback point into this buffer.
+    uint32_t* converted_words;
     size_t num_words;            // Number of words in the module.
     spv_diagnostic* diagnostic;  // Where diagnostics go.
     size_t word_index;           // The current position in words.
@@ -196,26 +225,33 @@ class Parser {
     // endianness?
     bool requires_endian_conversion;
 
+    // These tables are consulted for many operands, so they are indexed by id
+    // up to the id bound in the header, unless the bound is implausibly large
+    // for the size of the module.
+    //
     // Maps a result ID to its type ID.  By convention:
     //  - a result ID that is a type definition maps to itself.
     //  - a result ID without a type maps to 0.  (E.g. for OpLabel)
-    std::unordered_map<uint32_t, uint32_t> id_to_type_id;
+    spvtools::utils::IdTable<IdInfo> id_to_type_id;
     // Maps a type ID to its number type description.
-    std::unordered_map<uint32_t, NumberType> type_id_to_number_type_info;
-    // Maps an ExtInstImport id to the extended instruction type.
-    std::unordered_map<uint32_t, spv_ext_inst_type_t>
-        import_id_to_ext_inst_type;
+    spvtools::utils::IdTable<TypeInfo> type_id_to_number_type_info;
+    // Maps an ExtInstImport id to the extended instruction type, or to
+    // SPV_EXT_INST_TYPE_NONE for other ids.
+    spvtools::utils::IdTable<spv_ext_inst_type_t> import_id_to_ext_inst_type;
 
     // Used by parseOperand
     std::vector<spv_parsed_operand_t> operands;
-    std::vector<uint32_t> endian_converted_words;
+    // Holds the converted module if |requires_endian_conversion| is true and
+    // the caller gave no buffer for it.
+    std::vector<uint32_t> endian_converted_module;
     spv_operand_pattern_t expected_operands;
   } _;
 };
 
 spv_result_t Parser::parse(const uint32_t* words, size_t num_words,
+                           uint32_t* converted_words,
                            spv_diagnostic* diagnostic_arg) {
-  _ = State(words, num_words, diagnostic_arg);
+  _ = State(words, num_words, converted_words, diagnostic_arg);
 
   const spv_result_t result = parseModule();
 
@@ -248,6 +284,21 @@ spv_result_t Parser::parseModule() {
     return diagnostic(SPV_ERROR_INTERNAL)
            << "Internal error: unhandled header parse failure";
   }
+  _.id_to_type_id.Reserve(header.bound, _.num_words);
+  _.type_id_to_number_type_info.Reserve(header.bound, _.num_words);
+  _.import_id_to_ext_inst_type.Reserve(header.bound, _.num_words);
+
+  // Convert the module in one sweep, which is much cheaper than converting
+  // each word as it is read.
+  if (_.requires_endian_conversion) {
+    if (!_.converted_words) {
+      _.endian_converted_module.resize(_.num_words);
+      _.converted_words = _.endian_converted_module.data();
+    }
+    spvFixWords(_.raw_words, _.num_words, _.endian, _.converted_words);
+    _.words = _.converted_words;
+  }
+
   if (parsed_header_fn_) {
     if (auto error = parsed_header_fn_(user_data_, _.endian, header.magic,
                                        header.version, header.generator,
@@ -274,12 +325,6 @@ spv_result_t Parser::parseInstruction() {
 
   const uint32_t first_word = peek();
 
-  // If the module's endianness is different from the host native endianness,
-  // then converted_words contains the the endian-translated words in the
-  // instruction.
-  _.endian_converted_words.clear();
-  _.endian_converted_words.push_back(first_word);
-
   // After a successful parse of the instruction, the inst.operands member
   // will point to this vector's storage.
   _.operands.clear();
@@ -327,9 +372,8 @@ spv_result_t Parser::parseInstruction() {
     spv_operand_type_t type =
         spvTakeFirstMatchableOperand(&_.expected_operands);
 
-    if (auto error =
-            parseOperand(inst_offset, &inst, type, &_.endian_converted_words,
-                         &_.operands, &_.expected_operands)) {
+    if (auto error = parseOperand(inst_offset, &inst, type, &_.operands,
+                                  &_.expected_operands)) {
       return error;
     }
   }
@@ -350,27 +394,21 @@ spv_result_t Parser::parseInstruction() {
                         << " words instead.";
   }
 
-  // Check the computed length of the endian-converted words vector against
-  // the declared number of words in the instruction.  If endian conversion
-  // is required, then they should match.  If no endian conversion was
-  // performed, then the vector only contains the initial opcode/word-count
-  // word.
-  assert(!_.requires_endian_conversion ||
-         (inst_word_count == _.endian_converted_words.size()));
-  assert(_.requires_endian_conversion ||
-         (_.endian_converted_words.size() == 1));
-
   recordNumberType(inst_offset, &inst);
 
+  // Literal strings keep the module's byte order, so put their words back
+  // in the converted module.  The words of this instruction are not read
+  // again.
   if (_.requires_endian_conversion) {
-    // We must wait until here to set this pointer, because the vector might
-    // have been be resized while we accumulated its elements.
-    inst.words = _.endian_converted_words.data();
-  } else {
-    // If no conversion is required, then just point to the underlying binary.
-    // This saves time and space.
-    inst.words = _.words + inst_offset;
+    for (const auto& operand : _.operands) {
+      if (operand.type != SPV_OPERAND_TYPE_LITERAL_STRING) continue;
+      const size_t string_offset = inst_offset + operand.offset;
+      std::copy(_.raw_words + string_offset,
+                _.raw_words + string_offset + operand.num_words,
+                _.converted_words + string_offset);
+    }
   }
+  inst.words = _.words + inst_offset;
   inst.num_words = inst_word_count;
 
   // We must wait until here to set this pointer, because the vector might
@@ -390,7 +428,6 @@ spv_result_t Parser::parseInstruction() {
 spv_result_t Parser::parseOperand(size_t inst_offset,
                                   spv_parsed_instruction_t* inst,
                                   const spv_operand_type_t type,
-                                  std::vector<uint32_t>* words,
                                   std::vector<spv_parsed_operand_t>* operands,
                                   spv_operand_pattern_t* expected_operands) {
   const SpvOp opcode = static_cast<SpvOp>(inst->opcode);
@@ -415,10 +452,6 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
 
   const uint32_t word = peek();
 
-  // Do the words in this operand have to be converted to native endianness?
-  // True for all but literal strings.
-  bool convert_operand_endianness = true;
-
   switch (type) {
     case SPV_OPERAND_TYPE_TYPE_ID:
       if (!word)
@@ -432,15 +465,19 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       inst->result_id = word;
       // Save the result ID to type ID mapping.
       // In the grammar, type ID always appears before result ID.
-      if (_.id_to_type_id.find(inst->result_id) != _.id_to_type_id.end())
-        return diagnostic(SPV_ERROR_INVALID_ID)
-               << "Id " << inst->result_id << " is defined more than once";
-      // Record it.
-      // A regular value maps to its type.  Some instructions (e.g. OpLabel)
-      // have no type Id, and will map to 0.  The result Id for a
-      // type-generating instruction (e.g. OpTypeInt) maps to itself.
-      _.id_to_type_id[inst->result_id] =
-          spvOpcodeGeneratesType(opcode) ? inst->result_id : inst->type_id;
+      {
+        IdInfo& info = _.id_to_type_id[inst->result_id];
+        if (info.defined)
+          return diagnostic(SPV_ERROR_INVALID_ID)
+                 << "Id " << inst->result_id << " is defined more than once";
+        // Record it.
+        // A regular value maps to its type.  Some instructions (e.g. OpLabel)
+        // have no type Id, and will map to 0.  The result Id for a
+        // type-generating instruction (e.g. OpTypeInt) maps to itself.
+        info.defined = true;
+        info.type_id =
+            spvOpcodeGeneratesType(opcode) ? inst->result_id : inst->type_id;
+      }
       break;
 
     case SPV_OPERAND_TYPE_ID:
@@ -451,13 +488,14 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
       if (opcode == SpvOpExtInst && parsed_operand.offset == 3) {
         // The current word is the extended instruction set Id.
         // Set the extended instruction set type for the current instruction.
-        auto ext_inst_type_iter = _.import_id_to_ext_inst_type.find(word);
-        if (ext_inst_type_iter == _.import_id_to_ext_inst_type.end()) {
+        const spv_ext_inst_type_t ext_inst_type =
+            _.import_id_to_ext_inst_type.Get(word);
+        if (ext_inst_type == SPV_EXT_INST_TYPE_NONE) {
           return diagnostic(SPV_ERROR_INVALID_ID)
                  << "OpExtInst set Id " << word
                  << " does not reference an OpExtInstImport result Id";
         }
-        inst->ext_inst_type = ext_inst_type_iter->second;
+        inst->ext_inst_type = ext_inst_type;
       }
       break;
 
@@ -514,13 +552,12 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
         // The literal operands have the same type as the value
         // referenced by the selector Id.
         const uint32_t selector_id = peekAt(inst_offset + 1);
-        const auto type_id_iter = _.id_to_type_id.find(selector_id);
-        if (type_id_iter == _.id_to_type_id.end() ||
-            type_id_iter->second == 0) {
+        const IdInfo& selector_info = _.id_to_type_id.Get(selector_id);
+        if (!selector_info.defined || selector_info.type_id == 0) {
           return diagnostic() << "Invalid OpSwitch: selector id " << selector_id
                               << " has no type";
         }
-        uint32_t type_id = type_id_iter->second;
+        uint32_t type_id = selector_info.type_id;
 
         if (selector_id == type_id) {
           // Recall that by convention, a result ID that is a type definition
@@ -548,9 +585,9 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
 
     case SPV_OPERAND_TYPE_LITERAL_STRING:
     case SPV_OPERAND_TYPE_OPTIONAL_LITERAL_STRING: {
-      convert_operand_endianness = false;
+      // Literal strings are not subject to endian conversion.
       const char* string =
-          reinterpret_cast<const char*>(_.words + _.word_index);
+          reinterpret_cast<const char*>(_.raw_words + _.word_index);
       // Compute the length of the string, but make sure we don't run off the
       // end of the input.
       const size_t remaining_input_bytes =
@@ -697,21 +734,6 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
   if (_.num_words < index_after_operand)
     return exhaustedInputDiagnostic(inst_offset, opcode, type);
 
-  if (_.requires_endian_conversion) {
-    // Copy instruction words.  Translate to native endianness as needed.
-    if (convert_operand_endianness) {
-      const spv_endianness_t endianness = _.endian;
-      std::transform(_.words + _.word_index, _.words + index_after_operand,
-                     std::back_inserter(*words),
-                     [endianness](const uint32_t raw_word) {
-                       return spvFixWord(raw_word, endianness);
-                     });
-    } else {
-      words->insert(words->end(), _.words + _.word_index,
-                    _.words + index_after_operand);
-    }
-  }
-
   // Advance past the operand.
   _.word_index = index_after_operand;
 
@@ -721,11 +743,11 @@ spv_result_t Parser::parseOperand(size_t inst_offset,
 spv_result_t Parser::setNumericTypeInfoForType(
     spv_parsed_operand_t* parsed_operand, uint32_t type_id) {
   assert(type_id != 0);
-  auto type_info_iter = _.type_id_to_number_type_info.find(type_id);
-  if (type_info_iter == _.type_id_to_number_type_info.end()) {
+  const TypeInfo& type_info = _.type_id_to_number_type_info.Get(type_id);
+  if (!type_info.is_type) {
     return diagnostic() << "Type Id " << type_id << " is not a type";
   }
-  const NumberType& info = type_info_iter->second;
+  const NumberType& info = type_info.number;
   if (info.type == SPV_NUMBER_NONE) {
     // This is a valid type, but for something other than a scalar number.
     return diagnostic() << "Type Id " << type_id
@@ -753,7 +775,7 @@ void Parser::recordNumberType(size_t inst_offset,
       info.bit_width = peekAt(inst_offset + 2);
     }
     // The *result* Id of a type generating instruction is the type Id.
-    _.type_id_to_number_type_info[inst->result_id] = info;
+    _.type_id_to_number_type_info[inst->result_id] = {true, info};
   }
 }
 
@@ -770,9 +792,98 @@ spv_result_t spvBinaryParse(const spv_const_context context, void* user_data,
     spvtools::UseDiagnosticAsMessageConsumer(&hijack_context, diagnostic);
   }
   Parser parser(&hijack_context, user_data, parsed_header, parsed_instruction);
-  return parser.parse(code, num_words, diagnostic);
+  return parser.parse(code, num_words, nullptr, diagnostic);
 }
 
+spv_result_t spvBinaryParseInto(const spv_const_context context,
+                                void* user_data, const uint32_t* code,
+                                const size_t num_words,
+                                uint32_t* converted_words,
+                                spv_parsed_header_fn_t parsed_header,
+                                spv_parsed_instruction_fn_t parsed_instruction,
+                                spv_diagnostic* diagnostic) {
+  spv_context_t hijack_context = *context;
+  if (diagnostic) {
+    *diagnostic = nullptr;
+    spvtools::UseDiagnosticAsMessageConsumer(&hijack_context, diagnostic);
+  }
+  Parser parser(&hijack_context, user_data, parsed_header, parsed_instruction);
+  return parser.parse(code, num_words, converted_words, diagnostic);
+}
+
+spv_result_t spvBinaryIndexInstructions(const spv_const_context context,
+                                        const uint32_t* words,
+                                        const size_t num_words,
+                                        size_t* offsets,
+                                        const size_t max_offsets,
+                                        size_t* num_instructions,
+                                        spv_diagnostic* diagnostic) {
+  if (!num_instructions) return SPV_ERROR_INVALID_POINTER;
+  spv_context_t hijack_context = *context;
+  if (diagnostic) {
+    *diagnostic = nullptr;
+    spvtools::UseDiagnosticAsMessageConsumer(&hijack_context, diagnostic);
+  }
+  std::vector<size_t> index;
+  if (auto error = spvtools::IndexInstructions(hijack_context.consumer, words,
+                                               num_words, &index)) {
+    return error;
+  }
+  if (offsets) {
+    std::copy(index.begin(),
+              index.begin() + std::min(index.size(), max_offsets), offsets);
+  }
+  *num_instructions = index.size();
+  return SPV_SUCCESS;
+}
+
+namespace spvtools {
+
+spv_result_t IndexInstructions(const MessageConsumer& consumer,
+                               const uint32_t* words, size_t num_words,
+                               std::vector<size_t>* offsets) {
+  auto diagnostic = [&consumer](size_t word_index) {
+    return DiagnosticStream({0, 0, word_index}, consumer, "",
+                            SPV_ERROR_INVALID_BINARY);
+  };
+
+  if (!words) return diagnostic(0) << "Missing module.";
+  if (num_words < SPV_INDEX_INSTRUCTION)
+    return diagnostic(0) << "Module has incomplete header: only " << num_words
+                         << " words instead of " << SPV_INDEX_INSTRUCTION;
+  spv_endianness_t endian;
+  spv_const_binary_t binary{words, num_words};
+  if (spvBinaryEndianness(&binary, &endian)) {
+    return diagnostic(0) << "Invalid SPIR-V magic number '" << std::hex
+                         << words[0] << "'.";
+  }
+
+  // Only the first word of each instruction is read, so convert those alone.
+  std::vector<size_t> index;
+  size_t word_index = SPV_INDEX_INSTRUCTION;
+  while (word_index < num_words) {
+    const uint32_t word_count =
+        spvFixWord(words[word_index], endian) >> SpvWordCountShift;
+    if (word_count == 0) {
+      return diagnostic(word_index) << "Invalid instruction word count: 0";
+    }
+    if (word_count > num_words - word_index) {
+      return diagnostic(word_index)
+             << "End of input reached while indexing the instruction starting "
+                "at word "
+             << word_index << ": it has " << word_count << " words, but only "
+             << num_words - word_index << " remain.";
+    }
+    index.push_back(word_index);
+    word_index += word_count;
+  }
+
+  offsets->swap(index);
+  return SPV_SUCCESS;
+}
+
+}  // namespace spvtools
+
 // TODO(dneto): This probably belongs in text.cpp since that's the only place
 // that a spv_binary_t value is created.
 void spvBinaryDestroy(spv_binary binary) {
@@ -15,7 +15,9 @@
 #ifndef LIBSPIRV_BINARY_H_
 #define LIBSPIRV_BINARY_H_
 
-#include "spirv-tools/libspirv.h"
+#include <vector>
+
+#include "spirv-tools/libspirv.hpp"
 #include "spirv_definition.h"
 
 // Functions
@@ -33,4 +35,32 @@ spv_result_t spvBinaryHeaderGet(const spv_const_binary binary,
 // replacement for C11's strnlen_s which might not exist in all environments.
 size_t spv_strnlen_s(const char* str, size_t strsz);
 
+// Like spvBinaryParse, but a module which is not in host endianness is
+// converted into |converted_words|, which must have room for |num_words|
+// words.  The parsed instructions point into it.  Literal strings keep the
+// byte order of the module, so once the parse succeeds, |converted_words|
+// holds the module as a host endian producer would have written it.  It is
+// not written to for a module in host endianness.
+spv_result_t spvBinaryParseInto(const spv_const_context context,
+                                void* user_data, const uint32_t* words,
+                                const size_t num_words,
+                                uint32_t* converted_words,
+                                spv_parsed_header_fn_t parse_header,
+                                spv_parsed_instruction_fn_t parse_instruction,
+                                spv_diagnostic* diagnostic);
+
+namespace spvtools {
+
+// Finds the word offset of each instruction in the SPIR-V module |words| of
+// |num_words| words, and writes them to |offsets|.  Checks the header, and that
+// every instruction has a non-zero word count that does not run past the end of
+// the module.  Returns SPV_SUCCESS on success.  Otherwise returns
+// SPV_ERROR_INVALID_BINARY, reports the issue to |consumer|, and leaves
+// |offsets| untouched.
+spv_result_t IndexInstructions(const MessageConsumer& consumer,
+                               const uint32_t* words, size_t num_words,
+                               std::vector<size_t>* offsets);
+
+}  // namespace spvtools
+
 #endif  // LIBSPIRV_BINARY_H_
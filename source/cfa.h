@@ -48,17 +48,6 @@ class CFA {
     bb_iter iter;   ///< Iterator to the current child node being processed
   };
 
-  /// Returns true if a block with @p id is found in the @p work_list vector
-  ///
-  /// @param[in] work_list  Set of blocks visited in the the depth first
-  /// traversal
-  ///                       of the CFG
-  /// @param[in] id         The ID of the block being checked
-  ///
-  /// @return true if the edge work_list.back().block->id() => id is a back-edge
-  static bool FindInWorkList(const std::vector<block_info>& work_list,
-                             uint32_t id);
-
  public:
   /// @brief Depth first traversal starting from the \p entry BasicBlock
   ///
@@ -88,28 +77,27 @@ class CFA {
 
   /// @brief Calculates dominator edges for a set of blocks
   ///
-  /// Computes dominators using the algorithm of Cooper, Harvey, and Kennedy
-  /// "A Simple, Fast Dominance Algorithm", 2001.
+  /// Computes dominators using the Semi-NCA algorithm of Georgiadis, "Linear-
+  /// Time Algorithms for Dominators and Related Problems", 2005, which finds
+  /// semidominators as Lengauer and Tarjan do, then derives each immediate
+  /// dominator as a nearest common ancestor in the partially built tree. The
+  /// blocks are numbered densely, so the cost is nearly linear in the number
+  /// of edges whatever the shape of the CFG.
   ///
   /// The algorithm assumes there is a unique root node (a node without
   /// predecessors), and it is therefore at the end of the postorder vector.
-  ///
-  /// This function calculates the dominator edges for a set of blocks in the
-  /// CFG.
-  /// Uses the dominator algorithm by Cooper et al.
+  /// Predecessors which are not in the postorder vector are ignored.
   ///
   /// @param[in] postorder        A vector of blocks in post order traversal
-  /// order
-  ///                             in a CFG
+  ///                             order in a CFG
   /// @param[in] predecessor_func Function used to get the predecessor nodes of
-  /// a
-  ///                             block
+  ///                             a block
   ///
-  /// @return the dominator tree of the graph, as a vector of pairs of nodes.
-  /// The first node in the pair is a node in the graph. The second node in the
-  /// pair is its immediate dominator in the sense of Cooper et.al., where a
-  /// block
-  /// without predecessors (such as the root node) is its own immediate
+  /// @return the dominator tree of the graph, as a vector of pairs of nodes,
+  /// in the order of the postorder vector. The first node in the pair is a
+  /// node in the graph. The second node in the pair is its immediate
+  /// dominator, where a block which cannot be reached from the root through
+  /// the predecessor edges (such as the root node itself) is its own immediate
   /// dominator.
   static vector<pair<BB*, BB*>> CalculateDominators(
       const vector<cbb_ptr>& postorder, get_blocks_func predecessor_func);
@@ -132,21 +120,15 @@ class CFA {
       get_blocks_func succ_func, get_blocks_func pred_func);
 };
 
-template <class BB>
-bool CFA<BB>::FindInWorkList(const vector<block_info>& work_list, uint32_t id) {
-  for (const auto b : work_list) {
-    if (b.block->id() == id) return true;
-  }
-  return false;
-}
-
 template <class BB>
 void CFA<BB>::DepthFirstTraversal(const BB* entry,
                                   get_blocks_func successor_func,
                                   function<void(cbb_ptr)> preorder,
                                   function<void(cbb_ptr)> postorder,
                                   function<void(cbb_ptr, cbb_ptr)> backedge) {
-  unordered_set<uint32_t> processed;
+  /// NOTE: the ids of the blocks reached so far, mapped to whether the block
+  /// is still on the work list, so back-edges are found without a search.
+  unordered_map<uint32_t, bool> on_work_list;
 
   /// NOTE: work_list is the sequence of nodes from the root node to the node
   /// being processed in the traversal
@@ -155,24 +137,24 @@ void CFA<BB>::DepthFirstTraversal(const BB* entry,
 
   work_list.push_back({entry, begin(*successor_func(entry))});
   preorder(entry);
-  processed.insert(entry->id());
+  on_work_list[entry->id()] = true;
 
   while (!work_list.empty()) {
     block_info& top = work_list.back();
     if (top.iter == end(*successor_func(top.block))) {
       postorder(top.block);
+      on_work_list[top.block->id()] = false;
       work_list.pop_back();
     } else {
       BB* child = *top.iter;
       top.iter++;
-      if (FindInWorkList(work_list, child->id())) {
-        backedge(top.block, child);
-      }
-      if (processed.count(child->id()) == 0) {
+      const auto reached = on_work_list.insert({child->id(), true});
+      if (reached.second) {
         preorder(child);
         work_list.emplace_back(
             block_info{child, begin(*successor_func(child))});
-        processed.insert(child->id());
+      } else if (reached.first->second) {
+        backedge(top.block, child);
       }
     }
   }
@@ -181,68 +163,126 @@ void CFA<BB>::DepthFirstTraversal(const BB* entry,
 template <class BB>
 vector<pair<BB*, BB*>> CFA<BB>::CalculateDominators(
     const vector<cbb_ptr>& postorder, get_blocks_func predecessor_func) {
-  struct block_detail {
-    size_t dominator;  ///< The index of blocks's dominator in post order array
-    size_t postorder_index;  ///< The index of the block in the post order array
-  };
-  const size_t undefined_dom = postorder.size();
+  const size_t num_blocks = postorder.size();
+  if (num_blocks == 0) return {};
+  const size_t undefined = num_blocks;
+
+  unordered_map<cbb_ptr, size_t> postorder_index;
+  postorder_index.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) postorder_index[postorder[i]] = i;
+
+  // The predecessors and successors of each block, by postorder index, with
+  // the edges from blocks outside the postorder vector dropped. The
+  // predecessors of block i are preds[first_pred[i]] up to
+  // preds[first_pred[i + 1]], and likewise for the successors.
+  vector<size_t> first_pred(num_blocks + 1, 0);
+  vector<size_t> preds;
+  for (size_t i = 0; i < num_blocks; i++) {
+    first_pred[i] = preds.size();
+    for (const BB* pred : *predecessor_func(postorder[i])) {
+      const auto it = postorder_index.find(pred);
+      if (it != postorder_index.end()) preds.push_back(it->second);
+    }
+  }
+  first_pred[num_blocks] = preds.size();
+
+  vector<size_t> first_succ(num_blocks + 1, 0);
+  for (size_t pred : preds) first_succ[pred + 1]++;
+  for (size_t i = 0; i < num_blocks; i++) first_succ[i + 1] += first_succ[i];
+  vector<size_t> succs(preds.size());
+  {
+    vector<size_t> next_succ(first_succ.begin(), first_succ.end() - 1);
+    for (size_t i = 0; i < num_blocks; i++) {
+      for (size_t e = first_pred[i]; e < first_pred[i + 1]; e++) {
+        succs[next_succ[preds[e]]++] = i;
+      }
+    }
+  }
 
-  unordered_map<cbb_ptr, block_detail> idoms;
-  for (size_t i = 0; i < postorder.size(); i++) {
-    idoms[postorder[i]] = {undefined_dom, i};
+  // Number the blocks in the preorder of a depth first traversal from the
+  // root. From here on blocks are named by these numbers, so every ancestor
+  // of a block in the spanning tree has a smaller number than the block.
+  vector<size_t> preorder_number(num_blocks, undefined);
+  vector<size_t> block_of;  // The postorder index of each preorder number.
+  vector<size_t> parent;    // The parent in the spanning tree.
+  block_of.reserve(num_blocks);
+  parent.reserve(num_blocks);
+  {
+    // Pairs of a block and the next of its successors to look at.
+    vector<pair<size_t, size_t>> work_list;
+    const size_t root = num_blocks - 1;
+    preorder_number[root] = 0;
+    block_of.push_back(root);
+    parent.push_back(0);
+    work_list.push_back({root, first_succ[root]});
+    while (!work_list.empty()) {
+      pair<size_t, size_t>& top = work_list.back();
+      if (top.second == first_succ[top.first + 1]) {
+        work_list.pop_back();
+        continue;
+      }
+      const size_t succ = succs[top.second++];
+      if (preorder_number[succ] != undefined) continue;
+      preorder_number[succ] = block_of.size();
+      block_of.push_back(succ);
+      parent.push_back(preorder_number[top.first]);
+      work_list.push_back({succ, first_succ[succ]});
+    }
   }
-  idoms[postorder.back()].dominator = idoms[postorder.back()].postorder_index;
-
-  bool changed = true;
-  while (changed) {
-    changed = false;
-    for (auto b = postorder.rbegin() + 1; b != postorder.rend(); ++b) {
-      const vector<BB*>& predecessors = *predecessor_func(*b);
-      // Find the first processed/reachable predecessor that is reachable
-      // in the forward traversal.
-      auto res = find_if(begin(predecessors), end(predecessors),
-                         [&idoms, undefined_dom](BB* pred) {
-                           return idoms.count(pred) &&
-                                  idoms[pred].dominator != undefined_dom;
-                         });
-      if (res == end(predecessors)) continue;
-      const BB* idom = *res;
-      size_t idom_idx = idoms[idom].postorder_index;
-
-      // all other predecessors
-      for (const auto* p : predecessors) {
-        if (idom == p) continue;
-        // Only consider nodes reachable in the forward traversal.
-        // Otherwise the intersection doesn't make sense and will never
-        // terminate.
-        if (!idoms.count(p)) continue;
-        if (idoms[p].dominator != undefined_dom) {
-          size_t finger1 = idoms[p].postorder_index;
-          size_t finger2 = idom_idx;
-          while (finger1 != finger2) {
-            while (finger1 < finger2) {
-              finger1 = idoms[postorder[finger1]].dominator;
-            }
-            while (finger2 < finger1) {
-              finger2 = idoms[postorder[finger2]].dominator;
-            }
-          }
-          idom_idx = finger1;
+  const size_t num_reached = block_of.size();
+
+  // Find the semidominator of each block, walking the spanning tree
+  // backwards. |ancestor| links the blocks processed so far into a forest,
+  // compressed as it is searched, and |label| is the block with the smallest
+  // semidominator on the compressed path to each block.
+  vector<size_t> semi(num_reached);
+  vector<size_t> label(num_reached);
+  vector<size_t> ancestor(num_reached, undefined);
+  for (size_t v = 0; v < num_reached; v++) semi[v] = label[v] = v;
+  vector<size_t> path;
+  for (size_t w = num_reached - 1; w > 0; w--) {
+    const size_t block = block_of[w];
+    for (size_t e = first_pred[block]; e < first_pred[block + 1]; e++) {
+      size_t v = preorder_number[preds[e]];
+      if (v == undefined) continue;
+      if (ancestor[v] != undefined) {
+        // Compress the path from |v|, starting with the link nearest the
+        // root of its tree.
+        for (size_t u = v; ancestor[ancestor[u]] != undefined;
+             u = ancestor[u]) {
+          path.push_back(u);
         }
+        while (!path.empty()) {
+          const size_t u = path.back();
+          path.pop_back();
+          const size_t a = ancestor[u];
+          if (semi[label[a]] < semi[label[u]]) label[u] = label[a];
+          ancestor[u] = ancestor[a];
+        }
+        v = label[v];
       }
-      if (idoms[*b].dominator != idom_idx) {
-        idoms[*b].dominator = idom_idx;
-        changed = true;
-      }
+      if (semi[v] < semi[w]) semi[w] = semi[v];
     }
+    ancestor[w] = parent[w];
+  }
+
+  // The immediate dominator of each block is the nearest common ancestor of
+  // its parent and its semidominator in the dominator tree built so far.
+  vector<size_t> idom(parent);
+  for (size_t w = 1; w < num_reached; w++) {
+    while (idom[w] > semi[w]) idom[w] = idom[idom[w]];
   }
 
   vector<pair<bb_ptr, bb_ptr>> out;
-  for (auto idom : idoms) {
+  out.reserve(num_blocks);
+  for (size_t i = 0; i < num_blocks; i++) {
+    const size_t number = preorder_number[i];
+    const size_t dominator =
+        number == undefined ? i : block_of[idom[number]];
     // NOTE: performing a const cast for convenient usage with
     // UpdateImmediateDominators
-    out.push_back({const_cast<BB*>(get<0>(idom)),
-                   const_cast<BB*>(postorder[get<1>(idom).dominator])});
+    out.push_back({const_cast<BB*>(postorder[i]),
+                   const_cast<BB*>(postorder[dominator])});
   }
   return out;
 }
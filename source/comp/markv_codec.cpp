@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -548,6 +549,12 @@ class MarkvCodecBase {
   // List of instructions in the order they are given in the module.
   std::vector<std::unique_ptr<const Instruction>> instructions_;
 
+  // The words of |instructions_|, which do not own them.
+  std::deque<std::vector<uint32_t>> instruction_words_;
+
+  // The operands of |instructions_|.
+  std::vector<spv_parsed_operand_t> instruction_operands_;
+
   // Container/computer for long (32-bit) id descriptors.
   IdDescriptorCollection long_id_descriptors_;
 
@@ -859,7 +866,11 @@ class MarkvDecoder : public MarkvCodecBase {
 };
 
 void MarkvCodecBase::ProcessCurInstruction() {
-  instructions_.emplace_back(new Instruction(&inst_));
+  // The words of |inst_| are only valid until the next instruction.
+  instruction_words_.emplace_back(inst_.words, inst_.words + inst_.num_words);
+  spv_parsed_instruction_t inst = inst_;
+  inst.words = instruction_words_.back().data();
+  instructions_.emplace_back(new Instruction(&inst, &instruction_operands_));
 
   const SpvOp opcode = SpvOp(inst_.opcode);
 
@@ -18,7 +18,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstring>
-#include <iomanip>
+#include <iostream>
 #include <memory>
 #include <unordered_map>
 
@@ -35,6 +35,8 @@
 #include "spirv_constant.h"
 #include "spirv_endian.h"
 #include "util/hex_float.h"
+#include "util/parallel.h"
+#include "util/text_buffer.h"
 
 namespace {
 
@@ -51,14 +53,15 @@ class Disassembler {
                     ? kStandardIndent
                     : 0),
         text_(),
-        out_(print_ ? out_stream() : out_stream(text_)),
-        stream_(out_.get()),
         header_(!spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_NO_HEADER, options)),
         show_byte_offset_(spvIsInBitfield(
             SPV_BINARY_TO_TEXT_OPTION_SHOW_BYTE_OFFSET, options)),
         byte_offset_(0),
         name_mapper_(std::move(name_mapper)) {}
 
+  // Writes any text not yet written, if printing.
+  ~Disassembler() { Flush(); }
+
   // Emits the assembly header for the module, and sets up internal state
   // so subsequent callbacks can handle the cases where the entire module
   // is either big-endian or little-endian.
@@ -68,14 +71,35 @@ class Disassembler {
   // Emits the assembly text for the given instruction.
   spv_result_t HandleInstruction(const spv_parsed_instruction_t& inst);
 
+  // Emits text produced by another disassembler.
+  void EmitText(const spvtools::utils::TextBuffer& text) {
+    text_.Append(text.str());
+    if (text_.size() >= kFlushSize) Flush();
+  }
+
+  // Returns the text accumulated so far, if not printing.
+  const spvtools::utils::TextBuffer& text() const { return text_; }
+
+  // Sets the byte offset of the next instruction, for disassembling part of a
+  // module without its header.
+  void set_byte_offset(size_t byte_offset) { byte_offset_ = byte_offset; }
+
   // If not printing, populates text_result with the accumulated text.
   // Returns SPV_SUCCESS on success.
-  spv_result_t SaveTextResult(spv_text* text_result) const;
+  spv_result_t SaveTextResult(spv_text* text_result);
 
  private:
   enum { kStandardIndent = 15 };
-
-  using out_stream = spvtools::out_stream;
+  // How much text is accumulated before it is written, if printing.
+  static const size_t kFlushSize = 1 << 16;
+
+  // Writes the accumulated text to the standard output stream and clears it,
+  // if printing.
+  void Flush() {
+    if (!print_) return;
+    std::cout.write(text_.data(), static_cast<std::streamsize>(text_.size()));
+    text_.Clear();
+  }
 
   // Emits an operand for the given instruction, where the instruction
   // is at offset words from the start of the binary.
@@ -85,39 +109,36 @@ class Disassembler {
   // Emits a mask expression for the given mask word of the specified type.
   void EmitMaskOperand(const spv_operand_type_t type, const uint32_t word);
 
-  // Resets the output color, if color is turned on.
-  void ResetColor() {
-    if (color_) out_.get() << spvtools::clr::reset{print_};
+  // Emits the given color, if color is turned on. When printing, the text so
+  // far is written first, since on some platforms the color is set by calling
+  // into the console rather than by emitting an escape sequence.
+  template <typename Color>
+  void SetColor(Color color) {
+    if (!color_) return;
+    Flush();
+    text_.Append(static_cast<const char*>(color));
   }
+
+  // Resets the output color, if color is turned on.
+  void ResetColor() { SetColor(spvtools::clr::reset{print_}); }
   // Sets the output to grey, if color is turned on.
-  void SetGrey() {
-    if (color_) out_.get() << spvtools::clr::grey{print_};
-  }
+  void SetGrey() { SetColor(spvtools::clr::grey{print_}); }
   // Sets the output to blue, if color is turned on.
-  void SetBlue() {
-    if (color_) out_.get() << spvtools::clr::blue{print_};
-  }
+  void SetBlue() { SetColor(spvtools::clr::blue{print_}); }
   // Sets the output to yellow, if color is turned on.
-  void SetYellow() {
-    if (color_) out_.get() << spvtools::clr::yellow{print_};
-  }
+  void SetYellow() { SetColor(spvtools::clr::yellow{print_}); }
   // Sets the output to red, if color is turned on.
-  void SetRed() {
-    if (color_) out_.get() << spvtools::clr::red{print_};
-  }
+  void SetRed() { SetColor(spvtools::clr::red{print_}); }
   // Sets the output to green, if color is turned on.
-  void SetGreen() {
-    if (color_) out_.get() << spvtools::clr::green{print_};
-  }
+  void SetGreen() { SetColor(spvtools::clr::green{print_}); }
 
   const spvtools::AssemblyGrammar& grammar_;
   const bool print_;  // Should we also print to the standard output stream?
   const bool color_;  // Should we print in colour?
   const int indent_;  // How much to indent. 0 means don't indent
   spv_endianness_t endian_;  // The detected endianness of the binary.
-  std::stringstream text_;   // Captures the text, if not printing.
-  out_stream out_;  // The Output stream.  Either to text_ or standard output.
-  std::ostream& stream_;  // The output std::stream.
+  // Captures the text. If printing, it is written out as it grows.
+  spvtools::utils::TextBuffer text_;
   const bool header_;     // Should we output header as the leading comment?
   const bool show_byte_offset_;  // Should we print byte offset, in hex?
   size_t byte_offset_;           // The number of bytes processed so far.
@@ -133,19 +154,27 @@ spv_result_t Disassembler::HandleHeader(spv_endianness_t endian,
     SetGrey();
     const char* generator_tool =
         spvGeneratorStr(SPV_GENERATOR_TOOL_PART(generator));
-    stream_ << "; SPIR-V\n"
-            << "; Version: " << SPV_SPIRV_VERSION_MAJOR_PART(version) << "."
-            << SPV_SPIRV_VERSION_MINOR_PART(version) << "\n"
-            << "; Generator: " << generator_tool;
+    text_.Append("; SPIR-V\n; Version: ");
+    text_.AppendUnsigned(SPV_SPIRV_VERSION_MAJOR_PART(version));
+    text_.Append('.');
+    text_.AppendUnsigned(SPV_SPIRV_VERSION_MINOR_PART(version));
+    text_.Append("\n; Generator: ");
+    text_.Append(generator_tool);
     // For unknown tools, print the numeric tool value.
     if (0 == strcmp("Unknown", generator_tool)) {
-      stream_ << "(" << SPV_GENERATOR_TOOL_PART(generator) << ")";
+      text_.Append('(');
+      text_.AppendUnsigned(SPV_GENERATOR_TOOL_PART(generator));
+      text_.Append(')');
     }
     // Print the miscellaneous part of the generator word on the same
     // line as the tool name.
-    stream_ << "; " << SPV_GENERATOR_MISC_PART(generator) << "\n"
-            << "; Bound: " << id_bound << "\n"
-            << "; Schema: " << schema << "\n";
+    text_.Append("; ");
+    text_.AppendUnsigned(SPV_GENERATOR_MISC_PART(generator));
+    text_.Append("\n; Bound: ");
+    text_.AppendUnsigned(id_bound);
+    text_.Append("\n; Schema: ");
+    text_.AppendUnsigned(schema);
+    text_.Append('\n');
     ResetColor();
   }
 
@@ -159,39 +188,39 @@ spv_result_t Disassembler::HandleInstruction(
   if (inst.result_id) {
     SetBlue();
     const std::string id_name = name_mapper_(inst.result_id);
-    if (indent_)
-      stream_ << std::setw(std::max(0, indent_ - 3 - int(id_name.size())));
-    stream_ << "%" << id_name;
+    // Right-align the result id so that the opcodes line up.
+    const int padding = indent_ - 3 - int(id_name.size()) - 1;
+    if (padding > 0) text_.AppendFill(size_t(padding), ' ');
+    text_.Append('%');
+    text_.Append(id_name);
     ResetColor();
-    stream_ << " = ";
+    text_.Append(" = ");
   } else {
-    stream_ << std::string(indent_, ' ');
+    text_.AppendFill(size_t(indent_), ' ');
   }
 
-  stream_ << "Op" << spvOpcodeString(static_cast<SpvOp>(inst.opcode));
+  text_.Append("Op");
+  text_.Append(spvOpcodeString(static_cast<SpvOp>(inst.opcode)));
 
   for (uint16_t i = 0; i < inst.num_operands; i++) {
     const spv_operand_type_t type = inst.operands[i].type;
     assert(type != SPV_OPERAND_TYPE_NONE);
     if (type == SPV_OPERAND_TYPE_RESULT_ID) continue;
-    stream_ << " ";
+    text_.Append(' ');
     EmitOperand(inst, i);
   }
 
   if (show_byte_offset_) {
     SetGrey();
-    auto saved_flags = stream_.flags();
-    auto saved_fill = stream_.fill();
-    stream_ << " ; 0x" << std::setw(8) << std::hex << std::setfill('0')
-            << byte_offset_;
-    stream_.flags(saved_flags);
-    stream_.fill(saved_fill);
+    text_.Append(" ; 0x");
+    text_.AppendHex(byte_offset_, 8);
     ResetColor();
   }
 
   byte_offset_ += inst.num_words * sizeof(uint32_t);
 
-  stream_ << "\n";
+  text_.Append('\n');
+  if (text_.size() >= kFlushSize) Flush();
   return SPV_SUCCESS;
 }
 
@@ -204,48 +233,55 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
     case SPV_OPERAND_TYPE_RESULT_ID:
       assert(false && "<result-id> is not supposed to be handled here");
       SetBlue();
-      stream_ << "%" << name_mapper_(word);
+      text_.Append('%');
+      text_.Append(name_mapper_(word));
       break;
     case SPV_OPERAND_TYPE_ID:
     case SPV_OPERAND_TYPE_TYPE_ID:
     case SPV_OPERAND_TYPE_SCOPE_ID:
     case SPV_OPERAND_TYPE_MEMORY_SEMANTICS_ID:
       SetYellow();
-      stream_ << "%" << name_mapper_(word);
+      text_.Append('%');
+      text_.Append(name_mapper_(word));
       break;
     case SPV_OPERAND_TYPE_EXTENSION_INSTRUCTION_NUMBER: {
       spv_ext_inst_desc ext_inst;
       if (grammar_.lookupExtInst(inst.ext_inst_type, word, &ext_inst))
         assert(false && "should have caught this earlier");
       SetRed();
-      stream_ << ext_inst->name;
+      text_.Append(ext_inst->name);
     } break;
     case SPV_OPERAND_TYPE_SPEC_CONSTANT_OP_NUMBER: {
       spv_opcode_desc opcode_desc;
       if (grammar_.lookupOpcode(SpvOp(word), &opcode_desc))
         assert(false && "should have caught this earlier");
       SetRed();
-      stream_ << opcode_desc->name;
+      text_.Append(opcode_desc->name);
     } break;
     case SPV_OPERAND_TYPE_LITERAL_INTEGER:
     case SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER: {
       SetRed();
-      spvtools::EmitNumericLiteral(&stream_, inst, operand);
+      spvtools::EmitNumericLiteral(&text_, inst, operand);
       ResetColor();
     } break;
     case SPV_OPERAND_TYPE_LITERAL_STRING: {
-      stream_ << "\"";
+      text_.Append('"');
       SetGreen();
       // Strings are always little-endian, and null-terminated.
       // Write out the characters, escaping as needed, and without copying
       // the entire string.
       auto c_str = reinterpret_cast<const char*>(inst.words + operand.offset);
+      auto run = c_str;
       for (auto p = c_str; *p; ++p) {
-        if (*p == '"' || *p == '\\') stream_ << '\\';
-        stream_ << *p;
+        if (*p == '"' || *p == '\\') {
+          text_.Append(run, size_t(p - run));
+          text_.Append('\\');
+          run = p;
+        }
       }
+      text_.Append(run);
       ResetColor();
-      stream_ << '"';
+      text_.Append('"');
     } break;
     case SPV_OPERAND_TYPE_CAPABILITY:
     case SPV_OPERAND_TYPE_SOURCE_LANGUAGE:
@@ -274,7 +310,7 @@ void Disassembler::EmitOperand(const spv_parsed_instruction_t& inst,
       spv_operand_desc entry;
       if (grammar_.lookupOperand(operand.type, word, &entry))
         assert(false && "should have caught this earlier");
-      stream_ << entry->name;
+      text_.Append(entry->name);
     } break;
     case SPV_OPERAND_TYPE_FP_FAST_MATH_MODE:
     case SPV_OPERAND_TYPE_FUNCTION_CONTROL:
@@ -304,8 +340,8 @@ void Disassembler::EmitMaskOperand(const spv_operand_type_t type,
       spv_operand_desc entry;
       if (grammar_.lookupOperand(type, mask, &entry))
         assert(false && "should have caught this earlier");
-      if (num_emitted) stream_ << "|";
-      stream_ << entry->name;
+      if (num_emitted) text_.Append('|');
+      text_.Append(entry->name);
       num_emitted++;
     }
   }
@@ -314,16 +350,19 @@ void Disassembler::EmitMaskOperand(const spv_operand_type_t type,
     // of the 0 value. In many cases, that's "None".
     spv_operand_desc entry;
     if (SPV_SUCCESS == grammar_.lookupOperand(type, 0, &entry))
-      stream_ << entry->name;
+      text_.Append(entry->name);
   }
 }
 
-spv_result_t Disassembler::SaveTextResult(spv_text* text_result) const {
-  if (!print_) {
-    size_t length = text_.str().size();
+spv_result_t Disassembler::SaveTextResult(spv_text* text_result) {
+  if (print_) {
+    Flush();
+  } else {
+    size_t length = text_.size();
     char* str = new char[length + 1];
     if (!str) return SPV_ERROR_OUT_OF_MEMORY;
-    strncpy(str, text_.str().c_str(), length + 1);
+    memcpy(str, text_.data(), length);
+    str[length] = '\0';
     spv_text text = new spv_text_t();
     if (!text) {
       delete[] str;
@@ -353,6 +392,124 @@ spv_result_t DisassembleInstruction(
   return disassembler->HandleInstruction(*parsed_instruction);
 }
 
+// Disassembles the function bodies of a module on several threads. The
+// instructions before the first function are handed to the disassembler as
+// they are parsed. The instructions of function bodies are collected, and
+// disassembled a batch of whole functions at a time: each function by its own
+// Disassembler, whose text is then emitted by the disassembler, in order. The
+// text is the same as the disassembler would produce by itself.
+//
+// The module must be in host byte order, so that parsed instructions point
+// into it, and stay valid after they are parsed.
+class ParallelDisassembler {
+ public:
+  ParallelDisassembler(Disassembler* disassembler,
+                       const spvtools::AssemblyGrammar& grammar,
+                       uint32_t options, spvtools::NameMapper name_mapper,
+                       const uint32_t* code, uint32_t num_threads)
+      : disassembler_(disassembler),
+        grammar_(grammar),
+        // Function bodies are disassembled into memory.
+        options_(options & ~uint32_t(SPV_BINARY_TO_TEXT_OPTION_PRINT)),
+        name_mapper_(std::move(name_mapper)),
+        code_(code),
+        num_threads_(num_threads) {}
+
+  Disassembler* disassembler() { return disassembler_; }
+
+  // Collects the instruction if it is in a function body, or else hands it to
+  // the disassembler.
+  spv_result_t HandleInstruction(const spv_parsed_instruction_t& inst);
+
+  // Disassembles the collected function bodies.
+  void DisassembleFunctions();
+
+ private:
+  // How many words of function bodies are collected before they are
+  // disassembled, which bounds the memory used for collected instructions.
+  static const size_t kBatchSize = 1 << 20;
+
+  Disassembler* disassembler_;
+  const spvtools::AssemblyGrammar& grammar_;
+  const uint32_t options_;
+  const spvtools::NameMapper name_mapper_;
+  const uint32_t* code_;
+  const uint32_t num_threads_;
+  // The collected instructions, and the indices of the instructions which
+  // start functions. The operands of instruction i start at operands_[j],
+  // where j is operand_starts_[i].
+  std::vector<spv_parsed_instruction_t> instructions_;
+  std::vector<size_t> operand_starts_;
+  std::vector<spv_parsed_operand_t> operands_;
+  std::vector<size_t> function_starts_;
+  // The number of words in the collected instructions.
+  size_t num_words_ = 0;
+};
+
+spv_result_t ParallelDisassembler::HandleInstruction(
+    const spv_parsed_instruction_t& inst) {
+  if (inst.opcode == SpvOpFunction) {
+    if (num_words_ >= kBatchSize) DisassembleFunctions();
+    function_starts_.push_back(instructions_.size());
+  }
+  if (function_starts_.empty()) return disassembler_->HandleInstruction(inst);
+
+  instructions_.push_back(inst);
+  operand_starts_.push_back(operands_.size());
+  operands_.insert(operands_.end(), inst.operands,
+                   inst.operands + inst.num_operands);
+  num_words_ += inst.num_words;
+  return SPV_SUCCESS;
+}
+
+void ParallelDisassembler::DisassembleFunctions() {
+  const size_t num_instructions = instructions_.size();
+  for (size_t i = 0; i < num_instructions; ++i) {
+    instructions_[i].operands = operands_.data() + operand_starts_[i];
+  }
+
+  const size_t num_functions = function_starts_.size();
+  std::vector<std::unique_ptr<Disassembler>> functions(num_functions);
+  spvtools::utils::ParallelFor(num_threads_, num_functions, [&](size_t f) {
+    const size_t first = function_starts_[f];
+    const size_t last = f + 1 < num_functions ? function_starts_[f + 1]
+                                              : num_instructions;
+    functions[f].reset(new Disassembler(grammar_, options_, name_mapper_));
+    functions[f]->set_byte_offset(
+        size_t(instructions_[first].words - code_) * sizeof(uint32_t));
+    for (size_t i = first; i < last; ++i) {
+      functions[f]->HandleInstruction(instructions_[i]);
+    }
+  });
+  for (const auto& function : functions) {
+    disassembler_->EmitText(function->text());
+  }
+
+  instructions_.clear();
+  operand_starts_.clear();
+  operands_.clear();
+  function_starts_.clear();
+  num_words_ = 0;
+}
+
+spv_result_t DisassembleParallelHeader(void* user_data,
+                                       spv_endianness_t endian,
+                                       uint32_t /* magic */, uint32_t version,
+                                       uint32_t generator, uint32_t id_bound,
+                                       uint32_t schema) {
+  assert(user_data);
+  auto parallel = static_cast<ParallelDisassembler*>(user_data);
+  return parallel->disassembler()->HandleHeader(endian, version, generator,
+                                                id_bound, schema);
+}
+
+spv_result_t DisassembleParallelInstruction(
+    void* user_data, const spv_parsed_instruction_t* parsed_instruction) {
+  assert(user_data);
+  auto parallel = static_cast<ParallelDisassembler*>(user_data);
+  return parallel->HandleInstruction(*parsed_instruction);
+}
+
 // Simple wrapper class to provide extra data necessary for targeted
 // instruction disassembly.
 class WrappedDisassembler {
@@ -405,6 +562,17 @@ spv_result_t spvBinaryToText(const spv_const_context context,
                              const uint32_t* code, const size_t wordCount,
                              const uint32_t options, spv_text* pText,
                              spv_diagnostic* pDiagnostic) {
+  return spvBinaryToTextWithThreads(context, code, wordCount, options, 1, pText,
+                                    pDiagnostic);
+}
+
+spv_result_t spvBinaryToTextWithThreads(const spv_const_context context,
+                                        const uint32_t* code,
+                                        const size_t wordCount,
+                                        const uint32_t options,
+                                        const uint32_t num_threads,
+                                        spv_text* pText,
+                                        spv_diagnostic* pDiagnostic) {
   spv_context_t hijack_context = *context;
   if (pDiagnostic) {
     *pDiagnostic = nullptr;
@@ -425,9 +593,31 @@ spv_result_t spvBinaryToText(const spv_const_context context,
 
   // Now disassemble!
   Disassembler disassembler(grammar, options, name_mapper);
-  if (auto error = spvBinaryParse(&hijack_context, &disassembler, code,
-                                  wordCount, DisassembleHeader,
-                                  DisassembleInstruction, pDiagnostic)) {
+  // Function bodies are disassembled in parallel only for modules in host
+  // byte order, whose parsed instructions point into |code|. When printing in
+  // color, the color might be set by calling into the console, which has to
+  // happen as the text is printed.
+  const bool parallel =
+      num_threads > 1 && code && wordCount && code[0] == SpvMagicNumber &&
+      !(spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_PRINT, options) &&
+        spvIsInBitfield(SPV_BINARY_TO_TEXT_OPTION_COLOR, options));
+  if (parallel) {
+    // Names are generated on demand, so generate them all before they are
+    // asked for from several threads.
+    if (friendly_mapper) friendly_mapper->NameAllIds();
+    ParallelDisassembler parallel_disassembler(
+        &disassembler, grammar, options, name_mapper, code, num_threads);
+    const spv_result_t error = spvBinaryParse(
+        &hijack_context, &parallel_disassembler, code, wordCount,
+        DisassembleParallelHeader, DisassembleParallelInstruction, pDiagnostic);
+    // Emit the functions parsed before any error, as the disassembler would
+    // have done.
+    parallel_disassembler.DisassembleFunctions();
+    if (error) return error;
+  } else if (auto error = spvBinaryParse(&hijack_context, &disassembler, code,
+                                         wordCount, DisassembleHeader,
+                                         DisassembleInstruction,
+                                         pDiagnostic)) {
     return error;
   }
 
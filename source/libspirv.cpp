@@ -14,6 +14,7 @@
 
 #include "spirv-tools/libspirv.hpp"
 
+#include "binary.h"
 #include "table.h"
 
 namespace spvtools {
@@ -52,6 +53,7 @@ struct SpirvTools::Impl {
   ~Impl() { spvContextDestroy(context); }
 
   spv_context context;  // C interface context object.
+  uint32_t num_threads = 1;  // Maximum number of threads used for functions.
 };
 
 SpirvTools::SpirvTools(spv_target_env env) : impl_(new Impl(env)) {}
@@ -62,6 +64,10 @@ void SpirvTools::SetMessageConsumer(MessageConsumer consumer) {
   SetContextMessageConsumer(impl_->context, std::move(consumer));
 }
 
+void SpirvTools::SetNumThreads(uint32_t num_threads) {
+  impl_->num_threads = num_threads;
+}
+
 bool SpirvTools::Assemble(const std::string& text,
                           std::vector<uint32_t>* binary,
                           uint32_t options) const {
@@ -72,8 +78,9 @@ bool SpirvTools::Assemble(const char* text, const size_t text_size,
                           std::vector<uint32_t>* binary,
                           uint32_t options) const {
   spv_binary spvbinary = nullptr;
-  spv_result_t status = spvTextToBinaryWithOptions(
-      impl_->context, text, text_size, options, &spvbinary, nullptr);
+  spv_result_t status =
+      spvTextToBinaryWithThreads(impl_->context, text, text_size, options,
+                                 impl_->num_threads, &spvbinary, nullptr);
   if (status == SPV_SUCCESS) {
     binary->assign(spvbinary->code, spvbinary->code + spvbinary->wordCount);
   }
@@ -89,8 +96,9 @@ bool SpirvTools::Disassemble(const std::vector<uint32_t>& binary,
 bool SpirvTools::Disassemble(const uint32_t* binary, const size_t binary_size,
                              std::string* text, uint32_t options) const {
   spv_text spvtext = nullptr;
-  spv_result_t status = spvBinaryToText(impl_->context, binary, binary_size,
-                                        options, &spvtext, nullptr);
+  spv_result_t status =
+      spvBinaryToTextWithThreads(impl_->context, binary, binary_size, options,
+                                 impl_->num_threads, &spvtext, nullptr);
   if (status == SPV_SUCCESS) {
     text->assign(spvtext->str, spvtext->str + spvtext->length);
   }
@@ -115,4 +123,16 @@ bool SpirvTools::Validate(const uint32_t* binary, const size_t binary_size,
                                 nullptr) == SPV_SUCCESS;
 }
 
+bool SpirvTools::IndexInstructions(const std::vector<uint32_t>& binary,
+                                   std::vector<size_t>* offsets) const {
+  return IndexInstructions(binary.data(), binary.size(), offsets);
+}
+
+bool SpirvTools::IndexInstructions(const uint32_t* binary,
+                                   const size_t binary_size,
+                                   std::vector<size_t>* offsets) const {
+  return spvtools::IndexInstructions(impl_->context->consumer, binary,
+                                     binary_size, offsets) == SPV_SUCCESS;
+}
+
 }  // namespace spvtools
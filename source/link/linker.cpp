@@ -332,8 +332,9 @@ spv_result_t MergeModules(const MessageConsumer& consumer,
     std::vector<uint32_t> processed_words(num_words, 0u);
     std::memcpy(processed_words.data(), processed_string.data(), num_chars);
     linked_module->AddDebug3Inst(std::unique_ptr<Instruction>(
-        new Instruction(linked_context, SpvOpModuleProcessed, 0u, 0u,
-                        {{SPV_OPERAND_TYPE_LITERAL_STRING, processed_words}})));
+        new (linked_context) Instruction(
+            linked_context, SpvOpModuleProcessed, 0u, 0u,
+            {{SPV_OPERAND_TYPE_LITERAL_STRING, processed_words}})));
   }
 
   for (const auto& module : input_modules)
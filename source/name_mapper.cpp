@@ -20,12 +20,12 @@
 #include <sstream>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
 
 #include "spirv-tools/libspirv.h"
 
 #include "latest_version_spirv_header.h"
 #include "parsed_operand.h"
+#include "util/text_buffer.h"
 
 namespace spvtools {
 namespace {
@@ -39,6 +39,35 @@ std::string to_string(uint32_t id) {
   return os.str();
 }
 
+// Returns the FNV-1a hash of the |length| characters at |str|.
+size_t HashName(const char* str, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < length; ++i) {
+    hash = (hash ^ uint8_t(str[i])) * 16777619u;
+  }
+  return hash;
+}
+
+// Returns true if instructions with the given opcode suggest a name for their
+// result id which depends on their words.
+bool NameDependsOnWords(uint32_t opcode) {
+  switch (opcode) {
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:
+    case SpvOpTypeVector:
+    case SpvOpTypeMatrix:
+    case SpvOpTypeArray:
+    case SpvOpTypeRuntimeArray:
+    case SpvOpTypePointer:
+    case SpvOpTypePipe:
+    case SpvOpTypeOpaque:
+    case SpvOpConstant:
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // anonymous namespace
 
 NameMapper GetTrivialNameMapper() { return to_string; }
@@ -46,23 +75,48 @@ NameMapper GetTrivialNameMapper() { return to_string; }
 FriendlyNameMapper::FriendlyNameMapper(const spv_const_context context,
                                        const uint32_t* code,
                                        const size_t wordCount)
-    : grammar_(AssemblyGrammar(context)) {
+    : word_count_(wordCount), grammar_(AssemblyGrammar(context)) {
   spv_diagnostic diag = nullptr;
   // We don't care if the parse fails.
-  spvBinaryParse(context, this, code, wordCount, nullptr,
+  spvBinaryParse(context, this, code, wordCount, ParseHeaderForwarder,
                  ParseInstructionForwarder, &diag);
   spvDiagnosticDestroy(diag);
 }
 
 std::string FriendlyNameMapper::NameForId(uint32_t id) {
-  auto iter = name_for_id_.find(id);
-  if (iter == name_for_id_.end()) {
+  NameIdsUpTo(last_source_.Get(id));
+  return CurrentNameForId(id);
+}
+
+std::string FriendlyNameMapper::CurrentNameForId(uint32_t id) const {
+  const NameRef& name = name_for_id_.Get(id);
+  if (!name.length) {
     // It must have been an invalid module, so just return a trivial mapping.
     // We don't care about uniqueness.
     return to_string(id);
-  } else {
-    return iter->second;
   }
+  return names_.substr(name.offset, name.length);
+}
+
+void FriendlyNameMapper::NameIdsUpTo(size_t end) {
+  for (; num_sources_used_ < end; ++num_sources_used_) {
+    NameFromSource(sources_[num_sources_used_]);
+  }
+}
+
+bool FriendlyNameMapper::UseName(const NameRef& name) {
+  const char* str = names_.data() + name.offset;
+  const size_t hash = HashName(str, name.length);
+  const auto range = used_names_.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    const NameRef& used = it->second;
+    if (used.length == name.length &&
+        0 == names_.compare(used.offset, used.length, str, name.length)) {
+      return false;
+    }
+  }
+  used_names_.emplace(hash, name);
+  return true;
 }
 
 std::string FriendlyNameMapper::Sanitize(const std::string& suggested_name) {
@@ -82,16 +136,20 @@ std::string FriendlyNameMapper::Sanitize(const std::string& suggested_name) {
 
 void FriendlyNameMapper::SaveName(uint32_t id,
                                   const std::string& suggested_name) {
-  if (name_for_id_.find(id) != name_for_id_.end()) return;
+  if (name_for_id_.Get(id).length) return;
 
-  const std::string sanitized_suggested_name = Sanitize(suggested_name);
-  std::string name = sanitized_suggested_name;
-  auto inserted = used_names_.insert(name);
-  if (!inserted.second) {
-    const std::string base_name = sanitized_suggested_name + "_";
-    for (uint32_t index = 0; !inserted.second; ++index) {
-      name = base_name + to_string(index);
-      inserted = used_names_.insert(name);
+  // The name is built at the end of |names_|, and left there.
+  NameRef name = {uint32_t(names_.size()), 0};
+  names_ += Sanitize(suggested_name);
+  name.length = uint32_t(names_.size() - name.offset);
+  if (!UseName(name)) {
+    names_ += '_';
+    const size_t base_size = names_.size();
+    for (uint32_t index = 0;; ++index) {
+      names_.resize(base_size);
+      names_ += to_string(index);
+      name.length = uint32_t(names_.size() - name.offset);
+      if (UseName(name)) break;
     }
   }
   name_for_id_[id] = name;
@@ -168,21 +226,50 @@ void FriendlyNameMapper::SaveBuiltInName(uint32_t target_id,
 
 spv_result_t FriendlyNameMapper::ParseInstruction(
     const spv_parsed_instruction_t& inst) {
-  const auto result_id = inst.result_id;
+  const uint32_t* words = inst.words;
+  NameSource source = {inst.result_id, inst.opcode, 0, 0, SPV_NUMBER_NONE, 0};
   switch (inst.opcode) {
     case SpvOpName:
-      SaveName(inst.words[1], reinterpret_cast<const char*>(inst.words + 2));
+      source.id = words[1];
+      source.num_words = inst.num_words;
       break;
     case SpvOpDecorate:
-      // Decorations come after OpName.  So OpName will take precedence over
-      // decorations.
-      //
       // In theory, we should also handle OpGroupDecorate.  But that's unlikely
       // to occur.
-      if (inst.words[2] == SpvDecorationBuiltIn) {
-        assert(inst.num_words > 3);
-        SaveBuiltInName(inst.words[1], inst.words[3]);
-      }
+      if (words[2] != SpvDecorationBuiltIn) return SPV_SUCCESS;
+      assert(inst.num_words > 3);
+      source.id = words[1];
+      source.num_words = inst.num_words;
+      break;
+    case SpvOpConstant:
+      source.number_kind = inst.operands[2].number_kind;
+      source.number_bit_width = inst.operands[2].number_bit_width;
+      source.num_words = inst.num_words;
+      break;
+    default:
+      if (!inst.result_id) return SPV_SUCCESS;
+      if (NameDependsOnWords(inst.opcode)) source.num_words = inst.num_words;
+      break;
+  }
+  source.first_word = uint32_t(source_words_.size());
+  source_words_.insert(source_words_.end(), inst.words,
+                       inst.words + source.num_words);
+  sources_.push_back(source);
+  last_source_[source.id] = uint32_t(sources_.size());
+  return SPV_SUCCESS;
+}
+
+void FriendlyNameMapper::NameFromSource(const NameSource& source) {
+  const uint32_t* words = source_words_.data() + source.first_word;
+  const auto result_id = source.id;
+  switch (source.opcode) {
+    case SpvOpName:
+      SaveName(words[1], reinterpret_cast<const char*>(words + 2));
+      break;
+    case SpvOpDecorate:
+      // Decorations come after OpName.  So OpName will take precedence over
+      // decorations.
+      SaveBuiltInName(words[1], words[3]);
       break;
     case SpvOpTypeVoid:
       SaveName(result_id, "void");
@@ -193,7 +280,7 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
     case SpvOpTypeInt: {
       std::string signedness;
       std::string root;
-      const auto bit_width = inst.words[2];
+      const auto bit_width = words[2];
       switch (bit_width) {
         case 8:
           root = "char";
@@ -212,11 +299,11 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
           signedness = "i";
           break;
       }
-      if (0 == inst.words[3]) signedness = "u";
+      if (0 == words[3]) signedness = "u";
       SaveName(result_id, signedness + root);
     } break;
     case SpvOpTypeFloat: {
-      const auto bit_width = inst.words[2];
+      const auto bit_width = words[2];
       switch (bit_width) {
         case 16:
           SaveName(result_id, "half");
@@ -233,32 +320,32 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
       }
     } break;
     case SpvOpTypeVector:
-      SaveName(result_id, std::string("v") + to_string(inst.words[3]) +
-                              NameForId(inst.words[2]));
+      SaveName(result_id, std::string("v") + to_string(words[3]) +
+                              CurrentNameForId(words[2]));
       break;
     case SpvOpTypeMatrix:
-      SaveName(result_id, std::string("mat") + to_string(inst.words[3]) +
-                              NameForId(inst.words[2]));
+      SaveName(result_id, std::string("mat") + to_string(words[3]) +
+                              CurrentNameForId(words[2]));
       break;
     case SpvOpTypeArray:
-      SaveName(result_id, std::string("_arr_") + NameForId(inst.words[2]) +
-                              "_" + NameForId(inst.words[3]));
+      SaveName(result_id, std::string("_arr_") + CurrentNameForId(words[2]) +
+                              "_" + CurrentNameForId(words[3]));
       break;
     case SpvOpTypeRuntimeArray:
       SaveName(result_id,
-               std::string("_runtimearr_") + NameForId(inst.words[2]));
+               std::string("_runtimearr_") + CurrentNameForId(words[2]));
       break;
     case SpvOpTypePointer:
       SaveName(result_id, std::string("_ptr_") +
                               NameForEnumOperand(SPV_OPERAND_TYPE_STORAGE_CLASS,
-                                                 inst.words[2]) +
-                              "_" + NameForId(inst.words[3]));
+                                                 words[2]) +
+                              "_" + CurrentNameForId(words[3]));
       break;
     case SpvOpTypePipe:
       SaveName(result_id,
                std::string("Pipe") +
                    NameForEnumOperand(SPV_OPERAND_TYPE_ACCESS_QUALIFIER,
-                                      inst.words[2]));
+                                      words[2]));
       break;
     case SpvOpTypeEvent:
       SaveName(result_id, "Event");
@@ -275,7 +362,7 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
     case SpvOpTypeOpaque:
       SaveName(result_id,
                std::string("Opaque_") +
-                   Sanitize(reinterpret_cast<const char*>(inst.words + 2)));
+                   Sanitize(reinterpret_cast<const char*>(words + 2)));
       break;
     case SpvOpTypePipeStorage:
       SaveName(result_id, "PipeStorage");
@@ -295,14 +382,27 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
       SaveName(result_id, "false");
       break;
     case SpvOpConstant: {
-      std::ostringstream value;
-      EmitNumericLiteral(&value, inst, inst.operands[2]);
+      // The value is the only operand needed to emit it.
+      const spv_parsed_operand_t value_operand = {
+          3, uint16_t(source.num_words - 3),
+          SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER, source.number_kind,
+          source.number_bit_width};
+      const spv_parsed_instruction_t inst = {words,
+                                             uint16_t(source.num_words),
+                                             SpvOpConstant,
+                                             SPV_EXT_INST_TYPE_NONE,
+                                             words[1],
+                                             words[2],
+                                             &value_operand,
+                                             1};
+      utils::TextBuffer value;
+      EmitNumericLiteral(&value, inst, value_operand);
       auto value_str = value.str();
       // Use 'n' to signify negative. Other invalid characters will be mapped
       // to underscore.
       for (auto& c : value_str)
         if (c == '-') c = 'n';
-      SaveName(result_id, NameForId(inst.type_id) + "_" + value_str);
+      SaveName(result_id, CurrentNameForId(words[1]) + "_" + value_str);
     } break;
     default:
       // If this instruction otherwise defines an Id, then save a mapping for
@@ -310,11 +410,10 @@ spv_result_t FriendlyNameMapper::ParseInstruction(
       // string something like "1" that might collide with this result_id.
       // We should only do this if a name hasn't already been registered by some
       // previous forward reference.
-      if (result_id && name_for_id_.find(result_id) == name_for_id_.end())
+      if (!name_for_id_.Get(result_id).length)
         SaveName(result_id, to_string(result_id));
       break;
   }
-  return SPV_SUCCESS;
 }
 
 std::string FriendlyNameMapper::NameForEnumOperand(spv_operand_type_t type,
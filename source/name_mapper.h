@@ -18,10 +18,11 @@
 #include <functional>
 #include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 #include "assembly_grammar.h"
 #include "spirv-tools/libspirv.h"
+#include "util/id_table.h"
 
 namespace spvtools {
 
@@ -37,6 +38,11 @@ NameMapper GetTrivialNameMapper();
 // successful, then the NameForId method maps an Id to a friendly name
 // while also satisfying the constraints on a NameMapper.
 //
+// The parse only records which instructions suggest names for which Ids.  The
+// names are generated on demand, in module order, up to the last instruction
+// that suggests a name for the Id asked about, so they do not depend on the
+// order in which Ids are asked about.  The names are kept in a single buffer.
+//
 // The mapping is friendly in the following sense:
 //  - If an Id has a debug name (via OpName), then that will be used when
 //    possible.
@@ -61,9 +67,9 @@ NameMapper GetTrivialNameMapper();
 //  - Numeric literals in OpConstant map to a human-friendly name.
 class FriendlyNameMapper {
  public:
-  // Construct a friendly name mapper, and determine friendly names for each
-  // defined Id in the specified module.  The module is specified by the code
-  // wordCount, and should be parseable in the specified context.
+  // Construct a friendly name mapper for the specified module.  The module is
+  // specified by the code wordCount, and should be parseable in the specified
+  // context.  The module is not used after construction.
   FriendlyNameMapper(const spv_const_context context, const uint32_t* code,
                      const size_t wordCount);
 
@@ -78,11 +84,47 @@ class FriendlyNameMapper {
   // NameMapper.
   std::string NameForId(uint32_t id);
 
+  // Generates the names of all Ids.  Afterwards, NameForId does not modify
+  // the mapper, and can be called from several threads at once.
+  void NameAllIds() { NameIdsUpTo(sources_.size()); }
+
  private:
+  // A name in |names_|.
+  struct NameRef {
+    uint32_t offset;
+    uint32_t length;  // Zero for no name.
+  };
+
+  // An instruction which suggests a name for an Id.
+  struct NameSource {
+    uint32_t id;
+    uint32_t opcode;
+    // The words of the instruction, if needed to name the Id, are
+    // |source_words_|[first_word, first_word + num_words).
+    uint32_t first_word;
+    uint32_t num_words;
+    // The kind and width of the value of an OpConstant.
+    spv_number_kind_t number_kind;
+    uint32_t number_bit_width;
+  };
+
   // Transforms the given string so that it is acceptable as an Id name in
   // assembly language.  Two distinct inputs can map to the same output.
   std::string Sanitize(const std::string& suggested_name);
 
+  // Returns the name currently given to |id|, without generating any names.
+  std::string CurrentNameForId(uint32_t id) const;
+
+  // Generates names from the name sources before |end| which have not been
+  // used yet.
+  void NameIdsUpTo(size_t end);
+
+  // Generates a name from the given name source.
+  void NameFromSource(const NameSource& source);
+
+  // Records |name| as used, and returns true, unless it is already used.
+  bool UseName(const NameRef& name);
+
   // Records a name for the given id.  If this id already has a name, then
   // this is a no-op.  If the id doesn't have a name, use the given
   // suggested_name if it hasn't already been taken, and otherwise generate
@@ -93,10 +135,21 @@ class FriendlyNameMapper {
   // has a name then this is a no-op.
   void SaveBuiltInName(uint32_t target_id, uint32_t built_in);
 
-  // Collects information from the given parsed instruction to populate
-  // name_for_id_.  Returns SPV_SUCCESS;
+  // Records the given parsed instruction in sources_, if it suggests a name.
+  // Returns SPV_SUCCESS;
   spv_result_t ParseInstruction(const spv_parsed_instruction_t& inst);
 
+  // Forwards a parsed-header callback from the binary parser into the
+  // FriendlyNameMapper hidden inside the user_data parameter.
+  static spv_result_t ParseHeaderForwarder(void* user_data, spv_endianness_t,
+                                           uint32_t, uint32_t, uint32_t,
+                                           uint32_t id_bound, uint32_t) {
+    auto mapper = reinterpret_cast<FriendlyNameMapper*>(user_data);
+    mapper->name_for_id_.Reserve(id_bound, mapper->word_count_);
+    mapper->last_source_.Reserve(id_bound, mapper->word_count_);
+    return SPV_SUCCESS;
+  }
+
   // Forwards a parsed-instruction callback from the binary parser into the
   // FriendlyNameMapper hidden inside the user_data parameter.
   static spv_result_t ParseInstructionForwarder(
@@ -108,11 +161,23 @@ class FriendlyNameMapper {
   // Returns the friendly name for an enumerant.
   std::string NameForEnumOperand(spv_operand_type_t type, uint32_t word);
 
-  // Maps an id to its friendly name.  This will have an entry for each Id
-  // defined in the module.
-  std::unordered_map<uint32_t, std::string> name_for_id_;
-  // The set of names that have a mapping in name_for_id_;
-  std::unordered_set<std::string> used_names_;
+  // The number of words in the module.
+  size_t word_count_;
+  // The instructions which suggest names, in module order, and the words of
+  // those whose words are needed.
+  std::vector<NameSource> sources_;
+  std::vector<uint32_t> source_words_;
+  // Maps an id to one more than the index of the last source of its name.
+  utils::IdTable<uint32_t> last_source_;
+  // The number of sources names have been generated from.
+  size_t num_sources_used_ = 0;
+  // The generated names, one after another.
+  std::string names_;
+  // Maps an id to its friendly name.  Once all names are generated, this will
+  // have an entry for each Id defined in the module.
+  utils::IdTable<NameRef> name_for_id_;
+  // The names that have a mapping in name_for_id_, keyed by their hash.
+  std::unordered_multimap<size_t, NameRef> used_names_;
   // The assembly grammar for the current context.
   const AssemblyGrammar grammar_;
 };
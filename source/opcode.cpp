@@ -36,7 +36,8 @@ struct OpcodeDescPtrLen {
 #include "core.insts-unified1.inc"  // defines kOpcodeTableEntries_1_3
 
 static const spv_opcode_table_t kOpcodeTable = {ARRAY_SIZE(kOpcodeTableEntries),
-                                                kOpcodeTableEntries};
+                                                kOpcodeTableEntries,
+                                                kOpcodeTableNameIndex};
 
 // Represents a vendor tool entry in the SPIR-V XML Regsitry.
 struct VendorTool {
@@ -93,12 +94,17 @@ spv_result_t spvOpcodeTableNameLookup(spv_target_env env,
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
   if (!table) return SPV_ERROR_INVALID_TABLE;
 
-  // TODO: This lookup of the Opcode table is suboptimal! Binary sort would be
-  // preferable but the table requires sorting on the Opcode name, but it's
-  // static const initialized and matches the order of the spec.
-  const size_t nameLength = strlen(name);
-  for (uint64_t opcodeIndex = 0; opcodeIndex < table->count; ++opcodeIndex) {
-    const spv_opcode_desc_t& entry = table->entries[opcodeIndex];
+  // The name index lists entries sorted by name, so all the entries named
+  // |name| are adjacent, and in table order.
+  const uint16_t* const index_begin = table->nameIndex;
+  const uint16_t* const index_end = table->nameIndex + table->count;
+  const uint16_t* index = std::lower_bound(
+      index_begin, index_end, name, [table](uint16_t i, const char* key) {
+        return strcmp(table->entries[i].name, key) < 0;
+      });
+  for (; index != index_end && !strcmp(table->entries[*index].name, name);
+       ++index) {
+    const spv_opcode_desc_t& entry = table->entries[*index];
     // We considers the current opcode as available as long as
     // 1. The target environment satisfies the minimal requirement of the
     //    opcode; or
@@ -107,10 +113,8 @@ spv_result_t spvOpcodeTableNameLookup(spv_target_env env,
     // Note that the second rule assumes the extension enabling this instruction
     // is indeed requested in the SPIR-V code; checking that should be
     // validator's work.
-    if ((spvVersionForTargetEnv(env) >= entry.minVersion ||
-         entry.numExtensions > 0u || entry.numCapabilities > 0u) &&
-        nameLength == strlen(entry.name) &&
-        !strncmp(name, entry.name, nameLength)) {
+    if (spvVersionForTargetEnv(env) >= entry.minVersion ||
+        entry.numExtensions > 0u || entry.numCapabilities > 0u) {
       // NOTE: Found out Opcode!
       *pEntry = &entry;
       return SPV_SUCCESS;
@@ -167,16 +171,13 @@ void spvInstructionCopy(const uint32_t* words, const SpvOp opcode,
                         spv_instruction_t* pInst) {
   pInst->opcode = opcode;
   pInst->words.resize(wordCount);
-  for (uint16_t wordIndex = 0; wordIndex < wordCount; ++wordIndex) {
-    pInst->words[wordIndex] = spvFixWord(words[wordIndex], endian);
-    if (!wordIndex) {
-      uint16_t thisWordCount;
-      uint16_t thisOpcode;
-      spvOpcodeSplit(pInst->words[wordIndex], &thisWordCount, &thisOpcode);
-      assert(opcode == static_cast<SpvOp>(thisOpcode) &&
-             wordCount == thisWordCount && "Endianness failed!");
-    }
-  }
+  if (!wordCount) return;
+  spvFixWords(words, wordCount, endian, pInst->words.data());
+  uint16_t thisWordCount;
+  uint16_t thisOpcode;
+  spvOpcodeSplit(pInst->words[0], &thisWordCount, &thisOpcode);
+  assert(opcode == static_cast<SpvOp>(thisOpcode) &&
+         wordCount == thisWordCount && "Endianness failed!");
 }
 
 const char* spvOpcodeString(const SpvOp opcode) {
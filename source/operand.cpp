@@ -50,11 +50,28 @@ spv_result_t spvOperandTableNameLookup(spv_target_env env,
   if (!table) return SPV_ERROR_INVALID_TABLE;
   if (!name || !pEntry) return SPV_ERROR_INVALID_POINTER;
 
+  // Compares an entry name against the first |nameLength| characters of
+  // |name|, which need not be null-terminated.
+  const auto compare_name = [name, nameLength](const char* entry_name) {
+    const int result = strncmp(entry_name, name, nameLength);
+    if (result != 0) return result;
+    return entry_name[nameLength] == '\0' ? 0 : 1;
+  };
+
   for (uint64_t typeIndex = 0; typeIndex < table->count; ++typeIndex) {
     const auto& group = table->types[typeIndex];
     if (type != group.type) continue;
-    for (uint64_t index = 0; index < group.count; ++index) {
-      const auto& entry = group.entries[index];
+    // The name index lists entries sorted by name, so all the entries named
+    // |name| are adjacent, and in table order.
+    const uint16_t* const index_end = group.nameIndex + group.count;
+    const uint16_t* index = std::lower_bound(
+        group.nameIndex, index_end, name,
+        [&group, &compare_name](uint16_t i, const char*) {
+          return compare_name(group.entries[i].name) < 0;
+        });
+    for (; index != index_end && !compare_name(group.entries[*index].name);
+         ++index) {
+      const auto& entry = group.entries[*index];
       // We consider the current operand as available as long as
       // 1. The target environment satisfies the minimal requirement of the
       //    operand; or
@@ -64,10 +81,8 @@ spv_result_t spvOperandTableNameLookup(spv_target_env env,
       // Note that the second rule assumes the extension enabling this operand
       // is indeed requested in the SPIR-V code; checking that should be
       // validator's work.
-      if ((spvVersionForTargetEnv(env) >= entry.minVersion ||
-           entry.numExtensions > 0u || entry.numCapabilities > 0u) &&
-          nameLength == strlen(entry.name) &&
-          !strncmp(entry.name, name, nameLength)) {
+      if (spvVersionForTargetEnv(env) >= entry.minVersion ||
+          entry.numExtensions > 0u || entry.numCapabilities > 0u) {
         *pEntry = &entry;
         return SPV_SUCCESS;
       }
@@ -236,7 +236,7 @@ void AggressiveDCEPass::ComputeBlock2HeaderMaps(
 }
 
 void AggressiveDCEPass::AddBranch(uint32_t labelId, opt::BasicBlock* bp) {
-  std::unique_ptr<opt::Instruction> newBranch(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newBranch(new (context()) opt::Instruction(
       context(), SpvOpBranch, 0, 0,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {labelId}}}));
   context()->AnalyzeDefUse(&*newBranch);
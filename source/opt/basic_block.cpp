@@ -17,6 +17,7 @@
 #include "ir_context.h"
 #include "module.h"
 #include "reflect.h"
+#include "util/slab_pool.h"
 
 #include "make_unique.h"
 
@@ -32,8 +33,27 @@ const uint32_t kSelectionMergeMergeBlockIdInIdx = 0;
 
 }  // namespace
 
+void* BasicBlock::operator new(size_t size, IRContext* context) {
+  static_assert(alignof(BasicBlock) <= 16,
+                "SlabPool::AllocateFrom only aligns to 16 bytes.");
+  return utils::SlabPool::AllocateFrom(
+      context ? context->memory_pool() : nullptr, size);
+}
+
+void* BasicBlock::operator new(size_t size) {
+  return utils::SlabPool::AllocateFrom(nullptr, size);
+}
+
+void BasicBlock::operator delete(void* ptr, IRContext*) {
+  utils::SlabPool::DeallocateAny(ptr, sizeof(BasicBlock));
+}
+
+void BasicBlock::operator delete(void* ptr, size_t size) {
+  utils::SlabPool::DeallocateAny(ptr, size);
+}
+
 BasicBlock* BasicBlock::Clone(IRContext* context) const {
-  BasicBlock* clone = new BasicBlock(
+  BasicBlock* clone = new (context) BasicBlock(
       std::unique_ptr<Instruction>(GetLabelInst()->Clone(context)));
   for (const auto& inst : insts_)
     // Use the incoming context
@@ -208,8 +228,9 @@ BasicBlock* BasicBlock::SplitBasicBlock(IRContext* context, uint32_t label_id,
                                         iterator iter) {
   assert(!insts_.empty());
 
-  BasicBlock* new_block = new BasicBlock(MakeUnique<Instruction>(
+  std::unique_ptr<Instruction> label(new (context) Instruction(
       context, SpvOpLabel, 0, label_id, std::initializer_list<opt::Operand>{}));
+  BasicBlock* new_block = new (context) BasicBlock(std::move(label));
 
   new_block->insts_.Splice(new_block->end(), &insts_, iter, end());
   new_block->SetParent(GetParent());
@@ -49,6 +49,13 @@ class BasicBlock {
 
   explicit BasicBlock(const BasicBlock& bb) = delete;
 
+  // Allocates a basic block from the memory pool of |context|, in the same way
+  // as |Instruction|.
+  static void* operator new(size_t size, IRContext* context);
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, IRContext* context);
+  static void operator delete(void* ptr, size_t size);
+
   // Creates a clone of the basic block in the given |context|
   //
   // The parent function will default to null and needs to be explicitly set by
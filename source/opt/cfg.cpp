@@ -30,9 +30,11 @@ const int kMaxResultId = 0x400000;
 CFG::CFG(opt::Module* module)
     : module_(module),
       pseudo_entry_block_(std::unique_ptr<opt::Instruction>(
-          new opt::Instruction(module->context(), SpvOpLabel, 0, 0, {}))),
-      pseudo_exit_block_(std::unique_ptr<opt::Instruction>(new opt::Instruction(
-          module->context(), SpvOpLabel, 0, kMaxResultId, {}))) {
+          new (module->context()) opt::Instruction(module->context(),
+                                                   SpvOpLabel, 0, 0, {}))),
+      pseudo_exit_block_(std::unique_ptr<opt::Instruction>(
+          new (module->context()) opt::Instruction(
+              module->context(), SpvOpLabel, 0, kMaxResultId, {}))) {
   for (auto& fn : *module) {
     for (auto& blk : fn) {
       RegisterBlock(&blk);
@@ -263,10 +265,11 @@ BasicBlock* CFG::SplitLoopHeader(opt::BasicBlock* bb) {
       context, bb,
       opt::IRContext::kAnalysisDefUse |
           opt::IRContext::kAnalysisInstrToBlockMapping);
-  bb->AddInstruction(MakeUnique<opt::Instruction>(
-      context, SpvOpBranch, 0, 0,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {new_header->id()}}}));
+  bb->AddInstruction(
+      std::unique_ptr<opt::Instruction>(new (context) opt::Instruction(
+          context, SpvOpBranch, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {new_header->id()}}})));
   context->AnalyzeUses(bb->terminator());
   context->set_instr_block(bb->terminator(), bb);
   label2preds_[new_header->id()].push_back(bb->id());
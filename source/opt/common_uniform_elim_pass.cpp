@@ -223,7 +223,7 @@ void CommonUniformElimPass::GenACLoadRepl(
   load_in_operands.push_back(
       opt::Operand(spv_operand_type_t::SPV_OPERAND_TYPE_ID,
                    std::initializer_list<uint32_t>{varId}));
-  std::unique_ptr<opt::Instruction> newLoad(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newLoad(new (context()) opt::Instruction(
       context(), SpvOpLoad, varPteTypeId, ldResultId, load_in_operands));
   get_def_use_mgr()->AnalyzeInstDefUse(&*newLoad);
   newInsts->emplace_back(std::move(newLoad));
@@ -246,9 +246,9 @@ void CommonUniformElimPass::GenACLoadRepl(
     }
     ++iidIdx;
   });
-  std::unique_ptr<opt::Instruction> newExt(
-      new opt::Instruction(context(), SpvOpCompositeExtract, ptrPteTypeId,
-                           extResultId, ext_in_opnds));
+  std::unique_ptr<opt::Instruction> newExt(new (context()) opt::Instruction(
+      context(), SpvOpCompositeExtract, ptrPteTypeId, extResultId,
+      ext_in_opnds));
   get_def_use_mgr()->AnalyzeInstDefUse(&*newExt);
   newInsts->emplace_back(std::move(newExt));
   *resultId = extResultId;
@@ -387,9 +387,10 @@ bool CommonUniformElimPass::CommonUniformLoadElimination(opt::Function* func) {
         } else {
           // Copy load into most recent dominating block and remember it
           replId = TakeNextId();
-          std::unique_ptr<opt::Instruction> newLoad(new opt::Instruction(
-              context(), SpvOpLoad, inst->type_id(), replId,
-              {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {varId}}}));
+          std::unique_ptr<opt::Instruction> newLoad(
+              new (context()) opt::Instruction(
+                  context(), SpvOpLoad, inst->type_id(), replId,
+                  {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {varId}}}));
           get_def_use_mgr()->AnalyzeInstDefUse(&*newLoad);
           insertItr = insertItr.InsertBefore(std::move(newLoad));
           ++insertItr;
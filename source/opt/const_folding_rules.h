@@ -18,6 +18,7 @@
 #include <vector>
 
 #include "constants.h"
+#include "util/opcode_table.h"
 
 namespace spvtools {
 namespace opt {
@@ -56,21 +57,19 @@ class ConstantFoldingRules {
   ConstantFoldingRules();
 
   // Returns true if there is at least 1 folding rule for |opcode|.
-  bool HasFoldingRule(SpvOp opcode) const { return rules_.count(opcode); }
+  bool HasFoldingRule(SpvOp opcode) const {
+    return !rules_.Get(opcode).empty();
+  }
 
   // Returns an vector of constant folding rules for |opcode|.
   const std::vector<ConstantFoldingRule>& GetRulesForOpcode(
       SpvOp opcode) const {
-    auto it = rules_.find(opcode);
-    if (it != rules_.end()) {
-      return it->second;
-    }
-    return empty_vector_;
+    return rules_.Get(opcode);
   }
 
  private:
-  std::unordered_map<uint32_t, std::vector<ConstantFoldingRule>> rules_;
-  std::vector<ConstantFoldingRule> empty_vector_;
+  // The rules for each opcode, in priority order.
+  utils::OpcodeTable<std::vector<ConstantFoldingRule>> rules_;
 };
 
 }  // namespace opt
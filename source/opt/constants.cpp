@@ -267,26 +267,26 @@ std::unique_ptr<opt::Instruction> ConstantManager::CreateInstruction(
   uint32_t type =
       (type_id == 0) ? context()->get_type_mgr()->GetId(c->type()) : type_id;
   if (c->AsNullConstant()) {
-    return MakeUnique<opt::Instruction>(context(), SpvOp::SpvOpConstantNull,
-                                        type, id,
-                                        std::initializer_list<opt::Operand>{});
+    return std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+        context(), SpvOp::SpvOpConstantNull, type, id,
+        std::initializer_list<opt::Operand>{}));
   } else if (const BoolConstant* bc = c->AsBoolConstant()) {
-    return MakeUnique<opt::Instruction>(
+    return std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
         context(),
         bc->value() ? SpvOp::SpvOpConstantTrue : SpvOp::SpvOpConstantFalse,
-        type, id, std::initializer_list<opt::Operand>{});
+        type, id, std::initializer_list<opt::Operand>{}));
   } else if (const IntConstant* ic = c->AsIntConstant()) {
-    return MakeUnique<opt::Instruction>(
+    return std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
         context(), SpvOp::SpvOpConstant, type, id,
         std::initializer_list<opt::Operand>{opt::Operand(
             spv_operand_type_t::SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER,
-            ic->words())});
+            ic->words())}));
   } else if (const FloatConstant* fc = c->AsFloatConstant()) {
-    return MakeUnique<opt::Instruction>(
+    return std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
         context(), SpvOp::SpvOpConstant, type, id,
         std::initializer_list<opt::Operand>{opt::Operand(
             spv_operand_type_t::SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER,
-            fc->words())});
+            fc->words())}));
   } else if (const CompositeConstant* cc = c->AsCompositeConstant()) {
     return CreateCompositeInstruction(id, cc, type_id);
   } else {
@@ -310,8 +310,9 @@ std::unique_ptr<opt::Instruction> ConstantManager::CreateCompositeInstruction(
   }
   uint32_t type =
       (type_id == 0) ? context()->get_type_mgr()->GetId(cc->type()) : type_id;
-  return MakeUnique<opt::Instruction>(context(), SpvOp::SpvOpConstantComposite,
-                                      type, result_id, std::move(operands));
+  return std::unique_ptr<opt::Instruction>(
+      new (context()) opt::Instruction(context(), SpvOp::SpvOpConstantComposite,
+                                       type, result_id, std::move(operands)));
 }
 
 const Constant* ConstantManager::GetConstant(
@@ -74,7 +74,7 @@ bool DeadBranchElimPass::GetConstInteger(uint32_t selId, uint32_t* selVal) {
 
 void DeadBranchElimPass::AddBranch(uint32_t labelId, opt::BasicBlock* bp) {
   assert(get_def_use_mgr()->GetDef(labelId) != nullptr);
-  std::unique_ptr<opt::Instruction> newBranch(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newBranch(new (context()) opt::Instruction(
       context(), SpvOpBranch, 0, 0,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {labelId}}}));
   context()->AnalyzeDefUse(&*newBranch);
@@ -317,9 +317,10 @@ bool DeadBranchElimPass::EraseDeadBlocks(
         // Make unreachable, but leave the label.
         KillAllInsts(&*ebi, false);
         // Add unreachable terminator.
-        ebi->AddInstruction(MakeUnique<opt::Instruction>(
-            context(), SpvOpUnreachable, 0, 0,
-            std::initializer_list<opt::Operand>{}));
+        ebi->AddInstruction(
+            std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+                context(), SpvOpUnreachable, 0, 0,
+                std::initializer_list<opt::Operand>{})));
         context()->set_instr_block(&*ebi->tail(), &*ebi);
         modified = true;
       }
@@ -333,10 +334,11 @@ bool DeadBranchElimPass::EraseDeadBlocks(
         KillAllInsts(&*ebi, false);
         // Add unconditional branch to header.
         assert(unreachable_continues.count(&*ebi));
-        ebi->AddInstruction(MakeUnique<opt::Instruction>(
-            context(), SpvOpBranch, 0, 0,
-            std::initializer_list<opt::Operand>{
-                {SPV_OPERAND_TYPE_ID, {cont_id}}}));
+        ebi->AddInstruction(
+            std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+                context(), SpvOpBranch, 0, 0,
+                std::initializer_list<opt::Operand>{
+                    {SPV_OPERAND_TYPE_ID, {cont_id}}})));
         get_def_use_mgr()->AnalyzeInstUse(&*ebi->tail());
         context()->set_instr_block(&*ebi->tail(), &*ebi);
         modified = true;
@@ -14,14 +14,34 @@
 
 #include "def_use_manager.h"
 
+#include <algorithm>
 #include <iostream>
+#include <type_traits>
 
+#include "ir_context.h"
 #include "log.h"
 #include "reflect.h"
 
 namespace spvtools {
 namespace opt {
 namespace analysis {
+namespace {
+
+// The largest number of operands for which AnalyzeInstUse looks for the
+// earlier records of an instruction by walking them.
+const uint32_t kMaxOperandsToScan = 16;
+
+}  // anonymous namespace
+
+DefUseManager::DefUseManager(opt::Module* module)
+    : pool_(module && module->context() ? module->context()->memory_pool()
+                                        : nullptr) {
+  if (!pool_) {
+    own_pool_.reset(utils::SlabPool::Create());
+    pool_ = own_pool_.get();
+  }
+  AnalyzeDefUse(module);
+}
 
 void DefUseManager::AnalyzeInstDef(opt::Instruction* inst) {
   const uint32_t def_id = inst->result_id();
@@ -42,13 +62,28 @@ void DefUseManager::AnalyzeInstUse(opt::Instruction* inst) {
   // Create entry for the given instruction. Note that the instruction may
   // not have any in-operands. In such cases, we still need a entry for those
   // instructions so this manager knows it has seen the instruction later.
-  auto* used_ids = &inst_to_used_ids_[inst];
-  if (used_ids->size()) {
-    EraseUseRecordsOfOperandIds(inst);
-    used_ids = &inst_to_used_ids_[inst];
+  UserNode*& first_used = inst_to_user_nodes_[inst];
+
+  // The records of an earlier analysis of |inst| are kept for the definitions
+  // it still uses, so they are not inserted into the users again.
+  UserNode* old_records = first_used;
+  first_used = nullptr;
+  assert((!old_records || old_records->user_id == inst->unique_id()) &&
+         "An instruction was destroyed without clearing its records.");
+  const bool reanalyzed = old_records != nullptr;
+  // With many operands, the records are found through |records_by_def_|
+  // rather than by walking the lists of records. It maps each definition
+  // seen so far to its old record, or to nullptr once that is taken.
+  const bool use_map = reanalyzed && inst->NumOperands() > kMaxOperandsToScan;
+  if (use_map) {
+    records_by_def_.clear();
+    for (UserNode* node = old_records; node; node = node->next_use) {
+      records_by_def_[node->def_id] = node;
+    }
   }
-  used_ids->clear();  // It might have existed before.
 
+  // The records are kept in operand order.
+  UserNode* last_used = nullptr;
   for (uint32_t i = 0; i < inst->NumOperands(); ++i) {
     switch (inst->GetOperand(i).type) {
       // For any id type but result id type
@@ -59,13 +94,45 @@ void DefUseManager::AnalyzeInstUse(opt::Instruction* inst) {
         uint32_t use_id = inst->GetSingleWordOperand(i);
         opt::Instruction* def = GetDef(use_id);
         assert(def && "Definition is not registered.");
-        id_to_users_.insert(UserEntry(def, inst));
-        used_ids->push_back(use_id);
+        UserNode* node = nullptr;
+        if (use_map) {
+          auto result = records_by_def_.emplace(use_id, nullptr);
+          if (!result.second) {
+            // Either an old record, or nullptr if |def| was seen before.
+            node = result.first->second;
+            if (!node) break;
+            result.first->second = nullptr;
+          }
+        } else if (reanalyzed) {
+          if (FindUse(first_used, use_id)) break;
+          node = FindUse(old_records, use_id);
+        }
+        if (node) {
+          UnlinkUse(&old_records, node);
+        } else {
+          node = AddUser(def, inst);
+          if (!node) break;
+        }
+        node->prev_use = last_used;
+        node->next_use = nullptr;
+        if (last_used) {
+          last_used->next_use = node;
+        } else {
+          first_used = node;
+        }
+        last_used = node;
       } break;
       default:
         break;
     }
   }
+
+  // Remove the records of the definitions |inst| no longer uses.
+  while (old_records) {
+    UserNode* next = old_records->next_use;
+    RemoveUser(old_records);
+    old_records = next;
+  }
 }
 
 void DefUseManager::AnalyzeInstDefUse(opt::Instruction* inst) {
@@ -96,21 +163,53 @@ const opt::Instruction* DefUseManager::GetDef(uint32_t id) const {
   return iter->second;
 }
 
-DefUseManager::IdToUsersMap::const_iterator DefUseManager::UsersBegin(
-    const opt::Instruction* def) const {
-  return id_to_users_.lower_bound(
-      UserEntry(const_cast<opt::Instruction*>(def), nullptr));
+DefUseManager::UserMap& DefUseManager::UsersOf(uint32_t def_id) {
+  // The records are pointed to by the lists of records of their users, so
+  // growing |users_| must move the maps rather than copy them.
+  static_assert(std::is_nothrow_move_constructible<UserMap>::value,
+                "User maps would be copied when |users_| grows.");
+  if (def_id >= users_.size()) {
+    users_.resize(def_id + 1, UserMap(UserMap::allocator_type(pool_)));
+  }
+  return users_[def_id];
+}
+
+const DefUseManager::UserMap* DefUseManager::FindUsers(uint32_t def_id) const {
+  if (def_id >= users_.size() || users_[def_id].empty()) return nullptr;
+  return &users_[def_id];
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const IdToUsersMap::const_iterator& cached_end,
-                                const opt::Instruction* inst) const {
-  return (iter != cached_end && iter->first == inst);
+DefUseManager::UserNode* DefUseManager::AddUser(opt::Instruction* def,
+                                                opt::Instruction* user) {
+  UserMap& users = UsersOf(def->result_id());
+  const uint32_t user_id = user->unique_id();
+  auto iter = users.lower_bound(user_id);
+  if (iter != users.end() && iter->first == user_id) return nullptr;
+  iter = users.emplace_hint(
+      iter, user_id,
+      UserNode{user, user_id, def->result_id(), nullptr, nullptr});
+  return &iter->second;
 }
 
-bool DefUseManager::UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                                const opt::Instruction* inst) const {
-  return UsersNotEnd(iter, id_to_users_.end(), inst);
+void DefUseManager::RemoveUser(UserNode* node) {
+  users_[node->def_id].erase(node->user_id);
+}
+
+DefUseManager::UserNode* DefUseManager::FindUse(UserNode* first,
+                                                uint32_t def_id) {
+  for (UserNode* node = first; node; node = node->next_use) {
+    if (node->def_id == def_id) return node;
+  }
+  return nullptr;
+}
+
+void DefUseManager::UnlinkUse(UserNode** first, UserNode* node) {
+  if (node->prev_use) {
+    node->prev_use->next_use = node->next_use;
+  } else {
+    *first = node->next_use;
+  }
+  if (node->next_use) node->next_use->prev_use = node->prev_use;
 }
 
 bool DefUseManager::WhileEachUser(
@@ -121,9 +220,10 @@ bool DefUseManager::WhileEachUser(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    if (!f(iter->second)) return false;
+  const UserMap* users = FindUsers(def->result_id());
+  if (!users) return true;
+  for (const auto& p : *users) {
+    if (!f(p.second.user)) return false;
   }
   return true;
 }
@@ -155,9 +255,10 @@ bool DefUseManager::WhileEachUse(
          "Definition is not registered.");
   if (!def->HasResultId()) return true;
 
-  auto end = id_to_users_.end();
-  for (auto iter = UsersBegin(def); UsersNotEnd(iter, end, def); ++iter) {
-    opt::Instruction* user = iter->second;
+  const UserMap* users = FindUsers(def->result_id());
+  if (!users) return true;
+  for (const auto& p : *users) {
+    opt::Instruction* user = p.second.user;
     for (uint32_t idx = 0; idx != user->NumOperands(); ++idx) {
       const opt::Operand& op = user->GetOperand(idx);
       if (op.type != SPV_OPERAND_TYPE_RESULT_ID && spvIsIdType(op.type)) {
@@ -235,32 +336,33 @@ void DefUseManager::AnalyzeDefUse(opt::Module* module) {
 }
 
 void DefUseManager::ClearInst(opt::Instruction* inst) {
-  auto iter = inst_to_used_ids_.find(inst);
-  if (iter != inst_to_used_ids_.end()) {
-    EraseUseRecordsOfOperandIds(inst);
+  const bool analyzed = inst_to_user_nodes_.count(inst) != 0;
+  EraseUseRecordsOfOperandIds(inst);
+  if (analyzed) {
     if (inst->result_id() != 0) {
       // Remove all uses of this inst.
-      auto users_begin = UsersBegin(inst);
-      auto end = id_to_users_.end();
-      auto new_end = users_begin;
-      for (; UsersNotEnd(new_end, end, inst); ++new_end) {
+      if (inst->result_id() < users_.size()) {
+        UserMap& users = users_[inst->result_id()];
+        for (auto& p : users) {
+          UnlinkUse(&inst_to_user_nodes_[p.second.user], &p.second);
+        }
+        users.clear();
       }
-      id_to_users_.erase(users_begin, new_end);
       id_to_def_.erase(inst->result_id());
     }
   }
 }
 
 void DefUseManager::EraseUseRecordsOfOperandIds(const opt::Instruction* inst) {
-  // Go through all ids used by this instruction, remove this instruction's
-  // uses of them.
-  auto iter = inst_to_used_ids_.find(inst);
-  if (iter != inst_to_used_ids_.end()) {
-    for (auto use_id : iter->second) {
-      id_to_users_.erase(
-          UserEntry(GetDef(use_id), const_cast<opt::Instruction*>(inst)));
+  auto iter = inst_to_user_nodes_.find(inst);
+  if (iter != inst_to_user_nodes_.end()) {
+    UserNode* node = iter->second;
+    inst_to_user_nodes_.erase(iter);
+    while (node) {
+      UserNode* next = node->next_use;
+      RemoveUser(node);
+      node = next;
     }
-    inst_to_used_ids_.erase(inst);
   }
 }
 
@@ -269,23 +371,27 @@ bool operator==(const DefUseManager& lhs, const DefUseManager& rhs) {
     return false;
   }
 
-  if (lhs.id_to_users_ != rhs.id_to_users_) {
-    for (auto p : lhs.id_to_users_) {
-      if (rhs.id_to_users_.count(p) == 0) {
-        return false;
-      }
+  // The users of a definition are in unique id order, so they can be
+  // compared element by element. The definitions are the same, so the users
+  // of the same id belong to the same definition.
+  const size_t num_ids = std::max(lhs.users_.size(), rhs.users_.size());
+  for (uint32_t id = 0; id < num_ids; ++id) {
+    const DefUseManager::UserMap* lhs_users = lhs.FindUsers(id);
+    const DefUseManager::UserMap* rhs_users = rhs.FindUsers(id);
+    if (!lhs_users || !rhs_users) {
+      if (lhs_users != rhs_users) return false;
+      continue;
     }
-    for (auto p : rhs.id_to_users_) {
-      if (lhs.id_to_users_.count(p) == 0) {
-        return false;
-      }
+    if (lhs_users->size() != rhs_users->size() ||
+        !std::equal(lhs_users->begin(), lhs_users->end(), rhs_users->begin(),
+                    [](const DefUseManager::UserMap::value_type& l,
+                       const DefUseManager::UserMap::value_type& r) {
+                      return l.second.user == r.second.user;
+                    })) {
+      return false;
     }
-    return false;
   }
 
-  if (lhs.inst_to_used_ids_ != lhs.inst_to_used_ids_) {
-    return false;
-  }
   return true;
 }
 
@@ -16,6 +16,8 @@
 #define LIBSPIRV_OPT_DEF_USE_MANAGER_H_
 
 #include <list>
+#include <map>
+#include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -23,6 +25,7 @@
 #include "instruction.h"
 #include "module.h"
 #include "spirv-tools/libspirv.hpp"
+#include "util/slab_pool.h"
 
 namespace spvtools {
 namespace opt {
@@ -50,59 +53,23 @@ inline bool operator<(const Use& lhs, const Use& rhs) {
   return lhs.operand_index < rhs.operand_index;
 }
 
-// Definition and user pair.
-//
-// The first element of the pair is the definition.
-// The second element of the pair is the user.
-//
-// Definition should never be null. User can be null, however, such an entry
-// should be used only for searching (e.g. all users of a particular definition)
-// and never stored in a container.
-using UserEntry = std::pair<opt::Instruction*, opt::Instruction*>;
-
-// Orders UserEntry for use in associative containers (i.e. less than ordering).
-//
-// The definition of an UserEntry is treated as the major key and the users as
-// the minor key so that all the users of a particular definition are
-// consecutive in a container.
-//
-// A null user always compares less than a real user. This is done to provide
-// easy values to search for the beginning of the users of a particular
-// definition (i.e. using {def, nullptr}).
-struct UserEntryLess {
-  bool operator()(const UserEntry& lhs, const UserEntry& rhs) const {
-    // If lhs.first and rhs.first are both null, fall through to checking the
-    // second entries.
-    if (!lhs.first && rhs.first) return true;
-    if (lhs.first && !rhs.first) return false;
-
-    // If neither definition is null, then compare unique ids.
-    if (lhs.first && rhs.first) {
-      if (lhs.first->unique_id() < rhs.first->unique_id()) return true;
-      if (rhs.first->unique_id() < lhs.first->unique_id()) return false;
-    }
-
-    // Return false on equality.
-    if (!lhs.second && !rhs.second) return false;
-    if (!lhs.second) return true;
-    if (!rhs.second) return false;
-
-    // If neither user is null then compare unique ids.
-    return lhs.second->unique_id() < rhs.second->unique_id();
-  }
-};
-
 // A class for analyzing and managing defs and uses in an opt::Module.
 class DefUseManager {
  public:
   using IdToDefMap = std::unordered_map<uint32_t, opt::Instruction*>;
-  using IdToUsersMap = std::set<UserEntry, UserEntryLess>;
 
   // Constructs a def-use manager from the given |module|. All internal messages
   // will be communicated to the outside via the given message |consumer|. This
   // instance only keeps a reference to the |consumer|, so the |consumer| should
   // outlive this instance.
-  DefUseManager(opt::Module* module) { AnalyzeDefUse(module); }
+  //
+  // The user records are allocated from the memory pool of the context of
+  // |module|.
+  //
+  // The records of an instruction are looked up by its address, so an
+  // instruction must be cleared with |ClearInst| (or killed through the
+  // context) before it is destroyed.
+  DefUseManager(opt::Module* module);
 
   DefUseManager(const DefUseManager&) = delete;
   DefUseManager(DefUseManager&&) = delete;
@@ -196,8 +163,6 @@ class DefUseManager {
 
   // Returns the map from ids to their def instructions.
   const IdToDefMap& id_to_defs() const { return id_to_def_; }
-  // Returns the map from instructions to their users.
-  const IdToUsersMap& id_to_users() const { return id_to_users_; }
 
   // Clear the internal def-use record of the given instruction |inst|. This
   // method will update the use information of the operand ids of |inst|. The
@@ -206,7 +171,8 @@ class DefUseManager {
   // be removed. Does nothing if |inst| was not analyzed before.
   void ClearInst(opt::Instruction* inst);
 
-  // Erases the records that a given instruction uses its operand ids.
+  // Erases the records that a given instruction uses its operand ids. They are
+  // added again the next time |inst| is analyzed.
   void EraseUseRecordsOfOperandIds(const opt::Instruction* inst);
 
   friend bool operator==(const DefUseManager&, const DefUseManager&);
@@ -219,33 +185,75 @@ class DefUseManager {
   void UpdateDefUse(opt::Instruction* inst);
 
  private:
-  using InstToUsedIdsMap =
-      std::unordered_map<const opt::Instruction*, std::vector<uint32_t>>;
-
-  // Returns the first location that {|def|, nullptr} could be inserted into the
-  // users map without violating ordering.
-  IdToUsersMap::const_iterator UsersBegin(const opt::Instruction* def) const;
-
-  // Returns true if |iter| has not reached the end of |def|'s users.
+  // A record that |user| uses the result id of |def|. There is at most one
+  // record for each pair, however many operands of |user| refer to |def|.
   //
-  // In the first version |iter| is compared against the end of the map for
-  // validity before other checks. In the second version, |iter| is compared
-  // against |cached_end| for validity before other checks. This allows caching
-  // the map's end which is a performance improvement on some platforms.
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const opt::Instruction* def) const;
-  bool UsersNotEnd(const IdToUsersMap::const_iterator& iter,
-                   const IdToUsersMap::const_iterator& cached_end,
-                   const opt::Instruction* def) const;
+  // Each record is in the users of |def|, which are ordered by the unique ids
+  // of the users, and it is linked into the list of records of |user|, so that
+  // all the records of |user| are found without a search.
+  struct UserNode {
+    opt::Instruction* user;
+    // The unique id of |user|.
+    uint32_t user_id;
+    // The result id of |def|.
+    uint32_t def_id;
+    // Neighbours in the list of records of |user|.
+    UserNode* prev_use;
+    UserNode* next_use;
+  };
+
+  // The users of a definition, keyed by their unique ids. The records are
+  // allocated from the pool of the manager, and do not move once added.
+  using UserMap = std::map<
+      uint32_t, UserNode, std::less<uint32_t>,
+      utils::PoolAllocator<std::pair<const uint32_t, UserNode>>>;
+
+  // Maps each analyzed instruction to the first of the records of the
+  // definitions it uses, or to nullptr if it uses none.
+  using InstToUserNodesMap =
+      std::unordered_map<const opt::Instruction*, UserNode*>;
+
+  // Returns the users of the definition of |def_id|, which are created if
+  // needed.
+  UserMap& UsersOf(uint32_t def_id);
+
+  // Returns the users of the definition of |def_id|, or nullptr if it has
+  // none.
+  const UserMap* FindUsers(uint32_t def_id) const;
+
+  // Records that |user| uses |def|, unless that is already recorded. Returns
+  // the new record, or nullptr if there was one already.
+  UserNode* AddUser(opt::Instruction* def, opt::Instruction* user);
+
+  // Removes |node| from the users of its definition, which frees it. |node|
+  // must already be unlinked from the records of its user.
+  void RemoveUser(UserNode* node);
+
+  // Returns the record of the definition of |def_id| in the list of records
+  // starting at |first|, or nullptr if there is none.
+  static UserNode* FindUse(UserNode* first, uint32_t def_id);
+
+  // Unlinks |node| from the list of records of its user, which starts at
+  // |*first|.
+  static void UnlinkUse(UserNode** first, UserNode* node);
 
   // Analyzes the defs and uses in the given |module| and populates data
   // structures in this class. Does nothing if |module| is nullptr.
   void AnalyzeDefUse(opt::Module* module);
 
-  IdToDefMap id_to_def_;      // Mapping from ids to their definitions
-  IdToUsersMap id_to_users_;  // Mapping from ids to their users
-  // Mapping from instructions to the ids used in the instruction.
-  InstToUsedIdsMap inst_to_used_ids_;
+  // The pool the user records are allocated from. |own_pool_| is only used
+  // if the module has no context.
+  utils::SlabPoolPtr own_pool_;
+  utils::SlabPool* pool_;
+
+  IdToDefMap id_to_def_;  // Mapping from ids to their definitions
+  // The users of the definitions, indexed by result id.
+  std::vector<UserMap> users_;
+  // Mapping from instructions to the records of the ids they use. Every
+  // record is in exactly one of these lists.
+  InstToUserNodesMap inst_to_user_nodes_;
+  // Scratch space for AnalyzeInstUse, kept to reuse its buckets.
+  std::unordered_map<uint32_t, UserNode*> records_by_def_;
 };
 
 }  // namespace analysis
@@ -15,6 +15,7 @@
 #include <iostream>
 #include <memory>
 #include <set>
+#include <unordered_map>
 
 #include "cfa.h"
 #include "dominator_tree.h"
@@ -156,18 +157,13 @@ BasicBlockSuccessorHelper<BBType>::BasicBlockSuccessorHelper(
 template <typename BBType>
 void BasicBlockSuccessorHelper<BBType>::CreateSuccessorMap(
     Function& f, const BasicBlock* dummy_start_node) {
-  std::map<uint32_t, BasicBlock*> id_to_BB_map;
-  auto GetSuccessorBasicBlock = [&f, &id_to_BB_map](uint32_t successor_id) {
-    BasicBlock*& Succ = id_to_BB_map[successor_id];
-    if (!Succ) {
-      for (BasicBlock& BBIt : f) {
-        if (successor_id == BBIt.id()) {
-          Succ = &BBIt;
-          break;
-        }
-      }
-    }
-    return Succ;
+  // Index the blocks once, rather than searching the function for every
+  // successor, which is quadratic in the number of blocks.
+  std::unordered_map<uint32_t, BasicBlock*> id_to_BB_map;
+  for (BasicBlock& bb : f) id_to_BB_map.emplace(bb.id(), &bb);
+  auto GetSuccessorBasicBlock = [&id_to_BB_map](uint32_t successor_id) {
+    auto it = id_to_BB_map.find(successor_id);
+    return it == id_to_BB_map.end() ? nullptr : it->second;
   };
 
   if (invert_graph_) {
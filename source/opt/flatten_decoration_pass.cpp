@@ -116,7 +116,7 @@ Pass::Status FlattenDecorationPass::Process(opt::IRContext* c) {
             decoration_operands_iter++;  // Skip the group target.
             operands.insert(operands.end(), decoration_operands_iter,
                             inst_iter->end());
-            std::unique_ptr<Instruction> new_inst(new Instruction(
+            std::unique_ptr<Instruction> new_inst(new (context()) Instruction(
                 context(), SpvOp::SpvOpMemberDecorate, 0, 0, operands));
             inst_iter = inst_iter.InsertBefore(std::move(new_inst));
             ++inst_iter;
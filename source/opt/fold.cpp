@@ -193,7 +193,7 @@ bool InstructionFolder::FoldInstructionInternal(opt::Instruction* inst) const {
   std::vector<const analysis::Constant*> constants =
       const_manager->GetOperandConstants(inst);
 
-  for (FoldingRule rule : GetFoldingRules().GetRulesForOpcode(opcode)) {
+  for (const FoldingRule& rule : GetFoldingRules().GetRulesForOpcode(opcode)) {
     if (rule(inst, constants)) {
       return true;
     }
@@ -596,19 +596,16 @@ opt::Instruction* InstructionFolder::FoldInstructionToConstant(
     }
   });
 
-  if (GetConstantFoldingRules().HasFoldingRule(inst->opcode())) {
-    const analysis::Constant* folded_const = nullptr;
-    for (auto rule :
-         GetConstantFoldingRules().GetRulesForOpcode(inst->opcode())) {
-      folded_const = rule(inst, constants);
-      if (folded_const != nullptr) {
-        opt::Instruction* const_inst =
-            const_mgr->GetDefiningInstruction(folded_const, inst->type_id());
-        assert(const_inst->type_id() == inst->type_id());
-        // May be a new instruction that needs to be analysed.
-        context->UpdateDefUse(const_inst);
-        return const_inst;
-      }
+  for (const ConstantFoldingRule& rule :
+       GetConstantFoldingRules().GetRulesForOpcode(inst->opcode())) {
+    const analysis::Constant* folded_const = rule(inst, constants);
+    if (folded_const != nullptr) {
+      opt::Instruction* const_inst =
+          const_mgr->GetDefiningInstruction(folded_const, inst->type_id());
+      assert(const_inst->type_id() == inst->type_id());
+      // May be a new instruction that needs to be analysed.
+      context->UpdateDefUse(const_inst);
+      return const_inst;
     }
   }
 
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "constants.h"
+#include "util/opcode_table.h"
 
 namespace spvtools {
 namespace opt {
@@ -60,16 +61,12 @@ class FoldingRules {
   FoldingRules();
 
   const std::vector<FoldingRule>& GetRulesForOpcode(SpvOp opcode) const {
-    auto it = rules_.find(opcode);
-    if (it != rules_.end()) {
-      return it->second;
-    }
-    return empty_vector_;
+    return rules_.Get(opcode);
   }
 
  private:
-  std::unordered_map<uint32_t, std::vector<FoldingRule>> rules_;
-  std::vector<FoldingRule> empty_vector_;
+  // The rules for each opcode, in priority order.
+  utils::OpcodeTable<std::vector<FoldingRule>> rules_;
 };
 
 }  // namespace opt
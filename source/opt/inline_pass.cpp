@@ -32,7 +32,7 @@ namespace opt {
 uint32_t InlinePass::AddPointerToType(uint32_t type_id,
                                       SpvStorageClass storage_class) {
   uint32_t resultId = TakeNextId();
-  std::unique_ptr<opt::Instruction> type_inst(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> type_inst(new (context()) opt::Instruction(
       context(), SpvOpTypePointer, 0, resultId,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_STORAGE_CLASS,
         {uint32_t(storage_class)}},
@@ -49,7 +49,7 @@ uint32_t InlinePass::AddPointerToType(uint32_t type_id,
 
 void InlinePass::AddBranch(uint32_t label_id,
                            std::unique_ptr<opt::BasicBlock>* block_ptr) {
-  std::unique_ptr<opt::Instruction> newBranch(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newBranch(new (context()) opt::Instruction(
       context(), SpvOpBranch, 0, 0,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {label_id}}}));
   (*block_ptr)->AddInstruction(std::move(newBranch));
@@ -58,7 +58,7 @@ void InlinePass::AddBranch(uint32_t label_id,
 void InlinePass::AddBranchCond(uint32_t cond_id, uint32_t true_id,
                                uint32_t false_id,
                                std::unique_ptr<opt::BasicBlock>* block_ptr) {
-  std::unique_ptr<opt::Instruction> newBranch(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newBranch(new (context()) opt::Instruction(
       context(), SpvOpBranchConditional, 0, 0,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {cond_id}},
        {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {true_id}},
@@ -68,17 +68,18 @@ void InlinePass::AddBranchCond(uint32_t cond_id, uint32_t true_id,
 
 void InlinePass::AddLoopMerge(uint32_t merge_id, uint32_t continue_id,
                               std::unique_ptr<opt::BasicBlock>* block_ptr) {
-  std::unique_ptr<opt::Instruction> newLoopMerge(new opt::Instruction(
-      context(), SpvOpLoopMerge, 0, 0,
-      {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {merge_id}},
-       {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {continue_id}},
-       {spv_operand_type_t::SPV_OPERAND_TYPE_LOOP_CONTROL, {0}}}));
+  std::unique_ptr<opt::Instruction> newLoopMerge(
+      new (context()) opt::Instruction(
+          context(), SpvOpLoopMerge, 0, 0,
+          {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {merge_id}},
+           {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {continue_id}},
+           {spv_operand_type_t::SPV_OPERAND_TYPE_LOOP_CONTROL, {0}}}));
   (*block_ptr)->AddInstruction(std::move(newLoopMerge));
 }
 
 void InlinePass::AddStore(uint32_t ptr_id, uint32_t val_id,
                           std::unique_ptr<opt::BasicBlock>* block_ptr) {
-  std::unique_ptr<opt::Instruction> newStore(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newStore(new (context()) opt::Instruction(
       context(), SpvOpStore, 0, 0,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {ptr_id}},
        {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {val_id}}}));
@@ -87,7 +88,7 @@ void InlinePass::AddStore(uint32_t ptr_id, uint32_t val_id,
 
 void InlinePass::AddLoad(uint32_t type_id, uint32_t resultId, uint32_t ptr_id,
                          std::unique_ptr<opt::BasicBlock>* block_ptr) {
-  std::unique_ptr<opt::Instruction> newLoad(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> newLoad(new (context()) opt::Instruction(
       context(), SpvOpLoad, type_id, resultId,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {ptr_id}}}));
   (*block_ptr)->AddInstruction(std::move(newLoad));
@@ -95,7 +96,7 @@ void InlinePass::AddLoad(uint32_t type_id, uint32_t resultId, uint32_t ptr_id,
 
 std::unique_ptr<opt::Instruction> InlinePass::NewLabel(uint32_t label_id) {
   std::unique_ptr<opt::Instruction> newLabel(
-      new opt::Instruction(context(), SpvOpLabel, 0, label_id, {}));
+      new (context()) opt::Instruction(context(), SpvOpLabel, 0, label_id, {}));
   return newLabel;
 }
 
@@ -158,7 +159,7 @@ uint32_t InlinePass::CreateReturnVar(
       returnVarTypeId = AddPointerToType(calleeTypeId, SpvStorageClassFunction);
     // Add return var to new function scope variables.
     returnVarId = TakeNextId();
-    std::unique_ptr<opt::Instruction> var_inst(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> var_inst(new (context()) opt::Instruction(
         context(), SpvOpVariable, returnVarTypeId, returnVarId,
         {{spv_operand_type_t::SPV_OPERAND_TYPE_STORAGE_CLASS,
           {SpvStorageClassFunction}}}));
@@ -307,7 +308,8 @@ void InlinePass::GenInlineCode(
         // call. Copy the terminator into the new block.
         if (returnLabelId == 0) returnLabelId = this->TakeNextId();
         std::unique_ptr<opt::Instruction> terminator(
-            new opt::Instruction(context(), cpi->opcode(), 0, 0, {}));
+            new (context()) opt::Instruction(context(), cpi->opcode(), 0, 0,
+                                             {}));
         new_blk_ptr->AddInstruction(std::move(terminator));
         break;
       }
@@ -338,7 +340,7 @@ void InlinePass::GenInlineCode(
           firstBlock = true;
         }
         // Create first/next block.
-        new_blk_ptr.reset(new opt::BasicBlock(NewLabel(labelId)));
+        new_blk_ptr.reset(new (context()) opt::BasicBlock(NewLabel(labelId)));
         if (firstBlock) {
           // Copy contents of original caller block up to call instruction.
           for (auto cii = call_block_itr->begin(); cii != call_inst_itr;
@@ -364,7 +366,8 @@ void InlinePass::GenInlineCode(
             AddBranch(guard_block_id, &new_blk_ptr);
             new_blocks->push_back(std::move(new_blk_ptr));
             // Start the next block.
-            new_blk_ptr.reset(new opt::BasicBlock(NewLabel(guard_block_id)));
+            new_blk_ptr.reset(
+                new (context()) opt::BasicBlock(NewLabel(guard_block_id)));
             // Reset the mapping of the callee's entry block to point to
             // the guard block.  Do this so we can fix up phis later on to
             // satisfy dominance.
@@ -385,15 +388,16 @@ void InlinePass::GenInlineCode(
             singleTripLoopHeaderId = this->TakeNextId();
             AddBranch(singleTripLoopHeaderId, &new_blk_ptr);
             new_blocks->push_back(std::move(new_blk_ptr));
-            new_blk_ptr.reset(
-                new opt::BasicBlock(NewLabel(singleTripLoopHeaderId)));
+            new_blk_ptr.reset(new (context()) opt::BasicBlock(
+                NewLabel(singleTripLoopHeaderId)));
             returnLabelId = this->TakeNextId();
             singleTripLoopContinueId = this->TakeNextId();
             AddLoopMerge(returnLabelId, singleTripLoopContinueId, &new_blk_ptr);
             uint32_t postHeaderId = this->TakeNextId();
             AddBranch(postHeaderId, &new_blk_ptr);
             new_blocks->push_back(std::move(new_blk_ptr));
-            new_blk_ptr.reset(new opt::BasicBlock(NewLabel(postHeaderId)));
+            new_blk_ptr.reset(
+                new (context()) opt::BasicBlock(NewLabel(postHeaderId)));
             multiBlocks = true;
             // Reset the mapping of the callee's entry block to point to
             // the post-header block.  Do this so we can fix up phis later
@@ -435,14 +439,15 @@ void InlinePass::GenInlineCode(
             // to accommodate multiple returns, insert the continue
             // target block now, with a false branch back to the loop header.
             new_blocks->push_back(std::move(new_blk_ptr));
-            new_blk_ptr.reset(
-                new opt::BasicBlock(NewLabel(singleTripLoopContinueId)));
+            new_blk_ptr.reset(new (context()) opt::BasicBlock(
+                NewLabel(singleTripLoopContinueId)));
             AddBranchCond(GetFalseId(), singleTripLoopHeaderId, returnLabelId,
                           &new_blk_ptr);
           }
           // Generate the return block.
           new_blocks->push_back(std::move(new_blk_ptr));
-          new_blk_ptr.reset(new opt::BasicBlock(NewLabel(returnLabelId)));
+          new_blk_ptr.reset(
+              new (context()) opt::BasicBlock(NewLabel(returnLabelId)));
           multiBlocks = true;
         }
         // Load return value into result id of call, if it exists.
@@ -20,6 +20,7 @@
 #include "fold.h"
 #include "ir_context.h"
 #include "reflect.h"
+#include "util/slab_pool.h"
 
 namespace spvtools {
 namespace opt {
@@ -30,6 +31,13 @@ const uint32_t kTypeImageDimIndex = 1;
 const uint32_t kLoadBaseIndex = 0;
 const uint32_t kVariableStorageClassIndex = 0;
 const uint32_t kTypeImageSampledIndex = 5;
+
+// Returns the allocator for the operands of an instruction in |context|.
+Instruction::OperandStorage::allocator_type OperandAllocator(
+    IRContext* context) {
+  return Instruction::OperandStorage::allocator_type(
+      utils::PoolAllocator<Operand>(context->memory_pool()));
+}
 }  // namespace
 
 Instruction::Instruction(IRContext* c)
@@ -38,7 +46,8 @@ Instruction::Instruction(IRContext* c)
       opcode_(SpvOpNop),
       type_id_(0),
       result_id_(0),
-      unique_id_(c->TakeNextUniqueId()) {}
+      unique_id_(c->TakeNextUniqueId()),
+      operands_(OperandAllocator(c)) {}
 
 Instruction::Instruction(IRContext* c, SpvOp op)
     : utils::IntrusiveNodeBase<Instruction>(),
@@ -46,7 +55,8 @@ Instruction::Instruction(IRContext* c, SpvOp op)
       opcode_(op),
       type_id_(0),
       result_id_(0),
-      unique_id_(c->TakeNextUniqueId()) {}
+      unique_id_(c->TakeNextUniqueId()),
+      operands_(OperandAllocator(c)) {}
 
 Instruction::Instruction(IRContext* c, const spv_parsed_instruction_t& inst,
                          std::vector<Instruction>&& dbg_line)
@@ -55,15 +65,20 @@ Instruction::Instruction(IRContext* c, const spv_parsed_instruction_t& inst,
       type_id_(inst.type_id),
       result_id_(inst.result_id),
       unique_id_(c->TakeNextUniqueId()),
+      operands_(OperandAllocator(c)),
       dbg_line_insts_(std::move(dbg_line)) {
   assert((!IsDebugLineInst(opcode_) || dbg_line.empty()) &&
          "Op(No)Line attaching to Op(No)Line found");
+  operands_.reserve(inst.num_operands);
   for (uint32_t i = 0; i < inst.num_operands; ++i) {
     const auto& current_payload = inst.operands[i];
-    std::vector<uint32_t> words(
-        inst.words + current_payload.offset,
+    // The words are added in place, so that they are allocated from the pool
+    // of the operand.
+    operands_.emplace_back(current_payload.type, Operand::OperandData());
+    Operand::OperandData& words = operands_.back().words;
+    words.insert(
+        words.end(), inst.words + current_payload.offset,
         inst.words + current_payload.offset + current_payload.num_words);
-    operands_.emplace_back(current_payload.type, std::move(words));
   }
 }
 
@@ -75,7 +90,8 @@ Instruction::Instruction(IRContext* c, SpvOp op, uint32_t ty_id,
       type_id_(ty_id),
       result_id_(res_id),
       unique_id_(c->TakeNextUniqueId()),
-      operands_() {
+      operands_(OperandAllocator(c)) {
+  operands_.reserve((type_id_ != 0) + (result_id_ != 0) + in_operands.size());
   if (type_id_ != 0) {
     operands_.emplace_back(spv_operand_type_t::SPV_OPERAND_TYPE_TYPE_ID,
                            std::initializer_list<uint32_t>{type_id_});
@@ -106,8 +122,29 @@ Instruction& Instruction::operator=(Instruction&& that) {
   return *this;
 }
 
+void* Instruction::operator new(size_t size, IRContext* context) {
+  static_assert(alignof(Instruction) <= 16,
+                "SlabPool::AllocateFrom only aligns to 16 bytes.");
+  return utils::SlabPool::AllocateFrom(
+      context ? context->memory_pool() : nullptr, size);
+}
+
+void* Instruction::operator new(size_t size) {
+  return utils::SlabPool::AllocateFrom(nullptr, size);
+}
+
+void Instruction::operator delete(void* ptr, IRContext*) {
+  // This is only used if a constructor throws, and Instruction has no
+  // subclasses, so the size is known.
+  utils::SlabPool::DeallocateAny(ptr, sizeof(Instruction));
+}
+
+void Instruction::operator delete(void* ptr, size_t size) {
+  utils::SlabPool::DeallocateAny(ptr, size);
+}
+
 Instruction* Instruction::Clone(IRContext* c) const {
-  Instruction* clone = new Instruction(c);
+  Instruction* clone = new (c) Instruction(c);
   clone->opcode_ = opcode_;
   clone->type_id_ = type_id_;
   clone->result_id_ = result_id_;
@@ -23,6 +23,7 @@
 #include "opcode.h"
 #include "operand.h"
 #include "util/ilist_node.h"
+#include "util/slab_pool.h"
 #include "util/small_vector.h"
 
 #include "latest_version_glsl_std_450_header.h"
@@ -69,12 +70,30 @@ class InstructionList;
 // A *logical* operand to a SPIR-V instruction. It can be the type id, result
 // id, or other additional operands carried in an instruction.
 struct Operand {
-  using OperandData = utils::SmallVector<uint32_t, 2>;
+  using OperandData =
+      utils::SmallVector<uint32_t, 2, utils::PoolAllocator<uint32_t>>;
+  // The operands of an instruction store their words in the memory pool of
+  // the context of the instruction. The instruction passes the pool down with
+  // the constructors that take an allocator.
+  using allocator_type = utils::PoolAllocator<uint32_t>;
+
   Operand(spv_operand_type_t t, OperandData&& w)
       : type(t), words(std::move(w)) {}
 
   Operand(spv_operand_type_t t, const OperandData& w) : type(t), words(w) {}
 
+  Operand(spv_operand_type_t t, OperandData&& w, const allocator_type& a)
+      : type(t), words(std::move(w), a) {}
+
+  Operand(spv_operand_type_t t, const OperandData& w, const allocator_type& a)
+      : type(t), words(w, a) {}
+
+  Operand(const Operand& that, const allocator_type& a)
+      : type(that.type), words(that.words, a) {}
+
+  Operand(Operand&& that, const allocator_type& a)
+      : type(that.type), words(std::move(that.words), a) {}
+
   spv_operand_type_t type;  // Type of this logical operand.
   OperandData words;        // Binary segments of this logical operand.
 
@@ -98,8 +117,12 @@ inline bool operator!=(const Operand& o1, const Operand& o2) {
 class Instruction : public utils::IntrusiveNodeBase<Instruction> {
  public:
   using OperandList = std::vector<Operand>;
-  using iterator = OperandList::iterator;
-  using const_iterator = OperandList::const_iterator;
+  // The operands of an instruction, and their words, are allocated from the
+  // memory pool of its context.
+  using OperandStorage =
+      std::vector<Operand, utils::ScopedPoolAllocator<Operand>>;
+  using iterator = OperandStorage::iterator;
+  using const_iterator = OperandStorage::const_iterator;
 
   // Creates a default OpNop instruction.
   // This exists solely for containers that can't do without. Should be removed.
@@ -138,6 +161,16 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
 
   virtual ~Instruction() = default;
 
+  // Allocates an instruction from the memory pool of |context|, as in
+  // |new (context) Instruction(context, ...)|. If |context| is null, or for a
+  // plain new expression, the system allocator is used. Either way the
+  // instruction is freed with a plain delete expression, which finds out from
+  // its address where it came from.
+  static void* operator new(size_t size, IRContext* context);
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, IRContext* context);
+  static void operator delete(void* ptr, size_t size);
+
   // Returns a newly allocated instruction that has the same operands, result,
   // and type as |this|.  The new instruction is not linked into any list.
   // It is the responsibility of the caller to make sure that the storage is
@@ -443,7 +476,7 @@ class Instruction : public utils::IntrusiveNodeBase<Instruction> {
   uint32_t result_id_;  // Result id. A value of 0 means no result id.
   uint32_t unique_id_;  // Unique instruction id
   // All logical operands, including result type id and result id.
-  OperandList operands_;
+  OperandStorage operands_;
   // Opline and OpNoLine instructions preceding this instruction. Note that for
   // Instructions representing OpLine or OpNonLine itself, this field should be
   // empty.
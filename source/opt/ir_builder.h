@@ -58,11 +58,12 @@ class InstructionBuilder {
   opt::Instruction* AddSelectionMerge(
       uint32_t merge_id,
       uint32_t selection_control = SpvSelectionControlMaskNone) {
-    std::unique_ptr<opt::Instruction> new_branch_merge(new opt::Instruction(
-        GetContext(), SpvOpSelectionMerge, 0, 0,
-        {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {merge_id}},
-         {spv_operand_type_t::SPV_OPERAND_TYPE_SELECTION_CONTROL,
-          {selection_control}}}));
+    std::unique_ptr<opt::Instruction> new_branch_merge(
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpSelectionMerge, 0, 0,
+            {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {merge_id}},
+             {spv_operand_type_t::SPV_OPERAND_TYPE_SELECTION_CONTROL,
+              {selection_control}}}));
     return AddInstruction(std::move(new_branch_merge));
   }
 
@@ -70,9 +71,10 @@ class InstructionBuilder {
   // Note that the user must make sure the final basic block is
   // well formed.
   opt::Instruction* AddBranch(uint32_t label_id) {
-    std::unique_ptr<opt::Instruction> new_branch(new opt::Instruction(
-        GetContext(), SpvOpBranch, 0, 0,
-        {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {label_id}}}));
+    std::unique_ptr<opt::Instruction> new_branch(
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpBranch, 0, 0,
+            {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {label_id}}}));
     return AddInstruction(std::move(new_branch));
   }
 
@@ -98,11 +100,12 @@ class InstructionBuilder {
     if (merge_id != kInvalidId) {
       AddSelectionMerge(merge_id, selection_control);
     }
-    std::unique_ptr<opt::Instruction> new_branch(new opt::Instruction(
-        GetContext(), SpvOpBranchConditional, 0, 0,
-        {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {cond_id}},
-         {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {true_id}},
-         {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {false_id}}}));
+    std::unique_ptr<opt::Instruction> new_branch(
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpBranchConditional, 0, 0,
+            {{spv_operand_type_t::SPV_OPERAND_TYPE_ID, {cond_id}},
+             {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {true_id}},
+             {spv_operand_type_t::SPV_OPERAND_TYPE_ID, {false_id}}}));
     return AddInstruction(std::move(new_branch));
   }
 
@@ -141,7 +144,8 @@ class InstructionBuilder {
           spv_operand_type_t::SPV_OPERAND_TYPE_ID, {target.second}});
     }
     std::unique_ptr<opt::Instruction> new_switch(
-        new opt::Instruction(GetContext(), SpvOpSwitch, 0, 0, operands));
+        new (GetContext())
+            opt::Instruction(GetContext(), SpvOpSwitch, 0, 0, operands));
     return AddInstruction(std::move(new_switch));
   }
 
@@ -156,8 +160,9 @@ class InstructionBuilder {
     for (size_t i = 0; i < incomings.size(); i++) {
       phi_ops.push_back({SPV_OPERAND_TYPE_ID, {incomings[i]}});
     }
-    std::unique_ptr<opt::Instruction> phi_inst(new opt::Instruction(
-        GetContext(), SpvOpPhi, type, GetContext()->TakeNextId(), phi_ops));
+    std::unique_ptr<opt::Instruction> phi_inst(
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpPhi, type, GetContext()->TakeNextId(), phi_ops));
     return AddInstruction(std::move(phi_inst));
   }
 
@@ -167,7 +172,7 @@ class InstructionBuilder {
   // The id |op1| is the left hand side of the operation.
   // The id |op2| is the right hand side of the operation.
   opt::Instruction* AddIAdd(uint32_t type, uint32_t op1, uint32_t op2) {
-    std::unique_ptr<opt::Instruction> inst(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> inst(new (GetContext()) opt::Instruction(
         GetContext(), SpvOpIAdd, type, GetContext()->TakeNextId(),
         {{SPV_OPERAND_TYPE_ID, {op1}}, {SPV_OPERAND_TYPE_ID, {op2}}}));
     return AddInstruction(std::move(inst));
@@ -180,7 +185,7 @@ class InstructionBuilder {
   opt::Instruction* AddULessThan(uint32_t op1, uint32_t op2) {
     analysis::Bool bool_type;
     uint32_t type = GetContext()->get_type_mgr()->GetId(&bool_type);
-    std::unique_ptr<opt::Instruction> inst(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> inst(new (GetContext()) opt::Instruction(
         GetContext(), SpvOpULessThan, type, GetContext()->TakeNextId(),
         {{SPV_OPERAND_TYPE_ID, {op1}}, {SPV_OPERAND_TYPE_ID, {op2}}}));
     return AddInstruction(std::move(inst));
@@ -193,7 +198,7 @@ class InstructionBuilder {
   opt::Instruction* AddSLessThan(uint32_t op1, uint32_t op2) {
     analysis::Bool bool_type;
     uint32_t type = GetContext()->get_type_mgr()->GetId(&bool_type);
-    std::unique_ptr<opt::Instruction> inst(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> inst(new (GetContext()) opt::Instruction(
         GetContext(), SpvOpSLessThan, type, GetContext()->TakeNextId(),
         {{SPV_OPERAND_TYPE_ID, {op1}}, {SPV_OPERAND_TYPE_ID, {op2}}}));
     return AddInstruction(std::move(inst));
@@ -222,12 +227,13 @@ class InstructionBuilder {
   // bool) for |type|.
   opt::Instruction* AddSelect(uint32_t type, uint32_t cond, uint32_t true_value,
                               uint32_t false_value) {
-    std::unique_ptr<opt::Instruction> select(new opt::Instruction(
-        GetContext(), SpvOpSelect, type, GetContext()->TakeNextId(),
-        std::initializer_list<opt::Operand>{
-            {SPV_OPERAND_TYPE_ID, {cond}},
-            {SPV_OPERAND_TYPE_ID, {true_value}},
-            {SPV_OPERAND_TYPE_ID, {false_value}}}));
+    std::unique_ptr<opt::Instruction> select(
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpSelect, type, GetContext()->TakeNextId(),
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_ID, {cond}},
+                {SPV_OPERAND_TYPE_ID, {true_value}},
+                {SPV_OPERAND_TYPE_ID, {false_value}}}));
     return AddInstruction(std::move(select));
   }
 
@@ -248,8 +254,9 @@ class InstructionBuilder {
                        std::initializer_list<uint32_t>{id});
     }
     std::unique_ptr<opt::Instruction> construct(
-        new opt::Instruction(GetContext(), SpvOpCompositeConstruct, type,
-                             GetContext()->TakeNextId(), ops));
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpCompositeConstruct, type,
+            GetContext()->TakeNextId(), ops));
     return AddInstruction(std::move(construct));
   }
   // Adds an unsigned int32 constant to the binary.
@@ -305,16 +312,18 @@ class InstructionBuilder {
     }
 
     std::unique_ptr<opt::Instruction> new_inst(
-        new opt::Instruction(GetContext(), SpvOpCompositeExtract, type,
-                             GetContext()->TakeNextId(), operands));
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpCompositeExtract, type,
+            GetContext()->TakeNextId(), operands));
     return AddInstruction(std::move(new_inst));
   }
 
   // Creates an unreachable instruction.
   opt::Instruction* AddUnreachable() {
     std::unique_ptr<opt::Instruction> select(
-        new opt::Instruction(GetContext(), SpvOpUnreachable, 0, 0,
-                             std::initializer_list<opt::Operand>{}));
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpUnreachable, 0, 0,
+            std::initializer_list<opt::Operand>{}));
     return AddInstruction(std::move(select));
   }
 
@@ -328,8 +337,9 @@ class InstructionBuilder {
     }
 
     std::unique_ptr<opt::Instruction> new_inst(
-        new opt::Instruction(GetContext(), SpvOpAccessChain, type_id,
-                             GetContext()->TakeNextId(), operands));
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpAccessChain, type_id,
+            GetContext()->TakeNextId(), operands));
     return AddInstruction(std::move(new_inst));
   }
 
@@ -338,8 +348,9 @@ class InstructionBuilder {
     operands.push_back({SPV_OPERAND_TYPE_ID, {base_ptr_id}});
 
     std::unique_ptr<opt::Instruction> new_inst(
-        new opt::Instruction(GetContext(), SpvOpLoad, type_id,
-                             GetContext()->TakeNextId(), operands));
+        new (GetContext()) opt::Instruction(
+            GetContext(), SpvOpLoad, type_id, GetContext()->TakeNextId(),
+            operands));
     return AddInstruction(std::move(new_inst));
   }
 
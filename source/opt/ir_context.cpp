@@ -54,6 +54,9 @@ void IRContext::BuildInvalidAnalyses(IRContext::Analysis set) {
   if (set & kAnalysisValueNumberTable) {
     BuildValueNumberTable();
   }
+  if (set & kAnalysisStructLayout) {
+    BuildStructLayoutAnalysis();
+  }
 }
 
 void IRContext::InvalidateAnalysesExceptFor(
@@ -88,6 +91,9 @@ void IRContext::InvalidateAnalyses(IRContext::Analysis analyses_to_invalidate) {
   if (analyses_to_invalidate & kAnalysisValueNumberTable) {
     vn_table_.reset(nullptr);
   }
+  if (analyses_to_invalidate & kAnalysisStructLayout) {
+    struct_layout_.reset(nullptr);
+  }
 
   valid_analyses_ = Analysis(valid_analyses_ & ~analyses_to_invalidate);
 }
@@ -118,6 +124,11 @@ Instruction* IRContext::KillInst(opt::Instruction* inst) {
     type_mgr_->RemoveId(inst->result_id());
   }
 
+  if (AreAnalysesValid(kAnalysisStructLayout) &&
+      (opt::IsTypeInst(inst->opcode()) || inst->IsDecoration())) {
+    InvalidateAnalyses(kAnalysisStructLayout);
+  }
+
   if (constant_mgr_ && opt::IsConstantInst(inst->opcode())) {
     constant_mgr_->RemoveId(inst->result_id());
   }
@@ -27,7 +27,9 @@
 #include "module.h"
 #include "register_pressure.h"
 #include "scalar_analysis.h"
+#include "struct_layout_analysis.h"
 #include "type_manager.h"
+#include "util/slab_pool.h"
 #include "value_number_table.h"
 
 #include <algorithm>
@@ -65,7 +67,8 @@ class IRContext {
     kAnalysisScalarEvolution = 1 << 8,
     kAnalysisRegisterPressure = 1 << 9,
     kAnalysisValueNumberTable = 1 << 10,
-    kAnalysisEnd = 1 << 11
+    kAnalysisStructLayout = 1 << 11,
+    kAnalysisEnd = 1 << 12
   };
 
   friend inline Analysis operator|(Analysis lhs, Analysis rhs);
@@ -78,6 +81,7 @@ class IRContext {
       : syntax_context_(spvContextCreate(env)),
         grammar_(syntax_context_),
         unique_id_(0),
+        memory_pool_(utils::SlabPool::Create()),
         module_(new Module()),
         consumer_(std::move(c)),
         def_use_mgr_(nullptr),
@@ -93,6 +97,7 @@ class IRContext {
       : syntax_context_(spvContextCreate(env)),
         grammar_(syntax_context_),
         unique_id_(0),
+        memory_pool_(utils::SlabPool::Create()),
         module_(std::move(m)),
         consumer_(std::move(c)),
         def_use_mgr_(nullptr),
@@ -108,6 +113,11 @@ class IRContext {
 
   Module* module() const { return module_.get(); }
 
+  // Returns the memory pool for the instructions, basic blocks and operands of
+  // the module. Like the context, it must only be used by one thread at a
+  // time.
+  utils::SlabPool* memory_pool() const { return memory_pool_.get(); }
+
   // Returns a vector of pointers to constant-creation instructions in this
   // context.
   inline std::vector<Instruction*> GetConstants();
@@ -291,6 +301,15 @@ class IRContext {
     return scalar_evolution_analysis_.get();
   }
 
+  // Returns a pointer to the struct layout analysis.  If it is invalid it is
+  // rebuilt first.
+  opt::StructLayoutAnalysis* GetStructLayoutAnalysis() {
+    if (!AreAnalysesValid(kAnalysisStructLayout)) {
+      BuildStructLayoutAnalysis();
+    }
+    return struct_layout_.get();
+  }
+
   // Build the map from the ids to the OpName and OpMemberName instruction
   // associated with it.
   inline void BuildIdToNameMap();
@@ -498,6 +517,13 @@ class IRContext {
     valid_analyses_ = valid_analyses_ | kAnalysisValueNumberTable;
   }
 
+  // Builds the struct layout analysis from scratch, even if it was already
+  // valid.
+  void BuildStructLayoutAnalysis() {
+    struct_layout_.reset(new opt::StructLayoutAnalysis(this));
+    valid_analyses_ = valid_analyses_ | kAnalysisStructLayout;
+  }
+
   // Removes all computed dominator and post-dominator trees. This will force
   // the context to rebuild the trees on demand.
   void ResetDominatorAnalysis() {
@@ -551,6 +577,12 @@ class IRContext {
   // Therefore, 0 is not a valid unique id for an instruction.
   uint32_t unique_id_;
 
+  // The pool instructions, basic blocks and operands of |module_| are
+  // allocated from. It is declared before |module_| so that it is released
+  // after the module is destroyed, at which point it usually has no blocks in
+  // use and deletes itself.
+  utils::SlabPoolPtr memory_pool_;
+
   // The module being processed within this IR context.
   std::unique_ptr<Module> module_;
 
@@ -608,6 +640,9 @@ class IRContext {
 
   std::unique_ptr<opt::ValueNumberTable> vn_table_;
 
+  // The layouts of the struct types in |module_|.
+  std::unique_ptr<opt::StructLayoutAnalysis> struct_layout_;
+
   std::unique_ptr<opt::InstructionFolder> inst_folder_;
 };
 
@@ -797,6 +832,9 @@ void IRContext::AddAnnotationInst(std::unique_ptr<Instruction>&& a) {
   if (AreAnalysesValid(kAnalysisDecorations)) {
     get_decoration_mgr()->AddDecoration(a.get());
   }
+  if (AreAnalysesValid(kAnalysisStructLayout)) {
+    InvalidateAnalyses(kAnalysisStructLayout);
+  }
   module()->AddAnnotationInst(std::move(a));
 }
 
@@ -34,8 +34,8 @@ bool IrLoader::AddInstruction(const spv_parsed_instruction_t* inst) {
     return true;
   }
 
-  std::unique_ptr<Instruction> spv_inst(
-      new Instruction(module()->context(), *inst, std::move(dbg_line_info_)));
+  std::unique_ptr<Instruction> spv_inst(new (module()->context()) Instruction(
+      module()->context(), *inst, std::move(dbg_line_info_)));
   dbg_line_info_.clear();
 
   const char* src = source_.c_str();
@@ -71,7 +71,7 @@ bool IrLoader::AddInstruction(const spv_parsed_instruction_t* inst) {
       Error(consumer_, src, loc, "OpLabel inside basic block");
       return false;
     }
-    block_.reset(new BasicBlock(std::move(spv_inst)));
+    block_.reset(new (module()->context()) BasicBlock(std::move(spv_inst)));
   } else if (IsTerminatorInst(opcode)) {
     if (function_ == nullptr) {
       Error(consumer_, src, loc, "terminator instruction outside function");
@@ -36,7 +36,8 @@ void LocalAccessChainConvertPass::BuildAndAppendInst(
     const std::vector<opt::Operand>& in_opnds,
     std::vector<std::unique_ptr<opt::Instruction>>* newInsts) {
   std::unique_ptr<opt::Instruction> newInst(
-      new opt::Instruction(context(), opcode, typeId, resultId, in_opnds));
+      new (context()) opt::Instruction(context(), opcode, typeId, resultId,
+                                       in_opnds));
   get_def_use_mgr()->AnalyzeInstDefUse(&*newInst);
   newInsts->emplace_back(std::move(newInst));
 }
@@ -348,9 +348,10 @@ opt::BasicBlock* LoopPeeling::CreateBlockBefore(opt::BasicBlock* bb) {
   opt::CFG& cfg = *context_->cfg();
   assert(cfg.preds(bb->id()).size() == 1 && "More than one predecessor");
 
-  std::unique_ptr<opt::BasicBlock> new_bb = MakeUnique<opt::BasicBlock>(
-      std::unique_ptr<opt::Instruction>(new opt::Instruction(
-          context_, SpvOpLabel, 0, context_->TakeNextId(), {})));
+  std::unique_ptr<opt::BasicBlock> new_bb =
+      std::unique_ptr<opt::BasicBlock>(new (context_) opt::BasicBlock(
+          std::unique_ptr<opt::Instruction>(new (context_) opt::Instruction(
+              context_, SpvOpLabel, 0, context_->TakeNextId(), {}))));
   new_bb->SetParent(loop_utils_.GetFunction());
   // Update the loop descriptor.
   opt::Loop* in_loop = (*loop_utils_.GetLoopDescriptor())[bb];
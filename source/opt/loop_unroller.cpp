@@ -369,10 +369,10 @@ void LoopUnrollerUtilsImpl::Init(opt::Loop* loop) {
 // number of bodies.
 void LoopUnrollerUtilsImpl::PartiallyUnrollResidualFactor(opt::Loop* loop,
                                                           size_t factor) {
-  std::unique_ptr<opt::Instruction> new_label{new opt::Instruction(
+  std::unique_ptr<opt::Instruction> new_label{new (context_) opt::Instruction(
       context_, SpvOp::SpvOpLabel, 0, context_->TakeNextId(), {})};
   std::unique_ptr<opt::BasicBlock> new_exit_bb{
-      new opt::BasicBlock(std::move(new_label))};
+      new (context_) opt::BasicBlock(std::move(new_label))};
 
   // Save the id of the block before we move it.
   uint32_t new_merge_id = new_exit_bb->id();
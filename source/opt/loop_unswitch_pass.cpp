@@ -100,9 +100,10 @@ class LoopUnswitch {
     analysis::DefUseManager* def_use_mgr = context_->get_def_use_mgr();
 
     opt::BasicBlock* bb =
-        &*ip.InsertBefore(std::unique_ptr<opt::BasicBlock>(new opt::BasicBlock(
-            std::unique_ptr<opt::Instruction>(new opt::Instruction(
-                context_, SpvOpLabel, 0, context_->TakeNextId(), {})))));
+        &*ip.InsertBefore(std::unique_ptr<opt::BasicBlock>(
+            new (context_) opt::BasicBlock(std::unique_ptr<opt::Instruction>(
+                new (context_) opt::Instruction(
+                    context_, SpvOpLabel, 0, context_->TakeNextId(), {})))));
     bb->SetParent(function_);
     def_use_mgr->AnalyzeInstDef(bb->GetLabelInst());
     context_->set_instr_block(bb->GetLabelInst(), bb);
@@ -358,8 +358,8 @@ void LoopUtils::CreateLoopDedicatedExits() {
 
     // Create the dedicate exit basic block.
     opt::BasicBlock& exit = *insert_pt.InsertBefore(
-        std::unique_ptr<opt::BasicBlock>(new opt::BasicBlock(
-            std::unique_ptr<opt::Instruction>(new opt::Instruction(
+        std::unique_ptr<opt::BasicBlock>(new (context_) opt::BasicBlock(
+            std::unique_ptr<opt::Instruction>(new (context_) opt::Instruction(
                 context_, SpvOpLabel, 0, context_->TakeNextId(), {})))));
     exit.SetParent(function);
 
@@ -498,10 +498,10 @@ opt::Loop* LoopUtils::CloneAndAttachLoopToHeader(
   opt::Loop* new_loop = CloneLoop(cloning_result);
 
   // Create a new exit block/label for the new loop.
-  std::unique_ptr<opt::Instruction> new_label{new opt::Instruction(
+  std::unique_ptr<opt::Instruction> new_label{new (context_) opt::Instruction(
       context_, SpvOp::SpvOpLabel, 0, context_->TakeNextId(), {})};
   std::unique_ptr<opt::BasicBlock> new_exit_bb{
-      new opt::BasicBlock(std::move(new_label))};
+      new (context_) opt::BasicBlock(std::move(new_label))};
   new_exit_bb->SetParent(loop_->GetMergeBlock()->GetParent());
 
   // Create an unconditional branch to the header block.
@@ -232,7 +232,8 @@ uint32_t MemPass::Type2Undef(uint32_t type_id) {
   if (uitr != type2undefs_.end()) return uitr->second;
   const uint32_t undefId = TakeNextId();
   std::unique_ptr<opt::Instruction> undef_inst(
-      new opt::Instruction(context(), SpvOpUndef, type_id, undefId, {}));
+      new (context()) opt::Instruction(context(), SpvOpUndef, type_id, undefId,
+                                       {}));
   get_def_use_mgr()->AnalyzeInstDefUse(&*undef_inst);
   get_module()->AddGlobalValue(std::move(undef_inst));
   type2undefs_[type_id] = undefId;
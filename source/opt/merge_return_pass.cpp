@@ -99,11 +99,12 @@ void MergeReturnPass::ProcessStructured(
 void MergeReturnPass::CreateReturnBlock() {
   // Create a label for the new return block
   std::unique_ptr<opt::Instruction> return_label(
-      new opt::Instruction(context(), SpvOpLabel, 0u, TakeNextId(), {}));
+      new (context()) opt::Instruction(context(), SpvOpLabel, 0u, TakeNextId(),
+                                       {}));
 
   // Create the new basic block
   std::unique_ptr<opt::BasicBlock> return_block(
-      new opt::BasicBlock(std::move(return_label)));
+      new (context()) opt::BasicBlock(std::move(return_label)));
   function_->AddBasicBlock(std::move(return_block));
   final_return_block_ = &*(--function_->end());
   context()->AnalyzeDefUse(final_return_block_->GetLabelInst());
@@ -118,21 +119,25 @@ void MergeReturnPass::CreateReturn(opt::BasicBlock* block) {
   if (return_value_) {
     // Load and return the final return value
     uint32_t loadId = TakeNextId();
-    block->AddInstruction(MakeUnique<opt::Instruction>(
-        context(), SpvOpLoad, function_->type_id(), loadId,
-        std::initializer_list<opt::Operand>{
-            {SPV_OPERAND_TYPE_ID, {return_value_->result_id()}}}));
+    block->AddInstruction(
+        std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+            context(), SpvOpLoad, function_->type_id(), loadId,
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_ID, {return_value_->result_id()}}})));
     opt::Instruction* var_inst = block->terminator();
     context()->AnalyzeDefUse(var_inst);
     context()->set_instr_block(var_inst, block);
 
-    block->AddInstruction(MakeUnique<opt::Instruction>(
-        context(), SpvOpReturnValue, 0, 0,
-        std::initializer_list<opt::Operand>{{SPV_OPERAND_TYPE_ID, {loadId}}}));
+    block->AddInstruction(
+        std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+            context(), SpvOpReturnValue, 0, 0,
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_ID, {loadId}}})));
     context()->AnalyzeDefUse(block->terminator());
     context()->set_instr_block(block->terminator(), block);
   } else {
-    block->AddInstruction(MakeUnique<opt::Instruction>(context(), SpvOpReturn));
+    block->AddInstruction(std::unique_ptr<opt::Instruction>(
+        new (context()) opt::Instruction(context(), SpvOpReturn)));
     context()->AnalyzeDefUse(block->terminator());
     context()->set_instr_block(block->terminator(), block);
   }
@@ -358,9 +363,11 @@ void MergeReturnPass::PredicateBlock(
         }
       });
 
-  std::unique_ptr<opt::BasicBlock> new_merge_block(new opt::BasicBlock(
-      MakeUnique<opt::Instruction>(context(), SpvOpLabel, 0, TakeNextId(),
-                                   std::initializer_list<opt::Operand>{})));
+  std::unique_ptr<opt::BasicBlock> new_merge_block(
+      new (context()) opt::BasicBlock(std::unique_ptr<opt::Instruction>(
+          new (context()) opt::Instruction(
+              context(), SpvOpLabel, 0, TakeNextId(),
+              std::initializer_list<opt::Operand>{}))));
 
   opt::BasicBlock* new_merge =
       function_->InsertBasicBlockAfter(std::move(new_merge_block), tail_block);
@@ -388,10 +395,11 @@ void MergeReturnPass::PredicateBlock(
 
   // Add a branch to the new merge. If we jumped multiple blocks, the branch is
   // added to tail_block, otherwise the branch belongs in old_body.
-  tail_block->AddInstruction(MakeUnique<opt::Instruction>(
-      context(), SpvOpBranch, 0, 0,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {new_merge->id()}}}));
+  tail_block->AddInstruction(
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), SpvOpBranch, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {new_merge->id()}}})));
   get_def_use_mgr()->AnalyzeInstUse(tail_block->terminator());
   context()->set_instr_block(tail_block->terminator(), tail_block);
 
@@ -405,30 +413,33 @@ void MergeReturnPass::PredicateBlock(
   uint32_t bool_id = context()->get_type_mgr()->GetId(&bool_type);
   assert(bool_id != 0);
   uint32_t load_id = TakeNextId();
-  block->AddInstruction(MakeUnique<opt::Instruction>(
-      context(), SpvOpLoad, bool_id, load_id,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {return_flag_->result_id()}}}));
+  block->AddInstruction(
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), SpvOpLoad, bool_id, load_id,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {return_flag_->result_id()}}})));
   get_def_use_mgr()->AnalyzeInstDefUse(block->terminator());
   context()->set_instr_block(block->terminator(), block);
 
   // 2. Declare the merge block
   block->AddInstruction(
-      MakeUnique<opt::Instruction>(context(), SpvOpSelectionMerge, 0, 0,
-                                   std::initializer_list<opt::Operand>{
-                                       {SPV_OPERAND_TYPE_ID, {new_merge->id()}},
-                                       {SPV_OPERAND_TYPE_SELECTION_CONTROL,
-                                        {SpvSelectionControlMaskNone}}}));
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), SpvOpSelectionMerge, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {new_merge->id()}},
+              {SPV_OPERAND_TYPE_SELECTION_CONTROL,
+               {SpvSelectionControlMaskNone}}})));
   get_def_use_mgr()->AnalyzeInstUse(block->terminator());
   context()->set_instr_block(block->terminator(), block);
 
   // 3. Branch to new merge (true) or old body (false)
-  block->AddInstruction(MakeUnique<opt::Instruction>(
-      context(), SpvOpBranchConditional, 0, 0,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {load_id}},
-          {SPV_OPERAND_TYPE_ID, {new_merge->id()}},
-          {SPV_OPERAND_TYPE_ID, {old_body->id()}}}));
+  block->AddInstruction(
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), SpvOpBranchConditional, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {load_id}},
+              {SPV_OPERAND_TYPE_ID, {new_merge->id()}},
+              {SPV_OPERAND_TYPE_ID, {old_body->id()}}})));
   get_def_use_mgr()->AnalyzeInstUse(block->terminator());
   context()->set_instr_block(block->terminator(), block);
 
@@ -465,11 +476,12 @@ void MergeReturnPass::RecordReturned(opt::BasicBlock* block) {
     context()->UpdateDefUse(constant_true_);
   }
 
-  std::unique_ptr<opt::Instruction> return_store(new opt::Instruction(
-      context(), SpvOpStore, 0, 0,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {return_flag_->result_id()}},
-          {SPV_OPERAND_TYPE_ID, {constant_true_->result_id()}}}));
+  std::unique_ptr<opt::Instruction> return_store(
+      new (context()) opt::Instruction(
+          context(), SpvOpStore, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {return_flag_->result_id()}},
+              {SPV_OPERAND_TYPE_ID, {constant_true_->result_id()}}}));
 
   opt::Instruction* store_inst =
       &*block->tail().InsertBefore(std::move(return_store));
@@ -486,11 +498,12 @@ void MergeReturnPass::RecordReturnValue(opt::BasicBlock* block) {
   assert(return_value_ &&
          "Did not generate the variable to hold the return value.");
 
-  std::unique_ptr<opt::Instruction> value_store(new opt::Instruction(
-      context(), SpvOpStore, 0, 0,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_ID, {return_value_->result_id()}},
-          {SPV_OPERAND_TYPE_ID, {terminator.GetSingleWordInOperand(0u)}}}));
+  std::unique_ptr<opt::Instruction> value_store(
+      new (context()) opt::Instruction(
+          context(), SpvOpStore, 0, 0,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_ID, {return_value_->result_id()}},
+              {SPV_OPERAND_TYPE_ID, {terminator.GetSingleWordInOperand(0u)}}}));
 
   opt::Instruction* store_inst =
       &*block->tail().InsertBefore(std::move(value_store));
@@ -509,10 +522,11 @@ void MergeReturnPass::AddReturnValue() {
       return_type_id, SpvStorageClassFunction);
 
   uint32_t var_id = TakeNextId();
-  std::unique_ptr<opt::Instruction> returnValue(new opt::Instruction(
-      context(), SpvOpVariable, return_ptr_type, var_id,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}}}));
+  std::unique_ptr<opt::Instruction> returnValue(
+      new (context()) opt::Instruction(
+          context(), SpvOpVariable, return_ptr_type, var_id,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}}}));
 
   auto insert_iter = function_->begin()->begin();
   insert_iter.InsertBefore(std::move(returnValue));
@@ -541,7 +555,7 @@ void MergeReturnPass::AddReturnFlag() {
       type_mgr->FindPointerToType(bool_id, SpvStorageClassFunction);
 
   uint32_t var_id = TakeNextId();
-  std::unique_ptr<opt::Instruction> returnFlag(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> returnFlag(new (context()) opt::Instruction(
       context(), SpvOpVariable, bool_ptr_id, var_id,
       std::initializer_list<opt::Operand>{
           {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}},
@@ -595,14 +609,15 @@ void MergeReturnPass::MergeReturnBlocks(
     // Need a PHI node to select the correct return value.
     uint32_t phi_result_id = TakeNextId();
     uint32_t phi_type_id = function->type_id();
-    std::unique_ptr<opt::Instruction> phi_inst(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> phi_inst(new (context()) opt::Instruction(
         context(), SpvOpPhi, phi_type_id, phi_result_id, phi_ops));
     ret_block_iter->AddInstruction(std::move(phi_inst));
     opt::BasicBlock::iterator phiIter = ret_block_iter->tail();
 
     std::unique_ptr<opt::Instruction> return_inst(
-        new opt::Instruction(context(), SpvOpReturnValue, 0u, 0u,
-                             {{SPV_OPERAND_TYPE_ID, {phi_result_id}}}));
+        new (context()) opt::Instruction(
+            context(), SpvOpReturnValue, 0u, 0u,
+            {{SPV_OPERAND_TYPE_ID, {phi_result_id}}}));
     ret_block_iter->AddInstruction(std::move(return_inst));
     opt::BasicBlock::iterator ret = ret_block_iter->tail();
 
@@ -611,7 +626,7 @@ void MergeReturnPass::MergeReturnBlocks(
     get_def_use_mgr()->AnalyzeInstDef(&*ret);
   } else {
     std::unique_ptr<opt::Instruction> return_inst(
-        new opt::Instruction(context(), SpvOpReturn));
+        new (context()) opt::Instruction(context(), SpvOpReturn));
     ret_block_iter->AddInstruction(std::move(return_inst));
   }
 
@@ -66,7 +66,8 @@ uint32_t Module::GetGlobalValue(SpvOp opcode) const {
 void Module::AddGlobalValue(SpvOp opcode, uint32_t result_id,
                             uint32_t type_id) {
   std::unique_ptr<opt::Instruction> newGlobal(
-      new opt::Instruction(context(), opcode, type_id, result_id, {}));
+      new (context()) opt::Instruction(context(), opcode, type_id, result_id,
+                                       {}));
   AddGlobalValue(std::move(newGlobal));
 }
 
@@ -20,6 +20,7 @@
 #include "passes.h"
 #include "reduce_load_size.h"
 #include "simplification_pass.h"
+#include "util/parallel.h"
 
 namespace spvtools {
 
@@ -231,6 +232,81 @@ Optimizer& Optimizer::SetTimeReport(std::ostream* out) {
   return *this;
 }
 
+namespace {
+
+// A message reported while optimizing one module of a batch. It is kept until
+// it can be passed to the consumer on the thread running the batch.
+struct BatchMessage {
+  spv_message_level_t level;
+  std::string source;
+  spv_position_t position;
+  std::string message;
+};
+
+}  // namespace
+
+struct BatchOptimizer::Impl {
+  Impl(spv_target_env env, Recipe r)
+      : target_env(env), recipe(std::move(r)), consumer(), num_threads(1) {}
+
+  spv_target_env target_env;  // Target environment.
+  Recipe recipe;              // Registers the passes for each module.
+  MessageConsumer consumer;   // Message consumer.
+  uint32_t num_threads;       // Number of threads to optimize modules on.
+};
+
+BatchOptimizer::BatchOptimizer(spv_target_env env, Recipe recipe)
+    : impl_(new Impl(env, std::move(recipe))) {}
+
+BatchOptimizer::~BatchOptimizer() {}
+
+void BatchOptimizer::SetMessageConsumer(MessageConsumer c) {
+  impl_->consumer = std::move(c);
+}
+
+BatchOptimizer& BatchOptimizer::SetNumThreads(uint32_t num_threads) {
+  impl_->num_threads = num_threads;
+  return *this;
+}
+
+std::vector<bool> BatchOptimizer::Run(
+    const std::vector<std::vector<uint32_t>>& binaries,
+    std::vector<std::vector<uint32_t>>* optimized_binaries) const {
+  optimized_binaries->resize(binaries.size());
+  std::vector<std::vector<BatchMessage>> messages(binaries.size());
+  // Not a std::vector<bool>, whose elements cannot be written concurrently.
+  std::unique_ptr<bool[]> succeeded(new bool[binaries.size()]);
+
+  utils::ParallelFor(impl_->num_threads, binaries.size(), [&](size_t i) {
+    std::vector<BatchMessage>* module_messages = &messages[i];
+    Optimizer optimizer(impl_->target_env);
+    optimizer.SetMessageConsumer(
+        [module_messages](spv_message_level_t level, const char* source,
+                          const spv_position_t& position,
+                          const char* message) {
+          module_messages->push_back({level, source ? source : "", position,
+                                      message ? message : ""});
+        });
+    impl_->recipe(&optimizer);
+
+    const std::vector<uint32_t>& binary = binaries[i];
+    succeeded[i] = optimizer.Run(binary.data(), binary.size(),
+                                 &(*optimized_binaries)[i]);
+  });
+
+  std::vector<bool> result(binaries.size());
+  for (size_t i = 0; i < binaries.size(); ++i) {
+    if (impl_->consumer) {
+      for (const BatchMessage& m : messages[i]) {
+        impl_->consumer(m.level, m.source.c_str(), m.position,
+                        m.message.c_str());
+      }
+    }
+    result[i] = succeeded[i];
+  }
+  return result;
+}
+
 Optimizer::PassToken CreateNullPass() {
   return MakeUnique<Optimizer::PassToken::Impl>(MakeUnique<opt::NullPass>());
 }
@@ -17,7 +17,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -105,7 +107,11 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes(
     return modified;
   }
 
-  std::vector<Instruction*> visited_types;
+  // Types already visited, keyed on their structural hash so that looking up
+  // an equal type does not require comparing against every visited type.
+  std::unordered_map<const analysis::Type*, SpvId, analysis::HashTypePointer,
+                     analysis::CompareTypePointers>
+      visited_types;
   std::vector<Instruction*> to_delete;
   for (auto* i = &*ir_context->types_values_begin(); i; i = i->NextNode()) {
     // We only care about types.
@@ -114,29 +120,35 @@ bool RemoveDuplicatesPass::RemoveDuplicateTypes(
       continue;
     }
 
-    // Is the current type equal to one of the types we have aready visited?
-    SpvId id_to_keep = 0u;
-    // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-    // ResultIdTrie from unify_const_pass.cpp for this.
-    for (auto j : visited_types) {
-      if (AreTypesEqual(*i, *j, ir_context)) {
-        id_to_keep = j->result_id();
-        break;
-      }
-    }
+    // Types the type manager does not know about can never compare equal to
+    // anything (see |AreTypesEqual|), so keep them as they are.
+    if (!opt::IsTypeInst(i->opcode())) continue;
+    const analysis::Type* type =
+        ir_context->get_type_mgr()->GetType(i->result_id());
+    if (type == nullptr) continue;
 
-    if (id_to_keep == 0u) {
+    // Is the current type equal to one of the types we have aready visited?
+    auto res = visited_types.emplace(type, i->result_id());
+    if (res.second) {
       // This is a never seen before type, keep it around.
-      visited_types.emplace_back(i);
-    } else {
-      // The same type has already been seen before, remove this one.
-      ir_context->KillNamesAndDecorates(i->result_id());
-      ir_context->ReplaceAllUsesWith(i->result_id(), id_to_keep);
-      modified = true;
-      to_delete.emplace_back(i);
+      continue;
     }
+
+    // The same type has already been seen before, remove this one.
+    const SpvId id_to_keep = res.first->second;
+    ir_context->KillNamesAndDecorates(i->result_id());
+    ir_context->ReplaceAllUsesWith(i->result_id(), id_to_keep);
+    modified = true;
+    to_delete.emplace_back(i);
   }
 
+  // The type manager maps a type declared more than once to its last
+  // declaration, which is usually one of the duplicates being removed. Map each
+  // kept type to its own id first, so that killing the duplicates does not
+  // have to search all the types for a replacement id.
+  for (const auto& pair : visited_types) {
+    ir_context->get_type_mgr()->MapTypeToId(pair.second);
+  }
   for (auto i : to_delete) {
     ir_context->KillInst(i);
   }
@@ -157,25 +169,53 @@ bool RemoveDuplicatesPass::RemoveDuplicateDecorations(
     opt::IRContext* ir_context) const {
   bool modified = false;
 
-  std::vector<const Instruction*> visited_decorations;
+  if (ir_context->annotations().empty()) {
+    return modified;
+  }
 
   opt::analysis::DecorationManager decoration_manager(ir_context->module());
+
+  // Decorations already visited. Two decorations are only the same if they
+  // have the same opcode and in-operands, so hash on exactly those.
+  auto hash_decoration = [](const Instruction* inst) {
+    std::u32string h;
+    h.push_back(inst->opcode());
+    for (uint32_t i = 0; i < inst->NumInOperands(); ++i) {
+      const Operand& operand = inst->GetInOperand(i);
+      h.push_back(operand.type);
+      h.push_back(static_cast<uint32_t>(operand.words.size()));
+      for (uint32_t w : operand.words) h.push_back(w);
+    }
+    return std::hash<std::u32string>()(h);
+  };
+  auto same_decoration = [&decoration_manager](const Instruction* inst1,
+                                               const Instruction* inst2) {
+    return decoration_manager.AreDecorationsTheSame(inst1, inst2, false);
+  };
+  std::unordered_set<const Instruction*, decltype(hash_decoration),
+                     decltype(same_decoration)>
+      visited_decorations(static_cast<size_t>(std::distance(
+                              ir_context->annotation_begin(),
+                              ir_context->annotation_end())),
+                          hash_decoration, same_decoration);
+
   for (auto* i = &*ir_context->annotation_begin(); i;) {
-    // Is the current decoration equal to one of the decorations we have aready
-    // visited?
-    bool already_visited = false;
-    // TODO(dneto0): Use a trie to avoid quadratic behaviour? Extract the
-    // ResultIdTrie from unify_const_pass.cpp for this.
-    for (const Instruction* j : visited_decorations) {
-      if (decoration_manager.AreDecorationsTheSame(&*i, j, false)) {
-        already_visited = true;
+    switch (i->opcode()) {
+      case SpvOpDecorate:
+      case SpvOpMemberDecorate:
+      case SpvOpDecorateId:
+      case SpvOpDecorateStringGOOGLE:
         break;
-      }
+      default:
+        // Only the decorations above can ever be the same as another one.
+        i = i->NextNode();
+        continue;
     }
 
-    if (!already_visited) {
+    // Is the current decoration equal to one of the decorations we have aready
+    // visited?
+    if (visited_decorations.insert(i).second) {
       // This is a never seen before decoration, keep it around.
-      visited_decorations.emplace_back(&*i);
       i = i->NextNode();
     } else {
       // The same decoration has already been seen before, remove this one.
@@ -145,9 +145,10 @@ void ScalarReplacementPass::ReplaceWholeLoad(
     opt::Instruction* type = GetStorageType(var);
     uint32_t loadId = TakeNextId();
     std::unique_ptr<opt::Instruction> newLoad(
-        new opt::Instruction(context(), SpvOpLoad, type->result_id(), loadId,
-                             std::initializer_list<opt::Operand>{
-                                 {SPV_OPERAND_TYPE_ID, {var->result_id()}}}));
+        new (context()) opt::Instruction(
+            context(), SpvOpLoad, type->result_id(), loadId,
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_ID, {var->result_id()}}}));
     // Copy memory access attributes which start at index 1. Index 0 is the
     // pointer to load.
     for (uint32_t i = 1; i < load->NumInOperands(); ++i) {
@@ -163,8 +164,9 @@ void ScalarReplacementPass::ReplaceWholeLoad(
   // Construct a new composite.
   uint32_t compositeId = TakeNextId();
   where = load;
-  std::unique_ptr<opt::Instruction> compositeConstruct(new opt::Instruction(
-      context(), SpvOpCompositeConstruct, load->type_id(), compositeId, {}));
+  std::unique_ptr<opt::Instruction> compositeConstruct(
+      new (context()) opt::Instruction(context(), SpvOpCompositeConstruct,
+                                       load->type_id(), compositeId, {}));
   for (auto l : loads) {
     opt::Operand op(SPV_OPERAND_TYPE_ID,
                     std::initializer_list<uint32_t>{l->result_id()});
@@ -194,7 +196,7 @@ void ScalarReplacementPass::ReplaceWholeStore(
 
     opt::Instruction* type = GetStorageType(var);
     uint32_t extractId = TakeNextId();
-    std::unique_ptr<opt::Instruction> extract(new opt::Instruction(
+    std::unique_ptr<opt::Instruction> extract(new (context()) opt::Instruction(
         context(), SpvOpCompositeExtract, type->result_id(), extractId,
         std::initializer_list<opt::Operand>{
             {SPV_OPERAND_TYPE_ID, {storeInput}},
@@ -205,10 +207,11 @@ void ScalarReplacementPass::ReplaceWholeStore(
 
     // Create the store.
     std::unique_ptr<opt::Instruction> newStore(
-        new opt::Instruction(context(), SpvOpStore, 0, 0,
-                             std::initializer_list<opt::Operand>{
-                                 {SPV_OPERAND_TYPE_ID, {var->result_id()}},
-                                 {SPV_OPERAND_TYPE_ID, {extractId}}}));
+        new (context()) opt::Instruction(
+            context(), SpvOpStore, 0, 0,
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_ID, {var->result_id()}},
+                {SPV_OPERAND_TYPE_ID, {extractId}}}));
     // Copy memory access attributes which start at index 2. Index 0 is the
     // pointer and index 1 is the data.
     for (uint32_t i = 2; i < store->NumInOperands(); ++i) {
@@ -238,10 +241,11 @@ bool ScalarReplacementPass::ReplaceAccessChain(
       // Replace input access chain with another access chain.
       opt::BasicBlock::iterator chainIter(chain);
       uint32_t replacementId = TakeNextId();
-      std::unique_ptr<opt::Instruction> replacementChain(new opt::Instruction(
-          context(), chain->opcode(), chain->type_id(), replacementId,
-          std::initializer_list<opt::Operand>{
-              {SPV_OPERAND_TYPE_ID, {var->result_id()}}}));
+      std::unique_ptr<opt::Instruction> replacementChain(
+          new (context()) opt::Instruction(
+              context(), chain->opcode(), chain->type_id(), replacementId,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_ID, {var->result_id()}}}));
       // Add the remaining indexes.
       for (uint32_t i = 2; i < chain->NumInOperands(); ++i) {
         opt::Operand copy(chain->GetInOperand(i));
@@ -319,11 +323,12 @@ void ScalarReplacementPass::TransferAnnotations(
     if (decoration == SpvDecorationInvariant ||
         decoration == SpvDecorationRestrict) {
       for (auto var : *replacements) {
-        std::unique_ptr<opt::Instruction> annotation(new opt::Instruction(
-            context(), SpvOpDecorate, 0, 0,
-            std::initializer_list<opt::Operand>{
-                {SPV_OPERAND_TYPE_ID, {var->result_id()}},
-                {SPV_OPERAND_TYPE_DECORATION, {decoration}}}));
+        std::unique_ptr<opt::Instruction> annotation(
+            new (context()) opt::Instruction(
+                context(), SpvOpDecorate, 0, 0,
+                std::initializer_list<opt::Operand>{
+                    {SPV_OPERAND_TYPE_ID, {var->result_id()}},
+                    {SPV_OPERAND_TYPE_DECORATION, {decoration}}}));
         for (uint32_t i = 2; i < inst->NumInOperands(); ++i) {
           opt::Operand copy(inst->GetInOperand(i));
           annotation->AddOperand(std::move(copy));
@@ -340,7 +345,7 @@ void ScalarReplacementPass::CreateVariable(
     std::vector<opt::Instruction*>* replacements) {
   uint32_t ptrId = GetOrCreatePointerType(typeId);
   uint32_t id = TakeNextId();
-  std::unique_ptr<opt::Instruction> variable(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> variable(new (context()) opt::Instruction(
       context(), SpvOpVariable, ptrId, id,
       std::initializer_list<opt::Operand>{
           {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}}}));
@@ -394,11 +399,12 @@ uint32_t ScalarReplacementPass::GetOrCreatePointerType(uint32_t id) {
   }
 
   ptrId = TakeNextId();
-  context()->AddType(MakeUnique<opt::Instruction>(
-      context(), SpvOpTypePointer, 0, ptrId,
-      std::initializer_list<opt::Operand>{
-          {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}},
-          {SPV_OPERAND_TYPE_ID, {id}}}));
+  context()->AddType(
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), SpvOpTypePointer, 0, ptrId,
+          std::initializer_list<opt::Operand>{
+              {SPV_OPERAND_TYPE_STORAGE_CLASS, {SpvStorageClassFunction}},
+              {SPV_OPERAND_TYPE_ID, {id}}})));
   opt::Instruction* ptr = &*--context()->types_values_end();
   get_def_use_mgr()->AnalyzeInstDefUse(ptr);
   pointee_to_pointer_[id] = ptrId;
@@ -425,9 +431,10 @@ void ScalarReplacementPass::GetOrCreateInitialValue(opt::Instruction* source,
     if (iter == type_to_null_.end()) {
       newInitId = TakeNextId();
       type_to_null_[storageId] = newInitId;
-      context()->AddGlobalValue(MakeUnique<opt::Instruction>(
-          context(), SpvOpConstantNull, storageId, newInitId,
-          std::initializer_list<opt::Operand>{}));
+      context()->AddGlobalValue(
+          std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+              context(), SpvOpConstantNull, storageId, newInitId,
+              std::initializer_list<opt::Operand>{})));
       opt::Instruction* newNull = &*--context()->types_values_end();
       get_def_use_mgr()->AnalyzeInstDefUse(newNull);
     } else {
@@ -436,12 +443,14 @@ void ScalarReplacementPass::GetOrCreateInitialValue(opt::Instruction* source,
   } else if (opt::IsSpecConstantInst(init->opcode())) {
     // Create a new constant extract.
     newInitId = TakeNextId();
-    context()->AddGlobalValue(MakeUnique<opt::Instruction>(
-        context(), SpvOpSpecConstantOp, storageId, newInitId,
-        std::initializer_list<opt::Operand>{
-            {SPV_OPERAND_TYPE_SPEC_CONSTANT_OP_NUMBER, {SpvOpCompositeExtract}},
-            {SPV_OPERAND_TYPE_ID, {init->result_id()}},
-            {SPV_OPERAND_TYPE_LITERAL_INTEGER, {index}}}));
+    context()->AddGlobalValue(
+        std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+            context(), SpvOpSpecConstantOp, storageId, newInitId,
+            std::initializer_list<opt::Operand>{
+                {SPV_OPERAND_TYPE_SPEC_CONSTANT_OP_NUMBER,
+                 {SpvOpCompositeExtract}},
+                {SPV_OPERAND_TYPE_ID, {init->result_id()}},
+                {SPV_OPERAND_TYPE_LITERAL_INTEGER, {index}}})));
     opt::Instruction* newSpecConst = &*--context()->types_values_end();
     get_def_use_mgr()->AnalyzeInstDefUse(newSpecConst);
   } else if (init->opcode() == SpvOpConstantComposite) {
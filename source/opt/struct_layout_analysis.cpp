@@ -0,0 +1,59 @@
+// Copyright (c) 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "struct_layout_analysis.h"
+
+#include "ir_context.h"
+
+namespace spvtools {
+namespace opt {
+
+SpvOp StructLayoutAnalysis::GetOpcode(uint32_t id) const {
+  return context_->get_def_use_mgr()->GetDef(id)->opcode();
+}
+
+uint32_t StructLayoutAnalysis::NumInOperands(uint32_t id) const {
+  return context_->get_def_use_mgr()->GetDef(id)->NumInOperands();
+}
+
+uint32_t StructLayoutAnalysis::GetInOperand(uint32_t id,
+                                            uint32_t index) const {
+  return context_->get_def_use_mgr()->GetDef(id)->GetSingleWordInOperand(
+      index);
+}
+
+void StructLayoutAnalysis::ForEachDecoration(
+    uint32_t id,
+    const std::function<void(int member, SpvDecoration decoration,
+                             uint32_t value)>& f) const {
+  for (const opt::Instruction* inst :
+       context_->get_decoration_mgr()->GetDecorationsFor(id, false)) {
+    switch (inst->opcode()) {
+      case SpvOpDecorate:
+        f(kNoMember, SpvDecoration(inst->GetSingleWordInOperand(1)),
+          inst->NumInOperands() > 2 ? inst->GetSingleWordInOperand(2) : 0);
+        break;
+      case SpvOpMemberDecorate:
+        f(int(inst->GetSingleWordInOperand(1)),
+          SpvDecoration(inst->GetSingleWordInOperand(2)),
+          inst->NumInOperands() > 3 ? inst->GetSingleWordInOperand(3) : 0);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+}  // namespace opt
+}  // namespace spvtools
@@ -0,0 +1,96 @@
+// Copyright (c) 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_OPT_STRUCT_LAYOUT_ANALYSIS_H_
+#define LIBSPIRV_OPT_STRUCT_LAYOUT_ANALYSIS_H_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "struct_layout.h"
+
+namespace spvtools {
+namespace opt {
+
+class IRContext;
+
+// This class computes the explicit layout of the types in a module: the
+// member offsets of structs, and the base alignment and size of types under
+// the storage buffer or uniform buffer layout rules. It is the validator's
+// layout computation, run over the def-use and decoration managers of
+// |context|, and caches its results the same way.
+//
+// The cache is not updated as the module changes. A pass that changes struct
+// types or their layout decorations must invalidate this analysis. Decorations
+// applied through OpGroupMemberDecorate are not seen.
+class StructLayoutAnalysis : public LayoutTypeSource {
+ public:
+  explicit StructLayoutAnalysis(opt::IRContext* context)
+      : context_(context), cache_(this) {}
+
+  // Returns the Offset decoration of each member of the struct |struct_id|,
+  // or 0xffffffff for members without one.
+  const std::vector<uint32_t>& MemberOffsets(uint32_t struct_id) {
+    return cache_.MemberOffsets(struct_id);
+  }
+
+  // Returns the layout constraints of member |member| of the struct
+  // |struct_id|.
+  const LayoutConstraints& MemberConstraints(uint32_t struct_id,
+                                             uint32_t member) {
+    return cache_.MemberConstraints(struct_id, member);
+  }
+
+  // Returns the ArrayStride decoration of |array_id|, or 0 if it has none.
+  uint32_t ArrayStride(uint32_t array_id) const {
+    return cache_.ArrayStride(array_id);
+  }
+
+  // Returns the base alignment of the type |type_id|, under the uniform
+  // buffer rules if |round_up| is true and the storage buffer rules
+  // otherwise.
+  uint32_t BaseAlignment(
+      uint32_t type_id, bool round_up,
+      const LayoutConstraints& inherited = LayoutConstraints()) {
+    return cache_.BaseAlignment(type_id, round_up, inherited);
+  }
+
+  // Returns the size of the type |type_id|, not including padding at the end
+  // of a struct or array, under the uniform buffer rules if |round_up| is
+  // true and the storage buffer rules otherwise. Structs must have an Offset
+  // on their last member.
+  uint32_t Size(uint32_t type_id, bool round_up,
+                const LayoutConstraints& inherited = LayoutConstraints()) {
+    return cache_.Size(type_id, round_up, inherited);
+  }
+
+  // LayoutTypeSource interface.
+  SpvOp GetOpcode(uint32_t id) const override;
+  uint32_t NumInOperands(uint32_t id) const override;
+  uint32_t GetInOperand(uint32_t id, uint32_t index) const override;
+  void ForEachDecoration(
+      uint32_t id,
+      const std::function<void(int member, SpvDecoration decoration,
+                               uint32_t value)>& f) const override;
+
+ private:
+  opt::IRContext* context_;
+  StructLayoutCache cache_;
+};
+
+}  // namespace opt
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_OPT_STRUCT_LAYOUT_ANALYSIS_H_
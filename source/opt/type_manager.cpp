@@ -196,6 +196,12 @@ void TypeManager::RemoveId(uint32_t id) {
   id_to_type_.erase(iter);
 }
 
+void TypeManager::MapTypeToId(uint32_t id) {
+  auto iter = id_to_type_.find(id);
+  if (iter == id_to_type_.end()) return;
+  type_to_id_[iter->second] = id;
+}
+
 uint32_t TypeManager::GetTypeInstruction(const Type* type) {
   uint32_t id = GetId(type);
   if (id != 0) return id;
@@ -204,11 +210,11 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
   id = context()->TakeNextId();
   RegisterType(id, *type);
   switch (type->kind()) {
-#define DefineParameterlessCase(kind)                                 \
-  case Type::k##kind:                                                 \
-    typeInst.reset(                                                   \
-        new opt::Instruction(context(), SpvOpType##kind, 0, id,       \
-                             std::initializer_list<opt::Operand>{})); \
+#define DefineParameterlessCase(kind)                                   \
+  case Type::k##kind:                                                   \
+    typeInst.reset(new (context()) opt::Instruction(                    \
+        context(), SpvOpType##kind, 0, id,                              \
+        std::initializer_list<opt::Operand>{}));                        \
     break;
     DefineParameterlessCase(Void);
     DefineParameterlessCase(Bool);
@@ -221,7 +227,7 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
     DefineParameterlessCase(NamedBarrier);
 #undef DefineParameterlessCase
     case Type::kInteger:
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypeInt, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_LITERAL_INTEGER, {type->AsInteger()->width()}},
@@ -229,7 +235,7 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
                {(type->AsInteger()->IsSigned() ? 1u : 0u)}}}));
       break;
     case Type::kFloat:
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypeFloat, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_LITERAL_INTEGER, {type->AsFloat()->width()}}}));
@@ -237,27 +243,29 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
     case Type::kVector: {
       uint32_t subtype = GetTypeInstruction(type->AsVector()->element_type());
       typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeVector, 0, id,
-                               std::initializer_list<opt::Operand>{
-                                   {SPV_OPERAND_TYPE_ID, {subtype}},
-                                   {SPV_OPERAND_TYPE_LITERAL_INTEGER,
-                                    {type->AsVector()->element_count()}}}));
+          new (context()) opt::Instruction(
+              context(), SpvOpTypeVector, 0, id,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_ID, {subtype}},
+                  {SPV_OPERAND_TYPE_LITERAL_INTEGER,
+                   {type->AsVector()->element_count()}}}));
       break;
     }
     case Type::kMatrix: {
       uint32_t subtype = GetTypeInstruction(type->AsMatrix()->element_type());
       typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeMatrix, 0, id,
-                               std::initializer_list<opt::Operand>{
-                                   {SPV_OPERAND_TYPE_ID, {subtype}},
-                                   {SPV_OPERAND_TYPE_LITERAL_INTEGER,
-                                    {type->AsMatrix()->element_count()}}}));
+          new (context()) opt::Instruction(
+              context(), SpvOpTypeMatrix, 0, id,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_ID, {subtype}},
+                  {SPV_OPERAND_TYPE_LITERAL_INTEGER,
+                   {type->AsMatrix()->element_count()}}}));
       break;
     }
     case Type::kImage: {
       const Image* image = type->AsImage();
       uint32_t subtype = GetTypeInstruction(image->sampled_type());
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypeImage, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_ID, {subtype}},
@@ -279,14 +287,15 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
       uint32_t subtype =
           GetTypeInstruction(type->AsSampledImage()->image_type());
       typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeSampledImage, 0, id,
-                               std::initializer_list<opt::Operand>{
-                                   {SPV_OPERAND_TYPE_ID, {subtype}}}));
+          new (context()) opt::Instruction(
+              context(), SpvOpTypeSampledImage, 0, id,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_ID, {subtype}}}));
       break;
     }
     case Type::kArray: {
       uint32_t subtype = GetTypeInstruction(type->AsArray()->element_type());
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypeArray, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_ID, {subtype}},
@@ -297,9 +306,10 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
       uint32_t subtype =
           GetTypeInstruction(type->AsRuntimeArray()->element_type());
       typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeRuntimeArray, 0, id,
-                               std::initializer_list<opt::Operand>{
-                                   {SPV_OPERAND_TYPE_ID, {subtype}}}));
+          new (context()) opt::Instruction(
+              context(), SpvOpTypeRuntimeArray, 0, id,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_ID, {subtype}}}));
       break;
     }
     case Type::kStruct: {
@@ -309,8 +319,8 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
         ops.push_back(
             opt::Operand(SPV_OPERAND_TYPE_ID, {GetTypeInstruction(ty)}));
       }
-      typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeStruct, 0, id, ops));
+      typeInst.reset(new (context()) opt::Instruction(
+          context(), SpvOpTypeStruct, 0, id, ops));
       break;
     }
     case Type::kOpaque: {
@@ -321,15 +331,16 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
       char* dst = reinterpret_cast<char*>(words.data());
       strncpy(dst, opaque->name().c_str(), size);
       typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeOpaque, 0, id,
-                               std::initializer_list<opt::Operand>{
-                                   {SPV_OPERAND_TYPE_LITERAL_STRING, words}}));
+          new (context()) opt::Instruction(
+              context(), SpvOpTypeOpaque, 0, id,
+              std::initializer_list<opt::Operand>{
+                  {SPV_OPERAND_TYPE_LITERAL_STRING, words}}));
       break;
     }
     case Type::kPointer: {
       const Pointer* pointer = type->AsPointer();
       uint32_t subtype = GetTypeInstruction(pointer->pointee_type());
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypePointer, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_STORAGE_CLASS,
@@ -346,19 +357,19 @@ uint32_t TypeManager::GetTypeInstruction(const Type* type) {
         ops.push_back(
             opt::Operand(SPV_OPERAND_TYPE_ID, {GetTypeInstruction(ty)}));
       }
-      typeInst.reset(
-          new opt::Instruction(context(), SpvOpTypeFunction, 0, id, ops));
+      typeInst.reset(new (context()) opt::Instruction(
+          context(), SpvOpTypeFunction, 0, id, ops));
       break;
     }
     case Type::kPipe:
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypePipe, 0, id,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_ACCESS_QUALIFIER,
                {static_cast<uint32_t>(type->AsPipe()->access_qualifier())}}}));
       break;
     case Type::kForwardPointer:
-      typeInst.reset(new opt::Instruction(
+      typeInst.reset(new (context()) opt::Instruction(
           context(), SpvOpTypeForwardPointer, 0, 0,
           std::initializer_list<opt::Operand>{
               {SPV_OPERAND_TYPE_ID, {type->AsForwardPointer()->target_id()}},
@@ -400,7 +411,7 @@ uint32_t TypeManager::FindPointerToType(uint32_t type_id,
 
   // Must create the pointer type.
   uint32_t resultId = context()->TakeNextId();
-  std::unique_ptr<opt::Instruction> type_inst(new opt::Instruction(
+  std::unique_ptr<opt::Instruction> type_inst(new (context()) opt::Instruction(
       context(), SpvOpTypePointer, 0, resultId,
       {{spv_operand_type_t::SPV_OPERAND_TYPE_STORAGE_CLASS,
         {uint32_t(storage_class)}},
@@ -437,9 +448,10 @@ void TypeManager::CreateDecoration(uint32_t target,
     ops.push_back(
         opt::Operand(SPV_OPERAND_TYPE_LITERAL_INTEGER, {decoration[i]}));
   }
-  context()->AddAnnotationInst(MakeUnique<opt::Instruction>(
-      context(), (element == 0 ? SpvOpDecorate : SpvOpMemberDecorate), 0, 0,
-      ops));
+  context()->AddAnnotationInst(
+      std::unique_ptr<opt::Instruction>(new (context()) opt::Instruction(
+          context(), (element == 0 ? SpvOpDecorate : SpvOpMemberDecorate), 0,
+          0, ops)));
   opt::Instruction* inst = &*--context()->annotation_end();
   context()->get_def_use_mgr()->AnalyzeInstUse(inst);
 }
@@ -127,6 +127,14 @@ class TypeManager {
   // defining that type.
   void RemoveId(uint32_t id);
 
+  // Makes GetId() return |id| for the type of |id|. Does nothing if |id| is not
+  // a registered type.
+  //
+  // When several ids define the same type, GetId() returns the last one
+  // registered. Calling this before removing the others avoids the search
+  // RemoveId() does for another id defining that type.
+  void MapTypeToId(uint32_t id);
+
   // Returns the type of the member of |parent_type| that is identified by
   // |access_chain|.  The vector |access_chain| is a series of integers that are
   // used to pick members as in the |OpCompositeExtract| instructions.  If you
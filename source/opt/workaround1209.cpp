@@ -48,9 +48,10 @@ bool Workaround1209::RemoveOpUnreachableInLoops() {
           // Replace it with an unconditional branch to the loop merge.
           context()->KillInst(&*bb->tail());
           std::unique_ptr<opt::Instruction> new_branch(
-              new opt::Instruction(context(), SpvOpBranch, 0, 0,
-                                   {{spv_operand_type_t::SPV_OPERAND_TYPE_ID,
-                                     {loop_merges.top()}}}));
+              new (context()) opt::Instruction(
+                  context(), SpvOpBranch, 0, 0,
+                  {{spv_operand_type_t::SPV_OPERAND_TYPE_ID,
+                    {loop_merges.top()}}}));
           context()->AnalyzeDefUse(&*new_branch);
           bb->AddInstruction(std::move(new_branch));
           modified = true;
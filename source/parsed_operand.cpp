@@ -17,12 +17,53 @@
 #include "parsed_operand.h"
 
 #include <cassert>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
 #include "util/hex_float.h"
 
 namespace spvtools {
+namespace {
+
+// Emits |value| as writing it to a std::ostream would, but formats normal
+// numbers and zeros, by far the most common ones, without a stream.
+template <typename T>
+void EmitFloat(utils::TextBuffer* out, const utils::FloatProxy<T>& value) {
+  const T float_val = value.getAsFloat();
+  switch (std::fpclassify(float_val)) {
+    case FP_ZERO:
+    case FP_NORMAL:
+      out->AppendFloat(float_val, std::numeric_limits<T>::max_digits10);
+      break;
+    default: {
+      std::ostringstream stream;
+      stream << value;
+      out->Append(stream.str());
+    } break;
+  }
+}
+
+// Half precision floats are always emitted in hex float form.
+void EmitFloat(utils::TextBuffer* out,
+               const utils::FloatProxy<utils::Float16>& value) {
+  std::ostringstream stream;
+  stream << value;
+  out->Append(stream.str());
+}
+
+}  // anonymous namespace
 
 void EmitNumericLiteral(std::ostream* out, const spv_parsed_instruction_t& inst,
                         const spv_parsed_operand_t& operand) {
+  utils::TextBuffer buffer;
+  EmitNumericLiteral(&buffer, inst, operand);
+  *out << buffer.str();
+}
+
+void EmitNumericLiteral(utils::TextBuffer* out,
+                        const spv_parsed_instruction_t& inst,
+                        const spv_parsed_operand_t& operand) {
   assert(operand.type == SPV_OPERAND_TYPE_LITERAL_INTEGER ||
          operand.type == SPV_OPERAND_TYPE_TYPED_LITERAL_NUMBER);
   assert(1 <= operand.num_words);
@@ -32,18 +73,18 @@ void EmitNumericLiteral(std::ostream* out, const spv_parsed_instruction_t& inst,
   if (operand.num_words == 1) {
     switch (operand.number_kind) {
       case SPV_NUMBER_SIGNED_INT:
-        *out << int32_t(word);
+        out->AppendSigned(int32_t(word));
         break;
       case SPV_NUMBER_UNSIGNED_INT:
-        *out << word;
+        out->AppendUnsigned(word);
         break;
       case SPV_NUMBER_FLOATING:
         if (operand.number_bit_width == 16) {
-          *out << spvtools::utils::FloatProxy<spvtools::utils::Float16>(
-              uint16_t(word & 0xFFFF));
+          EmitFloat(out, spvtools::utils::FloatProxy<spvtools::utils::Float16>(
+                             uint16_t(word & 0xFFFF)));
         } else {
           // Assume 32-bit floats.
-          *out << spvtools::utils::FloatProxy<float>(word);
+          EmitFloat(out, spvtools::utils::FloatProxy<float>(word));
         }
         break;
       default:
@@ -55,14 +96,14 @@ void EmitNumericLiteral(std::ostream* out, const spv_parsed_instruction_t& inst,
         uint64_t(word) | (uint64_t(inst.words[operand.offset + 1]) << 32);
     switch (operand.number_kind) {
       case SPV_NUMBER_SIGNED_INT:
-        *out << int64_t(bits);
+        out->AppendSigned(int64_t(bits));
         break;
       case SPV_NUMBER_UNSIGNED_INT:
-        *out << bits;
+        out->AppendUnsigned(bits);
         break;
       case SPV_NUMBER_FLOATING:
         // Assume only 64-bit floats.
-        *out << spvtools::utils::FloatProxy<double>(bits);
+        EmitFloat(out, spvtools::utils::FloatProxy<double>(bits));
         break;
       default:
         assert(false && "Unreachable");
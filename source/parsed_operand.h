@@ -17,6 +17,7 @@
 
 #include <ostream>
 #include "spirv-tools/libspirv.h"
+#include "util/text_buffer.h"
 
 namespace spvtools {
 
@@ -26,6 +27,9 @@ namespace spvtools {
 // bits wide.
 void EmitNumericLiteral(std::ostream* out, const spv_parsed_instruction_t& inst,
                         const spv_parsed_operand_t& operand);
+void EmitNumericLiteral(utils::TextBuffer* out,
+                        const spv_parsed_instruction_t& inst,
+                        const spv_parsed_operand_t& operand);
 
 }  // namespace spvtools
 
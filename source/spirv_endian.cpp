@@ -31,14 +31,36 @@ static const union {
 
 #define I32_ENDIAN_HOST (o32_host_order.value)
 
+namespace {
+
+// Returns true if words in the given endianness have their bytes in the
+// opposite order from the host's.
+bool RequiresSwap(const spv_endianness_t endian) {
+  return (SPV_ENDIANNESS_LITTLE == endian &&
+          I32_ENDIAN_HOST == I32_ENDIAN_BIG) ||
+         (SPV_ENDIANNESS_BIG == endian && I32_ENDIAN_HOST == I32_ENDIAN_LITTLE);
+}
+
+uint32_t SwapBytes(const uint32_t word) {
+  return (word & 0x000000ff) << 24 | (word & 0x0000ff00) << 8 |
+         (word & 0x00ff0000) >> 8 | (word & 0xff000000) >> 24;
+}
+
+}  // anonymous namespace
+
 uint32_t spvFixWord(const uint32_t word, const spv_endianness_t endian) {
-  if ((SPV_ENDIANNESS_LITTLE == endian && I32_ENDIAN_HOST == I32_ENDIAN_BIG) ||
-      (SPV_ENDIANNESS_BIG == endian && I32_ENDIAN_HOST == I32_ENDIAN_LITTLE)) {
-    return (word & 0x000000ff) << 24 | (word & 0x0000ff00) << 8 |
-           (word & 0x00ff0000) >> 8 | (word & 0xff000000) >> 24;
-  }
+  return RequiresSwap(endian) ? SwapBytes(word) : word;
+}
 
-  return word;
+void spvFixWords(const uint32_t* words, size_t num_words,
+                 const spv_endianness_t endian, uint32_t* out) {
+  if (!RequiresSwap(endian)) {
+    if (out != words) memcpy(out, words, num_words * sizeof(uint32_t));
+    return;
+  }
+  // Keep the loop free of calls and branches, so that compilers turn it into
+  // vector byte shuffles.
+  for (size_t i = 0; i < num_words; ++i) out[i] = SwapBytes(words[i]);
 }
 
 uint64_t spvFixDoubleWord(const uint32_t low, const uint32_t high,
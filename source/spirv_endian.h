@@ -20,6 +20,12 @@
 // Converts a word in the specified endianness to the host native endianness.
 uint32_t spvFixWord(const uint32_t word, const spv_endianness_t endianness);
 
+// Converts |num_words| words in the specified endianness, starting at |words|,
+// to the host native endianness, and writes them to |out|. |out| may be the
+// same as |words|, but the ranges must not otherwise overlap.
+void spvFixWords(const uint32_t* words, size_t num_words,
+                 const spv_endianness_t endianness, uint32_t* out);
+
 // Converts a pair of words in the specified endianness to the host native
 // endianness.
 uint64_t spvFixDoubleWord(const uint32_t low, const uint32_t high,
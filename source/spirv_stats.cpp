@@ -185,7 +185,8 @@ class StatsAggregator {
   void ProcessExtension() {
     const Instruction& inst = GetCurrentInstruction();
     if (inst.opcode() != SpvOpExtension) return;
-    const std::string extension = GetExtensionString(&inst.c_inst());
+    const spv_parsed_instruction_t c_inst = inst.c_inst();
+    const std::string extension = GetExtensionString(&c_inst);
     ++stats_->extension_hist[extension];
   }
 
@@ -221,9 +222,9 @@ class StatsAggregator {
     const Instruction& inst = GetCurrentInstruction();
     if (inst.opcode() != SpvOpConstant) return;
     const uint32_t type_id = inst.GetOperandAs<uint32_t>(0);
-    const auto type_decl_it = vstate_->all_definitions().find(type_id);
-    assert(type_decl_it != vstate_->all_definitions().end());
-    const Instruction& type_decl_inst = *type_decl_it->second;
+    const Instruction* type_decl = vstate_->FindDef(type_id);
+    assert(type_decl);
+    const Instruction& type_decl_inst = *type_decl;
     const SpvOp type_op = type_decl_inst.opcode();
     if (type_op == SpvOpTypeInt) {
       const uint32_t bit_width = type_decl_inst.GetOperandAs<uint32_t>(1);
@@ -261,6 +262,10 @@ class StatsAggregator {
 
   SpirvStats* stats() { return stats_; }
 
+  // Returns the buffer to parse the module into. See
+  // ValidationState_t::converted_words.
+  uint32_t* converted_words() { return vstate_->converted_words(); }
+
  private:
   // Returns the current instruction (the one last processed by the validator).
   const Instruction& GetCurrentInstruction() const {
@@ -313,8 +318,9 @@ spv_result_t AggregateStats(const spv_context_t& context, const uint32_t* words,
 
   StatsAggregator stats_aggregator(stats, &context, words, num_words);
 
-  return spvBinaryParse(&context, &stats_aggregator, words, num_words,
-                        ProcessHeader, ProcessInstruction, pDiagnostic);
+  return spvBinaryParseInto(&context, &stats_aggregator, words, num_words,
+                            stats_aggregator.converted_words(), ProcessHeader,
+                            ProcessInstruction, pDiagnostic);
 }
 
 }  // namespace spvtools
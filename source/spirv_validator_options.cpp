@@ -91,3 +91,14 @@ void spvValidatorOptionsSetRelaxBlockLayout(spv_validator_options options,
                                             bool val) {
   options->relax_block_layout = val;
 }
+
+void spvValidatorOptionsSetNumThreads(spv_validator_options options,
+                                      uint32_t num_threads) {
+  options->num_threads = num_threads;
+}
+
+void spvValidatorOptionsSetCache(spv_validator_options options,
+                                 const char* directory, size_t max_size) {
+  options->cache_directory = directory ? directory : "";
+  options->cache_max_size = max_size;
+}
@@ -15,6 +15,9 @@
 #ifndef LIBSPIRV_SPIRV_VALIDATOR_OPTIONS_H_
 #define LIBSPIRV_SPIRV_VALIDATOR_OPTIONS_H_
 
+#include <cstddef>
+#include <string>
+
 #include "spirv-tools/libspirv.h"
 
 // Return true if the command line option for the validator limit is valid (Also
@@ -41,12 +44,22 @@ struct spv_validator_options_t {
       : universal_limits_(),
         relax_struct_store(false),
         relax_logical_pointer(false),
-        relax_block_layout(false) {}
+        relax_block_layout(false),
+        num_threads(1),
+        cache_directory(),
+        cache_max_size(64 << 20) {}
 
   validator_universal_limits_t universal_limits_;
   bool relax_struct_store;
   bool relax_logical_pointer;
   bool relax_block_layout;
+  uint32_t num_threads;
+  // The directory in which validation outcomes are cached, or empty if they
+  // are not. Any option which changes the outcome must be part of the key
+  // computed by ValidationCache::ComputeKey.
+  std::string cache_directory;
+  // The size the cache is kept within, in bytes.
+  size_t cache_max_size;
 };
 
 #endif  // LIBSPIRV_SPIRV_VALIDATOR_OPTIONS_H_
@@ -0,0 +1,217 @@
+// Copyright (c) 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "struct_layout.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "opcode.h"
+
+namespace spvtools {
+namespace {
+
+// Rounds x up to the next alignment. Assumes alignment is a power of two.
+uint32_t align(uint32_t x, uint32_t alignment) {
+  return (x + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+StructLayoutCache::StructLayout& StructLayoutCache::GetStructLayout(
+    uint32_t struct_id) {
+  auto iter = structs_.find(struct_id);
+  if (iter != structs_.end()) return iter->second;
+
+  StructLayout& layout = structs_[struct_id];
+  const uint32_t num_members = source_->NumInOperands(struct_id);
+  layout.member_offsets.assign(num_members, 0xffffffff);
+  layout.member_constraints.assign(num_members, LayoutConstraints());
+  source_->ForEachDecoration(
+      struct_id, [&layout, num_members](int member, SpvDecoration decoration,
+                                        uint32_t value) {
+        if (member < 0 || uint32_t(member) >= num_members) return;
+        LayoutConstraints& constraint = layout.member_constraints[member];
+        switch (decoration) {
+          case SpvDecorationOffset:
+            layout.member_offsets[member] = value;
+            break;
+          case SpvDecorationRowMajor:
+            constraint.majorness = kRowMajor;
+            break;
+          case SpvDecorationColMajor:
+            constraint.majorness = kColumnMajor;
+            break;
+          case SpvDecorationMatrixStride:
+            constraint.matrix_stride = value;
+            break;
+          default:
+            break;
+        }
+      });
+  return layout;
+}
+
+const std::vector<uint32_t>& StructLayoutCache::MemberOffsets(
+    uint32_t struct_id) {
+  return GetStructLayout(struct_id).member_offsets;
+}
+
+const LayoutConstraints& StructLayoutCache::MemberConstraints(
+    uint32_t struct_id, uint32_t member) {
+  return GetStructLayout(struct_id).member_constraints[member];
+}
+
+uint32_t StructLayoutCache::ArrayStride(uint32_t array_id) const {
+  uint32_t stride = 0;
+  source_->ForEachDecoration(
+      array_id, [&stride](int member, SpvDecoration decoration,
+                          uint32_t value) {
+        if (member == LayoutTypeSource::kNoMember &&
+            decoration == SpvDecorationArrayStride && stride == 0) {
+          stride = value;
+        }
+      });
+  return stride;
+}
+
+uint32_t StructLayoutCache::BaseAlignment(uint32_t type_id, bool round_up,
+                                          const LayoutConstraints& inherited) {
+  uint32_t base_alignment = 0;
+  switch (source_->GetOpcode(type_id)) {
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:
+      base_alignment = source_->GetInOperand(type_id, 0) / 8;
+      break;
+    case SpvOpTypeVector: {
+      const auto component_id = source_->GetInOperand(type_id, 0);
+      const auto num_components = source_->GetInOperand(type_id, 1);
+      const auto component_alignment =
+          BaseAlignment(component_id, round_up, inherited);
+      base_alignment =
+          component_alignment * (num_components == 3 ? 4 : num_components);
+      break;
+    }
+    case SpvOpTypeMatrix: {
+      const auto column_type = source_->GetInOperand(type_id, 0);
+      if (inherited.majorness == kColumnMajor) {
+        base_alignment = BaseAlignment(column_type, round_up, inherited);
+      } else {
+        // A row-major matrix of C columns has a base alignment equal to the
+        // base alignment of a vector of C matrix components.
+        const auto num_columns = source_->GetInOperand(type_id, 1);
+        const auto component_id = source_->GetInOperand(column_type, 0);
+        const auto component_alignment =
+            BaseAlignment(component_id, round_up, inherited);
+        base_alignment =
+            component_alignment * (num_columns == 3 ? 4 : num_columns);
+      }
+      break;
+    }
+    case SpvOpTypeArray:
+    case SpvOpTypeRuntimeArray:
+      base_alignment = BaseAlignment(source_->GetInOperand(type_id, 0),
+                                     round_up, inherited);
+      if (round_up) base_alignment = align(base_alignment, 16u);
+      break;
+    case SpvOpTypeStruct: {
+      auto& cached = GetStructLayout(type_id).rules[round_up];
+      if (cached.has_alignment) return cached.alignment;
+      for (uint32_t member_idx = 0,
+                    num_members = source_->NumInOperands(type_id);
+           member_idx < num_members; ++member_idx) {
+        base_alignment = std::max(
+            base_alignment,
+            BaseAlignment(source_->GetInOperand(type_id, member_idx),
+                          round_up, MemberConstraints(type_id, member_idx)));
+      }
+      if (round_up) base_alignment = align(base_alignment, 16u);
+      cached.has_alignment = true;
+      cached.alignment = base_alignment;
+      break;
+    }
+    default:
+      assert(0);
+      break;
+  }
+
+  return base_alignment;
+}
+
+uint32_t StructLayoutCache::Size(uint32_t type_id, bool round_up,
+                                 const LayoutConstraints& inherited) {
+  switch (source_->GetOpcode(type_id)) {
+    case SpvOpTypeInt:
+    case SpvOpTypeFloat:
+      return BaseAlignment(type_id, round_up, inherited);
+    case SpvOpTypeVector: {
+      const auto component_id = source_->GetInOperand(type_id, 0);
+      const auto num_components = source_->GetInOperand(type_id, 1);
+      return Size(component_id, round_up, inherited) * num_components;
+    }
+    case SpvOpTypeArray: {
+      const auto length_id = source_->GetInOperand(type_id, 1);
+      const auto length_opcode = source_->GetOpcode(length_id);
+      if (spvOpcodeIsSpecConstant(length_opcode)) return 0;
+      assert(SpvOpConstant == length_opcode);
+      const uint32_t num_elem = source_->GetInOperand(length_id, 0);
+      const uint32_t elem_size =
+          Size(source_->GetInOperand(type_id, 0), round_up, inherited);
+      // Account for gaps due to alignments in the first N-1 elements,
+      // then add the size of the last element.
+      return (num_elem - 1) * ArrayStride(type_id) + elem_size;
+    }
+    case SpvOpTypeRuntimeArray:
+      return 0;
+    case SpvOpTypeMatrix: {
+      const auto num_columns = source_->GetInOperand(type_id, 1);
+      if (inherited.majorness == kColumnMajor) {
+        return num_columns * inherited.matrix_stride;
+      } else {
+        // Row major case.
+        const auto column_type = source_->GetInOperand(type_id, 0);
+        const auto num_rows = source_->GetInOperand(column_type, 1);
+        const auto scalar_elem_type = source_->GetInOperand(column_type, 0);
+        const uint32_t scalar_elem_size =
+            Size(scalar_elem_type, round_up, inherited);
+        return (num_rows - 1) * inherited.matrix_stride +
+               num_columns * scalar_elem_size;
+      }
+    }
+    case SpvOpTypeStruct: {
+      auto& cached = GetStructLayout(type_id).rules[round_up];
+      if (cached.has_size) return cached.size;
+      const uint32_t num_members = source_->NumInOperands(type_id);
+      uint32_t size = 0;
+      if (num_members > 0) {
+        const uint32_t last_idx = num_members - 1;
+        // Find the offset of the last element and add the size.
+        const uint32_t offset = MemberOffsets(type_id)[last_idx];
+        // This depends on the caller having checked that all members have
+        // offsets.
+        assert(offset != 0xffffffff);
+        size = offset + Size(source_->GetInOperand(type_id, last_idx),
+                             round_up, MemberConstraints(type_id, last_idx));
+      }
+      cached.has_size = true;
+      cached.size = size;
+      return size;
+    }
+    default:
+      assert(0);
+      return 0;
+  }
+}
+
+}  // namespace spvtools
@@ -0,0 +1,137 @@
+// Copyright (c) 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_STRUCT_LAYOUT_H_
+#define LIBSPIRV_STRUCT_LAYOUT_H_
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "latest_version_spirv_header.h"
+
+namespace spvtools {
+
+// Distinguish between row and column major matrix layouts.
+enum MatrixLayout { kRowMajor, kColumnMajor };
+
+// Struct member layout attributes that are inherited through arrays.
+struct LayoutConstraints {
+  explicit LayoutConstraints(
+      MatrixLayout the_majorness = MatrixLayout::kColumnMajor,
+      uint32_t stride = 0)
+      : majorness(the_majorness), matrix_stride(stride) {}
+  MatrixLayout majorness;
+  uint32_t matrix_stride;
+};
+
+// The view of a module that StructLayoutCache needs. The validator and the
+// optimizer each implement it over their own representation of the module.
+class LayoutTypeSource {
+ public:
+  // The member index passed to ForEachDecoration() callbacks for decorations
+  // of the id itself.
+  static const int kNoMember = -1;
+
+  virtual ~LayoutTypeSource() = default;
+
+  // Returns the opcode of the instruction defining |id|.
+  virtual SpvOp GetOpcode(uint32_t id) const = 0;
+
+  // Returns the number of operands of the instruction defining |id|, not
+  // counting its result type and result id.
+  virtual uint32_t NumInOperands(uint32_t id) const = 0;
+
+  // Returns the operand |index| of the instruction defining |id|, not counting
+  // its result type and result id. The operand must be a single word.
+  virtual uint32_t GetInOperand(uint32_t id, uint32_t index) const = 0;
+
+  // Calls |f| for each decoration of |id| and of its members, with the member
+  // index or kNoMember, the decoration, and its first literal or 0.
+  virtual void ForEachDecoration(
+      uint32_t id,
+      const std::function<void(int member, SpvDecoration decoration,
+                               uint32_t value)>& f) const = 0;
+};
+
+// Computes the base alignment and size of types laid out with explicit
+// Offset, ArrayStride and MatrixStride decorations, under the Vulkan
+// standard storage buffer rules or, when |round_up| is true, the standard
+// uniform buffer rules, which round the alignment of arrays and structs up
+// to 16 bytes.
+//
+// The member offsets and constraints of each struct, and its alignment and
+// size under each set of rules, are computed once and cached. The cache is
+// not updated when the module changes, so a StructLayoutCache must not
+// outlive the types and decorations it has seen. Not thread safe.
+class StructLayoutCache {
+ public:
+  explicit StructLayoutCache(const LayoutTypeSource* source)
+      : source_(source) {}
+
+  // Returns the Offset decoration of each member of the struct |struct_id|,
+  // or 0xffffffff for members without one.
+  const std::vector<uint32_t>& MemberOffsets(uint32_t struct_id);
+
+  // Returns the layout constraints of member |member| of the struct
+  // |struct_id|, as given by its RowMajor, ColMajor and MatrixStride
+  // decorations.
+  const LayoutConstraints& MemberConstraints(uint32_t struct_id,
+                                             uint32_t member);
+
+  // Returns the ArrayStride decoration of |array_id|, or 0 if it has none.
+  uint32_t ArrayStride(uint32_t array_id) const;
+
+  // Returns the base alignment of the type |type_id|. Matrices are laid out
+  // according to |inherited|.
+  uint32_t BaseAlignment(uint32_t type_id, bool round_up,
+                         const LayoutConstraints& inherited);
+
+  // Returns the size of the type |type_id|, not including padding at the end
+  // of a struct or array. Matrices are laid out according to |inherited|.
+  // Structs must have an Offset on their last member. Arrays sized by a
+  // specialization constant, and runtime arrays, have size 0.
+  uint32_t Size(uint32_t type_id, bool round_up,
+                const LayoutConstraints& inherited);
+
+ private:
+  // The layout of a struct type under one set of layout rules.
+  struct RulesLayout {
+    bool has_alignment = false;
+    uint32_t alignment = 0;
+    bool has_size = false;
+    uint32_t size = 0;
+  };
+
+  // The layout of a struct type.
+  struct StructLayout {
+    std::vector<uint32_t> member_offsets;
+    std::vector<LayoutConstraints> member_constraints;
+    // The layout under storage buffer rules ([0]) and under uniform buffer
+    // rules ([1]).
+    RulesLayout rules[2];
+  };
+
+  // Returns the cached layout of |struct_id|, reading the member decorations
+  // on first use.
+  StructLayout& GetStructLayout(uint32_t struct_id);
+
+  const LayoutTypeSource* source_;
+  std::unordered_map<uint32_t, StructLayout> structs_;
+};
+
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_STRUCT_LAYOUT_H_
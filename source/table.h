@@ -67,6 +67,9 @@ typedef struct spv_operand_desc_group_t {
   const spv_operand_type_t type;
   const uint32_t count;
   const spv_operand_desc_t* entries;
+  // Indices into |entries|, ordered by entry name. Entries with the same name
+  // appear in the same relative order as in |entries|.
+  const uint16_t* nameIndex;
 } spv_operand_desc_group_t;
 
 typedef struct spv_ext_inst_desc_t {
@@ -86,6 +89,9 @@ typedef struct spv_ext_inst_group_t {
 typedef struct spv_opcode_table_t {
   const uint32_t count;
   const spv_opcode_desc_t* entries;
+  // Indices into |entries|, ordered by entry name. Entries with the same name
+  // appear in the same relative order as in |entries|.
+  const uint16_t* nameIndex;
 } spv_opcode_table_t;
 
 typedef struct spv_operand_table_t {
@@ -20,10 +20,12 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "assembly_grammar.h"
@@ -40,6 +42,7 @@
 #include "table.h"
 #include "text_handler.h"
 #include "util/bitutils.h"
+#include "util/parallel.h"
 #include "util/parse_number.h"
 
 bool spvIsValidIDCharacter(const char value) {
@@ -696,48 +699,195 @@ spv_result_t GetNumericIds(const spvtools::AssemblyGrammar& grammar,
   return SPV_SUCCESS;
 }
 
-// Translates a given assembly language module into binary form.
+// Encodes the instructions in the text of |context|, from its current position
+// on, and appends them to |instructions|.
+spv_result_t EncodeInstructions(const spvtools::AssemblyGrammar& grammar,
+                                spvtools::AssemblyContext* context,
+                                std::vector<spv_instruction_t>* instructions) {
+  // Skip past whitespace and comments.
+  context->advance();
+
+  while (context->hasText()) {
+    instructions->push_back({});
+    spv_instruction_t& inst = instructions->back();
+
+    if (spvTextEncodeOpcode(grammar, context, &inst)) {
+      return SPV_ERROR_INVALID_TEXT;
+    }
+
+    if (context->advance()) break;
+  }
+  return SPV_SUCCESS;
+}
+
+// Assigns ids to the names in the text of |context| in the order in which
+// encoding the text would, and writes the position of each OpFunction
+// instruction to |function_starts|. Returns false if this cannot be done
+// without encoding the text: when the text is invalid, or when it has
+// immediate words, which can change how the words after them are read.
+bool AssignIds(const spvtools::AssemblyGrammar& grammar,
+               spvtools::AssemblyContext* context,
+               std::vector<spv_position_t>* function_starts) {
+  // The name of the result id of the current instruction, while it waits for
+  // the type id of the instruction to be assigned first.
+  std::string result_id;
+  std::string word;
+  spv_position_t next_position = {};
+
+  if (context->advance()) return true;
+  if (!context->isStartOfNewInst()) return false;
+  while (true) {
+    if ('!' == context->peek()) return false;
+    if (context->isStartOfNewInst()) {
+      // A type id is required before the result id.
+      if (!result_id.empty()) return false;
+
+      const spv_position_t start = context->position();
+      if (context->getWord(&word, &next_position)) return false;
+      if ('%' == word.front()) {
+        result_id = word.substr(1);
+        // Skip the '=' sign; isStartOfNewInst() has checked it.
+        for (int i = 0; i < 2; ++i) {
+          context->setPosition(next_position);
+          if (context->advance()) return false;
+          if (context->getWord(&word, &next_position)) return false;
+        }
+      }
+
+      // NOTE: The table contains Opcode names without the "Op" prefix.
+      spv_opcode_desc opcode_entry;
+      if (grammar.lookupOpcode(word.c_str() + 2, &opcode_entry))
+        return false;
+      if (opcode_entry->opcode == SpvOpFunction)
+        function_starts->push_back(start);
+      // The result id is encoded where the grammar has it, which is after the
+      // type id, if there is one.
+      if (!opcode_entry->hasResult) {
+        result_id.clear();
+      } else if (!result_id.empty() && !opcode_entry->hasType) {
+        context->spvNamedIdAssignOrGet(result_id.c_str());
+        result_id.clear();
+      }
+    } else {
+      if (context->getWord(&word, &next_position)) return false;
+      if (!word.empty() && '%' == word.front()) {
+        context->spvNamedIdAssignOrGet(word.c_str() + 1);
+        if (!result_id.empty()) {
+          context->spvNamedIdAssignOrGet(result_id.c_str());
+          result_id.clear();
+        }
+      }
+    }
+    context->setPosition(next_position);
+    if (context->advance()) break;
+  }
+  return result_id.empty();
+}
+
+// Encodes the instructions of |text| like EncodeInstructions does, and writes
+// the id bound to |bound|, but encodes function bodies on up to |num_threads|
+// threads. Ids are first assigned to all names by AssignIds, so that the
+// result is the same. Returns false, without emitting diagnostics, if the text
+// has to be encoded serially instead: when it has errors, or when a function
+// body might be encoded differently without the function bodies before it.
+bool EncodeFunctionsInParallel(const spvtools::AssemblyGrammar& grammar,
+                               const spv_text text, uint32_t num_threads,
+                               std::vector<spv_instruction_t>* instructions,
+                               uint32_t* bound) {
+  if (!text->str) return false;
+
+  // The globals context sees the whole text while assigning ids, and then only
+  // the text before the first function.
+  spv_text_t globals_text = *text;
+  spvtools::AssemblyContext globals(&globals_text, spvtools::MessageConsumer());
+  std::vector<spv_position_t> function_starts;
+  if (!AssignIds(grammar, &globals, &function_starts)) return false;
+  if (function_starts.empty()) return false;
+
+  globals_text.length = function_starts[0].index;
+  globals.setPosition({});
+  if (EncodeInstructions(grammar, &globals, instructions)) return false;
+
+  const size_t num_functions = function_starts.size();
+  std::vector<spv_text_t> function_texts(num_functions);
+  std::vector<std::unique_ptr<spvtools::AssemblyContext>> contexts(
+      num_functions);
+  std::vector<std::vector<spv_instruction_t>> functions(num_functions);
+  std::unique_ptr<bool[]> encoded(new bool[num_functions]);
+  spvtools::utils::ParallelFor(
+      num_threads, num_functions, [&](const size_t i) {
+        function_texts[i] = {text->str, i + 1 < num_functions
+                                            ? function_starts[i + 1].index
+                                            : text->length};
+        contexts[i].reset(new spvtools::AssemblyContext(
+            &function_texts[i], spvtools::MessageConsumer(), &globals));
+        contexts[i]->setPosition(function_starts[i]);
+        encoded[i] =
+            EncodeInstructions(grammar, contexts[i].get(), &functions[i]) ==
+                SPV_SUCCESS &&
+            !contexts[i]->isOrderDependent();
+      });
+
+  // A value defined in two function bodies is an error.
+  std::unordered_set<uint32_t> values;
+  for (size_t i = 0; i < num_functions; ++i) {
+    if (!encoded[i] || !contexts[i]->collectValues(&values)) return false;
+  }
+
+  for (auto& function : functions) {
+    std::move(function.begin(), function.end(),
+              std::back_inserter(*instructions));
+  }
+  *bound = globals.getBound();
+  return true;
+}
+
+// Translates a given assembly language module into binary form, encoding
+// function bodies on up to |num_threads| threads.
 // If a diagnostic is generated, it is not yet marked as being
 // for a text-based input.
 spv_result_t spvTextToBinaryInternal(const spvtools::AssemblyGrammar& grammar,
                                      const spvtools::MessageConsumer& consumer,
                                      const spv_text text,
                                      const uint32_t options,
+                                     const uint32_t num_threads,
                                      spv_binary* pBinary) {
-  // The ids in this set will have the same values both in source and binary.
-  // All other ids will be generated by filling in the gaps.
-  std::set<uint32_t> ids_to_preserve;
-
-  if (options & SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS) {
-    // Collect all numeric ids from the source into ids_to_preserve.
-    const spv_result_t result =
-        GetNumericIds(grammar, consumer, text, &ids_to_preserve);
-    if (result != SPV_SUCCESS) return result;
-  }
-
-  spvtools::AssemblyContext context(text, consumer, std::move(ids_to_preserve));
-
-  if (!text->str) return context.diagnostic() << "Missing assembly text.";
-
-  if (!grammar.isValid()) {
-    return SPV_ERROR_INVALID_TABLE;
-  }
-  if (!pBinary) return SPV_ERROR_INVALID_POINTER;
-
   std::vector<spv_instruction_t> instructions;
+  uint32_t bound = 0;
+
+  // Numeric ids are preserved by a dry run of the whole text, which gains
+  // nothing from encoding functions in parallel.
+  if (num_threads <= 1 ||
+      (options & SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS) ||
+      !grammar.isValid() || !pBinary ||
+      !EncodeFunctionsInParallel(grammar, text, num_threads, &instructions,
+                                 &bound)) {
+    instructions.clear();
+
+    // The ids in this set will have the same values both in source and
+    // binary. All other ids will be generated by filling in the gaps.
+    std::set<uint32_t> ids_to_preserve;
+
+    if (options & SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS) {
+      // Collect all numeric ids from the source into ids_to_preserve.
+      const spv_result_t result =
+          GetNumericIds(grammar, consumer, text, &ids_to_preserve);
+      if (result != SPV_SUCCESS) return result;
+    }
 
-  // Skip past whitespace and comments.
-  context.advance();
+    spvtools::AssemblyContext context(text, consumer,
+                                      std::move(ids_to_preserve));
 
-  while (context.hasText()) {
-    instructions.push_back({});
-    spv_instruction_t& inst = instructions.back();
+    if (!text->str) return context.diagnostic() << "Missing assembly text.";
 
-    if (spvTextEncodeOpcode(grammar, &context, &inst)) {
-      return SPV_ERROR_INVALID_TEXT;
+    if (!grammar.isValid()) {
+      return SPV_ERROR_INVALID_TABLE;
     }
+    if (!pBinary) return SPV_ERROR_INVALID_POINTER;
 
-    if (context.advance()) break;
+    if (auto error = EncodeInstructions(grammar, &context, &instructions))
+      return error;
+    bound = context.getBound();
   }
 
   size_t totalSize = SPV_INDEX_INSTRUCTION;
@@ -754,7 +904,7 @@ spv_result_t spvTextToBinaryInternal(const spvtools::AssemblyGrammar& grammar,
     currentIndex += inst.words.size();
   }
 
-  if (auto error = SetHeader(grammar.target_env(), context.getBound(), data))
+  if (auto error = SetHeader(grammar.target_env(), bound, data))
     return error;
 
   spv_binary binary = new spv_binary_t();
@@ -787,6 +937,17 @@ spv_result_t spvTextToBinaryWithOptions(const spv_const_context context,
                                         const uint32_t options,
                                         spv_binary* pBinary,
                                         spv_diagnostic* pDiagnostic) {
+  return spvTextToBinaryWithThreads(context, input_text, input_text_size,
+                                    options, 1, pBinary, pDiagnostic);
+}
+
+spv_result_t spvTextToBinaryWithThreads(const spv_const_context context,
+                                        const char* input_text,
+                                        const size_t input_text_size,
+                                        const uint32_t options,
+                                        const uint32_t num_threads,
+                                        spv_binary* pBinary,
+                                        spv_diagnostic* pDiagnostic) {
   spv_context_t hijack_context = *context;
   if (pDiagnostic) {
     *pDiagnostic = nullptr;
@@ -797,7 +958,7 @@ spv_result_t spvTextToBinaryWithOptions(const spv_const_context context,
   spvtools::AssemblyGrammar grammar(&hijack_context);
 
   spv_result_t result = spvTextToBinaryInternal(
-      grammar, hijack_context.consumer, &text, options, pBinary);
+      grammar, hijack_context.consumer, &text, options, num_threads, pBinary);
   if (pDiagnostic && *pDiagnostic) (*pDiagnostic)->isTextSource = true;
 
   return result;
@@ -808,3 +969,208 @@ void spvTextDestroy(spv_text text) {
   delete[] text->str;
   delete text;
 }
+
+namespace spvtools {
+namespace {
+
+// The answer to whether some text starts with an instruction.
+enum class StartsInstruction { kYes, kNo, kNeedMoreText };
+
+// Returns whether the line starting at |index| in |text| starts with an
+// instruction, that is with "Op<Name>" or with "%<name> = Op<Name>", as
+// AssemblyContext::isStartOfNewInst() would see it. The result might depend on
+// text which has not been seen yet.
+StartsInstruction LineStartsInstruction(const std::string& text,
+                                        size_t index) {
+  const size_t size = text.size();
+  auto skip_blanks = [&text, size](size_t i, bool skip_newlines) {
+    while (i < size && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' ||
+                        (skip_newlines && text[i] == '\n')))
+      ++i;
+    return i;
+  };
+  auto starts_with_op = [&text, size](size_t i) {
+    if (i + 3 > size) return StartsInstruction::kNeedMoreText;
+    return text[i] == 'O' && text[i + 1] == 'p' && 'A' <= text[i + 2] &&
+                   text[i + 2] <= 'Z'
+               ? StartsInstruction::kYes
+               : StartsInstruction::kNo;
+  };
+
+  size_t i = skip_blanks(index, false);
+  if (i == size) return StartsInstruction::kNeedMoreText;
+  if (text[i] != '%') return starts_with_op(i);
+
+  // Skip the result id. It is not quoted, since that would be invalid.
+  while (i < size && !strchr(" \t\r\n;", text[i])) ++i;
+  i = skip_blanks(i, true);
+  if (i == size) return StartsInstruction::kNeedMoreText;
+  if (text[i] != '=') return StartsInstruction::kNo;
+  i = skip_blanks(i + 1, true);
+  if (i == size) return StartsInstruction::kNeedMoreText;
+  return starts_with_op(i);
+}
+
+}  // anonymous namespace
+
+struct IncrementalAssembler::Impl {
+  Impl(spv_target_env env, WordConsumer consumer)
+      : context(spvContextCreate(env)), words_consumer(std::move(consumer)) {}
+  ~Impl() { spvContextDestroy(context); }
+
+  // Scans the pending text from |scanned| on, for lines which start an
+  // instruction, and moves |cut| to the last one found.
+  void Scan();
+
+  // Assembles the first |size| characters of the pending text, which end at
+  // the start of an instruction, or at the end of the module. Hands out the
+  // header first if this is the first call. Returns false on failure.
+  bool Assemble(size_t size);
+
+  spv_context context;  // C interface context object.
+  WordConsumer words_consumer;
+  // Created by the first call to Assemble().
+  std::unique_ptr<AssemblyGrammar> grammar;
+  std::unique_ptr<AssemblyContext> assembly;
+  // The part of |pending| being assembled, as seen by |assembly|.
+  spv_text_t text = {nullptr, 0};
+  // The text which has been written, but not assembled yet.
+  std::string pending;
+  // The line at which |pending| starts in the whole text.
+  size_t pending_line = 0;
+  // The binary of the instructions being assembled.
+  std::vector<uint32_t> words;
+  // True if an error occurred, or if Finish() was called.
+  bool done = false;
+
+  // The state of the scan of |pending| for the starts of instructions.
+  size_t scanned = 0;  // The number of characters scanned.
+  size_t cut = 0;      // The last line found to start an instruction.
+  bool at_line_start = true;
+  bool in_comment = false;
+  bool quoting = false;
+  bool escaping = false;
+  char last_char = '\0';  // The last character which is not a blank.
+};
+
+void IncrementalAssembler::Impl::Scan() {
+  while (scanned < pending.size()) {
+    if (at_line_start) {
+      // A line starting with the opcode of "%<name> =" continues the
+      // instruction started on the previous line.
+      if (last_char != '=') {
+        const StartsInstruction starts =
+            LineStartsInstruction(pending, scanned);
+        if (starts == StartsInstruction::kNeedMoreText) return;
+        if (starts == StartsInstruction::kYes) cut = scanned;
+      }
+      at_line_start = false;
+    }
+
+    const char ch = pending[scanned++];
+    if (in_comment) {
+      if (ch == '\n') {
+        in_comment = false;
+        at_line_start = true;
+      }
+      continue;
+    }
+    if (escaping) {
+      escaping = false;
+      last_char = ch;
+      continue;
+    }
+    switch (ch) {
+      case '\\':
+        escaping = true;
+        break;
+      case '"':
+        quoting = !quoting;
+        break;
+      case ';':
+        if (!quoting) in_comment = true;
+        break;
+      case '\n':
+        if (!quoting) at_line_start = true;
+        break;
+      default:
+        break;
+    }
+    if (!in_comment && !strchr(" \t\r\n", ch)) last_char = ch;
+  }
+}
+
+bool IncrementalAssembler::Impl::Assemble(size_t size) {
+  if (!assembly) {
+    grammar.reset(new AssemblyGrammar(context));
+    if (!grammar->isValid()) return false;
+    // Forward messages, so that the consumer can be changed at any time.
+    spv_context ctx = context;
+    assembly.reset(new AssemblyContext(
+        &text, [ctx](spv_message_level_t level, const char* source,
+                     const spv_position_t& position, const char* message) {
+          if (ctx->consumer) ctx->consumer(level, source, position, message);
+        }));
+    uint32_t header[SPV_INDEX_INSTRUCTION];
+    SetHeader(grammar->target_env(), 0, header);
+    words_consumer(header, SPV_INDEX_INSTRUCTION);
+  }
+
+  text.str = pending.data();
+  text.length = size;
+  assembly->setPosition({pending_line, 0, 0});
+
+  words.clear();
+  // Skip past whitespace and comments.
+  assembly->advance();
+  while (assembly->hasText()) {
+    spv_instruction_t inst;
+    if (spvTextEncodeOpcode(*grammar, assembly.get(), &inst)) return false;
+    words.insert(words.end(), inst.words.begin(), inst.words.end());
+    if (assembly->advance()) break;
+  }
+  // The text ends at the start of a line, or at the end of the module.
+  pending_line = assembly->position().line;
+
+  if (!words.empty()) words_consumer(words.data(), words.size());
+  return true;
+}
+
+IncrementalAssembler::IncrementalAssembler(spv_target_env env,
+                                           WordConsumer consumer)
+    : impl_(new Impl(env, std::move(consumer))) {}
+
+IncrementalAssembler::~IncrementalAssembler() {}
+
+void IncrementalAssembler::SetMessageConsumer(MessageConsumer consumer) {
+  SetContextMessageConsumer(impl_->context, std::move(consumer));
+}
+
+bool IncrementalAssembler::Write(const char* text, size_t text_size) {
+  Impl& impl = *impl_;
+  if (impl.done) return false;
+  impl.pending.append(text, text_size);
+  impl.Scan();
+  if (impl.cut == 0) return true;
+
+  if (!impl.Assemble(impl.cut)) {
+    impl.done = true;
+    return false;
+  }
+  impl.pending.erase(0, impl.cut);
+  impl.scanned -= impl.cut;
+  impl.cut = 0;
+  return true;
+}
+
+bool IncrementalAssembler::Finish(uint32_t* bound) {
+  Impl& impl = *impl_;
+  if (impl.done) return false;
+  impl.done = true;
+  if (!impl.Assemble(impl.pending.size())) return false;
+  impl.pending.clear();
+  *bound = impl.assembly->getBound();
+  return true;
+}
+
+}  // namespace spvtools
@@ -155,6 +155,15 @@ const IdType kUnknownType = {0, false, IdTypeClass::kBottom};
 // This represents all of the data that is only valid for the duration of
 // a single compilation.
 uint32_t AssemblyContext::spvNamedIdAssignOrGet(const char* textValue) {
+  if (globals_) {
+    uint32_t id = 0;
+    if (!globals_->findNamedId(textValue, &id)) {
+      order_dependent_ = true;
+      id = 0;
+    }
+    return id;
+  }
+
   if (!ids_to_preserve_.empty()) {
     uint32_t id = 0;
     if (spvtools::utils::ParseNumber(textValue, &id)) {
@@ -182,6 +191,18 @@ uint32_t AssemblyContext::spvNamedIdAssignOrGet(const char* textValue) {
   return it->second;
 }
 
+bool AssemblyContext::findNamedId(const char* textValue, uint32_t* id) const {
+  if (!ids_to_preserve_.empty() &&
+      spvtools::utils::ParseNumber(textValue, id) &&
+      ids_to_preserve_.find(*id) != ids_to_preserve_.end()) {
+    return true;
+  }
+  const auto it = named_ids_.find(textValue);
+  if (it == named_ids_.end()) return false;
+  *id = it->second;
+  return true;
+}
+
 uint32_t AssemblyContext::getBound() const { return bound_; }
 
 spv_result_t AssemblyContext::advance() {
@@ -320,6 +341,8 @@ spv_result_t AssemblyContext::binaryEncodeString(const char* value,
 
 spv_result_t AssemblyContext::recordTypeDefinition(
     const spv_instruction_t* pInst) {
+  // Later function bodies might use the type.
+  if (globals_) order_dependent_ = true;
   uint32_t value = pInst->words[1];
   if (types_.find(value) != types_.end()) {
     return diagnostic() << "Value " << value
@@ -344,6 +367,7 @@ spv_result_t AssemblyContext::recordTypeDefinition(
 IdType AssemblyContext::getTypeOfTypeGeneratingValue(uint32_t value) const {
   auto type = types_.find(value);
   if (type == types_.end()) {
+    if (globals_) return globals_->getTypeOfTypeGeneratingValue(value);
     return kUnknownType;
   }
   return std::get<1>(*type);
@@ -352,6 +376,13 @@ IdType AssemblyContext::getTypeOfTypeGeneratingValue(uint32_t value) const {
 IdType AssemblyContext::getTypeOfValueInstruction(uint32_t value) const {
   auto type_value = value_types_.find(value);
   if (type_value == value_types_.end()) {
+    if (globals_) {
+      type_value = globals_->value_types_.find(value);
+      if (type_value != globals_->value_types_.end())
+        return getTypeOfTypeGeneratingValue(std::get<1>(*type_value));
+      // The value might be defined in an earlier function body.
+      order_dependent_ = true;
+    }
     return {0, false, IdTypeClass::kBottom};
   }
   return getTypeOfTypeGeneratingValue(std::get<1>(*type_value));
@@ -362,13 +393,20 @@ spv_result_t AssemblyContext::recordTypeIdForValue(uint32_t value,
   bool successfully_inserted = false;
   std::tie(std::ignore, successfully_inserted) =
       value_types_.insert(std::make_pair(value, type));
-  if (!successfully_inserted)
+  if (globals_ && globals_->value_types_.count(value))
+    successfully_inserted = false;
+  if (!successfully_inserted) {
+    // The message is reported when the text is assembled serially.
+    if (globals_) order_dependent_ = true;
     return diagnostic() << "Value is being defined a second time";
+  }
   return SPV_SUCCESS;
 }
 
 spv_result_t AssemblyContext::recordIdAsExtInstImport(
     uint32_t id, spv_ext_inst_type_t type) {
+  // Later function bodies might use the import.
+  if (globals_) order_dependent_ = true;
   bool successfully_inserted = false;
   std::tie(std::ignore, successfully_inserted) =
       import_id_to_ext_inst_type_.insert(std::make_pair(id, type));
@@ -380,11 +418,20 @@ spv_result_t AssemblyContext::recordIdAsExtInstImport(
 spv_ext_inst_type_t AssemblyContext::getExtInstTypeForId(uint32_t id) const {
   auto type = import_id_to_ext_inst_type_.find(id);
   if (type == import_id_to_ext_inst_type_.end()) {
+    if (globals_) return globals_->getExtInstTypeForId(id);
     return SPV_EXT_INST_TYPE_NONE;
   }
   return std::get<1>(*type);
 }
 
+bool AssemblyContext::collectValues(
+    std::unordered_set<uint32_t>* values) const {
+  for (const auto& value_type : value_types_) {
+    if (!values->insert(value_type.first).second) return false;
+  }
+  return true;
+}
+
 std::set<uint32_t> AssemblyContext::GetNumericIds() const {
   std::set<uint32_t> ids;
   for (const auto& kv : named_ids_) {
@@ -19,6 +19,7 @@
 #include <sstream>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "diagnostic.h"
 #include "instruction.h"
@@ -127,8 +128,22 @@ class AssemblyContext {
         next_id_(1),
         ids_to_preserve_(std::move(ids_to_preserve)) {}
 
+  // Constructs a context for assembling a function body, after |globals| has
+  // assigned ids to all names and assembled the instructions outside function
+  // bodies. |globals| is only read, so that several function bodies can be
+  // assembled at the same time.
+  AssemblyContext(spv_text text, const MessageConsumer& consumer,
+                  const AssemblyContext* globals)
+      : current_position_({}),
+        consumer_(consumer),
+        text_(text),
+        bound_(1),
+        next_id_(1),
+        globals_(globals) {}
+
   // Assigns a new integer value to the given text ID, or returns the previously
-  // assigned integer value if the ID has been seen before.
+  // assigned integer value if the ID has been seen before. For a function body
+  // context, returns the value assigned by its globals context.
   uint32_t spvNamedIdAssignOrGet(const char* textValue);
 
   // Returns the largest largest numeric ID that has been assigned.
@@ -236,7 +251,22 @@ class AssemblyContext {
   // from "%foo".
   std::set<uint32_t> GetNumericIds() const;
 
+  // Returns true if this function body context might have assembled its text
+  // differently, had the function bodies before it been assembled first. That
+  // is the case when it looked up a name or value type which neither it nor
+  // its globals context knows, when it defined a type or an import, or when
+  // it found a value being defined a second time.
+  bool isOrderDependent() const { return order_dependent_; }
+
+  // Adds the values whose types were recorded by this context to |values|.
+  // Returns false if any of them was already there.
+  bool collectValues(std::unordered_set<uint32_t>* values) const;
+
  private:
+  // Finds the id for the given text ID without assigning one. Returns true if
+  // it is found.
+  bool findNamedId(const char* textValue, uint32_t* id) const;
+
   // Maps ID names to their corresponding numerical ids.
   using spv_named_id_table = std::unordered_map<std::string, uint32_t>;
   // Maps type-defining IDs to their IdType.
@@ -255,6 +285,10 @@ class AssemblyContext {
   uint32_t bound_;
   uint32_t next_id_;
   std::set<uint32_t> ids_to_preserve_;
+  // The context of the globals, for a function body context.
+  const AssemblyContext* globals_ = nullptr;
+  // See isOrderDependent().  Mutable, since lookups set it.
+  mutable bool order_dependent_ = false;
 };
 
 }  // namespace spvtools
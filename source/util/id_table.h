@@ -0,0 +1,93 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_ID_TABLE_H_
+#define LIBSPIRV_UTIL_ID_TABLE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A map from SPIR-V ids to values of type |T|, for ids which are expected to
+// be dense below the id bound of the module.
+//
+// Ids below the bound given to |Reserve| are kept in a flat vector indexed by
+// id, so a lookup is a bounds check and an index. Any other id is kept in
+// pages of consecutive ids, where only the pages containing ids actually used
+// are allocated. If the id bound is much larger than the module could possibly
+// use, every id is paged.
+//
+// Ids with no value behave as if they hold a value-initialized |T|. References
+// to values stay valid for the lifetime of the table.
+template <class T>
+class IdTable {
+ public:
+  IdTable() = default;
+
+  IdTable(const IdTable&) = delete;
+  IdTable& operator=(const IdTable&) = delete;
+
+  // Moving a table keeps references to its values valid.
+  IdTable(IdTable&&) = default;
+  IdTable& operator=(IdTable&& that) {
+    flat_ = std::move(that.flat_);
+    pages_ = std::move(that.pages_);
+    return *this;
+  }
+
+  // Prepares the table for ids below |bound| in a module of |num_words| words.
+  // Every id in a module needs at least one word, so a bound larger than the
+  // word count means most ids are unused, and no flat storage is allocated.
+  // Must be called while the table is empty.
+  void Reserve(uint32_t bound, size_t num_words) {
+    if (bound <= num_words || bound <= kPageSize) flat_.resize(bound);
+  }
+
+  // Returns the value for |id|.
+  const T& Get(uint32_t id) const {
+    if (id < flat_.size()) return flat_[id];
+    const auto it = pages_.find(id / kPageSize);
+    if (it == pages_.end()) return empty_;
+    return it->second[id % kPageSize];
+  }
+
+  // Returns a reference to the value for |id|, which can be modified.
+  T& operator[](uint32_t id) {
+    if (id < flat_.size()) return flat_[id];
+    std::unique_ptr<T[]>& page = pages_[id / kPageSize];
+    if (!page) page.reset(new T[kPageSize]());
+    return page[id % kPageSize];
+  }
+
+ private:
+  static const uint32_t kPageSize = 1024;
+
+  // The values for ids below the reserved bound, indexed by id.
+  std::vector<T> flat_;
+  // Blocks of |kPageSize| values for the other ids, keyed by id / |kPageSize|.
+  std::unordered_map<uint32_t, std::unique_ptr<T[]>> pages_;
+  // The value reported for ids which were never assigned.
+  const T empty_ = T();
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_ID_TABLE_H_
@@ -0,0 +1,54 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_OPCODE_TABLE_H_
+#define LIBSPIRV_UTIL_OPCODE_TABLE_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A map from opcodes to values of type |T|, kept in a vector indexed by
+// opcode. It is meant for tables which are filled in once and then looked up
+// often, such as the tables of folding rules.
+//
+// Opcodes with no value behave as if they hold a value-initialized |T|.
+template <class T>
+class OpcodeTable {
+ public:
+  // Returns the value for |opcode|.
+  const T& Get(uint32_t opcode) const {
+    return opcode < values_.size() ? values_[opcode] : empty_;
+  }
+
+  // Returns a reference to the value for |opcode|, which can be modified. The
+  // reference is invalidated by the next call for a larger opcode.
+  T& operator[](uint32_t opcode) {
+    if (opcode >= values_.size()) values_.resize(opcode + 1);
+    return values_[opcode];
+  }
+
+ private:
+  // The values, indexed by opcode.
+  std::vector<T> values_;
+  // The value reported for opcodes which were never assigned.
+  const T empty_ = T();
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_OPCODE_TABLE_H_
@@ -0,0 +1,106 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#include <exception>
+#include <mutex>
+#define SPIRV_PARALLEL_EXCEPTIONS 1
+#endif
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+// The thread limit used when the number of hardware threads is not known.
+const uint32_t kDefaultMaxThreads = 8;
+
+// Joins every joinable thread of |threads| when destroyed, so that no thread
+// is left joinable if the caller returns early or the stack unwinds.
+class ThreadJoiner {
+ public:
+  explicit ThreadJoiner(std::vector<std::thread>* threads)
+      : threads_(threads) {}
+  ~ThreadJoiner() {
+    for (auto& thread : *threads_) {
+      if (thread.joinable()) thread.join();
+    }
+  }
+
+ private:
+  std::vector<std::thread>* threads_;
+};
+
+}  // anonymous namespace
+
+uint32_t MaxParallelThreads() {
+  const uint32_t hardware_threads = std::thread::hardware_concurrency();
+  return hardware_threads ? hardware_threads : kDefaultMaxThreads;
+}
+
+void ParallelFor(uint32_t num_threads, size_t num_tasks,
+                 const std::function<void(size_t)>& task) {
+  num_threads = std::min(num_threads, MaxParallelThreads());
+  if (num_threads <= 1 || num_tasks <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) task(i);
+    return;
+  }
+
+  std::atomic<size_t> next_task(0);
+#if defined(SPIRV_PARALLEL_EXCEPTIONS)
+  // The first exception thrown by a task. Once it is set, no more tasks are
+  // started, and it is rethrown on the calling thread.
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&next_task, num_tasks, &task, &error, &error_mutex]() {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) {
+      try {
+        task(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+        next_task = num_tasks;
+      }
+    }
+  };
+#else
+  auto worker = [&next_task, num_tasks, &task]() {
+    for (size_t i = next_task++; i < num_tasks; i = next_task++) task(i);
+  };
+#endif
+
+  // The calling thread is one of the workers.
+  const size_t num_helpers =
+      std::min(static_cast<size_t>(num_threads), num_tasks) - 1;
+  std::vector<std::thread> helpers;
+  helpers.reserve(num_helpers);
+  {
+    ThreadJoiner joiner(&helpers);
+    for (size_t i = 0; i < num_helpers; ++i) helpers.emplace_back(worker);
+    worker();
+  }
+
+#if defined(SPIRV_PARALLEL_EXCEPTIONS)
+  if (error) std::rethrow_exception(error);
+#endif
+}
+
+}  // namespace utils
+}  // namespace spvtools
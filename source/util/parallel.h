@@ -0,0 +1,48 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_PARALLEL_H_
+#define LIBSPIRV_UTIL_PARALLEL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace spvtools {
+namespace utils {
+
+// Returns the largest number of threads ParallelFor runs at once: the number
+// of hardware threads, or a small default if that is not known.
+uint32_t MaxParallelThreads();
+
+// Calls |task| once for each index in [0, |num_tasks|), using up to
+// |num_threads| threads, the calling thread included. |num_threads| is capped
+// at MaxParallelThreads(), and no more threads are started than there are
+// tasks. Indices are handed out to the threads in increasing order, as
+// threads become free. Returns once every call has returned, and every
+// started thread has been joined.
+//
+// If |num_threads| is 0 or 1, or there is at most one task, every call is
+// made on the calling thread, in increasing index order.
+//
+// When exceptions are enabled, the first exception thrown by |task| stops the
+// remaining indices from being handed out, and is rethrown on the calling
+// thread once the other threads are joined.
+void ParallelFor(uint32_t num_threads, size_t num_tasks,
+                 const std::function<void(size_t)>& task);
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_PARALLEL_H_
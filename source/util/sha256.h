@@ -0,0 +1,58 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_SHA256_H_
+#define LIBSPIRV_UTIL_SHA256_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace spvtools {
+namespace utils {
+
+// Computes the SHA-256 digest, as specified in FIPS 180-4, of a message which
+// is given in any number of pieces.
+class Sha256 {
+ public:
+  using Digest = std::array<uint8_t, 32>;
+
+  Sha256();
+
+  // Appends |size| bytes at |data| to the message.
+  void Update(const void* data, size_t size);
+
+  // Returns the digest of the message. No more data may be appended after.
+  Digest Finish();
+
+  // Returns |digest| as 64 lower case hexadecimal digits.
+  static std::string ToHex(const Digest& digest);
+
+ private:
+  // Mixes the 64 byte block at |block| into the state.
+  void ProcessBlock(const uint8_t* block);
+
+  uint32_t state_[8];
+  // The bytes of the message which do not yet fill a block.
+  uint8_t buffer_[64];
+  size_t buffered_;
+  // The length of the message so far, in bytes.
+  uint64_t length_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_SHA256_H_
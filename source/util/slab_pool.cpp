@@ -0,0 +1,141 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/slab_pool.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+namespace spvtools {
+namespace utils {
+namespace {
+
+// What each block from |SlabPool::AllocateFrom| is preceded by. It is padded
+// to keep the block aligned like the blocks of a pool.
+union BlockHeader {
+  // The pool the block came from, or nullptr for the system allocator.
+  SlabPool* pool;
+  char padding[16];
+};
+
+static_assert(sizeof(BlockHeader) == 16, "Unexpected block header size");
+
+// Returns |size| bytes aligned to |alignment|, which is a power of two.
+void* AllocateAligned(size_t size, size_t alignment) {
+#if defined(_WIN32)
+  void* ptr = _aligned_malloc(size, alignment);
+#else
+  void* ptr = nullptr;
+  if (posix_memalign(&ptr, alignment, size) != 0) ptr = nullptr;
+#endif
+  if (!ptr) std::abort();
+  return ptr;
+}
+
+void FreeAligned(void* ptr) {
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  std::free(ptr);
+#endif
+}
+
+}  // anonymous namespace
+
+SlabPool::SlabPool()
+    : slab_next_(nullptr),
+      slab_end_(nullptr),
+      free_blocks_(),
+      num_live_blocks_(0),
+      released_(false) {}
+
+SlabPool::~SlabPool() {
+  for (void* slab : slabs_) FreeAligned(slab);
+}
+
+void SlabPool::Release() {
+  assert(!released_ && "The pool was already released.");
+  released_ = true;
+  DeleteIfUnused();
+}
+
+void* SlabPool::Allocate(size_t size) {
+  if (size > kMaxBlockSize) return ::operator new(size);
+
+  ++num_live_blocks_;
+  const size_t index = size == 0 ? 0 : (size - 1) / kGranularity;
+  if (FreeBlock* block = free_blocks_[index]) {
+    free_blocks_[index] = block->next;
+    return block;
+  }
+
+  const size_t block_size = (index + 1) * kGranularity;
+  if (size_t(slab_end_ - slab_next_) < block_size) {
+    char* slab = static_cast<char*>(AllocateAligned(kSlabSize, kGranularity));
+    slabs_.push_back(slab);
+    slab_next_ = slab;
+    slab_end_ = slab + kSlabSize;
+  }
+  void* block = slab_next_;
+  slab_next_ += block_size;
+  return block;
+}
+
+void SlabPool::Deallocate(void* ptr, size_t size) {
+  if (size > kMaxBlockSize) {
+    ::operator delete(ptr);
+    return;
+  }
+
+  assert(num_live_blocks_ > 0 && "Deallocating more blocks than allocated.");
+  const size_t index = size == 0 ? 0 : (size - 1) / kGranularity;
+  FreeBlock* block = static_cast<FreeBlock*>(ptr);
+  block->next = free_blocks_[index];
+  free_blocks_[index] = block;
+  --num_live_blocks_;
+  DeleteIfUnused();
+}
+
+void* SlabPool::AllocateFrom(SlabPool* pool, size_t size) {
+  const size_t total = size + sizeof(BlockHeader);
+  // Large blocks come from the system allocator even with a pool, and do not
+  // keep it alive, so they must not refer to it.
+  if (total > kMaxBlockSize) pool = nullptr;
+  BlockHeader* header = static_cast<BlockHeader*>(
+      pool ? pool->Allocate(total) : AllocateAligned(total, kGranularity));
+  header->pool = pool;
+  return header + 1;
+}
+
+void SlabPool::DeallocateAny(void* ptr, size_t size) {
+  if (!ptr) return;
+  BlockHeader* header = static_cast<BlockHeader*>(ptr) - 1;
+  if (header->pool) {
+    header->pool->Deallocate(header, size + sizeof(BlockHeader));
+  } else {
+    FreeAligned(header);
+  }
+}
+
+void SlabPool::DeleteIfUnused() {
+  if (released_ && num_live_blocks_ == 0) delete this;
+}
+
+}  // namespace utils
+}  // namespace spvtools
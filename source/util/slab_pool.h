@@ -0,0 +1,172 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_SLAB_POOL_H_
+#define LIBSPIRV_UTIL_SLAB_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <scoped_allocator>
+#include <vector>
+
+namespace spvtools {
+namespace utils {
+
+// A memory pool for many small objects of a few sizes, such as the
+// instructions of a module.
+//
+// Memory is carved out of large slabs, and freed blocks are kept on a free
+// list for their size, so allocating and freeing a block usually does not
+// call into the system allocator. The slabs are freed all at once when the
+// pool goes away.
+//
+// A pool is owned by whoever created it, usually through a |SlabPoolPtr|.
+// Releasing it does not necessarily destroy it: the pool stays alive for as
+// long as blocks allocated from it are still in use, and deletes itself when
+// the last of them is deallocated. If no blocks are in use when it is
+// released, it deletes itself right away. This lets objects outlive the owner
+// of their pool.
+//
+// A pool is not thread-safe: a pool, and the blocks allocated from it, must
+// only be used by one thread at a time.
+class SlabPool {
+ public:
+  // Larger blocks come from the system allocator.
+  static const size_t kMaxBlockSize = 512;
+
+  // Creates a new pool. It must be released with |Release|.
+  static SlabPool* Create() { return new SlabPool(); }
+
+  SlabPool(const SlabPool&) = delete;
+  SlabPool& operator=(const SlabPool&) = delete;
+
+  // Gives up ownership of the pool. The pool is destroyed as soon as every
+  // block allocated from it has been deallocated, which may be right away.
+  void Release();
+
+  // Returns a block of at least |size| bytes, aligned for any object type.
+  void* Allocate(size_t size);
+
+  // Returns |ptr|, which was allocated from this pool with the given |size|,
+  // to the pool. This may destroy the pool if it was released.
+  void Deallocate(void* ptr, size_t size);
+
+  // Allocates |size| bytes from |pool|, or from the system allocator if
+  // |pool| is null, aligned like the blocks of |Allocate|. The block is
+  // preceded by a header that says where it came from, and must be returned
+  // with |DeallocateAny|.
+  static void* AllocateFrom(SlabPool* pool, size_t size);
+
+  // Deallocates |ptr|, which was returned by |AllocateFrom| with the given
+  // |size|. This may destroy its pool if the pool was released.
+  static void DeallocateAny(void* ptr, size_t size);
+
+  // Returns the number of slabs allocated so far.
+  size_t num_slabs() const { return slabs_.size(); }
+
+  // Returns the number of blocks of at most |kMaxBlockSize| bytes currently
+  // allocated from the pool.
+  size_t num_live_blocks() const { return num_live_blocks_; }
+
+ private:
+  // Block sizes are rounded up to a multiple of this, which is also the
+  // alignment of the blocks.
+  static const size_t kGranularity = 16;
+  // The size of the slabs that blocks are carved from.
+  static const size_t kSlabSize = 64 * 1024;
+
+  // A block on a free list.
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  SlabPool();
+  ~SlabPool();
+
+  // Deletes the pool if it was released and has no blocks in use.
+  void DeleteIfUnused();
+
+  // The slabs blocks are allocated from.
+  std::vector<void*> slabs_;
+  // The unused part of the last slab.
+  char* slab_next_;
+  char* slab_end_;
+  // Free blocks for each multiple of |kGranularity|.
+  FreeBlock* free_blocks_[kMaxBlockSize / kGranularity];
+  size_t num_live_blocks_;
+  bool released_;
+};
+
+// Releases the pool when the owner goes away.
+struct SlabPoolReleaser {
+  void operator()(SlabPool* pool) const { pool->Release(); }
+};
+
+using SlabPoolPtr = std::unique_ptr<SlabPool, SlabPoolReleaser>;
+
+// An allocator for standard containers that allocates from a |SlabPool|, or
+// from the system allocator if it has no pool. Like the pool, it is not
+// thread-safe.
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T;
+  // Moving a container moves its pool along with its elements.
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  PoolAllocator() : pool_(nullptr) {}
+  explicit PoolAllocator(SlabPool* pool) : pool_(pool) {}
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>& that) : pool_(that.pool()) {}
+
+  T* allocate(size_t n) {
+    const size_t size = n * sizeof(T);
+    return static_cast<T*>(pool_ ? pool_->Allocate(size)
+                                 : ::operator new(size));
+  }
+
+  void deallocate(T* ptr, size_t n) {
+    if (pool_) {
+      pool_->Deallocate(ptr, n * sizeof(T));
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  SlabPool* pool() const { return pool_; }
+
+  template <typename U>
+  bool operator==(const PoolAllocator<U>& that) const {
+    return pool_ == that.pool();
+  }
+
+  template <typename U>
+  bool operator!=(const PoolAllocator<U>& that) const {
+    return pool_ != that.pool();
+  }
+
+ private:
+  SlabPool* pool_;
+};
+
+// An allocator for containers of objects that themselves allocate with a
+// |PoolAllocator|. Those objects are given the pool of the container.
+template <typename T>
+using ScopedPoolAllocator = std::scoped_allocator_adaptor<PoolAllocator<T>>;
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_SLAB_POOL_H_
@@ -17,6 +17,8 @@
 
 #include <cassert>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 #include "opt/make_unique.h"
@@ -33,27 +35,55 @@ namespace utils {
 // should experiment with different values for |small_size| and compare to
 // using and |std::vector|.
 //
+// When the elements do not fit in the vector itself, they are stored in a
+// |std::vector| that uses |Allocator|, and that is itself allocated with
+// |Allocator|. A copy of a |SmallVector| uses the same allocator, and
+// assigning to a |SmallVector| does not change its allocator.
+//
 // TODO: I have implemented the public member functions from |std::vector| that
 // I needed.  If others are needed they should be implemented. Do not implement
 // public member functions that are not defined by std::vector.
-template <class T, size_t small_size>
+template <class T, size_t small_size, class Allocator = std::allocator<T>>
 class SmallVector {
+  using LargeVector = std::vector<T, Allocator>;
+  using LargeVectorAllocator = typename std::allocator_traits<
+      Allocator>::template rebind_alloc<LargeVector>;
+
  public:
   using iterator = T*;
   using const_iterator = const T*;
+  using allocator_type = Allocator;
+
+  SmallVector() : SmallVector(Allocator()) {}
 
-  SmallVector()
+  explicit SmallVector(const Allocator& allocator)
       : size_(0),
         small_data_(reinterpret_cast<T*>(buffer)),
+        allocator_(allocator),
         large_data_(nullptr) {}
 
-  SmallVector(const SmallVector& that) : SmallVector() { *this = that; }
+  SmallVector(const SmallVector& that) : SmallVector(that.allocator_) {
+    *this = that;
+  }
 
-  SmallVector(SmallVector&& that) : SmallVector() { *this = std::move(that); }
+  SmallVector(const SmallVector& that, const Allocator& allocator)
+      : SmallVector(allocator) {
+    *this = that;
+  }
+
+  SmallVector(SmallVector&& that) : SmallVector(that.allocator_) {
+    *this = std::move(that);
+  }
+
+  SmallVector(SmallVector&& that, const Allocator& allocator)
+      : SmallVector(allocator) {
+    *this = std::move(that);
+  }
 
   SmallVector(const std::vector<T>& vec) : SmallVector() {
     if (vec.size() > small_size) {
-      large_data_.reset(new std::vector<T>(vec));
+      large_data_ = NewLargeData();
+      large_data_->assign(vec.begin(), vec.end());
     } else {
       size_ = vec.size();
       for (uint32_t i = 0; i < size_; i++) {
@@ -64,7 +94,9 @@ class SmallVector {
 
   SmallVector(std::vector<T>&& vec) : SmallVector() {
     if (vec.size() > small_size) {
-      large_data_.reset(new std::vector<T>(std::move(vec)));
+      large_data_ = NewLargeData();
+      large_data_->assign(std::make_move_iterator(vec.begin()),
+                          std::make_move_iterator(vec.end()));
     } else {
       size_ = vec.size();
       for (uint32_t i = 0; i < size_; i++) {
@@ -80,7 +112,8 @@ class SmallVector {
         new (small_data_ + (size_++)) T(std::move(*it));
       }
     } else {
-      large_data_.reset(new std::vector<T>(std::move(init_list)));
+      large_data_ = NewLargeData();
+      large_data_->assign(init_list);
     }
   }
 
@@ -90,18 +123,20 @@ class SmallVector {
     for (T* p = small_data_; p < small_data_ + size_; ++p) {
       p->~T();
     }
+    DeleteLargeData();
   }
 
   SmallVector& operator=(const SmallVector& that) {
     assert(small_data_);
+    if (this == &that) return *this;
     if (that.large_data_) {
-      if (large_data_) {
-        *large_data_ = *that.large_data_;
-      } else {
-        large_data_.reset(new std::vector<T>(*that.large_data_));
+      if (!large_data_) {
+        DestructSmallData();
+        large_data_ = NewLargeData();
       }
+      large_data_->assign(that.large_data_->begin(), that.large_data_->end());
     } else {
-      large_data_.reset(nullptr);
+      DeleteLargeData();
       size_t i = 0;
       // Do a copy for any element in |this| that is already constructed.
       for (; i < size_ && i < that.size_; ++i) {
@@ -127,10 +162,24 @@ class SmallVector {
   }
 
   SmallVector& operator=(SmallVector&& that) {
-    if (that.large_data_) {
-      large_data_.reset(that.large_data_.release());
+    if (this == &that) return *this;
+    if (that.large_data_ && allocator_ == that.allocator_) {
+      DeleteLargeData();
+      DestructSmallData();
+      large_data_ = that.large_data_;
+      that.large_data_ = nullptr;
+    } else if (that.large_data_) {
+      // The elements have to be moved one by one into memory from our own
+      // allocator.
+      if (!large_data_) {
+        DestructSmallData();
+        large_data_ = NewLargeData();
+      }
+      large_data_->assign(std::make_move_iterator(that.large_data_->begin()),
+                          std::make_move_iterator(that.large_data_->end()));
+      that.DeleteLargeData();
     } else {
-      large_data_.reset(nullptr);
+      DeleteLargeData();
       size_t i = 0;
       // Do a move for any element in |this| that is already constructed.
       for (; i < size_ && i < that.size_; ++i) {
@@ -333,7 +382,7 @@ class SmallVector {
     }
 
     if (large_data_) {
-      typename std::vector<T>::iterator new_pos =
+      typename LargeVector::iterator new_pos =
           large_data_->begin() + element_idx;
       large_data_->insert(new_pos, first, last);
       return begin() + element_idx;
@@ -424,13 +473,32 @@ class SmallVector {
   // be access through |large_data|.
   void MoveToLargeData() {
     assert(!large_data_);
-    large_data_.reset(new std::vector<T>());
+    large_data_ = NewLargeData();
     for (size_t i = 0; i < size_; ++i) {
       large_data_->emplace_back(std::move(small_data_[i]));
     }
     DestructSmallData();
   }
 
+  // Returns a new empty vector for |large_data_|.
+  LargeVector* NewLargeData() {
+    LargeVectorAllocator allocator(allocator_);
+    LargeVector* vec =
+        std::allocator_traits<LargeVectorAllocator>::allocate(allocator, 1);
+    new (vec) LargeVector(allocator_);
+    return vec;
+  }
+
+  // Destroys |large_data_|, if there is one, and sets it to nullptr.
+  void DeleteLargeData() {
+    if (!large_data_) return;
+    LargeVectorAllocator allocator(allocator_);
+    large_data_->~LargeVector();
+    std::allocator_traits<LargeVectorAllocator>::deallocate(allocator,
+                                                            large_data_, 1);
+    large_data_ = nullptr;
+  }
+
   // Destroys all of the elements in |small_data_| that have been constructed.
   void DestructSmallData() {
     for (size_t i = 0; i < size_; ++i) {
@@ -451,11 +519,14 @@ class SmallVector {
   typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type
       buffer[small_size];
 
+  // The allocator for |large_data_| and its elements.
+  Allocator allocator_;
+
   // A pointer to a vector that is used to store the elements of the vector when
   // this size exceeds |small_size|.  If |large_data_| is nullptr, then the data
   // is stored in |small_data_|.  Otherwise, the data is stored in
-  // |large_data_|.
-  std::unique_ptr<std::vector<T>> large_data_;
+  // |large_data_|. It is allocated with |allocator_|.
+  LargeVector* large_data_;
 };  // namespace utils
 
 }  // namespace utils
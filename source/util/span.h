@@ -0,0 +1,68 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_SPAN_H_
+#define LIBSPIRV_UTIL_SPAN_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+
+namespace spvtools {
+namespace utils {
+
+// A view of |size()| consecutive values of type |T| which are owned elsewhere,
+// and must outlive the |Span|. It has the read-only interface of a
+// |std::vector|, so it can stand in for a reference to one.
+template <class T>
+class Span {
+ public:
+  using value_type = T;
+  using iterator = T*;
+  using const_iterator = T*;
+
+  Span() : data_(nullptr), size_(0) {}
+  Span(T* data, size_t size) : data_(data), size_(size) {}
+
+  T* data() const { return data_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  T& operator[](size_t index) const {
+    assert(index < size_);
+    return data_[index];
+  }
+  // Like operator[], but also checked in release builds: an out of range
+  // |index| aborts the program, as std::vector::at does without exceptions.
+  T& at(size_t index) const {
+    if (index >= size_) std::abort();
+    return data_[index];
+  }
+  T& front() const { return (*this)[0]; }
+  T& back() const { return (*this)[size_ - 1]; }
+
+  iterator begin() const { return data_; }
+  iterator end() const { return data_ + size_; }
+  const_iterator cbegin() const { return data_; }
+  const_iterator cend() const { return data_ + size_; }
+
+ private:
+  T* data_;
+  size_t size_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_SPAN_H_
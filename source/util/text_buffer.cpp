@@ -0,0 +1,70 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "util/text_buffer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace spvtools {
+namespace utils {
+
+void TextBuffer::AppendUnsigned(uint64_t value) {
+  // Enough for the 20 digits of the largest value.
+  char digits[20];
+  char* const end = digits + sizeof(digits);
+  char* first = end;
+  do {
+    *--first = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value);
+  text_.append(first, end);
+}
+
+void TextBuffer::AppendSigned(int64_t value) {
+  if (value < 0) {
+    text_.push_back('-');
+    // Negating in unsigned arithmetic also works for the smallest value.
+    AppendUnsigned(0 - static_cast<uint64_t>(value));
+  } else {
+    AppendUnsigned(static_cast<uint64_t>(value));
+  }
+}
+
+void TextBuffer::AppendHex(uint64_t value, size_t min_digits) {
+  static const char kHexDigits[] = "0123456789abcdef";
+  char digits[16];
+  char* const end = digits + sizeof(digits);
+  char* first = end;
+  do {
+    *--first = kHexDigits[value & 0xf];
+    value >>= 4;
+  } while (value);
+  const size_t num_digits = static_cast<size_t>(end - first);
+  if (num_digits < min_digits) text_.append(min_digits - num_digits, '0');
+  text_.append(first, end);
+}
+
+void TextBuffer::AppendFloat(double value, int precision) {
+  // The default floating point format of a stream is that of "%g". The
+  // longest result is a sign, 17 digits, a point and a 5 character exponent.
+  char digits[32];
+  const int length = snprintf(digits, sizeof(digits), "%.*g", precision, value);
+  if (length <= 0) return;
+  text_.append(digits, std::min(static_cast<size_t>(length),
+                                sizeof(digits) - 1));
+}
+
+}  // namespace utils
+}  // namespace spvtools
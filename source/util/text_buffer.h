@@ -0,0 +1,66 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_UTIL_TEXT_BUFFER_H_
+#define LIBSPIRV_UTIL_TEXT_BUFFER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace spvtools {
+namespace utils {
+
+// An append-only buffer of characters, for producing large amounts of text
+// such as disassembly. Numbers are formatted by hand rather than through
+// iostreams, but the text is the same as writing them to a std::ostream with
+// its default flags would produce, unless stated otherwise.
+class TextBuffer {
+ public:
+  // Returns the text appended since construction or the last call to Clear().
+  const char* data() const { return text_.data(); }
+  size_t size() const { return text_.size(); }
+  const std::string& str() const { return text_; }
+
+  // Removes all text, but keeps the storage.
+  void Clear() { text_.clear(); }
+
+  void Append(char c) { text_.push_back(c); }
+  void Append(const char* str) { text_.append(str); }
+  void Append(const char* str, size_t length) { text_.append(str, length); }
+  void Append(const std::string& str) { text_.append(str); }
+
+  // Appends |count| copies of |c|.
+  void AppendFill(size_t count, char c) { text_.append(count, c); }
+
+  // Appends |value| in decimal.
+  void AppendUnsigned(uint64_t value);
+  void AppendSigned(int64_t value);
+
+  // Appends |value| in lower case hexadecimal, without a prefix, padded with
+  // leading zeros to at least |min_digits| digits.
+  void AppendHex(uint64_t value, size_t min_digits);
+
+  // Appends |value| with up to |precision| significant digits, as a stream
+  // with that precision would.
+  void AppendFloat(double value, int precision);
+
+ private:
+  std::string text_;
+};
+
+}  // namespace utils
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_UTIL_TEXT_BUFFER_H_
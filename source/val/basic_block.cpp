@@ -15,6 +15,7 @@
 #include "val/basic_block.h"
 
 #include <algorithm>
+#include <cassert>
 #include <utility>
 #include <vector>
 
@@ -26,6 +27,10 @@ BasicBlock::BasicBlock(uint32_t label_id)
     : id_(label_id),
       immediate_dominator_(nullptr),
       immediate_post_dominator_(nullptr),
+      dom_first_(0),
+      dom_last_(0),
+      pdom_first_(0),
+      pdom_last_(0),
       predecessors_(),
       successors_(),
       type_(0),
@@ -35,10 +40,24 @@ BasicBlock::BasicBlock(uint32_t label_id)
 
 void BasicBlock::SetImmediateDominator(BasicBlock* dom_block) {
   immediate_dominator_ = dom_block;
+  dom_first_ = dom_last_ = 0;
 }
 
 void BasicBlock::SetImmediatePostDominator(BasicBlock* pdom_block) {
   immediate_post_dominator_ = pdom_block;
+  pdom_first_ = pdom_last_ = 0;
+}
+
+void BasicBlock::SetDominatorInterval(uint32_t first, uint32_t last) {
+  assert(0 < first && first < last);
+  dom_first_ = first;
+  dom_last_ = last;
+}
+
+void BasicBlock::SetPostDominatorInterval(uint32_t first, uint32_t last) {
+  assert(0 < first && first < last);
+  pdom_first_ = first;
+  pdom_last_ = last;
 }
 
 const BasicBlock* BasicBlock::immediate_dominator() const {
@@ -68,12 +87,18 @@ void BasicBlock::RegisterBranchInstruction(SpvOp branch_instruction) {
 }
 
 bool BasicBlock::dominates(const BasicBlock& other) const {
+  if (dom_first_ && other.dom_first_) {
+    return dom_first_ <= other.dom_first_ && other.dom_last_ <= dom_last_;
+  }
   return (this == &other) ||
          !(other.dom_end() ==
            std::find(other.dom_begin(), other.dom_end(), this));
 }
 
 bool BasicBlock::postdominates(const BasicBlock& other) const {
+  if (pdom_first_ && other.pdom_first_) {
+    return pdom_first_ <= other.pdom_first_ && other.pdom_last_ <= pdom_last_;
+  }
   return (this == &other) ||
          !(other.pdom_end() ==
            std::find(other.pdom_begin(), other.pdom_end(), this));
@@ -94,6 +94,18 @@ class BasicBlock {
   /// @param[in] pdom_block The post dominator block
   void SetImmediatePostDominator(BasicBlock* pdom_block);
 
+  /// Sets the interval spanned by this block in a depth first numbering of the
+  /// dominator tree, so that it dominates exactly the blocks whose intervals
+  /// lie within its own. Setting the immediate dominator clears the interval.
+  ///
+  /// @param[in] first The number given to the block before its subtree
+  /// @param[in] last The number given to the block after its subtree
+  void SetDominatorInterval(uint32_t first, uint32_t last);
+
+  /// Sets the interval spanned by this block in a depth first numbering of the
+  /// post dominator tree. Setting the immediate post dominator clears it.
+  void SetPostDominatorInterval(uint32_t first, uint32_t last);
+
   /// Returns the immedate dominator of this basic block
   BasicBlock* immediate_dominator();
 
@@ -132,11 +144,14 @@ class BasicBlock {
   bool operator==(const uint32_t& other_id) const { return other_id == id_; }
 
   /// Returns true if this block dominates the other block.
-  /// Assumes dominators have been computed.
+  /// Assumes dominators have been computed. Takes constant time if both
+  /// blocks have dominator intervals, and walks the dominator chain of
+  /// the other block otherwise.
   bool dominates(const BasicBlock& other) const;
 
   /// Returns true if this block postdominates the other block.
-  /// Assumes dominators have been computed.
+  /// Assumes dominators have been computed. Takes constant time if both
+  /// blocks have post dominator intervals.
   bool postdominates(const BasicBlock& other) const;
 
   /// @brief A BasicBlock dominator iterator class
@@ -212,6 +227,16 @@ class BasicBlock {
   /// Pointer to the immediate dominator of the BasicBlock
   BasicBlock* immediate_post_dominator_;
 
+  /// The interval of the BasicBlock in the dominator tree, or zeros if it has
+  /// not been numbered
+  uint32_t dom_first_;
+  uint32_t dom_last_;
+
+  /// The interval of the BasicBlock in the post dominator tree, or zeros if it
+  /// has not been numbered
+  uint32_t pdom_first_;
+  uint32_t pdom_last_;
+
   /// The set of predecessors of the BasicBlock
   std::vector<BasicBlock*> predecessors_;
 
@@ -33,17 +33,20 @@ OPERATOR(==)
 #undef OPERATOR
 
 Instruction::Instruction(const spv_parsed_instruction_t* inst,
+                         std::vector<spv_parsed_operand_t>* operand_pool,
                          Function* defining_function,
                          BasicBlock* defining_block)
-    : words_(inst->words, inst->words + inst->num_words),
-      operands_(inst->operands, inst->operands + inst->num_operands),
-      inst_({words_.data(), inst->num_words, inst->opcode, inst->ext_inst_type,
-             inst->type_id, inst->result_id, operands_.data(),
-             inst->num_operands}),
+    : operand_pool_(operand_pool),
+      first_operand_(operand_pool->size()),
+      inst_({inst->words, inst->num_words, inst->opcode, inst->ext_inst_type,
+             inst->type_id, inst->result_id, nullptr, inst->num_operands}),
       instruction_position_(0),
       function_(defining_function),
       block_(defining_block),
-      uses_() {}
+      uses_() {
+  operand_pool->insert(operand_pool->end(), inst->operands,
+                       inst->operands + inst->num_operands);
+}
 
 void Instruction::RegisterUse(const Instruction* inst, uint32_t index) {
   uses_.push_back(make_pair(inst, index));
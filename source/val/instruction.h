@@ -23,6 +23,7 @@
 
 #include "spirv-tools/libspirv.h"
 #include "table.h"
+#include "util/span.h"
 
 namespace spvtools {
 
@@ -31,11 +32,19 @@ class Function;
 
 /// Wraps the spv_parsed_instruction struct along with use and definition of the
 /// instruction's result id
+///
+/// The instruction does not own its words, which usually belong to the module
+/// being validated. Its operands are kept in a pool shared with the other
+/// instructions of the module.
 class Instruction {
  public:
-  explicit Instruction(const spv_parsed_instruction_t* inst,
-                       Function* defining_function = nullptr,
-                       BasicBlock* defining_block = nullptr);
+  /// Creates an instruction for \p inst, whose words must outlive it. The
+  /// operands of \p inst are appended to \p operand_pool, which must also
+  /// outlive it.
+  Instruction(const spv_parsed_instruction_t* inst,
+              std::vector<spv_parsed_operand_t>* operand_pool,
+              Function* defining_function = nullptr,
+              BasicBlock* defining_block = nullptr);
 
   /// Registers the use of the Instruction in instruction \p inst at \p index
   void RegisterUse(const Instruction* inst, uint32_t index);
@@ -61,34 +70,44 @@ class Instruction {
   }
 
   /// The word used to define the Instruction
-  uint32_t word(size_t index) const { return words_[index]; }
+  uint32_t word(size_t index) const { return inst_.words[index]; }
 
   /// The words used to define the Instruction
-  const std::vector<uint32_t>& words() const { return words_; }
+  utils::Span<const uint32_t> words() const {
+    return utils::Span<const uint32_t>(inst_.words, inst_.num_words);
+  }
 
   /// The operands of the Instruction
-  const std::vector<spv_parsed_operand_t>& operands() const {
-    return operands_;
+  utils::Span<const spv_parsed_operand_t> operands() const {
+    return utils::Span<const spv_parsed_operand_t>(
+        operand_pool_->data() + first_operand_, inst_.num_operands);
   }
 
-  /// Provides direct access to the stored C instruction object.
-  const spv_parsed_instruction_t& c_inst() const { return inst_; }
+  /// Returns the C instruction object for the Instruction. Its pointers are
+  /// invalidated when another instruction is added to the operand pool.
+  spv_parsed_instruction_t c_inst() const {
+    spv_parsed_instruction_t inst = inst_;
+    inst.operands = operands().data();
+    return inst;
+  }
 
   // Casts the words belonging to the operand under |index| to |T| and returns.
   template <typename T>
   T GetOperandAs(size_t index) const {
-    const spv_parsed_operand_t& operand = operands_.at(index);
+    const spv_parsed_operand_t& operand = operands().at(index);
     assert(operand.num_words * 4 >= sizeof(T));
     assert(operand.offset + operand.num_words <= inst_.num_words);
-    return *reinterpret_cast<const T*>(&words_[operand.offset]);
+    return *reinterpret_cast<const T*>(&inst_.words[operand.offset]);
   }
 
   int InstructionPosition() const { return instruction_position_; }
   void SetInstructionPosition(int pos) { instruction_position_ = pos; }
 
  private:
-  const std::vector<uint32_t> words_;
-  const std::vector<spv_parsed_operand_t> operands_;
+  /// The pool holding the operands, starting at index |first_operand_|.
+  const std::vector<spv_parsed_operand_t>* operand_pool_;
+  size_t first_operand_;
+  /// The C instruction object, whose operands are in the pool.
   spv_parsed_instruction_t inst_;
   int instruction_position_;
 
@@ -0,0 +1,230 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "val/validation_cache.h"
+
+#if defined(SPIRV_WINDOWS)
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+
+#include "spirv_validator_options.h"
+
+namespace spvtools {
+namespace {
+
+// Identifies the format of the files, and of the keys.
+const char kMagic[8] = {'S', 'P', 'V', 'V', 'A', 'L', '0', '1'};
+
+// Appends |value| to |bytes|, least significant byte first.
+void AppendInteger(uint64_t value, size_t size, std::vector<uint8_t>* bytes) {
+  for (size_t i = 0; i < size; ++i) {
+    bytes->push_back(static_cast<uint8_t>(value >> (8 * i)));
+  }
+}
+
+void AppendString(const std::string& str, std::vector<uint8_t>* bytes) {
+  AppendInteger(str.size(), 4, bytes);
+  bytes->insert(bytes->end(), str.begin(), str.end());
+}
+
+// Reads the values written by AppendInteger and AppendString. Reading past
+// the end yields zeros and makes the reader fail.
+class Reader {
+ public:
+  Reader(const uint8_t* data, size_t size)
+      : data_(data), size_(size), offset_(0), failed_(false) {}
+
+  bool failed() const { return failed_; }
+  bool AtEnd() const { return offset_ == size_; }
+
+  const uint8_t* Bytes(size_t size) {
+    if (size > size_ - offset_) {
+      failed_ = true;
+      offset_ = size_;
+      return nullptr;
+    }
+    const uint8_t* bytes = data_ + offset_;
+    offset_ += size;
+    return bytes;
+  }
+
+  uint64_t Integer(size_t size) {
+    const uint8_t* bytes = Bytes(size);
+    uint64_t value = 0;
+    for (size_t i = 0; bytes && i < size; ++i) {
+      value |= uint64_t(bytes[i]) << (8 * i);
+    }
+    return value;
+  }
+
+  std::string String() {
+    const size_t length = static_cast<size_t>(Integer(4));
+    const uint8_t* bytes = Bytes(length);
+    return bytes ? std::string(bytes, bytes + length) : std::string();
+  }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t offset_;
+  bool failed_;
+};
+
+// Returns the id of the current process.
+uint64_t ProcessId() {
+#if defined(SPIRV_WINDOWS)
+  return static_cast<uint64_t>(_getpid());
+#else
+  return static_cast<uint64_t>(getpid());
+#endif
+}
+
+// Returns a suffix for a temporary file which no other thread or process is
+// using at the same time. The process id tells processes sharing the cache
+// directory apart, and the thread id and counter tell apart the files of one
+// process.
+std::string UniqueSuffix() {
+  static std::atomic<uint32_t> counter(0);
+  const uint64_t ticks = static_cast<uint64_t>(
+      std::chrono::high_resolution_clock::now().time_since_epoch().count());
+  const uint64_t thread =
+      std::hash<std::thread::id>()(std::this_thread::get_id());
+  return ".tmp" + std::to_string(ProcessId()) + "-" + std::to_string(ticks) +
+         "-" + std::to_string(thread) + "-" + std::to_string(counter++);
+}
+
+}  // anonymous namespace
+
+ValidationCache::ValidationCache(const std::string& directory,
+                                 size_t max_size)
+    : directory_(directory),
+      num_files_(max_size < kMaxEntrySize ? 1 : max_size / kMaxEntrySize) {}
+
+ValidationCache::Key ValidationCache::ComputeKey(
+    spv_target_env env, spv_const_validator_options options,
+    const uint32_t* words, size_t num_words) {
+  std::vector<uint8_t> header(kMagic, kMagic + sizeof(kMagic));
+  AppendString(spvSoftwareVersionDetailsString(), &header);
+  AppendInteger(env, 4, &header);
+  const validator_universal_limits_t& limits = options->universal_limits_;
+  for (uint32_t limit :
+       {limits.max_struct_members, limits.max_struct_depth,
+        limits.max_local_variables, limits.max_global_variables,
+        limits.max_switch_branches, limits.max_function_args,
+        limits.max_control_flow_nesting_depth,
+        limits.max_access_chain_indexes}) {
+    AppendInteger(limit, 4, &header);
+  }
+  AppendInteger(options->relax_struct_store, 1, &header);
+  AppendInteger(options->relax_logical_pointer, 1, &header);
+  AppendInteger(options->relax_block_layout, 1, &header);
+  AppendInteger(num_words, 8, &header);
+
+  utils::Sha256 sha;
+  sha.Update(header.data(), header.size());
+  sha.Update(words, num_words * sizeof(uint32_t));
+  return sha.Finish();
+}
+
+bool ValidationCache::Load(const Key& key, Entry* entry) const {
+  FILE* file = fopen(EntryPath(key).c_str(), "rb");
+  if (!file) return false;
+  uint8_t data[kMaxEntrySize + 1];
+  const size_t size = fread(data, 1, sizeof(data), file);
+  fclose(file);
+  if (size > kMaxEntrySize) return false;
+
+  Reader reader(data, size);
+  const uint8_t* magic = reader.Bytes(sizeof(kMagic));
+  const uint8_t* stored_key = reader.Bytes(key.size());
+  if (!magic || memcmp(magic, kMagic, sizeof(kMagic)) != 0) return false;
+  if (!stored_key || memcmp(stored_key, key.data(), key.size()) != 0) {
+    return false;
+  }
+
+  Entry loaded;
+  loaded.result = static_cast<spv_result_t>(
+      static_cast<int32_t>(static_cast<uint32_t>(reader.Integer(4))));
+  const uint64_t num_messages = reader.Integer(4);
+  for (uint64_t i = 0; i < num_messages && !reader.failed(); ++i) {
+    Message message;
+    message.level = static_cast<spv_message_level_t>(reader.Integer(4));
+    message.source = reader.String();
+    message.position.line = static_cast<size_t>(reader.Integer(8));
+    message.position.column = static_cast<size_t>(reader.Integer(8));
+    message.position.index = static_cast<size_t>(reader.Integer(8));
+    message.text = reader.String();
+    loaded.messages.push_back(message);
+  }
+  if (reader.failed() || !reader.AtEnd()) return false;
+  *entry = std::move(loaded);
+  return true;
+}
+
+void ValidationCache::Store(const Key& key, const Entry& entry) const {
+  std::vector<uint8_t> data(kMagic, kMagic + sizeof(kMagic));
+  data.insert(data.end(), key.begin(), key.end());
+  AppendInteger(static_cast<uint32_t>(entry.result), 4, &data);
+  AppendInteger(entry.messages.size(), 4, &data);
+  for (const Message& message : entry.messages) {
+    AppendInteger(static_cast<uint32_t>(message.level), 4, &data);
+    AppendString(message.source, &data);
+    AppendInteger(message.position.line, 8, &data);
+    AppendInteger(message.position.column, 8, &data);
+    AppendInteger(message.position.index, 8, &data);
+    AppendString(message.text, &data);
+    if (data.size() > kMaxEntrySize) return;
+  }
+
+  // Readers see either the old file or the complete new one.
+  const std::string path = EntryPath(key);
+  const std::string temp_path = path + UniqueSuffix();
+  FILE* file = fopen(temp_path.c_str(), "wb");
+  if (!file) return;
+  const bool written = fwrite(data.data(), 1, data.size(), file) ==
+                       data.size();
+  if (fclose(file) != 0 || !written) {
+    remove(temp_path.c_str());
+    return;
+  }
+  if (rename(temp_path.c_str(), path.c_str()) != 0) {
+    // Some platforms do not replace an existing file.
+    remove(path.c_str());
+    if (rename(temp_path.c_str(), path.c_str()) != 0) {
+      remove(temp_path.c_str());
+    }
+  }
+}
+
+std::string ValidationCache::EntryPath(const Key& key) const {
+  uint64_t prefix = 0;
+  for (size_t i = 0; i < 8; ++i) prefix = prefix << 8 | key[i];
+  std::string path = directory_;
+  if (!path.empty() && path.back() != '/' && path.back() != '\\') {
+    path.push_back('/');
+  }
+  return path + "spirv-val-" + std::to_string(prefix % num_files_);
+}
+
+}  // namespace spvtools
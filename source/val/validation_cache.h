@@ -0,0 +1,89 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_VAL_VALIDATIONCACHE_H_
+#define LIBSPIRV_VAL_VALIDATIONCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "spirv-tools/libspirv.h"
+#include "util/sha256.h"
+
+namespace spvtools {
+
+/// A directory of files recording the outcome of validating modules, so that a
+/// module which was validated before does not need to be validated again.
+///
+/// An outcome is found by a key which is a digest of everything it depends on:
+/// the words of the module, the target environment, the validator options and
+/// the version of the library. Each key maps to one of a fixed number of files,
+/// chosen so that the files together stay within the size given to the cache.
+/// Recording an outcome replaces whichever outcome used the same file.
+///
+/// Files are written under a temporary name and then renamed, so several
+/// processes may share a directory. The cache is only an optimization: any
+/// failure to read or write it is ignored.
+class ValidationCache {
+ public:
+  /// A message the validator sent to the message consumer.
+  struct Message {
+    spv_message_level_t level;
+    std::string source;
+    spv_position_t position;
+    std::string text;
+  };
+
+  /// The outcome of validating a module.
+  struct Entry {
+    spv_result_t result = SPV_SUCCESS;
+    std::vector<Message> messages;
+  };
+
+  using Key = utils::Sha256::Digest;
+
+  /// The largest file kept for an outcome, in bytes. Outcomes with more
+  /// messages than fit are not recorded.
+  static const size_t kMaxEntrySize = 4096;
+
+  /// Creates a cache in |directory|, which must exist, using at most
+  /// |max_size| bytes but always room for at least one outcome.
+  ValidationCache(const std::string& directory, size_t max_size);
+
+  /// Returns the key for validating the |num_words| words at |words| for |env|
+  /// with |options|. The number of threads is not part of the key, since it
+  /// does not change the outcome.
+  static Key ComputeKey(spv_target_env env,
+                        spv_const_validator_options options,
+                        const uint32_t* words, size_t num_words);
+
+  /// Returns true and fills in |entry| if an outcome is recorded for |key|.
+  bool Load(const Key& key, Entry* entry) const;
+
+  /// Records |entry| as the outcome for |key|.
+  void Store(const Key& key, const Entry& entry) const;
+
+  /// Returns the path of the file which holds the outcome for |key|, if any.
+  std::string EntryPath(const Key& key) const;
+
+ private:
+  std::string directory_;
+  size_t num_files_;
+};
+
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_VAL_VALIDATIONCACHE_H_
@@ -18,12 +18,12 @@
 #include <stack>
 
 #include "opcode.h"
+#include "spirv_endian.h"
 #include "val/basic_block.h"
 #include "val/construct.h"
 #include "val/function.h"
 
 using std::deque;
-using std::make_pair;
 using std::pair;
 using std::string;
 using std::unordered_map;
@@ -147,8 +147,10 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
                                      const size_t num_words)
     : context_(ctx),
       options_(opt),
-      words_(words),
+      raw_words_(words),
       num_words_(num_words),
+      converted_words_(),
+      words_(words),
       instruction_counter_(0),
       unresolved_forward_ids_{},
       operand_names_{},
@@ -157,16 +159,25 @@ ValidationState_t::ValidationState_t(const spv_const_context ctx,
       module_capabilities_(),
       module_extensions_(),
       ordered_instructions_(),
-      all_definitions_(),
+      operand_pool_(),
       global_vars_(),
       local_vars_(),
-      struct_nesting_depth_(),
       grammar_(ctx),
       addressing_model_(SpvAddressingModelMax),
       memory_model_(SpvMemoryModelMax),
       in_function_(false) {
   assert(opt && "Validator options may not be Null.");
 
+  // The parser converts a module of the other byte order into
+  // |converted_words_|, and the instructions point there instead.
+  spv_const_binary_t binary = {words, num_words};
+  spv_endianness_t endian;
+  if (spvBinaryEndianness(&binary, &endian) == SPV_SUCCESS &&
+      !spvIsHostEndian(endian)) {
+    converted_words_.resize(num_words);
+    words_ = converted_words_.data();
+  }
+
   switch (context_->target_env) {
     case SPV_ENV_WEBGPU_0:
       features_.bans_op_undef = true;
@@ -229,19 +240,15 @@ vector<uint32_t> ValidationState_t::UnresolvedForwardIds() const {
 }
 
 bool ValidationState_t::IsDefinedId(uint32_t id) const {
-  return all_definitions_.find(id) != end(all_definitions_);
+  return all_definitions_.Get(id) != nullptr;
 }
 
 const Instruction* ValidationState_t::FindDef(uint32_t id) const {
-  auto it = all_definitions_.find(id);
-  if (it == all_definitions_.end()) return nullptr;
-  return it->second;
+  return all_definitions_.Get(id);
 }
 
 Instruction* ValidationState_t::FindDef(uint32_t id) {
-  auto it = all_definitions_.find(id);
-  if (it == all_definitions_.end()) return nullptr;
-  return it->second;
+  return all_definitions_.Get(id);
 }
 
 // Increments the instruction count. Used for diagnostic
@@ -294,9 +301,7 @@ const Function& ValidationState_t::current_function() const {
 }
 
 const Function* ValidationState_t::function(uint32_t id) const {
-  const auto it = id_to_function_.find(id);
-  if (it == id_to_function_.end()) return nullptr;
-  return it->second;
+  return id_to_function_.Get(id);
 }
 
 bool ValidationState_t::in_function_body() const { return in_function_; }
@@ -413,7 +418,8 @@ spv_result_t ValidationState_t::RegisterFunction(
   in_function_ = true;
   module_functions_.emplace_back(id, ret_type_id, function_control,
                                  function_type_id);
-  id_to_function_.emplace(id, &current_function());
+  Function*& function = id_to_function_[id];
+  if (!function) function = &current_function();
 
   // TODO(umar): validate function type and type_id
 
@@ -434,8 +440,14 @@ spv_result_t ValidationState_t::RegisterFunctionEnd() {
 
 void ValidationState_t::RegisterInstruction(
     const spv_parsed_instruction_t& inst) {
+  // The instructions borrow the words of the module in host endianness.
+  assert(inst.words >= words_ &&
+         inst.words + inst.num_words <= words_ + num_words_ &&
+         "The module must be parsed into converted_words().");
+
   if (in_function_body()) {
-    ordered_instructions_.emplace_back(&inst, &current_function(),
+    ordered_instructions_.emplace_back(&inst, &operand_pool_,
+                                       &current_function(),
                                        current_function().current_block());
     if (in_block() &&
         spvOpcodeIsBlockTerminator(static_cast<SpvOp>(inst.opcode))) {
@@ -443,13 +455,14 @@ void ValidationState_t::RegisterInstruction(
           &ordered_instructions_.back());
     }
   } else {
-    ordered_instructions_.emplace_back(&inst, nullptr, nullptr);
+    ordered_instructions_.emplace_back(&inst, &operand_pool_);
   }
   ordered_instructions_.back().SetInstructionPosition(instruction_counter_);
 
   uint32_t id = ordered_instructions_.back().id();
   if (id) {
-    all_definitions_.insert(make_pair(id, &ordered_instructions_.back()));
+    Instruction*& definition = all_definitions_[id];
+    if (!definition) definition = &ordered_instructions_.back();
   }
 
   // If the instruction is using an OpTypeSampledImage as an operand, it should
@@ -484,7 +497,13 @@ void ValidationState_t::RegisterSampledImageConsumer(uint32_t sampled_image_id,
 
 uint32_t ValidationState_t::getIdBound() const { return id_bound_; }
 
-void ValidationState_t::setIdBound(const uint32_t bound) { id_bound_ = bound; }
+void ValidationState_t::setIdBound(const uint32_t bound) {
+  id_bound_ = bound;
+  all_definitions_.Reserve(bound, num_words_);
+  id_to_function_.Reserve(bound, num_words_);
+  struct_nesting_depth_.Reserve(bound, num_words_);
+  id_decorations_.Reserve(bound, num_words_);
+}
 
 bool ValidationState_t::RegisterUniqueTypeDeclaration(
     const spv_parsed_instruction_t& inst) {
@@ -865,8 +884,8 @@ const std::vector<uint32_t>& ValidationState_t::FunctionEntryPoints(
 }
 
 std::string ValidationState_t::Disassemble(const Instruction& inst) const {
-  const spv_parsed_instruction_t& c_inst(inst.c_inst());
-  return Disassemble(c_inst.words, c_inst.num_words);
+  const auto words = inst.words();
+  return Disassemble(words.data(), static_cast<uint16_t>(words.size()));
 }
 
 std::string ValidationState_t::Disassemble(const uint32_t* words,
@@ -875,7 +894,8 @@ std::string ValidationState_t::Disassemble(const uint32_t* words,
                                  SPV_BINARY_TO_TEXT_OPTION_FRIENDLY_NAMES;
 
   return spvInstructionBinaryToText(context()->target_env, words, num_words,
-                                    words_, num_words_, disassembly_options);
+                                    raw_words_, num_words_,
+                                    disassembly_options);
 }
 
 }  // namespace spvtools
@@ -31,6 +31,7 @@
 #include "latest_version_spirv_header.h"
 #include "spirv-tools/libspirv.h"
 #include "spirv_definition.h"
+#include "util/id_table.h"
 #include "val/function.h"
 #include "val/instruction.h"
 
@@ -92,6 +93,13 @@ class ValidationState_t {
   /// Returns the command line options
   spv_const_validator_options options() const { return options_; }
 
+  /// Returns the buffer the parser should convert the module into, so that the
+  /// instructions can point into it, or nullptr if the module is already in
+  /// host endianness.
+  uint32_t* converted_words() {
+    return converted_words_.empty() ? nullptr : converted_words_.data();
+  }
+
   /// Forward declares the id in the module
   spv_result_t ForwardDeclareId(uint32_t id);
 
@@ -314,20 +322,12 @@ class ValidationState_t {
   }
 
   /// Returns all the decorations for the given <id>. If no decorations exist
-  /// for the <id>, it registers an empty vector for it in the map and
-  /// returns the empty vector.
+  /// for the <id>, returns an empty vector.
   std::vector<Decoration>& id_decorations(uint32_t id) {
     return id_decorations_[id];
   }
   const std::vector<Decoration>& id_decorations(uint32_t id) const {
-    // TODO: This would throw or generate SIGABRT if id has no
-    // decorations. Remove/refactor this function.
-    return id_decorations_.at(id);
-  }
-
-  // Returns const pointer to the internal decoration container.
-  const std::map<uint32_t, std::vector<Decoration>>& id_decorations() const {
-    return id_decorations_;
+    return id_decorations_.Get(id);
   }
 
   /// Finds id's def, if it exists.  If found, returns the definition otherwise
@@ -343,11 +343,6 @@ class ValidationState_t {
     return ordered_instructions_;
   }
 
-  /// Returns a map of instructions mapped by their result id
-  const std::unordered_map<uint32_t, Instruction*>& all_definitions() const {
-    return all_definitions_;
-  }
-
   /// Returns a vector containing the Ids of instructions that consume the given
   /// SampledImage id.
   std::vector<uint32_t> getSampledImageConsumers(uint32_t id) const;
@@ -380,8 +375,8 @@ class ValidationState_t {
   }
 
   /// Returns the nesting depth of a given structure ID
-  uint32_t struct_nesting_depth(uint32_t id) {
-    return struct_nesting_depth_[id];
+  uint32_t struct_nesting_depth(uint32_t id) const {
+    return struct_nesting_depth_.Get(id);
   }
 
   /// Records that the structure type has a member decorated with a built-in.
@@ -490,10 +485,17 @@ class ValidationState_t {
   /// Stores the Validator command line options. Must be a valid options object.
   const spv_const_validator_options options_;
 
-  /// The SPIR-V binary module we're validating.
-  const uint32_t* words_;
+  /// The SPIR-V binary module we're validating, as given.
+  const uint32_t* const raw_words_;
   const size_t num_words_;
 
+  /// The module in host endianness, which the parser fills in if the module
+  /// was given in the other byte order.  Empty otherwise.
+  std::vector<uint32_t> converted_words_;
+
+  /// The module in host endianness, which the instructions point into.
+  const uint32_t* words_;
+
   /// Tracks the number of instructions evaluated by the validator
   int instruction_counter_;
 
@@ -529,8 +531,11 @@ class ValidationState_t {
   /// valid until the end of lifetime of the validation state.
   std::deque<Instruction> ordered_instructions_;
 
-  /// Instructions that can be referenced by Ids
-  std::unordered_map<uint32_t, Instruction*> all_definitions_;
+  /// The operands of all instructions in |ordered_instructions_|, in order.
+  std::vector<spv_parsed_operand_t> operand_pool_;
+
+  /// Instructions that can be referenced by Ids, indexed by result id
+  utils::IdTable<Instruction*> all_definitions_;
 
   /// IDs that are entry points, ie, arguments to OpEntryPoint.
   std::vector<uint32_t> entry_points_;
@@ -555,10 +560,10 @@ class ValidationState_t {
   std::unordered_set<uint32_t> builtin_structs_;
 
   /// Structure Nesting Depth
-  std::unordered_map<uint32_t, uint32_t> struct_nesting_depth_;
+  utils::IdTable<uint32_t> struct_nesting_depth_;
 
   /// Stores the list of decorations for a given <id>
-  std::map<uint32_t, std::vector<Decoration>> id_decorations_;
+  utils::IdTable<std::vector<Decoration>> id_decorations_;
 
   /// Stores type declarations which need to be unique (i.e. non-aggregates),
   /// in the form [opcode, operand words], result_id is not stored.
@@ -579,7 +584,7 @@ class ValidationState_t {
   Feature features_;
 
   /// Maps function ids to function stat objects.
-  std::unordered_map<uint32_t, Function*> id_to_function_;
+  utils::IdTable<Function*> id_to_function_;
 
   /// Mapping entry point -> execution models. It is presumed that the same
   /// function could theoretically be used as 'main' by multiple OpEntryPoint
@@ -40,6 +40,7 @@
 #include "val/construct.h"
 #include "val/function.h"
 #include "val/instruction.h"
+#include "val/validation_cache.h"
 #include "val/validation_state.h"
 
 using std::function;
@@ -60,13 +61,10 @@ using spvtools::LiteralsPass;
 using spvtools::ModuleLayoutPass;
 using spvtools::ValidationState_t;
 
-spv_result_t spvValidateIDs(const spv_instruction_t* pInsts,
-                            const uint64_t count,
-                            const ValidationState_t& state,
+spv_result_t spvValidateIDs(const ValidationState_t& state,
                             spv_position position) {
   position->index = SPV_INDEX_INSTRUCTION;
-  if (auto error = spvValidateInstructionIDs(pInsts, count, state, position))
-    return error;
+  if (auto error = spvValidateInstructionIDs(state, position)) return error;
   return SPV_SUCCESS;
 }
 
@@ -120,37 +118,44 @@ void DebugInstructionPass(ValidationState_t& _,
   }
 }
 
-// Parses OpExtension instruction and registers extension.
-void RegisterExtension(ValidationState_t& _,
-                       const spv_parsed_instruction_t* inst) {
-  const std::string extension_str = spvtools::GetExtensionString(inst);
-  Extension extension;
-  if (!GetExtensionFromString(extension_str.c_str(), &extension)) {
-    // The error will be logged in the ProcessInstruction pass.
-    return;
-  }
-
-  _.RegisterExtension(extension);
-}
+// Scans the words of the beginning of the module for OpExtension
+// instructions, and registers extensions if recognized. Stops at the first
+// instruction which is not SpvOpCapability or SpvOpExtension. According to the
+// SPIR-V spec extensions are declared after capabilities and before everything
+// else.
+//
+// This only looks at the raw words of that preamble, so that the module is
+// fully parsed only once. Malformed instructions end the scan; they are
+// diagnosed when the module is parsed.
+void ProcessExtensions(ValidationState_t& _, const uint32_t* words,
+                       const size_t num_words, spv_endianness_t endian) {
+  size_t index = SPV_INDEX_INSTRUCTION;
+  while (index < num_words) {
+    uint16_t word_count;
+    uint16_t opcode;
+    spvOpcodeSplit(spvFixWord(words[index], endian), &word_count, &opcode);
+    if (word_count == 0 || word_count > num_words - index) return;
+
+    if (opcode == SpvOpExtension) {
+      // The extension name is a nul-terminated string packed into the words
+      // following the first one. Like the binary parser, read its bytes in
+      // order without converting the words to host order.
+      const char* str = reinterpret_cast<const char*>(words + index + 1);
+      const char* str_end = str + 4 * (word_count - 1);
+      const bool terminated = std::find(str, str_end, '\0') != str_end;
+
+      // The error, if any, will be logged in the ProcessInstruction pass.
+      Extension extension;
+      if (terminated && GetExtensionFromString(str, &extension)) {
+        _.RegisterExtension(extension);
+      }
+    } else if (opcode != SpvOpCapability) {
+      // OpExtension block is finished.
+      return;
+    }
 
-// Parses the beginning of the module searching for OpExtension instructions.
-// Registers extensions if recognized. Returns SPV_REQUESTED_TERMINATION
-// once an instruction which is not SpvOpCapability and SpvOpExtension is
-// encountered. According to the SPIR-V spec extensions are declared after
-// capabilities and before everything else.
-spv_result_t ProcessExtensions(void* user_data,
-                               const spv_parsed_instruction_t* inst) {
-  const SpvOp opcode = static_cast<SpvOp>(inst->opcode);
-  if (opcode == SpvOpCapability) return SPV_SUCCESS;
-
-  if (opcode == SpvOpExtension) {
-    ValidationState_t& _ = *(reinterpret_cast<ValidationState_t*>(user_data));
-    RegisterExtension(_, inst);
-    return SPV_SUCCESS;
+    index += word_count;
   }
-
-  // OpExtension block is finished, requesting termination.
-  return SPV_REQUESTED_TERMINATION;
 }
 
 spv_result_t ProcessInstruction(void* user_data,
@@ -279,14 +284,15 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
 
   // Look for OpExtension instructions and register extensions.
   // Diagnostics if any will be produced in the next pass (ProcessInstruction).
-  spvBinaryParse(&context, vstate, words, num_words,
-                 /* parsed_header = */ nullptr, ProcessExtensions,
-                 /* diagnostic = */ nullptr);
+  ProcessExtensions(*vstate, words, num_words, endian);
 
   // NOTE: Parse the module and perform inline validation checks. These
-  // checks do not require the the knowledge of the whole module.
-  if (auto error = spvBinaryParse(&context, vstate, words, num_words, setHeader,
-                                  ProcessInstruction, pDiagnostic))
+  // checks do not require the the knowledge of the whole module. A module of
+  // the other byte order is converted once, into the validation state, which
+  // the instructions then point into.
+  if (auto error = spvBinaryParseInto(&context, vstate, words, num_words,
+                                      vstate->converted_words(), setHeader,
+                                      ProcessInstruction, pDiagnostic))
     return error;
 
   if (!vstate->has_memory_model_specified())
@@ -348,32 +354,56 @@ spv_result_t ValidateBinaryUsingContextAndValidationState(
     }
   }
 
-  // NOTE: Copy each instruction for easier processing
-  std::vector<spv_instruction_t> instructions;
-  // Expect average instruction length to be a bit over 2 words.
-  instructions.reserve(binary->wordCount / 2);
-  uint64_t index = SPV_INDEX_INSTRUCTION;
-  while (index < binary->wordCount) {
-    uint16_t wordCount;
-    uint16_t opcode;
-    spvOpcodeSplit(spvFixWord(binary->code[index], endian), &wordCount,
-                   &opcode);
-    spv_instruction_t inst;
-    spvInstructionCopy(&binary->code[index], static_cast<SpvOp>(opcode),
-                       wordCount, endian, &inst);
-    instructions.emplace_back(std::move(inst));
-    index += wordCount;
-  }
-
   position.index = SPV_INDEX_INSTRUCTION;
-  if (auto error = spvValidateIDs(instructions.data(), instructions.size(),
-                                  *vstate, &position))
-    return error;
+  if (auto error = spvValidateIDs(*vstate, &position)) return error;
 
   if (auto error = ValidateBuiltIns(*vstate)) return error;
 
   return SPV_SUCCESS;
 }
+
+// Validates the module as spvValidateWithOptions does, but first looks for its
+// outcome in the cache named by |options|, and records the outcome there if it
+// is not found. The recorded messages are sent to the consumer of
+// |hijack_context| as if validation had run.
+spv_result_t ValidateUsingCache(spv_context_t* hijack_context,
+                                spv_const_validator_options options,
+                                const uint32_t* words, const size_t num_words,
+                                spv_diagnostic* pDiagnostic) {
+  const spvtools::ValidationCache cache(options->cache_directory,
+                                        options->cache_max_size);
+  const auto key = spvtools::ValidationCache::ComputeKey(
+      hijack_context->target_env, options, words, num_words);
+  spvtools::ValidationCache::Entry entry;
+  const spvtools::MessageConsumer consumer = hijack_context->consumer;
+
+  if (cache.Load(key, &entry)) {
+    if (consumer) {
+      for (const auto& message : entry.messages) {
+        consumer(message.level, message.source.c_str(), message.position,
+                 message.text.c_str());
+      }
+    }
+    return entry.result;
+  }
+
+  hijack_context->consumer = [&entry, &consumer](
+                                 spv_message_level_t level, const char* source,
+                                 const spv_position_t& position,
+                                 const char* message) {
+    entry.messages.push_back(
+        {level, source ? source : "", position, message ? message : ""});
+    if (consumer) consumer(level, source, position, message);
+  };
+  ValidationState_t vstate(hijack_context, options, words, num_words);
+  entry.result = ValidateBinaryUsingContextAndValidationState(
+      *hijack_context, words, num_words, pDiagnostic, &vstate);
+  hijack_context->consumer = consumer;
+
+  // Running out of memory says nothing about the module.
+  if (entry.result != SPV_ERROR_OUT_OF_MEMORY) cache.Store(key, entry);
+  return entry.result;
+}
 }  // anonymous namespace
 
 spv_result_t spvValidate(const spv_const_context context,
@@ -415,6 +445,11 @@ spv_result_t spvValidateWithOptions(const spv_const_context context,
     spvtools::UseDiagnosticAsMessageConsumer(&hijack_context, pDiagnostic);
   }
 
+  if (!options->cache_directory.empty()) {
+    return ValidateUsingCache(&hijack_context, options, binary->code,
+                              binary->wordCount, pDiagnostic);
+  }
+
   // Create the ValidationState using the context.
   ValidationState_t vstate(&hijack_context, options, binary->code,
                            binary->wordCount);
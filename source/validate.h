@@ -197,36 +197,28 @@ spv_result_t PrimitivesPass(ValidationState_t& _,
 
 /// @brief Validate the ID usage of the instruction stream
 ///
-/// @param[in] pInsts stream of instructions
-/// @param[in] instCount number of instructions
-/// @param[in] usedefs use-def info from module parsing
+/// @param[in] state validation state holding the parsed instructions
 /// @param[in,out] position current position in the stream
 ///
 /// @return result code
-spv_result_t spvValidateInstructionIDs(const spv_instruction_t* pInsts,
-                                       const uint64_t instCount,
-                                       const spvtools::ValidationState_t& state,
+spv_result_t spvValidateInstructionIDs(const spvtools::ValidationState_t& state,
                                        spv_position position);
 
 /// @brief Validate the ID's within a SPIR-V binary
 ///
-/// @param[in] pInstructions array of instructions
-/// @param[in] count number of elements in instruction array
-/// @param[in] bound the binary header
+/// @param[in] state validation state holding the parsed instructions
 /// @param[in,out] position current word in the binary
-/// @param[in] consumer message consumer callback
 ///
 /// @return result code
-spv_result_t spvValidateIDs(const spv_instruction_t* pInstructions,
-                            const uint64_t count, const uint32_t bound,
-                            spv_position position,
-                            const spvtools::MessageConsumer& consumer);
+spv_result_t spvValidateIDs(const spvtools::ValidationState_t& state,
+                            spv_position position);
 
 namespace spvtools {
 // Performs validation for the SPIRV-V module binary.
 // The main difference between this API and spvValidateBinary is that the
 // "Validation State" is not destroyed upon function return; it lives on and is
-// pointed to by the vstate unique_ptr.
+// pointed to by the vstate unique_ptr. The instructions of the validation
+// state refer to |words|, which must outlive it.
 spv_result_t ValidateBinaryAndKeepValidationState(
     const spv_const_context context, spv_const_validator_options options,
     const uint32_t* words, const size_t num_words, spv_diagnostic* pDiagnostic,
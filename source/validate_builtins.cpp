@@ -16,6 +16,7 @@
 
 #include "validate.h"
 
+#include <algorithm>
 #include <functional>
 #include <list>
 #include <map>
@@ -2457,17 +2458,27 @@ spv_result_t BuiltInsValidator::ValidateSingleBuiltInAtDefinition(
 }
 
 spv_result_t BuiltInsValidator::ValidateBuiltInsAtDefinition() {
-  for (const auto& kv : _.id_decorations()) {
-    const uint32_t id = kv.first;
-    const auto& decorations = kv.second;
-    if (decorations.empty()) {
-      continue;
+  // Built-ins are validated in id order, so that the first error reported
+  // does not depend on where the ids are defined in the binary.
+  std::vector<const Instruction*> definitions;
+  for (const auto& inst : _.ordered_instructions()) {
+    const uint32_t id = inst.id();
+    if (!id) continue;
+
+    for (const auto& decoration : _.id_decorations(id)) {
+      if (decoration.dec_type() == SpvDecorationBuiltIn) {
+        definitions.push_back(&inst);
+        break;
+      }
     }
+  }
+  std::sort(definitions.begin(), definitions.end(),
+            [](const Instruction* lhs, const Instruction* rhs) {
+              return lhs->id() < rhs->id();
+            });
 
-    const Instruction* inst = _.FindDef(id);
-    assert(inst);
-
-    for (const auto& decoration : kv.second) {
+  for (const Instruction* inst : definitions) {
+    for (const auto& decoration : _.id_decorations(inst->id())) {
       if (decoration.dec_type() != SpvDecorationBuiltIn) {
         continue;
       }
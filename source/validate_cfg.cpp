@@ -19,6 +19,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <string>
 #include <tuple>
@@ -28,6 +29,7 @@
 #include <vector>
 
 #include "spirv_validator_options.h"
+#include "util/parallel.h"
 #include "val/basic_block.h"
 #include "val/construct.h"
 #include "val/function.h"
@@ -56,6 +58,49 @@ using bb_ptr = BasicBlock*;
 using cbb_ptr = const BasicBlock*;
 using bb_iter = vector<BasicBlock*>::const_iterator;
 
+// Numbers the dominator tree given by |edges|, pairs of a block and its
+// immediate dominator, in depth first order. Each block is passed to
+// |set_interval| with the numbers given to it before and after its subtree,
+// so that a block dominates exactly the blocks whose intervals lie within its
+// own. Numbering continues from |*number|, which is left at the last number
+// given out, so that trees numbered with the same counter never overlap.
+void NumberDominatorTree(
+    const vector<pair<bb_ptr, bb_ptr>>& edges, uint32_t* number,
+    const function<void(bb_ptr, uint32_t, uint32_t)>& set_interval) {
+  unordered_map<cbb_ptr, vector<bb_ptr>> children;
+  vector<bb_ptr> roots;
+  for (const auto& edge : edges) {
+    if (edge.first == edge.second) {
+      roots.push_back(edge.first);
+    } else {
+      children[edge.second].push_back(edge.first);
+    }
+  }
+
+  // The tree is walked without recursion, since deeply nested control flow
+  // makes for deep dominator trees.
+  struct TreeNode {
+    bb_ptr block;
+    uint32_t first;
+    size_t next_child;
+  };
+  vector<TreeNode> stack;
+  for (auto root : roots) {
+    stack.push_back({root, ++*number, 0});
+    while (!stack.empty()) {
+      TreeNode& top = stack.back();
+      const auto it = children.find(top.block);
+      if (it != children.end() && top.next_child < it->second.size()) {
+        const bb_ptr child = it->second[top.next_child++];
+        stack.push_back({child, ++*number, 0});
+      } else {
+        set_interval(top.block, top.first, ++*number);
+        stack.pop_back();
+      }
+    }
+  }
+}
+
 }  // namespace
 
 void printDominatorList(const BasicBlock& b) {
@@ -447,8 +492,100 @@ spv_result_t StructuredControlFlowChecks(
   return SPV_SUCCESS;
 }
 
+namespace {
+
+// Sets the immediate dominator, immediate postdominator and dominator tree
+// intervals of each block of |function|, numbering both trees from
+// |first_number|, and records the back-edges in |back_edges|. This only
+// writes to |function| and its blocks, so different functions can be
+// analyzed concurrently.
+void AnalyzeFunctionCfg(Function& function, uint32_t first_number,
+                        vector<pair<uint32_t, uint32_t>>* back_edges) {
+  // Set each block's immediate dominator and immediate postdominator,
+  // and find all back-edges.
+  //
+  // We want to analyze all the blocks in the function, even in degenerate
+  // control flow cases including unreachable blocks.  So use the augmented
+  // CFG to ensure we cover all the blocks.
+  vector<const BasicBlock*> postorder;
+  vector<const BasicBlock*> postdom_postorder;
+  auto ignore_block = [](cbb_ptr) {};
+  auto ignore_edge = [](cbb_ptr, cbb_ptr) {};
+  if (!function.ordered_blocks().empty()) {
+    /// calculate dominators
+    CFA<BasicBlock>::DepthFirstTraversal(
+        function.first_block(), function.AugmentedCFGSuccessorsFunction(),
+        ignore_block, [&](cbb_ptr b) { postorder.push_back(b); },
+        ignore_edge);
+    auto edges = CFA<BasicBlock>::CalculateDominators(
+        postorder, function.AugmentedCFGPredecessorsFunction());
+    for (auto edge : edges) {
+      edge.first->SetImmediateDominator(edge.second);
+    }
+    uint32_t dominator_number = first_number;
+    NumberDominatorTree(edges, &dominator_number,
+                        [](bb_ptr b, uint32_t first, uint32_t last) {
+                          b->SetDominatorInterval(first, last);
+                        });
+
+    /// calculate post dominators
+    CFA<BasicBlock>::DepthFirstTraversal(
+        function.pseudo_exit_block(),
+        function.AugmentedCFGPredecessorsFunction(), ignore_block,
+        [&](cbb_ptr b) { postdom_postorder.push_back(b); }, ignore_edge);
+    auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
+        postdom_postorder, function.AugmentedCFGSuccessorsFunction());
+    for (auto edge : postdom_edges) {
+      edge.first->SetImmediatePostDominator(edge.second);
+    }
+    uint32_t post_dominator_number = first_number;
+    NumberDominatorTree(postdom_edges, &post_dominator_number,
+                        [](bb_ptr b, uint32_t first, uint32_t last) {
+                          b->SetPostDominatorInterval(first, last);
+                        });
+    /// calculate back edges.
+    CFA<BasicBlock>::DepthFirstTraversal(
+        function.pseudo_entry_block(),
+        function.AugmentedCFGSuccessorsFunctionIncludingHeaderToContinueEdge(),
+        ignore_block, ignore_block, [&](cbb_ptr from, cbb_ptr to) {
+          back_edges->emplace_back(from->id(), to->id());
+        });
+  }
+  UpdateContinueConstructExitBlocks(function, *back_edges);
+}
+
+}  // namespace
+
 spv_result_t PerformCfgChecks(ValidationState_t& _) {
+  // Each function numbers its dominator trees from its own range, so a block
+  // never appears to dominate a block of another function. A tree holds at
+  // most the blocks of the function and its two pseudo blocks, and each of
+  // them takes two numbers.
+  vector<Function*> functions;
+  vector<uint32_t> first_numbers;
+  uint32_t next_number = 0;
   for (auto& function : _.functions()) {
+    functions.push_back(&function);
+    first_numbers.push_back(next_number);
+    const auto num_blocks =
+        static_cast<uint32_t>(function.ordered_blocks().size());
+    next_number += 2 * (num_blocks + 2);
+  }
+
+  // The analysis of the functions is spread over the validator's threads.
+  // The checks below stay serial, in function order: they report through
+  // |_|, whose diagnostics go straight to the context's consumer, and the
+  // first failing function must be the one reported. A function with
+  // undefined blocks is not analyzed, as it fails the first check.
+  vector<vector<pair<uint32_t, uint32_t>>> back_edges(functions.size());
+  utils::ParallelFor(
+      _.options()->num_threads, functions.size(), [&](size_t i) {
+        if (functions[i]->undefined_block_count() != 0) return;
+        AnalyzeFunctionCfg(*functions[i], first_numbers[i], &back_edges[i]);
+      });
+
+  for (size_t i = 0; i < functions.size(); ++i) {
+    Function& function = *functions[i];
     // Check all referenced blocks are defined within a function
     if (function.undefined_block_count() != 0) {
       string undef_blocks("{");
@@ -467,50 +604,6 @@ spv_result_t PerformCfgChecks(ValidationState_t& _) {
              << _.getIdName(function.id());
     }
 
-    // Set each block's immediate dominator and immediate postdominator,
-    // and find all back-edges.
-    //
-    // We want to analyze all the blocks in the function, even in degenerate
-    // control flow cases including unreachable blocks.  So use the augmented
-    // CFG to ensure we cover all the blocks.
-    vector<const BasicBlock*> postorder;
-    vector<const BasicBlock*> postdom_postorder;
-    vector<pair<uint32_t, uint32_t>> back_edges;
-    auto ignore_block = [](cbb_ptr) {};
-    auto ignore_edge = [](cbb_ptr, cbb_ptr) {};
-    if (!function.ordered_blocks().empty()) {
-      /// calculate dominators
-      CFA<BasicBlock>::DepthFirstTraversal(
-          function.first_block(), function.AugmentedCFGSuccessorsFunction(),
-          ignore_block, [&](cbb_ptr b) { postorder.push_back(b); },
-          ignore_edge);
-      auto edges = CFA<BasicBlock>::CalculateDominators(
-          postorder, function.AugmentedCFGPredecessorsFunction());
-      for (auto edge : edges) {
-        edge.first->SetImmediateDominator(edge.second);
-      }
-
-      /// calculate post dominators
-      CFA<BasicBlock>::DepthFirstTraversal(
-          function.pseudo_exit_block(),
-          function.AugmentedCFGPredecessorsFunction(), ignore_block,
-          [&](cbb_ptr b) { postdom_postorder.push_back(b); }, ignore_edge);
-      auto postdom_edges = CFA<BasicBlock>::CalculateDominators(
-          postdom_postorder, function.AugmentedCFGSuccessorsFunction());
-      for (auto edge : postdom_edges) {
-        edge.first->SetImmediatePostDominator(edge.second);
-      }
-      /// calculate back edges.
-      CFA<BasicBlock>::DepthFirstTraversal(
-          function.pseudo_entry_block(),
-          function
-              .AugmentedCFGSuccessorsFunctionIncludingHeaderToContinueEdge(),
-          ignore_block, ignore_block, [&](cbb_ptr from, cbb_ptr to) {
-            back_edges.emplace_back(from->id(), to->id());
-          });
-    }
-    UpdateContinueConstructExitBlocks(function, back_edges);
-
     auto& blocks = function.ordered_blocks();
     if (!blocks.empty()) {
       // Check if the order of blocks in the binary appear before the blocks
@@ -545,7 +638,7 @@ spv_result_t PerformCfgChecks(ValidationState_t& _) {
 
     /// Structured control flow checks are only required for shader capabilities
     if (_.HasCapability(SpvCapabilityShader)) {
-      if (auto error = StructuredControlFlowChecks(_, &function, back_edges))
+      if (auto error = StructuredControlFlowChecks(_, &function, back_edges[i]))
         return error;
     }
   }
@@ -16,57 +16,60 @@
 
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <string>
-#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 
 #include "diagnostic.h"
 #include "opcode.h"
 #include "spirv_target_env.h"
 #include "spirv_validator_options.h"
+#include "struct_layout.h"
 #include "val/validation_state.h"
 
 namespace spvtools {
 namespace {
 
-using std::make_pair;
+// Gives StructLayoutCache access to the types and decorations of the module
+// being validated.
+class ValidationLayoutSource : public LayoutTypeSource {
+ public:
+  explicit ValidationLayoutSource(const ValidationState_t& vstate)
+      : vstate_(vstate) {}
 
-// Distinguish between row and column major matrix layouts.
-enum MatrixLayout { kRowMajor, kColumnMajor };
-
-// A functor for hashing a pair of integers.
-struct PairHash {
-  std::size_t operator()(const std::pair<uint32_t, uint32_t> pair) const {
-    const uint32_t a = pair.first;
-    const uint32_t b = pair.second;
-    const uint32_t rotated_b = (b >> 2) | ((b & 3) << 30);
-    return a ^ rotated_b;
+  SpvOp GetOpcode(uint32_t id) const override {
+    return vstate_.FindDef(id)->opcode();
   }
-};
 
-// Struct member layout attributes that are inherited through arrays.
-struct LayoutConstraints {
-  explicit LayoutConstraints(
-      MatrixLayout the_majorness = MatrixLayout::kColumnMajor,
-      uint32_t stride = 0)
-      : majorness(the_majorness), matrix_stride(stride) {}
-  MatrixLayout majorness;
-  uint32_t matrix_stride;
-};
+  uint32_t NumInOperands(uint32_t id) const override {
+    const auto inst = vstate_.FindDef(id);
+    return uint32_t(inst->words().size() - FirstInOperand(*inst));
+  }
 
-// A type for mapping (struct id, member id) to layout constraints.
-using MemberConstraints = std::unordered_map<std::pair<uint32_t, uint32_t>,
-                                             LayoutConstraints, PairHash>;
+  uint32_t GetInOperand(uint32_t id, uint32_t index) const override {
+    const auto inst = vstate_.FindDef(id);
+    return inst->words()[FirstInOperand(*inst) + index];
+  }
 
-// Returns the array stride of the given array type.
-uint32_t GetArrayStride(uint32_t array_id, ValidationState_t& vstate) {
-  for (auto& decoration : vstate.id_decorations(array_id)) {
-    if (SpvDecorationArrayStride == decoration.dec_type()) {
-      return decoration.params()[0];
+  void ForEachDecoration(
+      uint32_t id,
+      const std::function<void(int member, SpvDecoration decoration,
+                               uint32_t value)>& f) const override {
+    for (const auto& decoration : vstate_.id_decorations(id)) {
+      f(decoration.struct_member_index(), decoration.dec_type(),
+        decoration.params().empty() ? 0 : decoration.params()[0]);
     }
   }
-  return 0;
-}
+
+ private:
+  // Returns the index of the first word of |inst| after its result id.
+  static size_t FirstInOperand(const Instruction& inst) {
+    return inst.type_id() ? 3 : 2;
+  }
+
+  const ValidationState_t& vstate_;
+};
 
 // Returns true if the given variable has a BuiltIn decoration.
 bool isBuiltInVar(uint32_t var_id, ValidationState_t& vstate) {
@@ -147,152 +150,6 @@ uint32_t align(uint32_t x, uint32_t alignment) {
   return (x + alignment - 1) & ~(alignment - 1);
 }
 
-// Returns base alignment of struct member. If |roundUp| is true, also
-// ensure that structs and arrays are aligned at least to a multiple of 16
-// bytes.
-uint32_t getBaseAlignment(uint32_t member_id, bool roundUp,
-                          const LayoutConstraints& inherited,
-                          MemberConstraints& constraints,
-                          ValidationState_t& vstate) {
-  const auto inst = vstate.FindDef(member_id);
-  const auto& words = inst->words();
-  uint32_t baseAlignment = 0;
-  switch (inst->opcode()) {
-    case SpvOpTypeInt:
-    case SpvOpTypeFloat:
-      baseAlignment = words[2] / 8;
-      break;
-    case SpvOpTypeVector: {
-      const auto componentId = words[2];
-      const auto numComponents = words[3];
-      const auto componentAlignment = getBaseAlignment(
-          componentId, roundUp, inherited, constraints, vstate);
-      baseAlignment =
-          componentAlignment * (numComponents == 3 ? 4 : numComponents);
-      break;
-    }
-    case SpvOpTypeMatrix: {
-      const auto column_type = words[2];
-      if (inherited.majorness == kColumnMajor) {
-        baseAlignment = getBaseAlignment(column_type, roundUp, inherited,
-                                         constraints, vstate);
-      } else {
-        // A row-major matrix of C columns has a base alignment equal to the
-        // base alignment of a vector of C matrix components.
-        const auto num_columns = words[3];
-        const auto component_inst = vstate.FindDef(column_type);
-        const auto component_id = component_inst->words()[2];
-        const auto componentAlignment = getBaseAlignment(
-            component_id, roundUp, inherited, constraints, vstate);
-        baseAlignment =
-            componentAlignment * (num_columns == 3 ? 4 : num_columns);
-      }
-    } break;
-    case SpvOpTypeArray:
-    case SpvOpTypeRuntimeArray:
-      baseAlignment =
-          getBaseAlignment(words[2], roundUp, inherited, constraints, vstate);
-      if (roundUp) baseAlignment = align(baseAlignment, 16u);
-      break;
-    case SpvOpTypeStruct: {
-      const auto members = getStructMembers(member_id, vstate);
-      for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
-           memberIdx < numMembers; ++memberIdx) {
-        const auto id = members[memberIdx];
-        const auto& constraint = constraints[make_pair(member_id, memberIdx)];
-        baseAlignment = std::max(
-            baseAlignment,
-            getBaseAlignment(id, roundUp, constraint, constraints, vstate));
-      }
-      if (roundUp) baseAlignment = align(baseAlignment, 16u);
-      break;
-    }
-    default:
-      assert(0);
-      break;
-  }
-
-  return baseAlignment;
-}
-
-// Returns size of a struct member. Doesn't include padding at the end of struct
-// or array.  Assumes that in the struct case, all members have offsets.
-uint32_t getSize(uint32_t member_id, bool roundUp,
-                 const LayoutConstraints& inherited,
-                 MemberConstraints& constraints, ValidationState_t& vstate) {
-  const auto inst = vstate.FindDef(member_id);
-  const auto& words = inst->words();
-  switch (inst->opcode()) {
-    case SpvOpTypeInt:
-    case SpvOpTypeFloat:
-      return getBaseAlignment(member_id, roundUp, inherited, constraints,
-                              vstate);
-    case SpvOpTypeVector: {
-      const auto componentId = words[2];
-      const auto numComponents = words[3];
-      const auto componentSize =
-          getSize(componentId, roundUp, inherited, constraints, vstate);
-      const auto size = componentSize * numComponents;
-      return size;
-    }
-    case SpvOpTypeArray: {
-      const auto sizeInst = vstate.FindDef(words[3]);
-      if (spvOpcodeIsSpecConstant(sizeInst->opcode())) return 0;
-      assert(SpvOpConstant == sizeInst->opcode());
-      const uint32_t num_elem = sizeInst->words()[3];
-      const uint32_t elem_type = words[2];
-      const uint32_t elem_size =
-          getSize(elem_type, roundUp, inherited, constraints, vstate);
-      // Account for gaps due to alignments in the first N-1 elements,
-      // then add the size of the last element.
-      const auto size =
-          (num_elem - 1) * GetArrayStride(member_id, vstate) + elem_size;
-      return size;
-    }
-    case SpvOpTypeRuntimeArray:
-      return 0;
-    case SpvOpTypeMatrix: {
-      const auto num_columns = words[3];
-      if (inherited.majorness == kColumnMajor) {
-        return num_columns * inherited.matrix_stride;
-      } else {
-        // Row major case.
-        const auto column_type = words[2];
-        const auto component_inst = vstate.FindDef(column_type);
-        const auto num_rows = component_inst->words()[3];
-        const auto scalar_elem_type = component_inst->words()[2];
-        const uint32_t scalar_elem_size =
-            getSize(scalar_elem_type, roundUp, inherited, constraints, vstate);
-        return (num_rows - 1) * inherited.matrix_stride +
-               num_columns * scalar_elem_size;
-      }
-    }
-    case SpvOpTypeStruct: {
-      const auto& members = getStructMembers(member_id, vstate);
-      if (members.empty()) return 0;
-      const auto lastIdx = uint32_t(members.size() - 1);
-      const auto& lastMember = members.back();
-      uint32_t offset = 0xffffffff;
-      // Find the offset of the last element and add the size.
-      for (auto& decoration : vstate.id_decorations(member_id)) {
-        if (SpvDecorationOffset == decoration.dec_type() &&
-            decoration.struct_member_index() == (int)lastIdx) {
-          offset = decoration.params()[0];
-        }
-      }
-      // This check depends on the fact that all members have offsets.  This
-      // has been checked earlier in the flow.
-      assert(offset != 0xffffffff);
-      const auto& constraint = constraints[make_pair(lastMember, lastIdx)];
-      return offset +
-             getSize(lastMember, roundUp, constraint, constraints, vstate);
-    }
-    default:
-      assert(0);
-      return 0;
-  }
-}
-
 // A member is defined to improperly straddle if either of the following are
 // true:
 // - It is a vector with total size less than or equal to 16 bytes, and has
@@ -302,9 +159,8 @@ uint32_t getSize(uint32_t member_id, bool roundUp,
 // decorations placing its first byte at a non-integer multiple of 16.
 bool hasImproperStraddle(uint32_t id, uint32_t offset,
                          const LayoutConstraints& inherited,
-                         MemberConstraints& constraints,
-                         ValidationState_t& vstate) {
-  const auto size = getSize(id, false, inherited, constraints, vstate);
+                         StructLayoutCache& layout) {
+  const auto size = layout.Size(id, false, inherited);
   const auto F = offset;
   const auto L = offset + size - 1;
   if (size <= 16) {
@@ -325,10 +181,12 @@ bool IsAlignedTo(uint32_t offset, uint32_t alignment) {
 // Returns SPV_SUCCESS if the given struct satisfies standard layout rules for
 // Block or BufferBlocks in Vulkan.  Otherwise emits a diagnostic and returns
 // something other than SPV_SUCCESS.  Matrices inherit the specified column
-// or row major-ness.
+// or row major-ness.  Structs which satisfy the rules are recorded in
+// |checked|, and are not checked again.
 spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
                          const char* decoration_str, bool blockRules,
-                         MemberConstraints& constraints,
+                         StructLayoutCache& layout,
+                         std::unordered_set<uint32_t>& checked,
                          ValidationState_t& vstate) {
   auto fail = [&vstate, struct_id, storage_class_str, decoration_str,
                blockRules](uint32_t member_idx) -> DiagnosticStream {
@@ -342,31 +200,21 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
     return ds;
   };
   if (vstate.options()->relax_block_layout) return SPV_SUCCESS;
+  if (checked.count(struct_id)) return SPV_SUCCESS;
   const auto& members = getStructMembers(struct_id, vstate);
+  const auto& offsets = layout.MemberOffsets(struct_id);
   uint32_t prevOffset = 0;
   uint32_t nextValidOffset = 0;
   for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
        memberIdx < numMembers; memberIdx++) {
     auto id = members[memberIdx];
-    uint32_t offset = 0xffffffff;
-    for (auto& decoration : vstate.id_decorations(struct_id)) {
-      if (decoration.struct_member_index() == (int)memberIdx) {
-        switch (decoration.dec_type()) {
-          case SpvDecorationOffset:
-            offset = decoration.params()[0];
-            break;
-          default:
-            break;
-        }
-      }
-    }
+    const uint32_t offset = offsets[memberIdx];
     const LayoutConstraints& constraint =
-        constraints[make_pair(struct_id, uint32_t(memberIdx))];
-    const auto alignment =
-        getBaseAlignment(id, blockRules, constraint, constraints, vstate);
+        layout.MemberConstraints(struct_id, memberIdx);
+    const auto alignment = layout.BaseAlignment(id, blockRules, constraint);
     const auto inst = vstate.FindDef(id);
     const auto opcode = inst->opcode();
-    const auto size = getSize(id, blockRules, constraint, constraints, vstate);
+    const auto size = layout.Size(id, blockRules, constraint);
     // Check offset.
     if (offset == 0xffffffff)
       return fail(memberIdx) << "is missing an Offset decoration";
@@ -385,15 +233,16 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
                              << nextValidOffset - 1;
     // Check improper straddle of vectors.
     if (SpvOpTypeVector == opcode &&
-        hasImproperStraddle(id, offset, constraint, constraints, vstate))
+        hasImproperStraddle(id, offset, constraint, layout))
       return fail(memberIdx)
              << "is an improperly straddling vector at offset " << offset;
     // Check struct members recursively.
     spv_result_t recursive_status = SPV_SUCCESS;
     if (SpvOpTypeStruct == opcode &&
-        SPV_SUCCESS != (recursive_status =
-                            checkLayout(id, storage_class_str, decoration_str,
-                                        blockRules, constraints, vstate)))
+        SPV_SUCCESS !=
+            (recursive_status =
+                 checkLayout(id, storage_class_str, decoration_str, blockRules,
+                             layout, checked, vstate)))
       return recursive_status;
     // Check matrix stride.
     if (SpvOpTypeMatrix == opcode) {
@@ -412,7 +261,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
       if (SpvOpTypeStruct == arrayInst->opcode() &&
           SPV_SUCCESS != (recursive_status = checkLayout(
                               typeId, storage_class_str, decoration_str,
-                              blockRules, constraints, vstate)))
+                              blockRules, layout, checked, vstate)))
         return recursive_status;
       // Check array stride.
       for (auto& decoration : vstate.id_decorations(id)) {
@@ -431,6 +280,7 @@ spv_result_t checkLayout(uint32_t struct_id, const char* storage_class_str,
     }
     prevOffset = offset;
   }
+  checked.insert(struct_id);
   return SPV_SUCCESS;
 }
 
@@ -607,13 +457,13 @@ spv_result_t CheckDecorationsOfEntryPoints(ValidationState_t& vstate) {
 }
 
 spv_result_t CheckDescriptorSetArrayOfArrays(ValidationState_t& vstate) {
-  for (const auto& def : vstate.all_definitions()) {
-    const auto inst = def.second;
+  for (const auto& def : vstate.ordered_instructions()) {
+    const auto inst = &def;
     if (SpvOpVariable != inst->opcode()) continue;
 
     // Verify this variable is a DescriptorSet
     bool has_descriptor_set = false;
-    for (const auto& decoration : vstate.id_decorations(def.first)) {
+    for (const auto& decoration : vstate.id_decorations(inst->id())) {
       if (SpvDecorationDescriptorSet == decoration.dec_type()) {
         has_descriptor_set = true;
         break;
@@ -644,90 +494,14 @@ spv_result_t CheckDescriptorSetArrayOfArrays(ValidationState_t& vstate) {
   return SPV_SUCCESS;
 }
 
-// Load |constraints| with all the member constraints for structs contained
-// within the given array type.
-void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
-                                      uint32_t array_id,
-                                      const LayoutConstraints& inherited,
-                                      ValidationState_t& vstate);
-
-// Load |constraints| with all the member constraints for the given struct,
-// and all its contained structs.
-void ComputeMemberConstraintsForStruct(MemberConstraints* constraints,
-                                       uint32_t struct_id,
-                                       const LayoutConstraints& inherited,
-                                       ValidationState_t& vstate) {
-  assert(constraints);
-  const auto& members = getStructMembers(struct_id, vstate);
-  for (uint32_t memberIdx = 0, numMembers = uint32_t(members.size());
-       memberIdx < numMembers; memberIdx++) {
-    LayoutConstraints& constraint =
-        (*constraints)[make_pair(struct_id, memberIdx)];
-    constraint = inherited;
-    for (auto& decoration : vstate.id_decorations(struct_id)) {
-      if (decoration.struct_member_index() == (int)memberIdx) {
-        switch (decoration.dec_type()) {
-          case SpvDecorationRowMajor:
-            constraint.majorness = kRowMajor;
-            break;
-          case SpvDecorationColMajor:
-            constraint.majorness = kColumnMajor;
-            break;
-          case SpvDecorationMatrixStride:
-            constraint.matrix_stride = decoration.params()[0];
-            break;
-          default:
-            break;
-        }
-      }
-    }
-
-    // Now recurse
-    auto member_type_id = members[memberIdx];
-    const auto member_type_inst = vstate.FindDef(member_type_id);
-    const auto opcode = member_type_inst->opcode();
-    switch (opcode) {
-      case SpvOpTypeArray:
-      case SpvOpTypeRuntimeArray:
-        ComputeMemberConstraintsForArray(constraints, member_type_id, inherited,
-                                         vstate);
-        break;
-      case SpvOpTypeStruct:
-        ComputeMemberConstraintsForStruct(constraints, member_type_id,
-                                          inherited, vstate);
-        break;
-      default:
-        break;
-    }
-  }
-}
-
-void ComputeMemberConstraintsForArray(MemberConstraints* constraints,
-                                      uint32_t array_id,
-                                      const LayoutConstraints& inherited,
-                                      ValidationState_t& vstate) {
-  assert(constraints);
-  auto elem_type_id = vstate.FindDef(array_id)->words()[2];
-  const auto elem_type_inst = vstate.FindDef(elem_type_id);
-  const auto opcode = elem_type_inst->opcode();
-  switch (opcode) {
-    case SpvOpTypeArray:
-    case SpvOpTypeRuntimeArray:
-      ComputeMemberConstraintsForArray(constraints, elem_type_id, inherited,
-                                       vstate);
-      break;
-    case SpvOpTypeStruct:
-      ComputeMemberConstraintsForStruct(constraints, elem_type_id, inherited,
-                                        vstate);
-      break;
-    default:
-      break;
-  }
-}
-
 spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
-  for (const auto& def : vstate.all_definitions()) {
-    const auto inst = def.second;
+  const ValidationLayoutSource layout_source(vstate);
+  StructLayoutCache layout(&layout_source);
+  // The structs known to follow the storage buffer rules ([0]) and the
+  // uniform buffer rules ([1]).
+  std::unordered_set<uint32_t> checked_structs[2];
+  for (const auto& def : vstate.ordered_instructions()) {
+    const auto inst = &def;
     const auto& words = inst->words();
     if (SpvOpVariable == inst->opcode()) {
       // For storage class / decoration combinations, see Vulkan 14.5.4 "Offset
@@ -741,9 +515,6 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
         assert(SpvOpTypePointer == ptrInst->opcode());
         const auto id = ptrInst->words()[3];
         if (SpvOpTypeStruct != vstate.FindDef(id)->opcode()) continue;
-        MemberConstraints constraints;
-        ComputeMemberConstraintsForStruct(&constraints, id, LayoutConstraints(),
-                                          vstate);
         // Prepare for messages
         const char* sc_str =
             uniform ? "Uniform"
@@ -785,13 +556,13 @@ spv_result_t CheckDecorationsOfBuffers(ValidationState_t& vstate) {
                         "decorations.";
             } else if (blockRules &&
                        (SPV_SUCCESS != (recursive_status = checkLayout(
-                                            id, sc_str, deco_str, true,
-                                            constraints, vstate)))) {
+                                            id, sc_str, deco_str, true, layout,
+                                            checked_structs[1], vstate)))) {
               return recursive_status;
             } else if (bufferRules &&
                        (SPV_SUCCESS != (recursive_status = checkLayout(
-                                            id, sc_str, deco_str, false,
-                                            constraints, vstate)))) {
+                                            id, sc_str, deco_str, false, layout,
+                                            checked_structs[0], vstate)))) {
               return recursive_status;
             }
           }
@@ -17,21 +17,25 @@
 #include <cassert>
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <iterator>
 #include <stack>
+#include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "diagnostic.h"
-#include "instruction.h"
 #include "message.h"
 #include "opcode.h"
 #include "operand.h"
 #include "spirv-tools/libspirv.h"
 #include "spirv_validator_options.h"
+#include "util/parallel.h"
+#include "util/span.h"
 #include "val/function.h"
+#include "val/instruction.h"
 #include "val/validation_state.h"
 
 using std::function;
@@ -46,8 +50,7 @@ namespace {
 
 class idUsage {
  public:
-  idUsage(spv_const_context context, const spv_instruction_t* pInsts,
-          const uint64_t instCountArg, const SpvMemoryModel memoryModelArg,
+  idUsage(spv_const_context context, const SpvMemoryModel memoryModelArg,
           const SpvAddressingModel addressingModelArg,
           const ValidationState_t& module, const vector<uint32_t>& entry_points,
           spv_position positionArg, const MessageConsumer& consumer)
@@ -55,8 +58,6 @@ class idUsage {
         opcodeTable(context->opcode_table),
         operandTable(context->operand_table),
         extInstTable(context->ext_inst_table),
-        firstInst(pInsts),
-        instCount(instCountArg),
         memoryModel(memoryModelArg),
         addressingModel(addressingModelArg),
         position(positionArg),
@@ -64,18 +65,16 @@ class idUsage {
         module_(module),
         entry_points_(entry_points) {}
 
-  bool isValid(const spv_instruction_t* inst);
+  bool isValid(const Instruction* inst);
 
   template <SpvOp>
-  bool isValid(const spv_instruction_t* inst, const spv_opcode_desc);
+  bool isValid(const Instruction* inst, const spv_opcode_desc);
 
  private:
   const spv_target_env targetEnv;
   const spv_opcode_table opcodeTable;
   const spv_operand_table operandTable;
   const spv_ext_inst_table extInstTable;
-  const spv_instruction_t* const firstInst;
-  const uint64_t instCount;
   const SpvMemoryModel memoryModel;
   const SpvAddressingModel addressingModel;
   spv_position position;
@@ -117,7 +116,7 @@ class idUsage {
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpUndef>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpUndef>(const Instruction* inst,
                                   const spv_opcode_desc) {
   assert(0 && "Unimplemented!");
   return false;
@@ -125,23 +124,23 @@ bool idUsage::isValid<SpvOpUndef>(const spv_instruction_t *inst,
 #endif  // 0
 
 template <>
-bool idUsage::isValid<SpvOpMemberName>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpMemberName>(const Instruction* inst,
                                        const spv_opcode_desc) {
   auto typeIndex = 1;
-  auto type = module_.FindDef(inst->words[typeIndex]);
+  auto type = module_.FindDef(inst->words()[typeIndex]);
   if (!type || SpvOpTypeStruct != type->opcode()) {
     DIAG(type) << "OpMemberName Type <id> '"
-               << module_.getIdName(inst->words[typeIndex])
+               << module_.getIdName(inst->words()[typeIndex])
                << "' is not a struct type.";
     return false;
   }
   auto memberIndex = 2;
-  auto member = inst->words[memberIndex];
+  auto member = inst->words()[memberIndex];
   auto memberCount = (uint32_t)(type->words().size() - 2);
   if (memberCount <= member) {
     DIAG(module_.FindDef(member))
         << "OpMemberName Member <id> '"
-        << module_.getIdName(inst->words[memberIndex])
+        << module_.getIdName(inst->words()[memberIndex])
         << "' index is larger than Type <id> '" << module_.getIdName(type->id())
         << "'s member count.";
     return false;
@@ -150,13 +149,13 @@ bool idUsage::isValid<SpvOpMemberName>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpLine>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpLine>(const Instruction* inst,
                                  const spv_opcode_desc) {
   auto fileIndex = 1;
-  auto file = module_.FindDef(inst->words[fileIndex]);
+  auto file = module_.FindDef(inst->words()[fileIndex]);
   if (!file || SpvOpString != file->opcode()) {
     DIAG(file) << "OpLine Target <id> '"
-               << module_.getIdName(inst->words[fileIndex])
+               << module_.getIdName(inst->words()[fileIndex])
                << "' is not an OpString.";
     return false;
   }
@@ -164,16 +163,16 @@ bool idUsage::isValid<SpvOpLine>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpDecorate>(const Instruction* inst,
                                      const spv_opcode_desc) {
   auto decorationIndex = 2;
-  auto decoration = inst->words[decorationIndex];
+  auto decoration = inst->words()[decorationIndex];
   if (decoration == SpvDecorationSpecId) {
     auto targetIndex = 1;
-    auto target = module_.FindDef(inst->words[targetIndex]);
+    auto target = module_.FindDef(inst->words()[targetIndex]);
     if (!target || !spvOpcodeIsScalarSpecConstant(target->opcode())) {
       DIAG(target) << "OpDecorate SpectId decoration target <id> '"
-                   << module_.getIdName(inst->words[decorationIndex])
+                   << module_.getIdName(inst->words()[decorationIndex])
                    << "' is not a scalar specialization constant.";
       return false;
     }
@@ -183,23 +182,23 @@ bool idUsage::isValid<SpvOpDecorate>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpMemberDecorate>(const Instruction* inst,
                                            const spv_opcode_desc) {
   auto structTypeIndex = 1;
-  auto structType = module_.FindDef(inst->words[structTypeIndex]);
+  auto structType = module_.FindDef(inst->words()[structTypeIndex]);
   if (!structType || SpvOpTypeStruct != structType->opcode()) {
     DIAG(structType) << "OpMemberDecorate Structure type <id> '"
-                     << module_.getIdName(inst->words[structTypeIndex])
+                     << module_.getIdName(inst->words()[structTypeIndex])
                      << "' is not a struct type.";
     return false;
   }
   auto memberIndex = 2;
-  auto member = inst->words[memberIndex];
+  auto member = inst->words()[memberIndex];
   auto memberCount = static_cast<uint32_t>(structType->words().size() - 2);
   if (memberCount < member) {
     DIAG(structType) << "Index " << member
                      << " provided in OpMemberDecorate for struct <id> "
-                     << module_.getIdName(inst->words[structTypeIndex])
+                     << module_.getIdName(inst->words()[structTypeIndex])
                      << " is out of bounds. The structure has " << memberCount
                      << " members. Largest valid index is " << memberCount - 1
                      << ".";
@@ -209,10 +208,10 @@ bool idUsage::isValid<SpvOpMemberDecorate>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpDecorationGroup>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpDecorationGroup>(const Instruction* inst,
                                             const spv_opcode_desc) {
   auto decorationGroupIndex = 1;
-  auto decorationGroup = module_.FindDef(inst->words[decorationGroupIndex]);
+  auto decorationGroup = module_.FindDef(inst->words()[decorationGroupIndex]);
 
   for (auto pair : decorationGroup->uses()) {
     auto use = pair.first;
@@ -229,14 +228,14 @@ bool idUsage::isValid<SpvOpDecorationGroup>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpGroupDecorate>(const Instruction* inst,
                                           const spv_opcode_desc) {
   auto decorationGroupIndex = 1;
-  auto decorationGroup = module_.FindDef(inst->words[decorationGroupIndex]);
+  auto decorationGroup = module_.FindDef(inst->words()[decorationGroupIndex]);
   if (!decorationGroup || SpvOpDecorationGroup != decorationGroup->opcode()) {
     DIAG(decorationGroup) << "OpGroupDecorate Decoration group <id> '"
                           << module_.getIdName(
-                                 inst->words[decorationGroupIndex])
+                                 inst->words()[decorationGroupIndex])
                           << "' is not a decoration group.";
     return false;
   }
@@ -244,22 +243,22 @@ bool idUsage::isValid<SpvOpGroupDecorate>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpGroupMemberDecorate>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpGroupMemberDecorate>(const Instruction* inst,
                                                 const spv_opcode_desc) {
   auto decorationGroupIndex = 1;
-  auto decorationGroup = module_.FindDef(inst->words[decorationGroupIndex]);
+  auto decorationGroup = module_.FindDef(inst->words()[decorationGroupIndex]);
   if (!decorationGroup || SpvOpDecorationGroup != decorationGroup->opcode()) {
     DIAG(decorationGroup) << "OpGroupMemberDecorate Decoration group <id> '"
                           << module_.getIdName(
-                                 inst->words[decorationGroupIndex])
+                                 inst->words()[decorationGroupIndex])
                           << "' is not a decoration group.";
     return false;
   }
   // Grammar checks ensures that the number of arguments to this instruction
   // is an odd number: 1 decoration group + (id,literal) pairs.
-  for (size_t i = 2; i + 1 < inst->words.size(); i = i + 2) {
-    const uint32_t struct_id = inst->words[i];
-    const uint32_t index = inst->words[i + 1];
+  for (size_t i = 2; i + 1 < inst->words().size(); i = i + 2) {
+    const uint32_t struct_id = inst->words()[i];
+    const uint32_t index = inst->words()[i + 1];
     auto struct_instr = module_.FindDef(struct_id);
     if (!struct_instr || SpvOpTypeStruct != struct_instr->opcode()) {
       DIAG(struct_instr) << "OpGroupMemberDecorate Structure type <id> '"
@@ -285,30 +284,30 @@ bool idUsage::isValid<SpvOpGroupMemberDecorate>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpExtInst>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpExtInst>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif  // 0
 
 template <>
-bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpEntryPoint>(const Instruction* inst,
                                        const spv_opcode_desc) {
   auto entryPointIndex = 2;
-  auto entryPoint = module_.FindDef(inst->words[entryPointIndex]);
+  auto entryPoint = module_.FindDef(inst->words()[entryPointIndex]);
   if (!entryPoint || SpvOpFunction != entryPoint->opcode()) {
     DIAG(entryPoint) << "OpEntryPoint Entry Point <id> '"
-                     << module_.getIdName(inst->words[entryPointIndex])
+                     << module_.getIdName(inst->words()[entryPointIndex])
                      << "' is not a function.";
     return false;
   }
   // don't check kernel function signatures
-  const SpvExecutionModel executionModel = SpvExecutionModel(inst->words[1]);
+  const SpvExecutionModel executionModel = SpvExecutionModel(inst->words()[1]);
   if (executionModel != SpvExecutionModelKernel) {
     // TODO: Check the entry point signature is void main(void), may be subject
     // to change
     auto entryPointType = module_.FindDef(entryPoint->words()[4]);
     if (!entryPointType || 3 != entryPointType->words().size()) {
       DIAG(entryPoint) << "OpEntryPoint Entry Point <id> '"
-                       << module_.getIdName(inst->words[entryPointIndex])
+                       << module_.getIdName(inst->words()[entryPointIndex])
                        << "'s function parameter count is not zero.";
       return false;
     }
@@ -317,7 +316,7 @@ bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
   auto returnType = module_.FindDef(entryPoint->type_id());
   if (!returnType || SpvOpTypeVoid != returnType->opcode()) {
     DIAG(entryPoint) << "OpEntryPoint Entry Point <id> '"
-                     << module_.getIdName(inst->words[entryPointIndex])
+                     << module_.getIdName(inst->words()[entryPointIndex])
                      << "'s function return type is not void.";
     return false;
   }
@@ -325,16 +324,16 @@ bool idUsage::isValid<SpvOpEntryPoint>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpExecutionMode>(const Instruction* inst,
                                           const spv_opcode_desc) {
   auto entryPointIndex = 1;
-  auto entryPointID = inst->words[entryPointIndex];
+  auto entryPointID = inst->words()[entryPointIndex];
   auto found =
       std::find(entry_points_.cbegin(), entry_points_.cend(), entryPointID);
   if (found == entry_points_.cend()) {
     DIAG(module_.FindDef(entryPointID))
         << "OpExecutionMode Entry Point <id> '"
-        << module_.getIdName(inst->words[entryPointIndex])
+        << module_.getIdName(inst->words()[entryPointIndex])
         << "' is not the Entry Point "
            "operand of an OpEntryPoint.";
     return false;
@@ -343,13 +342,13 @@ bool idUsage::isValid<SpvOpExecutionMode>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeVector>(const Instruction* inst,
                                        const spv_opcode_desc) {
   auto componentIndex = 2;
-  auto componentType = module_.FindDef(inst->words[componentIndex]);
+  auto componentType = module_.FindDef(inst->words()[componentIndex]);
   if (!componentType || !spvOpcodeIsScalarType(componentType->opcode())) {
     DIAG(componentType) << "OpTypeVector Component Type <id> '"
-                        << module_.getIdName(inst->words[componentIndex])
+                        << module_.getIdName(inst->words()[componentIndex])
                         << "' is not a scalar type.";
     return false;
   }
@@ -357,13 +356,13 @@ bool idUsage::isValid<SpvOpTypeVector>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeMatrix>(const Instruction* inst,
                                        const spv_opcode_desc) {
   auto columnTypeIndex = 2;
-  auto columnType = module_.FindDef(inst->words[columnTypeIndex]);
+  auto columnType = module_.FindDef(inst->words()[columnTypeIndex]);
   if (!columnType || SpvOpTypeVector != columnType->opcode()) {
     DIAG(columnType) << "OpTypeMatrix Column Type <id> '"
-                     << module_.getIdName(inst->words[columnTypeIndex])
+                     << module_.getIdName(inst->words()[columnTypeIndex])
                      << "' is not a vector.";
     return false;
   }
@@ -371,7 +370,7 @@ bool idUsage::isValid<SpvOpTypeMatrix>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeSampler>(const spv_instruction_t*,
+bool idUsage::isValid<SpvOpTypeSampler>(const Instruction*,
                                         const spv_opcode_desc) {
   // OpTypeSampler takes no arguments in Rev31 and beyond.
   return true;
@@ -381,8 +380,8 @@ bool idUsage::isValid<SpvOpTypeSampler>(const spv_instruction_t*,
 // constant-defining instruction (either OpConstant or
 // OpSpecConstant). typeWords are the words of the constant's-type-defining
 // OpTypeInt.
-bool aboveZero(const vector<uint32_t>& constWords,
-               const vector<uint32_t>& typeWords) {
+bool aboveZero(utils::Span<const uint32_t> constWords,
+               utils::Span<const uint32_t> typeWords) {
   const uint32_t width = typeWords[2];
   const bool is_signed = typeWords[3] > 0;
   const uint32_t loWord = constWords[3];
@@ -398,21 +397,21 @@ bool aboveZero(const vector<uint32_t>& constWords,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeArray>(const Instruction* inst,
                                       const spv_opcode_desc) {
   auto elementTypeIndex = 2;
-  auto elementType = module_.FindDef(inst->words[elementTypeIndex]);
+  auto elementType = module_.FindDef(inst->words()[elementTypeIndex]);
   if (!elementType || !spvOpcodeGeneratesType(elementType->opcode())) {
     DIAG(elementType) << "OpTypeArray Element Type <id> '"
-                      << module_.getIdName(inst->words[elementTypeIndex])
+                      << module_.getIdName(inst->words()[elementTypeIndex])
                       << "' is not a type.";
     return false;
   }
   auto lengthIndex = 3;
-  auto length = module_.FindDef(inst->words[lengthIndex]);
+  auto length = module_.FindDef(inst->words()[lengthIndex]);
   if (!length || !spvOpcodeIsConstant(length->opcode())) {
     DIAG(length) << "OpTypeArray Length <id> '"
-                 << module_.getIdName(inst->words[lengthIndex])
+                 << module_.getIdName(inst->words()[lengthIndex])
                  << "' is not a scalar constant type.";
     return false;
   }
@@ -423,7 +422,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
   auto constResultType = module_.FindDef(constInst[constResultTypeIndex]);
   if (!constResultType || SpvOpTypeInt != constResultType->opcode()) {
     DIAG(length) << "OpTypeArray Length <id> '"
-                 << module_.getIdName(inst->words[lengthIndex])
+                 << module_.getIdName(inst->words()[lengthIndex])
                  << "' is not a constant integer type.";
     return false;
   }
@@ -435,7 +434,7 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
     // Else fall through!
     case SpvOpConstantNull: {
       DIAG(length) << "OpTypeArray Length <id> '"
-                   << module_.getIdName(inst->words[lengthIndex])
+                   << module_.getIdName(inst->words()[lengthIndex])
                    << "' default value must be at least 1.";
       return false;
     }
@@ -449,13 +448,13 @@ bool idUsage::isValid<SpvOpTypeArray>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeRuntimeArray>(const Instruction* inst,
                                              const spv_opcode_desc) {
   auto elementTypeIndex = 2;
-  auto elementType = module_.FindDef(inst->words[elementTypeIndex]);
+  auto elementType = module_.FindDef(inst->words()[elementTypeIndex]);
   if (!elementType || !spvOpcodeGeneratesType(elementType->opcode())) {
     DIAG(elementType) << "OpTypeRuntimeArray Element Type <id> '"
-                      << module_.getIdName(inst->words[elementTypeIndex])
+                      << module_.getIdName(inst->words()[elementTypeIndex])
                       << "' is not a type.";
     return false;
   }
@@ -463,18 +462,18 @@ bool idUsage::isValid<SpvOpTypeRuntimeArray>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeStruct>(const Instruction* inst,
                                        const spv_opcode_desc) {
   ValidationState_t& vstate = const_cast<ValidationState_t&>(module_);
-  const uint32_t struct_id = inst->words[1];
+  const uint32_t struct_id = inst->words()[1];
   auto structType = module_.FindDef(struct_id);
-  for (size_t memberTypeIndex = 2; memberTypeIndex < inst->words.size();
+  for (size_t memberTypeIndex = 2; memberTypeIndex < inst->words().size();
        ++memberTypeIndex) {
-    auto memberTypeId = inst->words[memberTypeIndex];
+    auto memberTypeId = inst->words()[memberTypeIndex];
     auto memberType = module_.FindDef(memberTypeId);
     if (!memberType || !spvOpcodeGeneratesType(memberType->opcode())) {
       DIAG(memberType) << "OpTypeStruct Member Type <id> '"
-                       << module_.getIdName(inst->words[memberTypeIndex])
+                       << module_.getIdName(inst->words()[memberTypeIndex])
                        << "' is not a type.";
       return false;
     }
@@ -518,7 +517,7 @@ bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
       built_in_members.insert(decoration.struct_member_index());
     }
   }
-  int num_struct_members = static_cast<int>(inst->words.size() - 2);
+  int num_struct_members = static_cast<int>(inst->words().size() - 2);
   int num_builtin_members = static_cast<int>(built_in_members.size());
   if (num_builtin_members > 0 && num_builtin_members != num_struct_members) {
     DIAG(structType)
@@ -536,13 +535,13 @@ bool idUsage::isValid<SpvOpTypeStruct>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypePointer>(const Instruction* inst,
                                         const spv_opcode_desc) {
   auto typeIndex = 3;
-  auto type = module_.FindDef(inst->words[typeIndex]);
+  auto type = module_.FindDef(inst->words()[typeIndex]);
   if (!type || !spvOpcodeGeneratesType(type->opcode())) {
     DIAG(type) << "OpTypePointer Type <id> '"
-               << module_.getIdName(inst->words[typeIndex])
+               << module_.getIdName(inst->words()[typeIndex])
                << "' is not a type.";
     return false;
   }
@@ -550,23 +549,23 @@ bool idUsage::isValid<SpvOpTypePointer>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpTypeFunction>(const Instruction* inst,
                                          const spv_opcode_desc) {
   auto returnTypeIndex = 2;
-  auto returnType = module_.FindDef(inst->words[returnTypeIndex]);
+  auto returnType = module_.FindDef(inst->words()[returnTypeIndex]);
   if (!returnType || !spvOpcodeGeneratesType(returnType->opcode())) {
     DIAG(returnType) << "OpTypeFunction Return Type <id> '"
-                     << module_.getIdName(inst->words[returnTypeIndex])
+                     << module_.getIdName(inst->words()[returnTypeIndex])
                      << "' is not a type.";
     return false;
   }
   size_t num_args = 0;
-  for (size_t paramTypeIndex = 3; paramTypeIndex < inst->words.size();
+  for (size_t paramTypeIndex = 3; paramTypeIndex < inst->words().size();
        ++paramTypeIndex, ++num_args) {
-    auto paramType = module_.FindDef(inst->words[paramTypeIndex]);
+    auto paramType = module_.FindDef(inst->words()[paramTypeIndex]);
     if (!paramType || !spvOpcodeGeneratesType(paramType->opcode())) {
       DIAG(paramType) << "OpTypeFunction Parameter Type <id> '"
-                      << module_.getIdName(inst->words[paramTypeIndex])
+                      << module_.getIdName(inst->words()[paramTypeIndex])
                       << "' is not a type.";
       return false;
     }
@@ -577,7 +576,7 @@ bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
     DIAG(returnType) << "OpTypeFunction may not take more than "
                      << num_function_args_limit
                      << " arguments. OpTypeFunction <id> '"
-                     << module_.getIdName(inst->words[1]) << "' has "
+                     << module_.getIdName(inst->words()[1]) << "' has "
                      << num_args << " arguments.";
     return false;
   }
@@ -585,20 +584,20 @@ bool idUsage::isValid<SpvOpTypeFunction>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpTypePipe>(const spv_instruction_t*,
+bool idUsage::isValid<SpvOpTypePipe>(const Instruction*,
                                      const spv_opcode_desc) {
   // OpTypePipe has no ID arguments.
   return true;
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantTrue>(const Instruction* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypeBool != resultType->opcode()) {
     DIAG(resultType) << "OpConstantTrue Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a boolean type.";
     return false;
   }
@@ -606,13 +605,13 @@ bool idUsage::isValid<SpvOpConstantTrue>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantFalse>(const Instruction* inst,
                                           const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypeBool != resultType->opcode()) {
     DIAG(resultType) << "OpConstantFalse Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a boolean type.";
     return false;
   }
@@ -620,24 +619,24 @@ bool idUsage::isValid<SpvOpConstantFalse>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantComposite>(const Instruction* inst,
                                               const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || !spvOpcodeIsComposite(resultType->opcode())) {
     DIAG(resultType) << "OpConstantComposite Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a composite type.";
     return false;
   }
 
-  auto constituentCount = inst->words.size() - 3;
+  auto constituentCount = inst->words().size() - 3;
   switch (resultType->opcode()) {
     case SpvOpTypeVector: {
       auto componentCount = resultType->words()[3];
       if (componentCount != constituentCount) {
         // TODO: Output ID's on diagnostic
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpConstantComposite Constituent <id> count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id())
@@ -646,24 +645,26 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
       }
       auto componentType = module_.FindDef(resultType->words()[2]);
       assert(componentType);
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentResultType = module_.FindDef(constituent->type_id());
         if (!constituentResultType ||
             componentType->opcode() != constituentResultType->opcode()) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "'s type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s vector element type.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "'s type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s vector element type.";
           return false;
         }
       }
@@ -672,7 +673,7 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
       auto columnCount = resultType->words()[3];
       if (columnCount != constituentCount) {
         // TODO: Output ID's on diagnostic
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpConstantComposite Constituent <id> count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id()) << "'s matrix column count.";
@@ -685,26 +686,28 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
       auto componentType = module_.FindDef(columnType->words()[2]);
       assert(componentType);
 
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent || !(SpvOpConstantComposite == constituent->opcode() ||
                               SpvOpUndef == constituent->opcode())) {
           // The message says "... or undef" because the spec does not say
           // undef is a constant.
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant composite or undef.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant composite or undef.";
           return false;
         }
         auto vector = module_.FindDef(constituent->type_id());
         assert(vector);
         if (columnType->opcode() != vector->opcode()) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s matrix column type.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s matrix column type.";
           return false;
         }
         auto vectorComponentType = module_.FindDef(vector->words()[2]);
@@ -712,7 +715,7 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
         if (componentType->id() != vectorComponentType->id()) {
           DIAG(constituent)
               << "OpConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' component type does not match Result Type <id> '"
               << module_.getIdName(resultType->id())
               << "'s matrix column component type.";
@@ -721,7 +724,7 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
         if (componentCount != vector->words()[3]) {
           DIAG(constituent)
               << "OpConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' vector component count does not match Result Type <id> '"
               << module_.getIdName(resultType->id())
               << "'s vector component count.";
@@ -735,30 +738,32 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
       auto length = module_.FindDef(resultType->words()[3]);
       assert(length);
       if (length->words()[3] != constituentCount) {
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpConstantComposite Constituent count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id()) << "'s array length.";
         return false;
       }
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentType = module_.FindDef(constituent->type_id());
         assert(constituentType);
         if (elementType->id() != constituentType->id()) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "'s type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s array element type.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "'s type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s array element type.";
           return false;
         }
       }
@@ -767,21 +772,22 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
       auto memberCount = resultType->words().size() - 2;
       if (memberCount != constituentCount) {
         DIAG(resultType) << "OpConstantComposite Constituent <id> '"
-                         << module_.getIdName(inst->words[resultTypeIndex])
+                         << module_.getIdName(inst->words()[resultTypeIndex])
                          << "' count does not match Result Type <id> '"
                          << module_.getIdName(resultType->id())
                          << "'s struct member count.";
         return false;
       }
       for (uint32_t constituentIndex = 3, memberIndex = 2;
-           constituentIndex < inst->words.size();
+           constituentIndex < inst->words().size();
            constituentIndex++, memberIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentType = module_.FindDef(constituent->type_id());
@@ -792,7 +798,7 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
         if (memberType->id() != constituentType->id()) {
           DIAG(constituent)
               << "OpConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' type does not match the Result Type <id> '"
               << module_.getIdName(resultType->id()) << "'s member type.";
           return false;
@@ -805,13 +811,13 @@ bool idUsage::isValid<SpvOpConstantComposite>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantSampler>(const Instruction* inst,
                                             const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypeSampler != resultType->opcode()) {
     DIAG(resultType) << "OpConstantSampler Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a sampler type.";
     return false;
   }
@@ -821,7 +827,7 @@ bool idUsage::isValid<SpvOpConstantSampler>(const spv_instruction_t* inst,
 // True if instruction defines a type that can have a null value, as defined by
 // the SPIR-V spec.  Tracks composite-type components through module to check
 // nullability transitively.
-bool IsTypeNullable(const vector<uint32_t>& instruction,
+bool IsTypeNullable(utils::Span<const uint32_t> instruction,
                     const ValidationState_t& module) {
   uint16_t opcode;
   uint16_t word_count;
@@ -856,13 +862,13 @@ bool IsTypeNullable(const vector<uint32_t>& instruction,
 }
 
 template <>
-bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpConstantNull>(const Instruction* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || !IsTypeNullable(resultType->words(), module_)) {
     DIAG(resultType) << "OpConstantNull Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' cannot have a null value.";
     return false;
   }
@@ -870,13 +876,13 @@ bool idUsage::isValid<SpvOpConstantNull>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSpecConstantTrue>(const Instruction* inst,
                                              const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypeBool != resultType->opcode()) {
     DIAG(resultType) << "OpSpecConstantTrue Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a boolean type.";
     return false;
   }
@@ -884,13 +890,13 @@ bool idUsage::isValid<SpvOpSpecConstantTrue>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstantFalse>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSpecConstantFalse>(const Instruction* inst,
                                               const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypeBool != resultType->opcode()) {
     DIAG(resultType) << "OpSpecConstantFalse Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a boolean type.";
     return false;
   }
@@ -898,10 +904,10 @@ bool idUsage::isValid<SpvOpSpecConstantFalse>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSampledImage>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSampledImage>(const Instruction* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 2;
-  auto resultID = inst->words[resultTypeIndex];
+  auto resultID = inst->words()[resultTypeIndex];
   auto sampledImageInstr = module_.FindDef(resultID);
   // We need to validate 2 things:
   // * All OpSampledImage instructions must be in the same block in which their
@@ -947,19 +953,19 @@ bool idUsage::isValid<SpvOpSampledImage>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpSpecConstantComposite>(const Instruction* inst,
                                                   const spv_opcode_desc) {
   // The result type must be a composite type.
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || !spvOpcodeIsComposite(resultType->opcode())) {
     DIAG(resultType) << "OpSpecConstantComposite Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a composite type.";
     return false;
   }
   // Validation checks differ based on the type of composite type.
-  auto constituentCount = inst->words.size() - 3;
+  auto constituentCount = inst->words().size() - 3;
   switch (resultType->opcode()) {
     // For Vectors, the following must be met:
     // * Number of constituents in the result type and the vector must match.
@@ -970,7 +976,7 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
     case SpvOpTypeVector: {
       auto componentCount = resultType->words()[3];
       if (componentCount != constituentCount) {
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpSpecConstantComposite Constituent <id> count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id())
@@ -979,24 +985,26 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
       }
       auto componentType = module_.FindDef(resultType->words()[2]);
       assert(componentType);
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentResultType = module_.FindDef(constituent->type_id());
         if (!constituentResultType ||
             componentType->opcode() != constituentResultType->opcode()) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "'s type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s vector element type.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "'s type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s vector element type.";
           return false;
         }
       }
@@ -1005,7 +1013,7 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
     case SpvOpTypeMatrix: {
       auto columnCount = resultType->words()[3];
       if (columnCount != constituentCount) {
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpSpecConstantComposite Constituent <id> count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id()) << "'s matrix column count.";
@@ -1018,28 +1026,30 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
       auto componentType = module_.FindDef(columnType->words()[2]);
       assert(componentType);
 
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         auto constituentOpCode = constituent->opcode();
         if (!constituent || !(SpvOpSpecConstantComposite == constituentOpCode ||
                               SpvOpConstantComposite == constituentOpCode ||
                               SpvOpUndef == constituentOpCode)) {
           // The message says "... or undef" because the spec does not say
           // undef is a constant.
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant composite or undef.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant composite or undef.";
           return false;
         }
         auto vector = module_.FindDef(constituent->type_id());
         assert(vector);
         if (columnType->opcode() != vector->opcode()) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s matrix column type.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s matrix column type.";
           return false;
         }
         auto vectorComponentType = module_.FindDef(vector->words()[2]);
@@ -1047,7 +1057,7 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
         if (componentType->id() != vectorComponentType->id()) {
           DIAG(constituent)
               << "OpSpecConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' component type does not match Result Type <id> '"
               << module_.getIdName(resultType->id())
               << "'s matrix column component type.";
@@ -1056,7 +1066,7 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
         if (componentCount != vector->words()[3]) {
           DIAG(constituent)
               << "OpSpecConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' vector component count does not match Result Type <id> '"
               << module_.getIdName(resultType->id())
               << "'s vector component count.";
@@ -1071,30 +1081,32 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
       auto length = module_.FindDef(resultType->words()[3]);
       assert(length);
       if (length->words()[3] != constituentCount) {
-        DIAG(module_.FindDef(inst->words.back()))
+        DIAG(module_.FindDef(inst->words().back()))
             << "OpSpecConstantComposite Constituent count does not match "
                "Result Type <id> '"
             << module_.getIdName(resultType->id()) << "'s array length.";
         return false;
       }
-      for (size_t constituentIndex = 3; constituentIndex < inst->words.size();
+      for (size_t constituentIndex = 3; constituentIndex < inst->words().size();
            constituentIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentType = module_.FindDef(constituent->type_id());
         assert(constituentType);
         if (elementType->id() != constituentType->id()) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "'s type does not match Result Type <id> '"
-                            << module_.getIdName(resultType->id())
-                            << "'s array element type.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "'s type does not match Result Type <id> '"
+              << module_.getIdName(resultType->id())
+              << "'s array element type.";
           return false;
         }
       }
@@ -1104,21 +1116,22 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
       auto memberCount = resultType->words().size() - 2;
       if (memberCount != constituentCount) {
         DIAG(resultType) << "OpSpecConstantComposite Constituent <id> '"
-                         << module_.getIdName(inst->words[resultTypeIndex])
+                         << module_.getIdName(inst->words()[resultTypeIndex])
                          << "' count does not match Result Type <id> '"
                          << module_.getIdName(resultType->id())
                          << "'s struct member count.";
         return false;
       }
       for (uint32_t constituentIndex = 3, memberIndex = 2;
-           constituentIndex < inst->words.size();
+           constituentIndex < inst->words().size();
            constituentIndex++, memberIndex++) {
-        auto constituent = module_.FindDef(inst->words[constituentIndex]);
+        auto constituent = module_.FindDef(inst->words()[constituentIndex]);
         if (!constituent ||
             !spvOpcodeIsConstantOrUndef(constituent->opcode())) {
-          DIAG(constituent) << "OpSpecConstantComposite Constituent <id> '"
-                            << module_.getIdName(inst->words[constituentIndex])
-                            << "' is not a constant or undef.";
+          DIAG(constituent)
+              << "OpSpecConstantComposite Constituent <id> '"
+              << module_.getIdName(inst->words()[constituentIndex])
+              << "' is not a constant or undef.";
           return false;
         }
         auto constituentType = module_.FindDef(constituent->type_id());
@@ -1129,7 +1142,7 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
         if (memberType->id() != constituentType->id()) {
           DIAG(constituent)
               << "OpSpecConstantComposite Constituent <id> '"
-              << module_.getIdName(inst->words[constituentIndex])
+              << module_.getIdName(inst->words()[constituentIndex])
               << "' type does not match the Result Type <id> '"
               << module_.getIdName(resultType->id()) << "'s member type.";
           return false;
@@ -1144,23 +1157,23 @@ bool idUsage::isValid<SpvOpSpecConstantComposite>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpSpecConstantOp>(const spv_instruction_t *inst) {}
+bool idUsage::isValid<SpvOpSpecConstantOp>(const Instruction* inst) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpVariable>(const Instruction* inst,
                                      const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || SpvOpTypePointer != resultType->opcode()) {
     DIAG(resultType) << "OpVariable Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not a pointer type.";
     return false;
   }
   const auto initialiserIndex = 4;
-  if (initialiserIndex < inst->words.size()) {
-    const auto initialiser = module_.FindDef(inst->words[initialiserIndex]);
+  if (initialiserIndex < inst->words().size()) {
+    const auto initialiser = module_.FindDef(inst->words()[initialiserIndex]);
     const auto storageClassIndex = 3;
     const auto is_module_scope_var =
         initialiser && (initialiser->opcode() == SpvOpVariable) &&
@@ -1169,7 +1182,7 @@ bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
         initialiser && spvOpcodeIsConstant(initialiser->opcode());
     if (!initialiser || !(is_constant || is_module_scope_var)) {
       DIAG(initialiser) << "OpVariable Initializer <id> '"
-                        << module_.getIdName(inst->words[initialiserIndex])
+                        << module_.getIdName(inst->words()[initialiserIndex])
                         << "' is not a constant or module-scope variable.";
       return false;
     }
@@ -1178,13 +1191,13 @@ bool idUsage::isValid<SpvOpVariable>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpLoad>(const Instruction* inst,
                                  const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType) {
     DIAG(resultType) << "OpLoad Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' is not defind.";
     return false;
   }
@@ -1192,7 +1205,7 @@ bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
       module_.features().variable_pointers ||
       module_.features().variable_pointers_storage_buffer;
   auto pointerIndex = 3;
-  auto pointer = module_.FindDef(inst->words[pointerIndex]);
+  auto pointer = module_.FindDef(inst->words()[pointerIndex]);
   if (!pointer ||
       (addressingModel == SpvAddressingModelLogical &&
        ((!uses_variable_pointer &&
@@ -1200,21 +1213,21 @@ bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
         (uses_variable_pointer &&
          !spvOpcodeReturnsLogicalVariablePointer(pointer->opcode()))))) {
     DIAG(pointer) << "OpLoad Pointer <id> '"
-                  << module_.getIdName(inst->words[pointerIndex])
+                  << module_.getIdName(inst->words()[pointerIndex])
                   << "' is not a logical pointer.";
     return false;
   }
   auto pointerType = module_.FindDef(pointer->type_id());
   if (!pointerType || pointerType->opcode() != SpvOpTypePointer) {
     DIAG(pointer) << "OpLoad type for pointer <id> '"
-                  << module_.getIdName(inst->words[pointerIndex])
+                  << module_.getIdName(inst->words()[pointerIndex])
                   << "' is not a pointer type.";
     return false;
   }
   auto pointeeType = module_.FindDef(pointerType->words()[3]);
   if (!pointeeType || resultType->id() != pointeeType->id()) {
     DIAG(resultType) << "OpLoad Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' does not match Pointer <id> '"
                      << module_.getIdName(pointer->id()) << "'s type.";
     return false;
@@ -1223,13 +1236,13 @@ bool idUsage::isValid<SpvOpLoad>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpStore>(const Instruction* inst,
                                   const spv_opcode_desc) {
   const bool uses_variable_pointer =
       module_.features().variable_pointers ||
       module_.features().variable_pointers_storage_buffer;
   const auto pointerIndex = 1;
-  auto pointer = module_.FindDef(inst->words[pointerIndex]);
+  auto pointer = module_.FindDef(inst->words()[pointerIndex]);
   if (!pointer ||
       (addressingModel == SpvAddressingModelLogical &&
        ((!uses_variable_pointer &&
@@ -1237,14 +1250,14 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
         (uses_variable_pointer &&
          !spvOpcodeReturnsLogicalVariablePointer(pointer->opcode()))))) {
     DIAG(pointer) << "OpStore Pointer <id> '"
-                  << module_.getIdName(inst->words[pointerIndex])
+                  << module_.getIdName(inst->words()[pointerIndex])
                   << "' is not a logical pointer.";
     return false;
   }
   auto pointerType = module_.FindDef(pointer->type_id());
   if (!pointer || pointerType->opcode() != SpvOpTypePointer) {
     DIAG(pointer) << "OpStore type for pointer <id> '"
-                  << module_.getIdName(inst->words[pointerIndex])
+                  << module_.getIdName(inst->words()[pointerIndex])
                   << "' is not a pointer type.";
     return false;
   }
@@ -1252,7 +1265,7 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
   assert(type);
   if (SpvOpTypeVoid == type->opcode()) {
     DIAG(pointer) << "OpStore Pointer <id> '"
-                  << module_.getIdName(inst->words[pointerIndex])
+                  << module_.getIdName(inst->words()[pointerIndex])
                   << "'s type is void.";
     return false;
   }
@@ -1264,7 +1277,7 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
     if (!module_.GetPointerTypeInfo(pointerType->id(), &dataType,
                                     &storageClass)) {
       DIAG(pointer) << "OpStore Pointer <id> '"
-                    << module_.getIdName(inst->words[pointerIndex])
+                    << module_.getIdName(inst->words()[pointerIndex])
                     << "' is not pointer type";
       return false;
     }
@@ -1273,17 +1286,17 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
         storageClass == SpvStorageClassInput ||
         storageClass == SpvStorageClassPushConstant) {
       DIAG(pointer) << "OpStore Pointer <id> '"
-                    << module_.getIdName(inst->words[pointerIndex])
+                    << module_.getIdName(inst->words()[pointerIndex])
                     << "' storage class is read-only";
       return false;
     }
   }
 
   auto objectIndex = 2;
-  auto object = module_.FindDef(inst->words[objectIndex]);
+  auto object = module_.FindDef(inst->words()[objectIndex]);
   if (!object || !object->type_id()) {
     DIAG(object) << "OpStore Object <id> '"
-                 << module_.getIdName(inst->words[objectIndex])
+                 << module_.getIdName(inst->words()[objectIndex])
                  << "' is not an object.";
     return false;
   }
@@ -1291,7 +1304,7 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
   assert(objectType);
   if (SpvOpTypeVoid == objectType->opcode()) {
     DIAG(object) << "OpStore Object <id> '"
-                 << module_.getIdName(inst->words[objectIndex])
+                 << module_.getIdName(inst->words()[objectIndex])
                  << "'s type is void.";
     return false;
   }
@@ -1301,7 +1314,7 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
         type->opcode() != SpvOpTypeStruct ||
         objectType->opcode() != SpvOpTypeStruct) {
       DIAG(pointer) << "OpStore Pointer <id> '"
-                    << module_.getIdName(inst->words[pointerIndex])
+                    << module_.getIdName(inst->words()[pointerIndex])
                     << "'s type does not match Object <id> '"
                     << module_.getIdName(object->id()) << "'s type.";
       return false;
@@ -1310,7 +1323,7 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
     // TODO: Check for layout compatible matricies and arrays as well.
     if (!AreLayoutCompatibleStructs(type, objectType)) {
       DIAG(pointer) << "OpStore Pointer <id> '"
-                    << module_.getIdName(inst->words[pointerIndex])
+                    << module_.getIdName(inst->words()[pointerIndex])
                     << "'s layout does not match Object <id> '"
                     << module_.getIdName(object->id()) << "'s layout.";
       return false;
@@ -1320,13 +1333,13 @@ bool idUsage::isValid<SpvOpStore>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpCopyMemory>(const Instruction* inst,
                                        const spv_opcode_desc) {
   auto targetIndex = 1;
-  auto target = module_.FindDef(inst->words[targetIndex]);
+  auto target = module_.FindDef(inst->words()[targetIndex]);
   if (!target) return false;
   auto sourceIndex = 2;
-  auto source = module_.FindDef(inst->words[sourceIndex]);
+  auto source = module_.FindDef(inst->words()[sourceIndex]);
   if (!source) return false;
   auto targetPointerType = module_.FindDef(target->type_id());
   assert(targetPointerType);
@@ -1338,7 +1351,7 @@ bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_t* inst,
   assert(sourceType);
   if (targetType->id() != sourceType->id()) {
     DIAG(source) << "OpCopyMemory Target <id> '"
-                 << module_.getIdName(inst->words[sourceIndex])
+                 << module_.getIdName(inst->words()[sourceIndex])
                  << "'s type does not match Source <id> '"
                  << module_.getIdName(sourceType->id()) << "'s type.";
     return false;
@@ -1347,28 +1360,28 @@ bool idUsage::isValid<SpvOpCopyMemory>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpCopyMemorySized>(const Instruction* inst,
                                             const spv_opcode_desc) {
   auto targetIndex = 1;
-  auto target = module_.FindDef(inst->words[targetIndex]);
+  auto target = module_.FindDef(inst->words()[targetIndex]);
   if (!target) return false;
   auto sourceIndex = 2;
-  auto source = module_.FindDef(inst->words[sourceIndex]);
+  auto source = module_.FindDef(inst->words()[sourceIndex]);
   if (!source) return false;
   auto sizeIndex = 3;
-  auto size = module_.FindDef(inst->words[sizeIndex]);
+  auto size = module_.FindDef(inst->words()[sizeIndex]);
   if (!size) return false;
   auto targetPointerType = module_.FindDef(target->type_id());
   if (!targetPointerType || SpvOpTypePointer != targetPointerType->opcode()) {
     DIAG(target) << "OpCopyMemorySized Target <id> '"
-                 << module_.getIdName(inst->words[targetIndex])
+                 << module_.getIdName(inst->words()[targetIndex])
                  << "' is not a pointer.";
     return false;
   }
   auto sourcePointerType = module_.FindDef(source->type_id());
   if (!sourcePointerType || SpvOpTypePointer != sourcePointerType->opcode()) {
     DIAG(source) << "OpCopyMemorySized Source <id> '"
-                 << module_.getIdName(inst->words[sourceIndex])
+                 << module_.getIdName(inst->words()[sourceIndex])
                  << "' is not a pointer.";
     return false;
   }
@@ -1382,7 +1395,7 @@ bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
       assert(sizeType);
       if (SpvOpTypeInt != sizeType->opcode()) {
         DIAG(size) << "OpCopyMemorySized Size <id> '"
-                   << module_.getIdName(inst->words[sizeIndex])
+                   << module_.getIdName(inst->words()[sizeIndex])
                    << "'s type is not an integer type.";
         return false;
       }
@@ -1393,14 +1406,14 @@ bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
       auto sizeType = module_.FindDef(pointerType->type_id());
       if (!sizeType || SpvOpTypeInt != sizeType->opcode()) {
         DIAG(size) << "OpCopyMemorySized Size <id> '"
-                   << module_.getIdName(inst->words[sizeIndex])
+                   << module_.getIdName(inst->words()[sizeIndex])
                    << "'s variable type is not an integer type.";
         return false;
       }
     } break;
     default:
       DIAG(size) << "OpCopyMemorySized Size <id> '"
-                 << module_.getIdName(inst->words[sizeIndex])
+                 << module_.getIdName(inst->words()[sizeIndex])
                  << "' is not a constant or variable.";
       return false;
   }
@@ -1410,17 +1423,24 @@ bool idUsage::isValid<SpvOpCopyMemorySized>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpAccessChain>(const Instruction* inst,
                                         const spv_opcode_desc) {
   std::string instr_name =
-      "Op" + std::string(spvOpcodeString(static_cast<SpvOp>(inst->opcode)));
+      "Op" + std::string(spvOpcodeString(static_cast<SpvOp>(inst->opcode())));
+
+  // OpPtrAccessChain and OpInBoundsPtrAccessChain have an extra Element <id>
+  // operand before the indexes, but are otherwise validated the same way.
+  const bool has_element_operand =
+      inst->opcode() == SpvOpPtrAccessChain ||
+      inst->opcode() == SpvOpInBoundsPtrAccessChain;
+  const size_t first_index = has_element_operand ? 5 : 4;
 
   // The result type must be OpTypePointer. Result Type is at word 1.
   auto resultTypeIndex = 1;
-  auto resultTypeInstr = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultTypeInstr = module_.FindDef(inst->words()[resultTypeIndex]);
   if (SpvOpTypePointer != resultTypeInstr->opcode()) {
     DIAG(resultTypeInstr) << "The Result Type of " << instr_name << " <id> '"
-                          << module_.getIdName(inst->words[2])
+                          << module_.getIdName(inst->words()[2])
                           << "' must be OpTypePointer. Found Op"
                           << spvOpcodeString(
                                  static_cast<SpvOp>(resultTypeInstr->opcode()))
@@ -1435,11 +1455,11 @@ bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t* inst,
 
   // Base must be a pointer, pointing to the base of a composite object.
   auto baseIdIndex = 3;
-  auto baseInstr = module_.FindDef(inst->words[baseIdIndex]);
+  auto baseInstr = module_.FindDef(inst->words()[baseIdIndex]);
   auto baseTypeInstr = module_.FindDef(baseInstr->type_id());
   if (!baseTypeInstr || SpvOpTypePointer != baseTypeInstr->opcode()) {
     DIAG(baseInstr) << "The Base <id> '"
-                    << module_.getIdName(inst->words[baseIdIndex]) << "' in "
+                    << module_.getIdName(inst->words()[baseIdIndex]) << "' in "
                     << instr_name << " instruction must be a pointer.";
     return false;
   }
@@ -1461,7 +1481,7 @@ bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t* inst,
   // Check Universal Limit (SPIR-V Spec. Section 2.17).
   // The number of indexes passed to OpAccessChain may not exceed 255
   // The instruction includes 4 words + N words (for N indexes)
-  const size_t num_indexes = inst->words.size() - 4;
+  const size_t num_indexes = inst->words().size() - first_index;
   const size_t num_indexes_limit =
       module_.options()->universal_limits_.max_access_chain_indexes;
   if (num_indexes > num_indexes_limit) {
@@ -1477,8 +1497,8 @@ bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t* inst,
   // instruction. The second index will apply similarly to that result, and so
   // on. Once any non-composite type is reached, there must be no remaining
   // (unused) indexes.
-  for (size_t i = 4; i < inst->words.size(); ++i) {
-    const uint32_t cur_word = inst->words[i];
+  for (size_t i = first_index; i < inst->words().size(); ++i) {
+    const uint32_t cur_word = inst->words()[i];
     // Earlier ID checks ensure that cur_word definition exists.
     auto cur_word_instr = module_.FindDef(cur_word);
     // The index must be a scalar integer type (See OpAccessChain in the Spec.)
@@ -1558,54 +1578,50 @@ bool idUsage::isValid<SpvOpAccessChain>(const spv_instruction_t* inst,
 
 template <>
 bool idUsage::isValid<SpvOpInBoundsAccessChain>(
-    const spv_instruction_t* inst, const spv_opcode_desc opcodeEntry) {
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {
   return isValid<SpvOpAccessChain>(inst, opcodeEntry);
 }
 
 template <>
-bool idUsage::isValid<SpvOpPtrAccessChain>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpPtrAccessChain>(const Instruction* inst,
                                            const spv_opcode_desc opcodeEntry) {
   // OpPtrAccessChain's validation rules are similar to OpAccessChain, with one
   // difference: word 4 must be id of an integer (Element <id>).
   // The grammar guarantees that there are at least 5 words in the instruction
   // (i.e. if there are fewer than 5 words, the SPIR-V code will not compile.)
-  int elem_index = 4;
-  // We can remove the Element <id> from the instruction words, and simply call
-  // the validation code of OpAccessChain.
-  spv_instruction_t new_inst = *inst;
-  new_inst.words.erase(new_inst.words.begin() + elem_index);
-  return isValid<SpvOpAccessChain>(&new_inst, opcodeEntry);
+  // The validation code of OpAccessChain skips the Element <id>.
+  return isValid<SpvOpAccessChain>(inst, opcodeEntry);
 }
 
 template <>
 bool idUsage::isValid<SpvOpInBoundsPtrAccessChain>(
-    const spv_instruction_t* inst, const spv_opcode_desc opcodeEntry) {
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {
   // Has the same validation rules as OpPtrAccessChain
   return isValid<SpvOpPtrAccessChain>(inst, opcodeEntry);
 }
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpArrayLength>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpArrayLength>(const Instruction* inst,
                                         const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<SpvOpImagePointer>(const spv_instruction_t *inst,
+bool idUsage::isValid<SpvOpImagePointer>(const Instruction* inst,
                                          const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<SpvOpGenericPtrMemSemantics>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpFunction>(const Instruction* inst,
                                      const spv_opcode_desc) {
-  const auto* thisInst = module_.FindDef(inst->words[2u]);
+  const auto* thisInst = module_.FindDef(inst->words()[2u]);
   if (!thisInst) return false;
 
   for (uint32_t entryId : module_.FunctionEntryPoints(thisInst->id())) {
@@ -1617,7 +1633,7 @@ bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
       for (auto model : *models) {
         std::string reason;
         if (!thisFunc->IsCompatibleWithExecutionModel(model, &reason)) {
-          DIAG(module_.FindDef(inst->words[2]))
+          DIAG(module_.FindDef(inst->words()[2]))
               << "OpEntryPoint Entry Point <id> '" << module_.getIdName(entryId)
               << "'s callgraph contains function <id> "
               << module_.getIdName(thisInst->id())
@@ -1630,13 +1646,13 @@ bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
   }
 
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType) return false;
   auto functionTypeIndex = 4;
-  auto functionType = module_.FindDef(inst->words[functionTypeIndex]);
+  auto functionType = module_.FindDef(inst->words()[functionTypeIndex]);
   if (!functionType || SpvOpTypeFunction != functionType->opcode()) {
     DIAG(functionType) << "OpFunction Function Type <id> '"
-                       << module_.getIdName(inst->words[functionTypeIndex])
+                       << module_.getIdName(inst->words()[functionTypeIndex])
                        << "' is not a function type.";
     return false;
   }
@@ -1644,7 +1660,7 @@ bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
   assert(returnType);
   if (returnType->id() != resultType->id()) {
     DIAG(resultType) << "OpFunction Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' does not match the Function Type <id> '"
                      << module_.getIdName(resultType->id())
                      << "'s return type.";
@@ -1654,26 +1670,29 @@ bool idUsage::isValid<SpvOpFunction>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpFunctionParameter>(const Instruction* inst,
                                               const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType) return false;
   // NOTE: Find OpFunction & ensure OpFunctionParameter is not out of place.
   size_t paramIndex = 0;
-  assert(firstInst < inst && "Invalid instruction pointer");
-  while (firstInst != --inst) {
-    if (SpvOpFunction == inst->opcode) {
+  const auto& instructions = module_.ordered_instructions();
+  size_t index = static_cast<size_t>(inst->InstructionPosition()) - 1;
+  assert(index > 0 && "Invalid instruction position");
+  while (--index > 0) {
+    if (SpvOpFunction == instructions[index].opcode()) {
       break;
-    } else if (SpvOpFunctionParameter == inst->opcode) {
+    } else if (SpvOpFunctionParameter == instructions[index].opcode()) {
       paramIndex++;
     }
   }
-  auto functionType = module_.FindDef(inst->words[4]);
+  const Instruction* function = &instructions[index];
+  auto functionType = module_.FindDef(function->words()[4]);
   assert(functionType);
   if (paramIndex >= functionType->words().size() - 3) {
-    DIAG(module_.FindDef(inst->words[0]))
-        << "Too many OpFunctionParameters for " << inst->words[2]
+    DIAG(module_.FindDef(function->words()[0]))
+        << "Too many OpFunctionParameters for " << function->words()[2]
         << ": expected " << functionType->words().size() - 3
         << " based on the function's type";
     return false;
@@ -1682,7 +1701,7 @@ bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
   assert(paramType);
   if (resultType->id() != paramType->id()) {
     DIAG(resultType) << "OpFunctionParameter Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "' does not match the OpTypeFunction parameter "
                         "type of the same index.";
     return false;
@@ -1691,16 +1710,16 @@ bool idUsage::isValid<SpvOpFunctionParameter>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpFunctionCall>(const Instruction* inst,
                                          const spv_opcode_desc) {
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType) return false;
   auto functionIndex = 3;
-  auto function = module_.FindDef(inst->words[functionIndex]);
+  auto function = module_.FindDef(inst->words()[functionIndex]);
   if (!function || SpvOpFunction != function->opcode()) {
     DIAG(function) << "OpFunctionCall Function <id> '"
-                   << module_.getIdName(inst->words[functionIndex])
+                   << module_.getIdName(inst->words()[functionIndex])
                    << "' is not a function.";
     return false;
   }
@@ -1708,7 +1727,7 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
   assert(returnType);
   if (returnType->id() != resultType->id()) {
     DIAG(resultType) << "OpFunctionCall Result Type <id> '"
-                     << module_.getIdName(inst->words[resultTypeIndex])
+                     << module_.getIdName(inst->words()[resultTypeIndex])
                      << "'s type does not match Function <id> '"
                      << module_.getIdName(returnType->id())
                      << "'s return type.";
@@ -1716,17 +1735,17 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
   }
   auto functionType = module_.FindDef(function->words()[4]);
   assert(functionType);
-  auto functionCallArgCount = inst->words.size() - 4;
+  auto functionCallArgCount = inst->words().size() - 4;
   auto functionParamCount = functionType->words().size() - 3;
   if (functionParamCount != functionCallArgCount) {
-    DIAG(module_.FindDef(inst->words.back()))
+    DIAG(module_.FindDef(inst->words().back()))
         << "OpFunctionCall Function <id>'s parameter count does not match "
            "the argument count.";
     return false;
   }
   for (size_t argumentIndex = 4, paramIndex = 3;
-       argumentIndex < inst->words.size(); argumentIndex++, paramIndex++) {
-    auto argument = module_.FindDef(inst->words[argumentIndex]);
+       argumentIndex < inst->words().size(); argumentIndex++, paramIndex++) {
+    auto argument = module_.FindDef(inst->words()[argumentIndex]);
     if (!argument) return false;
     auto argumentType = module_.FindDef(argument->type_id());
     assert(argumentType);
@@ -1734,7 +1753,7 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
     assert(parameterType);
     if (argumentType->id() != parameterType->id()) {
       DIAG(argument) << "OpFunctionCall Argument <id> '"
-                     << module_.getIdName(inst->words[argumentIndex])
+                     << module_.getIdName(inst->words()[argumentIndex])
                      << "'s type does not match Function <id> '"
                      << module_.getIdName(parameterType->id())
                      << "'s parameter type.";
@@ -1745,17 +1764,17 @@ bool idUsage::isValid<SpvOpFunctionCall>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpVectorShuffle>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpVectorShuffle>(const Instruction* inst,
                                           const spv_opcode_desc) {
   auto instr_name = [&inst]() {
     std::string name =
-        "Op" + std::string(spvOpcodeString(static_cast<SpvOp>(inst->opcode)));
+        "Op" + std::string(spvOpcodeString(static_cast<SpvOp>(inst->opcode())));
     return name;
   };
 
   // Result Type must be an OpTypeVector.
   auto resultTypeIndex = 1;
-  auto resultType = module_.FindDef(inst->words[resultTypeIndex]);
+  auto resultType = module_.FindDef(inst->words()[resultTypeIndex]);
   if (!resultType || resultType->opcode() != SpvOpTypeVector) {
     DIAG(resultType) << "The Result Type of " << instr_name()
                      << " must be OpTypeVector. Found Op"
@@ -1767,11 +1786,11 @@ bool idUsage::isValid<SpvOpVectorShuffle>(const spv_instruction_t* inst,
 
   // The number of components in Result Type must be the same as the number of
   // Component operands.
-  auto componentCount = inst->words.size() - 5;
+  auto componentCount = inst->words().size() - 5;
   auto vectorComponentCountIndex = 3;
   auto resultVectorDimension = resultType->words()[vectorComponentCountIndex];
   if (componentCount != resultVectorDimension) {
-    DIAG(module_.FindDef(inst->words.back()))
+    DIAG(module_.FindDef(inst->words().back()))
         << instr_name()
         << " component literals count does not match "
            "Result Type <id> '"
@@ -1782,10 +1801,10 @@ bool idUsage::isValid<SpvOpVectorShuffle>(const spv_instruction_t* inst,
   // Vector 1 and Vector 2 must both have vector types, with the same Component
   // Type as Result Type.
   auto vector1Index = 3;
-  auto vector1Object = module_.FindDef(inst->words[vector1Index]);
+  auto vector1Object = module_.FindDef(inst->words()[vector1Index]);
   auto vector1Type = module_.FindDef(vector1Object->type_id());
   auto vector2Index = 4;
-  auto vector2Object = module_.FindDef(inst->words[vector2Index]);
+  auto vector2Object = module_.FindDef(inst->words()[vector2Index]);
   auto vector2Type = module_.FindDef(vector2Object->type_id());
   if (!vector1Type || vector1Type->opcode() != SpvOpTypeVector) {
     DIAG(vector1Object) << "The type of Vector 1 must be OpTypeVector.";
@@ -1815,10 +1834,10 @@ bool idUsage::isValid<SpvOpVectorShuffle>(const spv_instruction_t* inst,
   auto vector2ComponentCount = vector2Type->words()[vectorComponentCountIndex];
   auto N = vector1ComponentCount + vector2ComponentCount;
   auto firstLiteralIndex = 5;
-  for (size_t i = firstLiteralIndex; i < inst->words.size(); ++i) {
-    auto literal = inst->words[i];
+  for (size_t i = firstLiteralIndex; i < inst->words().size(); ++i) {
+    auto literal = inst->words()[i];
     if (literal != 0xFFFFFFFF && literal >= N) {
-      DIAG(module_.FindDef(inst->words[i]))
+      DIAG(module_.FindDef(inst->words()[i]))
           << "Component literal value " << literal << " is greater than "
           << N - 1 << ".";
       return false;
@@ -1829,9 +1848,9 @@ bool idUsage::isValid<SpvOpVectorShuffle>(const spv_instruction_t* inst,
 }
 
 template <>
-bool idUsage::isValid<SpvOpPhi>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpPhi>(const Instruction* inst,
                                 const spv_opcode_desc /*opcodeEntry*/) {
-  auto thisInst = module_.FindDef(inst->words[2]);
+  auto thisInst = module_.FindDef(inst->words()[2]);
   SpvOp typeOp = module_.GetIdOpcode(thisInst->type_id());
   if (!spvOpcodeGeneratesType(typeOp)) {
     DIAG(thisInst) << "OpPhi's type <id> "
@@ -1841,7 +1860,7 @@ bool idUsage::isValid<SpvOpPhi>(const spv_instruction_t* inst,
   }
 
   auto block = thisInst->block();
-  size_t numInOps = inst->words.size() - 3;
+  size_t numInOps = inst->words().size() - 3;
   if (numInOps % 2 != 0) {
     DIAG(thisInst)
         << "OpPhi does not have an equal number of incoming values and "
@@ -1867,8 +1886,8 @@ bool idUsage::isValid<SpvOpPhi>(const spv_instruction_t* inst,
     return false;
   }
 
-  for (size_t i = 3; i < inst->words.size(); ++i) {
-    auto incId = inst->words[i];
+  for (size_t i = 3; i < inst->words().size(); ++i) {
+    auto incId = inst->words()[i];
     if (i % 2 == 1) {
       // Incoming value type must match the phi result type.
       auto incTypeId = module_.GetTypeId(incId);
@@ -1904,20 +1923,20 @@ bool idUsage::isValid<SpvOpPhi>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<OpLoopMerge>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLoopMerge>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSelectionMerge>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpBranchConditional>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpBranchConditional>(const Instruction* inst,
                                               const spv_opcode_desc) {
-  const size_t numOperands = inst->words.size() - 1;
+  const size_t numOperands = inst->words().size() - 1;
   const size_t condOperandIndex = 1;
   const size_t targetTrueIndex = 2;
   const size_t targetFalseIndex = 3;
@@ -1933,7 +1952,7 @@ bool idUsage::isValid<SpvOpBranchConditional>(const spv_instruction_t* inst,
   bool ret = true;
 
   // grab the condition operand and check that it is a bool
-  const auto condOp = module_.FindDef(inst->words[condOperandIndex]);
+  const auto condOp = module_.FindDef(inst->words()[condOperandIndex]);
   if (!condOp || !module_.IsBoolScalarType(condOp->type_id())) {
     DIAG(condOp)
         << "Condition operand for OpBranchConditional must be of boolean type";
@@ -1944,7 +1963,7 @@ bool idUsage::isValid<SpvOpBranchConditional>(const spv_instruction_t* inst,
   // note that we don't need to check that the target labels are in the same
   // function,
   // PerformCfgChecks already checks for that
-  const auto targetOpTrue = module_.FindDef(inst->words[targetTrueIndex]);
+  const auto targetOpTrue = module_.FindDef(inst->words()[targetTrueIndex]);
   if (!targetOpTrue || SpvOpLabel != targetOpTrue->opcode()) {
     DIAG(targetOpTrue)
         << "The 'True Label' operand for OpBranchConditional must be the "
@@ -1952,7 +1971,7 @@ bool idUsage::isValid<SpvOpBranchConditional>(const spv_instruction_t* inst,
     ret = false;
   }
 
-  const auto targetOpFalse = module_.FindDef(inst->words[targetFalseIndex]);
+  const auto targetOpFalse = module_.FindDef(inst->words()[targetFalseIndex]);
   if (!targetOpFalse || SpvOpLabel != targetOpFalse->opcode()) {
     DIAG(targetOpFalse)
         << "The 'False Label' operand for OpBranchConditional must be the "
@@ -1965,18 +1984,18 @@ bool idUsage::isValid<SpvOpBranchConditional>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<OpSwitch>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpSwitch>(const Instruction* inst,
                                 const spv_opcode_desc opcodeEntry) {}
 #endif
 
 template <>
-bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
+bool idUsage::isValid<SpvOpReturnValue>(const Instruction* inst,
                                         const spv_opcode_desc) {
   auto valueIndex = 1;
-  auto value = module_.FindDef(inst->words[valueIndex]);
+  auto value = module_.FindDef(inst->words()[valueIndex]);
   if (!value || !value->type_id()) {
     DIAG(value) << "OpReturnValue Value <id> '"
-                << module_.getIdName(inst->words[valueIndex])
+                << module_.getIdName(inst->words()[valueIndex])
                 << "' does not represent a value.";
     return false;
   }
@@ -2003,19 +2022,21 @@ bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
   }
 
   // NOTE: Find OpFunction
-  const spv_instruction_t* function = inst - 1;
-  while (firstInst != function) {
-    if (SpvOpFunction == function->opcode) break;
-    function--;
-  }
-  if (SpvOpFunction != function->opcode) {
+  const auto& instructions = module_.ordered_instructions();
+  size_t index = static_cast<size_t>(inst->InstructionPosition()) - 1;
+  assert(index > 0 && "Invalid instruction position");
+  while (--index > 0) {
+    if (SpvOpFunction == instructions[index].opcode()) break;
+  }
+  const Instruction* function = &instructions[index];
+  if (SpvOpFunction != function->opcode()) {
     DIAG(value) << "OpReturnValue is not in a basic block.";
     return false;
   }
-  auto returnType = module_.FindDef(function->words[1]);
+  auto returnType = module_.FindDef(function->words()[1]);
   if (!returnType || returnType->id() != valueType->id()) {
     DIAG(value) << "OpReturnValue Value <id> '"
-                << module_.getIdName(inst->words[valueIndex])
+                << module_.getIdName(inst->words()[valueIndex])
                 << "'s type does not match OpFunction's return type.";
     return false;
   }
@@ -2024,219 +2045,219 @@ bool idUsage::isValid<SpvOpReturnValue>(const spv_instruction_t* inst,
 
 #if 0
 template <>
-bool idUsage::isValid<OpLifetimeStart>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLifetimeStart>(const Instruction* inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpLifetimeStop>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpLifetimeStop>(const Instruction* inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicInit>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicInit>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicLoad>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicLoad>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicStore>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicStore>(const Instruction* inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicExchange>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicCompareExchange>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicCompareExchangeWeak>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicIIncrement>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpAtomicIDecrement>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIAdd>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicISub>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicISub>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicUMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicUMin>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicUMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicUMax>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicAnd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicAnd>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicOr>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicOr>(const Instruction* inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicXor>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicXor>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIMin>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpAtomicIMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpAtomicIMax>(const Instruction* inst,
                                     const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpEmitStreamVertex>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpEndStreamPrimitive>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupAsyncCopy>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupWaitEvents>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupAll>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupAll>(const Instruction* inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupAny>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupAny>(const Instruction* inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupBroadcast>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupIAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupIAdd>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFAdd>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFAdd>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFMin>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupUMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupUMin>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupSMin>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupSMin>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupFMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupFMax>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupUMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupUMax>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpGroupSMax>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpGroupSMax>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpEnqueueMarker>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpEnqueueMarker>(const Instruction* inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpEnqueueKernel>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpEnqueueKernel>(const Instruction* inst,
                                        const spv_opcode_desc opcodeEntry) {
 }
 #endif
@@ -2244,170 +2265,170 @@ bool idUsage::isValid<OpEnqueueKernel>(const spv_instruction_t *inst,
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelNDrangeSubGroupCount>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelNDrangeMaxSubGroupSize>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelWorkGroupSize>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetKernelPreferredWorkGroupSizeMultiple>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpRetainEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpRetainEvent>(const Instruction* inst,
                                      const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpReleaseEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpReleaseEvent>(const Instruction* inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCreateUserEvent>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpIsValidEvent>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpIsValidEvent>(const Instruction* inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpSetUserEventStatus>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCaptureEventProfilingInfo>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetDefaultQueue>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpBuildNDRange>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpBuildNDRange>(const Instruction* inst,
                                       const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpReadPipe>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpReadPipe>(const Instruction* inst,
                                   const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
-bool idUsage::isValid<OpWritePipe>(const spv_instruction_t *inst,
+bool idUsage::isValid<OpWritePipe>(const Instruction* inst,
                                    const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReservedReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReservedWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReserveReadPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpReserveWritePipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCommitReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpCommitWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpIsValidReserveId>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetNumPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGetMaxPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupReserveReadPipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupReserveWritePipePackets>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupCommitReadPipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #if 0
 template <>
 bool idUsage::isValid<OpGroupCommitWritePipe>(
-    const spv_instruction_t *inst, const spv_opcode_desc opcodeEntry) {}
+    const Instruction* inst, const spv_opcode_desc opcodeEntry) {}
 #endif
 
 #undef DIAG
 
-bool idUsage::isValid(const spv_instruction_t* inst) {
+bool idUsage::isValid(const Instruction* inst) {
   spv_opcode_desc opcodeEntry = nullptr;
-  if (spvOpcodeTableValueLookup(targetEnv, opcodeTable, inst->opcode,
+  if (spvOpcodeTableValueLookup(targetEnv, opcodeTable, inst->opcode(),
                                 &opcodeEntry))
     return false;
 #define CASE(OpCode) \
@@ -2416,7 +2437,7 @@ bool idUsage::isValid(const spv_instruction_t* inst) {
 #define TODO(OpCode) \
   case Spv##OpCode:  \
     return true;
-  switch (inst->opcode) {
+  switch (inst->opcode()) {
     TODO(OpUndef)
     CASE(OpMemberName)
     CASE(OpLine)
@@ -2664,16 +2685,21 @@ spv_result_t UpdateIdUse(ValidationState_t& _) {
 ///
 /// NOTE: This function does NOT check module scoped functions which are
 /// checked during the initial binary parse in the IdPass below
+///
+/// NOTE: This function runs on one thread whatever the validator options say.
+/// Each dominance query only compares two dominator tree intervals, so it is
+/// a small part of the validation time.
 spv_result_t CheckIdDefinitionDominateUse(const ValidationState_t& _) {
   unordered_set<const Instruction*> phi_instructions;
-  for (const auto& definition : _.all_definitions()) {
+  for (const auto& definition : _.ordered_instructions()) {
+    if (!definition.id()) continue;
     // Check only those definitions defined in a function
-    if (const Function* func = definition.second->function()) {
-      if (const BasicBlock* block = definition.second->block()) {
+    if (const Function* func = definition.function()) {
+      if (const BasicBlock* block = definition.block()) {
         if (!block->reachable()) continue;
         // If the Id is defined within a block then make sure all references to
         // that Id appear in a blocks that are dominated by the defining block
-        for (auto& use_index_pair : definition.second->uses()) {
+        for (auto& use_index_pair : definition.uses()) {
           const Instruction* use = use_index_pair.first;
           if (const BasicBlock* use_block = use->block()) {
             if (use_block->reachable() == false) continue;
@@ -2681,7 +2707,7 @@ spv_result_t CheckIdDefinitionDominateUse(const ValidationState_t& _) {
               phi_instructions.insert(use);
             } else if (!block->dominates(*use->block())) {
               return _.diag(SPV_ERROR_INVALID_ID)
-                     << "ID " << _.getIdName(definition.first)
+                     << "ID " << _.getIdName(definition.id())
                      << " defined in block " << _.getIdName(block->id())
                      << " does not dominate its use in block "
                      << _.getIdName(use_block->id());
@@ -2692,11 +2718,11 @@ spv_result_t CheckIdDefinitionDominateUse(const ValidationState_t& _) {
         // If the Ids defined within a function but not in a block(i.e. function
         // parameters, block ids), then make sure all references to that Id
         // appear within the same function
-        for (auto use : definition.second->uses()) {
+        for (auto use : definition.uses()) {
           const Instruction* inst = use.first;
           if (inst->function() && inst->function() != func) {
             return _.diag(SPV_ERROR_INVALID_ID)
-                   << "ID " << _.getIdName(definition.first)
+                   << "ID " << _.getIdName(definition.id())
                    << " used in function "
                    << _.getIdName(inst->function()->id())
                    << " is used outside of it's defining function "
@@ -2798,16 +2824,99 @@ spv_result_t IdPass(ValidationState_t& _,
 
 }  // namespace spvtools
 
-spv_result_t spvValidateInstructionIDs(const spv_instruction_t* pInsts,
-                                       const uint64_t instCount,
-                                       const spvtools::ValidationState_t& state,
+namespace {
+
+// Number of instructions checked by one task of the threaded ID validation.
+const size_t kInstructionsPerTask = 1024;
+
+// A message captured while validating on a worker thread.
+struct BufferedMessage {
+  spv_message_level_t level;
+  std::string source;
+  spv_position_t position;
+  std::string message;
+};
+
+// The outcome of checking one contiguous range of instructions.
+struct TaskResult {
+  bool failed = false;
+  spv_position_t position = {0, 0, 0};
+  std::vector<BufferedMessage> messages;
+};
+
+// Checks the instructions in chunks on |num_threads| threads. Messages are
+// buffered per chunk, and only the ones from the first failing chunk are
+// passed on, so the result matches that of the serial walk.
+spv_result_t ValidateInstructionIDsInParallel(
+    const spvtools::ValidationState_t& state, spv_position position,
+    uint32_t num_threads) {
+  const auto& instructions = state.ordered_instructions();
+  const size_t num_tasks =
+      (instructions.size() + kInstructionsPerTask - 1) / kInstructionsPerTask;
+  std::vector<TaskResult> results(num_tasks);
+  // Chunks after the earliest known failure need not be checked.
+  std::atomic<size_t> first_failure(num_tasks);
+
+  spvtools::utils::ParallelFor(num_threads, num_tasks, [&](size_t task) {
+    if (task > first_failure.load()) return;
+    TaskResult& result = results[task];
+    result.position = *position;
+    spvtools::MessageConsumer consumer =
+        [&result](spv_message_level_t level, const char* source,
+                  const spv_position_t& pos, const char* message) {
+          result.messages.push_back(
+              {level, source ? source : "", pos, message ? message : ""});
+        };
+    spvtools::idUsage idUsage(state.context(), state.memory_model(),
+                              state.addressing_model(), state,
+                              state.entry_points(), &result.position,
+                              consumer);
+    const size_t begin = task * kInstructionsPerTask;
+    const size_t end =
+        std::min(begin + kInstructionsPerTask, instructions.size());
+    for (size_t i = begin; i < end; ++i) {
+      if (!idUsage.isValid(&instructions[i])) {
+        result.failed = true;
+        size_t current = first_failure.load();
+        while (task < current &&
+               !first_failure.compare_exchange_weak(current, task)) {
+        }
+        return;
+      }
+    }
+  });
+
+  const size_t failed_task = first_failure.load();
+  if (failed_task == num_tasks) return SPV_SUCCESS;
+
+  const TaskResult& result = results[failed_task];
+  const auto& consumer = state.context()->consumer;
+  if (consumer) {
+    for (const auto& message : result.messages) {
+      consumer(message.level, message.source.c_str(), message.position,
+               message.message.c_str());
+    }
+  }
+  *position = result.position;
+  return SPV_ERROR_INVALID_ID;
+}
+
+}  // namespace
+
+spv_result_t spvValidateInstructionIDs(const spvtools::ValidationState_t& state,
                                        spv_position position) {
-  spvtools::idUsage idUsage(state.context(), pInsts, instCount,
-                            state.memory_model(), state.addressing_model(),
-                            state, state.entry_points(), position,
+  const uint32_t num_threads = state.options()->num_threads;
+  if (num_threads > 1 &&
+      state.ordered_instructions().size() > kInstructionsPerTask) {
+    return ValidateInstructionIDsInParallel(state, position, num_threads);
+  }
+
+  spvtools::idUsage idUsage(state.context(), state.memory_model(),
+                            state.addressing_model(), state,
+                            state.entry_points(), position,
                             state.context()->consumer);
-  for (uint64_t instIndex = 0; instIndex < instCount; ++instIndex) {
-    if (!idUsage.isValid(&pInsts[instIndex])) return SPV_ERROR_INVALID_ID;
+  for (const auto& inst : state.ordered_instructions()) {
+    if (!idUsage.isValid(&inst)) return SPV_ERROR_INVALID_ID;
   }
   return SPV_SUCCESS;
 }
@@ -0,0 +1,136 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Counts the calls to the global operator new made while loading a module,
+// inlining every call in it, and destroying it. Blocks handed out by the
+// context's memory pool come from slabs, which are counted separately.
+
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "benchmark.h"
+#include "opt/build_module.h"
+#include "opt/inline_exhaustive_pass.h"
+#include "opt/ir_context.h"
+#include "opt/pass_manager.h"
+#include "spirv-tools/libspirv.hpp"
+
+namespace {
+
+size_t num_allocations = 0;
+
+}  // namespace
+
+void* operator new(size_t size) {
+  ++num_allocations;
+  if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+  std::abort();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+namespace {
+
+using spvtools::benchmark::ReportCount;
+
+const uint32_t kNumFunctions = 2000;
+
+// Returns a shader whose entry point calls each of |kNumFunctions| functions
+// once, each call in a block of its own. Each function has a few blocks, so
+// that inlining it creates both instructions and blocks.
+std::string CallingShader() {
+  std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+%void = OpTypeVoid
+%bool = OpTypeBool
+%float = OpTypeFloat 32
+%fn = OpTypeFunction %void
+%fn_float = OpTypeFunction %float %float
+%float_1 = OpConstant %float 1
+%float_2 = OpConstant %float 2
+)";
+  // Each $ in the body of a function is replaced by the number of the
+  // function, to keep the ids unique.
+  const std::string body = R"(%f$ = OpFunction %float None %fn_float
+%p$ = OpFunctionParameter %float
+%entry$ = OpLabel
+%a$ = OpFAdd %float %p$ %float_2
+%m$ = OpFMul %float %a$ %a$
+%c$ = OpFOrdLessThan %bool %m$ %float_2
+OpSelectionMerge %merge$ None
+OpBranchConditional %c$ %then$ %merge$
+%then$ = OpLabel
+%y$ = OpFNegate %float %m$
+OpBranch %merge$
+%merge$ = OpLabel
+%phi$ = OpPhi %float %y$ %then$ %m$ %entry$
+OpReturnValue %phi$
+OpFunctionEnd
+)";
+  std::string calls;
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    const std::string n = std::to_string(i);
+    for (char c : body) {
+      if (c == '$') {
+        text += n;
+      } else {
+        text += c;
+      }
+    }
+    calls += "%call" + n + " = OpFunctionCall %float %f" + n + " %float_1\n";
+    calls += "OpBranch %b" + n + "\n%b" + n + " = OpLabel\n";
+  }
+  return text + R"(%main = OpFunction %void None %fn
+%main_entry = OpLabel
+)" + calls +
+         R"(OpReturn
+OpFunctionEnd
+)";
+}
+
+TEST(AllocationBenchmark, LoadInlineAndDestroy) {
+  spvtools::SpirvTools tools(SPV_ENV_UNIVERSAL_1_2);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(tools.Assemble(CallingShader(), &binary));
+
+  size_t before = num_allocations;
+  std::unique_ptr<spvtools::opt::IRContext> context = spvtools::BuildModule(
+      SPV_ENV_UNIVERSAL_1_2, nullptr, binary.data(), binary.size());
+  ASSERT_NE(context, nullptr);
+  ReportCount("allocations, load", kNumFunctions, num_allocations - before);
+  ReportCount("slabs, load", kNumFunctions,
+              context->memory_pool()->num_slabs());
+
+  spvtools::opt::PassManager manager;
+  manager.AddPass<spvtools::opt::InlineExhaustivePass>();
+  before = num_allocations;
+  EXPECT_EQ(manager.Run(context.get()),
+            spvtools::opt::Pass::Status::SuccessWithChange);
+  ReportCount("allocations, inline", kNumFunctions, num_allocations - before);
+  ReportCount("slabs, load and inline", kNumFunctions,
+              context->memory_pool()->num_slabs());
+
+  before = num_allocations;
+  context.reset();
+  ReportCount("allocations, destroy", kNumFunctions, num_allocations - before);
+}
+
+}  // namespace
@@ -0,0 +1,56 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_TEST_BENCHMARK_BENCHMARK_H_
+#define LIBSPIRV_TEST_BENCHMARK_BENCHMARK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace spvtools {
+namespace benchmark {
+
+// Returns the shortest wall time, in seconds, of |repeats| calls to |f|.
+template <typename Function>
+double MinSeconds(int repeats, Function f) {
+  double best = 0;
+  for (int i = 0; i < repeats; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best) best = elapsed.count();
+  }
+  return best;
+}
+
+// Prints one line of a report: what was measured, the size of the input, and
+// the time it took.
+inline void Report(const std::string& name, size_t size, double seconds) {
+  std::printf("%-40s %8u %10.4fs\n", name.c_str(),
+              static_cast<unsigned>(size), seconds);
+}
+
+// Prints one line of a report: what was counted, the size of the input, and
+// the count.
+inline void ReportCount(const std::string& name, size_t size, size_t count) {
+  std::printf("%-40s %8u %11u\n", name.c_str(), static_cast<unsigned>(size),
+              static_cast<unsigned>(count));
+}
+
+}  // namespace benchmark
+}  // namespace spvtools
+
+#endif  // LIBSPIRV_TEST_BENCHMARK_BENCHMARK_H_
@@ -0,0 +1,159 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how the time taken to build dominator and post-dominator trees
+// grows with the number of blocks, for a few shapes of control flow graph.
+
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+
+#include "benchmark.h"
+#include "opt/build_module.h"
+#include "opt/dominator_analysis.h"
+#include "opt/ir_context.h"
+
+namespace {
+
+using spvtools::benchmark::MinSeconds;
+using spvtools::benchmark::Report;
+
+// Returns a module with one function whose body is |blocks|. The body starts
+// with a block labeled %entry and ends by branching to the block labeled
+// %exit.
+std::string FunctionWithBlocks(const std::string& blocks) {
+  return R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%cond = OpConstantTrue %bool
+%sel = OpConstant %int 0
+%main = OpFunction %void None %fn
+)" + blocks +
+         R"(%exit = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+}
+
+// A straight line of |n| blocks.
+std::string Chain(uint32_t n) {
+  std::string blocks = "%entry = OpLabel\nOpBranch %b0\n";
+  for (uint32_t i = 0; i < n; ++i) {
+    const std::string next =
+        i + 1 < n ? "%b" + std::to_string(i + 1) : std::string("%exit");
+    blocks += "%b" + std::to_string(i) + " = OpLabel\nOpBranch " + next + "\n";
+  }
+  return FunctionWithBlocks(blocks);
+}
+
+// A sequence of |n| / 4 if-then-else diamonds.
+std::string Diamonds(uint32_t n) {
+  std::string blocks = "%entry = OpLabel\nOpBranch %h0\n";
+  for (uint32_t i = 0; i < n / 4; ++i) {
+    const std::string k = std::to_string(i);
+    const std::string next =
+        i + 1 < n / 4 ? "%h" + std::to_string(i + 1) : std::string("%exit");
+    blocks += "%h" + k + " = OpLabel\nOpSelectionMerge %m" + k +
+              " None\nOpBranchConditional %cond %t" + k + " %e" + k + "\n";
+    blocks += "%t" + k + " = OpLabel\nOpBranch %m" + k + "\n";
+    blocks += "%e" + k + " = OpLabel\nOpBranch %m" + k + "\n";
+    blocks += "%m" + k + " = OpLabel\nOpBranch " + next + "\n";
+  }
+  return FunctionWithBlocks(blocks);
+}
+
+// A sequence of |n| / 4 loops, each with a back-edge from its continue
+// target.
+std::string Loops(uint32_t n) {
+  std::string blocks = "%entry = OpLabel\nOpBranch %h0\n";
+  for (uint32_t i = 0; i < n / 4; ++i) {
+    const std::string k = std::to_string(i);
+    const std::string next =
+        i + 1 < n / 4 ? "%h" + std::to_string(i + 1) : std::string("%exit");
+    blocks += "%h" + k + " = OpLabel\nOpLoopMerge %m" + k + " %c" + k +
+              " None\nOpBranch %b" + k + "\n";
+    blocks += "%b" + k + " = OpLabel\nOpBranchConditional %cond %c" + k +
+              " %m" + k + "\n";
+    blocks += "%c" + k + " = OpLabel\nOpBranch %h" + k + "\n";
+    blocks += "%m" + k + " = OpLabel\nOpBranch " + next + "\n";
+  }
+  return FunctionWithBlocks(blocks);
+}
+
+// One switch with |n| cases.
+std::string Switch(uint32_t n) {
+  std::string targets;
+  std::string cases;
+  for (uint32_t i = 0; i < n; ++i) {
+    const std::string k = std::to_string(i);
+    targets += " " + k + " %s" + k;
+    cases += "%s" + k + " = OpLabel\nOpBranch %exit\n";
+  }
+  return FunctionWithBlocks(
+      "%entry = OpLabel\nOpSelectionMerge %exit None\nOpSwitch %sel %exit" +
+      targets + "\n" + cases);
+}
+
+// Times both trees for the shape built by |shape| with each of |sizes|
+// blocks.
+void RunShape(const std::string& name,
+              const std::function<std::string(uint32_t)>& shape,
+              std::initializer_list<uint32_t> sizes) {
+  for (uint32_t n : sizes) {
+    std::unique_ptr<spvtools::opt::IRContext> context =
+        spvtools::BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, shape(n));
+    ASSERT_NE(context, nullptr);
+    const spvtools::opt::Function* function = &*context->module()->begin();
+
+    const double dom_seconds = MinSeconds(3, [function]() {
+      spvtools::opt::DominatorAnalysis analysis;
+      analysis.InitializeTree(function);
+    });
+    Report("dominators, " + name, n, dom_seconds);
+
+    const double post_dom_seconds = MinSeconds(3, [function]() {
+      spvtools::opt::PostDominatorAnalysis analysis;
+      analysis.InitializeTree(function);
+    });
+    Report("post-dominators, " + name, n, post_dom_seconds);
+  }
+}
+
+TEST(DominatorBenchmark, Chain) {
+  RunShape("chain", Chain, {16000, 32000, 64000});
+}
+
+TEST(DominatorBenchmark, Diamonds) {
+  RunShape("diamonds", Diamonds, {16000, 32000, 64000});
+}
+
+TEST(DominatorBenchmark, Loops) {
+  RunShape("loops", Loops, {16000, 32000, 64000});
+}
+
+// An OpSwitch has at most 65535 words, so it can have at most about 32000
+// cases.
+TEST(DominatorBenchmark, Switch) {
+  RunShape("switch", Switch, {8000, 16000, 32000});
+}
+
+}  // namespace
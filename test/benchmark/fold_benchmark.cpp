@@ -0,0 +1,150 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how many instructions the instruction folder goes through per
+// second, both when no rule applies and when folding to a constant.
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "benchmark.h"
+#include "opt/build_module.h"
+#include "opt/fold.h"
+#include "opt/ir_context.h"
+
+namespace {
+
+using spvtools::benchmark::MinSeconds;
+using spvtools::benchmark::Report;
+
+const uint32_t kNumGroups = 2000;
+const size_t kRepeats = 20;
+
+// Returns a shader with |kNumGroups| groups of arithmetic instructions. The
+// ones named %x* use a loaded value, so that no rule can fold them. The ones
+// named %k* only use constants.
+std::string ArithmeticShader() {
+  std::string body;
+  for (uint32_t i = 0; i < kNumGroups; ++i) {
+    const std::string n = std::to_string(i);
+    body += "%xa" + n + " = OpIAdd %int %i %int_2\n";
+    body += "%xs" + n + " = OpISub %int %i %int_2\n";
+    body += "%xm" + n + " = OpIMul %int %i %int_2\n";
+    body += "%xn" + n + " = OpSNegate %int %i\n";
+    body += "%xf" + n + " = OpFAdd %float %f %float_2\n";
+    body += "%xg" + n + " = OpFMul %float %f %float_2\n";
+    body += "%ka" + n + " = OpIAdd %int %int_2 %int_3\n";
+    body += "%km" + n + " = OpIMul %int %int_2 %int_3\n";
+  }
+  return R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%int = OpTypeInt 32 1
+%float = OpTypeFloat 32
+%ptr_int = OpTypePointer Function %int
+%ptr_float = OpTypePointer Function %float
+%int_2 = OpConstant %int 2
+%int_3 = OpConstant %int 3
+%float_2 = OpConstant %float 2
+%main = OpFunction %void None %fn
+%entry = OpLabel
+%vi = OpVariable %ptr_int Function
+%vf = OpVariable %ptr_float Function
+%i = OpLoad %int %vi
+%f = OpLoad %float %vf
+)" + body +
+         R"(OpReturn
+OpFunctionEnd
+)";
+}
+
+class FoldBenchmark : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    context_ = spvtools::BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr,
+                                     ArithmeticShader());
+    ASSERT_NE(context_, nullptr);
+    context_->module()->ForEachInst([this](spvtools::opt::Instruction* inst) {
+      switch (inst->opcode()) {
+        case SpvOpIAdd:
+        case SpvOpISub:
+        case SpvOpIMul:
+        case SpvOpSNegate:
+        case SpvOpFAdd:
+        case SpvOpFMul:
+          if (context_->get_constant_mgr()->FindDeclaredConstant(
+                  inst->GetSingleWordInOperand(0))) {
+            constant_insts_.push_back(inst);
+          } else {
+            variable_insts_.push_back(inst);
+          }
+          break;
+        default:
+          break;
+      }
+    });
+  }
+
+  std::unique_ptr<spvtools::opt::IRContext> context_;
+  // The instructions that only use constants.
+  std::vector<spvtools::opt::Instruction*> constant_insts_;
+  // The instructions that use a loaded value.
+  std::vector<spvtools::opt::Instruction*> variable_insts_;
+};
+
+// Every rule for the opcode is tried and fails, so this measures the dispatch
+// to the rules and the rules themselves.
+TEST_F(FoldBenchmark, NoRuleApplies) {
+  const spvtools::opt::InstructionFolder& folder =
+      context_->get_instruction_folder();
+  size_t folded = 0;
+  const double seconds = MinSeconds(3, [&]() {
+    folded = 0;
+    for (size_t r = 0; r < kRepeats; ++r) {
+      for (spvtools::opt::Instruction* inst : variable_insts_) {
+        if (folder.FoldInstruction(inst)) ++folded;
+      }
+    }
+  });
+  EXPECT_EQ(folded, 0u);
+  Report("fold attempts, no rule applies", variable_insts_.size() * kRepeats,
+         seconds);
+}
+
+TEST_F(FoldBenchmark, FoldToConstant) {
+  const spvtools::opt::InstructionFolder& folder =
+      context_->get_instruction_folder();
+  size_t folded = 0;
+  const double seconds = MinSeconds(3, [&]() {
+    folded = 0;
+    for (size_t r = 0; r < kRepeats; ++r) {
+      for (spvtools::opt::Instruction* inst : constant_insts_) {
+        if (folder.FoldInstructionToConstant(
+                inst, [](uint32_t id) { return id; })) {
+          ++folded;
+        }
+      }
+    }
+  });
+  EXPECT_EQ(folded, kRepeats * constant_insts_.size());
+  Report("folds to a constant", constant_insts_.size() * kRepeats, seconds);
+}
+
+}  // namespace
@@ -0,0 +1,125 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the speed of the binary parser on a large shader.
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "benchmark.h"
+#include "spirv-tools/libspirv.hpp"
+
+namespace {
+
+using spvtools::benchmark::MinSeconds;
+using spvtools::benchmark::Report;
+
+const uint32_t kNumFunctions = 20000;
+
+// Returns a shader with |kNumFunctions| functions. They mix instructions made
+// only of single-word operands with ones that have strings, masks or a
+// variable number of operands.
+std::string LargeShader() {
+  std::string text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+OpMemberDecorate %block 0 Offset 0
+OpMemberDecorate %block 1 Offset 16
+OpDecorate %block Block
+%void = OpTypeVoid
+%bool = OpTypeBool
+%int = OpTypeInt 32 1
+%float = OpTypeFloat 32
+%v4float = OpTypeVector %float 4
+%block = OpTypeStruct %v4float %float
+%fn = OpTypeFunction %void
+%fn_float = OpTypeFunction %float %float
+%ptr_block = OpTypePointer Function %block
+%ptr_float = OpTypePointer Function %float
+%int_0 = OpConstant %int 0
+%int_1 = OpConstant %int 1
+%float_1 = OpConstant %float 1
+%float_2 = OpConstant %float 2
+)";
+  // Each $ in the body of a function is replaced by the number of the
+  // function, to keep the ids unique.
+  const std::string body = R"(%f$ = OpFunction %float None %fn_float
+%p$ = OpFunctionParameter %float
+%entry$ = OpLabel
+%v$ = OpVariable %ptr_block Function
+%ac$ = OpAccessChain %ptr_float %v$ %int_1
+OpStore %ac$ %p$ Aligned 4
+%l$ = OpLoad %float %ac$ Aligned 4
+%a$ = OpFAdd %float %l$ %float_2
+%m$ = OpFMul %float %a$ %a$
+%vec$ = OpCompositeConstruct %v4float %a$ %m$ %l$ %float_1
+%x$ = OpCompositeExtract %float %vec$ 2
+%c$ = OpFOrdLessThan %bool %x$ %float_2
+OpSelectionMerge %merge$ None
+OpBranchConditional %c$ %then$ %merge$
+%then$ = OpLabel
+%y$ = OpFNegate %float %x$
+OpBranch %merge$
+%merge$ = OpLabel
+%phi$ = OpPhi %float %y$ %then$ %x$ %entry$
+OpReturnValue %phi$
+OpFunctionEnd
+)";
+  std::string functions;
+  for (uint32_t i = 0; i < kNumFunctions; ++i) {
+    const std::string n = std::to_string(i);
+    text += "OpName %f" + n + " \"function_number_" + n + "\"\n";
+    for (char c : body) {
+      if (c == '$') {
+        functions += n;
+      } else {
+        functions += c;
+      }
+    }
+  }
+  return text + functions + R"(%main = OpFunction %void None %fn
+%main_entry = OpLabel
+OpReturn
+OpFunctionEnd
+)";
+}
+
+TEST(ParseBenchmark, LargeShader) {
+  spvtools::SpirvTools tools(SPV_ENV_UNIVERSAL_1_2);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(tools.Assemble(LargeShader(), &binary));
+
+  spv_context context = spvContextCreate(SPV_ENV_UNIVERSAL_1_2);
+  size_t num_instructions = 0;
+  const double seconds = MinSeconds(5, [&]() {
+    num_instructions = 0;
+    const spv_result_t result = spvBinaryParse(
+        context, &num_instructions, binary.data(), binary.size(), nullptr,
+        [](void* user_data, const spv_parsed_instruction_t*) {
+          ++*static_cast<size_t*>(user_data);
+          return SPV_SUCCESS;
+        },
+        nullptr);
+    EXPECT_EQ(result, SPV_SUCCESS);
+  });
+  spvContextDestroy(context);
+
+  EXPECT_GT(num_instructions, 20 * kNumFunctions);
+  Report("parse, instructions", num_instructions, seconds);
+}
+
+}  // namespace
@@ -0,0 +1,89 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures how the time taken by the remove duplicates pass grows with the
+// number of types and decorations.
+
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "benchmark.h"
+#include "spirv-tools/libspirv.hpp"
+#include "spirv-tools/optimizer.hpp"
+
+namespace {
+
+using spvtools::benchmark::MinSeconds;
+using spvtools::benchmark::Report;
+
+// Returns a module declaring |n| array types twice over, each copy with the
+// same decoration.
+std::string DuplicateArrayTypes(uint32_t n) {
+  std::string decorations;
+  std::string types = "%int = OpTypeInt 32 0\n";
+  for (uint32_t i = 0; i < n; ++i) {
+    const std::string index = std::to_string(i);
+    for (const char* copy : {"%a", "%b"}) {
+      decorations += "OpDecorate " + (copy + index) + " ArrayStride 4\n";
+    }
+    types += "%c" + index + " = OpConstant %int " + std::to_string(i + 1) +
+             "\n";
+    for (const char* copy : {"%a", "%b"}) {
+      types += copy + index + " = OpTypeArray %int %c" + index + "\n";
+    }
+  }
+  return "OpCapability Shader\n"
+         "OpCapability Linkage\n"
+         "OpMemoryModel Logical GLSL450\n" +
+         decorations + types;
+}
+
+// Returns the number of times |needle| occurs in |haystack|.
+size_t CountOccurrences(const std::string& haystack,
+                        const std::string& needle) {
+  size_t count = 0;
+  for (size_t pos = haystack.find(needle); pos != std::string::npos;
+       pos = haystack.find(needle, pos + needle.size())) {
+    ++count;
+  }
+  return count;
+}
+
+// The pass used to compare each type with every type before it, so doubling
+// the number of types quadrupled the time. It should now about double.
+TEST(RemoveDuplicatesBenchmark, DuplicateArrayTypes) {
+  spvtools::SpirvTools tools(SPV_ENV_UNIVERSAL_1_2);
+  for (uint32_t n : {1000u, 2000u, 4000u, 8000u}) {
+    std::vector<uint32_t> binary;
+    ASSERT_TRUE(tools.Assemble(DuplicateArrayTypes(n), &binary));
+
+    std::vector<uint32_t> optimized;
+    const double seconds = MinSeconds(3, [&]() {
+      spvtools::Optimizer optimizer(SPV_ENV_UNIVERSAL_1_2);
+      optimizer.RegisterPass(spvtools::CreateRemoveDuplicatesPass());
+      optimized.clear();
+      ASSERT_TRUE(optimizer.Run(binary.data(), binary.size(), &optimized));
+    });
+    Report("remove duplicates, array types", n, seconds);
+
+    std::string text;
+    ASSERT_TRUE(tools.Disassemble(optimized, &text));
+    EXPECT_EQ(CountOccurrences(text, "OpTypeArray"), n);
+    EXPECT_EQ(CountOccurrences(text, "OpDecorate"), n);
+  }
+}
+
+}  // namespace
@@ -14,10 +14,12 @@
 
 #include <sstream>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
 #include "latest_version_opencl_std_header.h"
+#include "source/binary.h"
 #include "source/message.h"
 #include "source/table.h"
 #include "test_fixture.h"
@@ -194,21 +196,23 @@ ParsedInstruction MakeParsedInt32TypeInstruction(uint32_t result_id) {
   return ParsedInstruction(parsed_i32_inst);
 }
 
+// Returns the given words with their bytes in the opposite order.
+std::vector<uint32_t> FlipWords(std::vector<uint32_t> words) {
+  std::transform(words.begin(), words.end(), words.begin(),
+                 [](const uint32_t raw_word) {
+                   return spvFixWord(raw_word, I32_ENDIAN_HOST == I32_ENDIAN_BIG
+                                                   ? SPV_ENDIANNESS_LITTLE
+                                                   : SPV_ENDIANNESS_BIG);
+                 });
+  return words;
+}
+
 class BinaryParseTest : public spvtest::TextToBinaryTestBase<::testing::Test> {
  protected:
   void Parse(const SpirvVector& words, spv_result_t expected_result,
              bool flip_words = false) {
-    SpirvVector flipped_words(words);
     SCOPED_TRACE(flip_words ? "Flipped Endianness" : "Normal Endianness");
-    if (flip_words) {
-      std::transform(flipped_words.begin(), flipped_words.end(),
-                     flipped_words.begin(), [](const uint32_t raw_word) {
-                       return spvFixWord(raw_word,
-                                         I32_ENDIAN_HOST == I32_ENDIAN_BIG
-                                             ? SPV_ENDIANNESS_LITTLE
-                                             : SPV_ENDIANNESS_BIG);
-                     });
-    }
+    const SpirvVector flipped_words = flip_words ? FlipWords(words) : words;
     EXPECT_EQ(expected_result,
               spvBinaryParse(ScopedContext().context, &client_,
                              flipped_words.data(), flipped_words.size(),
@@ -515,6 +519,79 @@ TEST_F(BinaryParseTest, InstructionWithStringOperand) {
   EXPECT_EQ(nullptr, diagnostic_);
 }
 
+TEST_F(BinaryParseTest, InstructionWithStringOperandInOtherEndianness) {
+  // Literal strings keep the byte order of the module.  Use a string whose
+  // terminating null fills a whole word, so it has the same length either way.
+  const auto str_words = MakeVector("abcdefgh");
+  const auto instruction = MakeInstruction(SpvOpName, {99}, str_words);
+  const auto words = Concatenate({ExpectedHeaderForBound(100), instruction});
+  const auto expected_words =
+      Concatenate({{instruction[0], 99}, FlipWords(str_words)});
+  InSequence calls_expected_in_specific_order;
+  EXPECT_HEADER(100).WillOnce(Return(SPV_SUCCESS));
+  const auto operands = std::vector<spv_parsed_operand_t>{
+      MakeSimpleOperand(1, SPV_OPERAND_TYPE_ID),
+      MakeLiteralStringOperand(2, static_cast<uint16_t>(str_words.size()))};
+  EXPECT_CALL(client_,
+              Instruction(ParsedInstruction(spv_parsed_instruction_t{
+                  expected_words.data(),
+                  static_cast<uint16_t>(expected_words.size()), SpvOpName,
+                  SPV_EXT_INST_TYPE_NONE, 0 /*type id*/,
+                  0 /* No result id for OpName*/, operands.data(),
+                  static_cast<uint16_t>(operands.size())})))
+      .WillOnce(Return(SPV_SUCCESS));
+  Parse(words, SPV_SUCCESS, true);
+  EXPECT_EQ(nullptr, diagnostic_);
+}
+
+TEST(BinaryParseInto, ConvertsTheModuleInPlaceOfTheInstructions) {
+  const auto str_words = MakeVector("abcdefgh");
+  const auto words = Concatenate(
+      {ExpectedHeaderForBound(2), MakeInstruction(SpvOpName, {1}, str_words),
+       MakeInstruction(SpvOpTypeInt, {1, 32, 1})});
+  const auto expected_words =
+      Concatenate({ExpectedHeaderForBound(2),
+                   MakeInstruction(SpvOpName, {1}, FlipWords(str_words)),
+                   MakeInstruction(SpvOpTypeInt, {1, 32, 1})});
+  const auto flipped_words = FlipWords(words);
+  std::vector<uint32_t> converted_words(words.size());
+  std::vector<const uint32_t*> parsed_words;
+  auto record_words = [](void* user_data,
+                         const spv_parsed_instruction_t* inst) {
+    static_cast<std::vector<const uint32_t*>*>(user_data)->push_back(
+        inst->words);
+    return SPV_SUCCESS;
+  };
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryParseInto(ScopedContext().context, &parsed_words,
+                               flipped_words.data(), flipped_words.size(),
+                               converted_words.data(), nullptr, record_words,
+                               nullptr));
+  EXPECT_THAT(converted_words, Eq(expected_words));
+  EXPECT_THAT(parsed_words,
+              Eq(std::vector<const uint32_t*>{converted_words.data() + 5,
+                                              converted_words.data() + 10}));
+}
+
+TEST(BinaryParseInto, LeavesTheBufferAloneForAHostEndianModule) {
+  const auto words = Concatenate({ExpectedHeaderForBound(2),
+                                  MakeInstruction(SpvOpTypeInt, {1, 32, 1})});
+  std::vector<uint32_t> converted_words(words.size());
+  const uint32_t* parsed_words = nullptr;
+  auto record_words = [](void* user_data,
+                         const spv_parsed_instruction_t* inst) {
+    *static_cast<const uint32_t**>(user_data) = inst->words;
+    return SPV_SUCCESS;
+  };
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryParseInto(ScopedContext().context, &parsed_words,
+                               words.data(), words.size(),
+                               converted_words.data(), nullptr, record_words,
+                               nullptr));
+  EXPECT_THAT(converted_words, Eq(std::vector<uint32_t>(words.size())));
+  EXPECT_EQ(words.data() + 5, parsed_words);
+}
+
 // Checks for non-zero values for the result_id and ext_inst_type members
 // spv_parsed_instruction_t.
 TEST_F(BinaryParseTest, ExtendedInstruction) {
@@ -548,6 +625,72 @@ TEST_F(BinaryParseTest, ExtendedInstruction) {
   EXPECT_EQ(nullptr, diagnostic_);
 }
 
+TEST(BinaryIndexInstructions, FindsEachInstruction) {
+  const auto words = Concatenate({ExpectedHeaderForBound(3),
+                                  MakeInstruction(SpvOpTypeVoid, {1}),
+                                  MakeInstruction(SpvOpTypeInt, {2, 32, 1}),
+                                  MakeInstruction(SpvOpNop, {})});
+  for (bool endian_swap : kSwapEndians) {
+    SCOPED_TRACE(endian_swap ? "Flipped Endianness" : "Normal Endianness");
+    const auto module = endian_swap ? FlipWords(words) : words;
+    size_t num_instructions = 0;
+    EXPECT_EQ(SPV_SUCCESS,
+              spvBinaryIndexInstructions(ScopedContext().context, module.data(),
+                                         module.size(), nullptr, 0,
+                                         &num_instructions, nullptr));
+    ASSERT_EQ(3u, num_instructions);
+    std::vector<size_t> offsets(num_instructions);
+    EXPECT_EQ(SPV_SUCCESS,
+              spvBinaryIndexInstructions(ScopedContext().context, module.data(),
+                                         module.size(), offsets.data(),
+                                         offsets.size(), &num_instructions,
+                                         nullptr));
+    EXPECT_THAT(offsets, Eq(std::vector<size_t>{5, 7, 11}));
+  }
+}
+
+TEST(BinaryIndexInstructions, EmptyModuleHasNoInstructions) {
+  const auto words = ExpectedHeaderForBound(1);
+  size_t num_instructions = 42;
+  EXPECT_EQ(SPV_SUCCESS,
+            spvBinaryIndexInstructions(ScopedContext().context, words.data(),
+                                       words.size(), nullptr, 0,
+                                       &num_instructions, nullptr));
+  EXPECT_EQ(0u, num_instructions);
+}
+
+using BinaryIndexInstructionsDiagnosticTest =
+    ::testing::TestWithParam<std::pair<std::vector<uint32_t>, std::string>>;
+
+TEST_P(BinaryIndexInstructionsDiagnosticTest, RejectsBadWordCounts) {
+  const auto& words = GetParam().first;
+  spv_diagnostic diagnostic = nullptr;
+  size_t num_instructions = 0;
+  EXPECT_EQ(SPV_ERROR_INVALID_BINARY,
+            spvBinaryIndexInstructions(ScopedContext().context, words.data(),
+                                       words.size(), nullptr, 0,
+                                       &num_instructions, &diagnostic));
+  ASSERT_NE(nullptr, diagnostic);
+  EXPECT_THAT(diagnostic->error, Eq(GetParam().second));
+  spvDiagnosticDestroy(diagnostic);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    BinaryIndexInstructions, BinaryIndexInstructionsDiagnosticTest,
+    ::testing::ValuesIn(
+        std::vector<std::pair<std::vector<uint32_t>, std::string>>{
+            {{SpvMagicNumber, 0x10000},
+             "Module has incomplete header: only 2 words instead of 5"},
+            {Concatenate({ExpectedHeaderForBound(1),
+                          MakeInstruction(SpvOpNop, {}),
+                          {spvOpcodeMake(0, SpvOpNop)}}),
+             "Invalid instruction word count: 0"},
+            {Concatenate({ExpectedHeaderForBound(2),
+                          {spvOpcodeMake(4, SpvOpTypeInt), 1, 32}}),
+             "End of input reached while indexing the instruction starting at "
+             "word 5: it has 4 words, but only 3 remain."},
+        }), );
+
 // A binary parser diagnostic test case where we provide the words array
 // pointer and word count explicitly.
 struct WordsAndCountDiagnosticCase {
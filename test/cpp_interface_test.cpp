@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <algorithm>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -215,6 +217,223 @@ TEST(CppInterface, ValidateWithOptionsFail) {
           "Number of OpTypeStruct members (10) has exceeded the limit (9)"));
 }
 
+// Assembles |text| with an IncrementalAssembler, writing it in pieces of
+// |piece_size| characters, and returns the binary with its bound patched in.
+std::vector<uint32_t> AssembleIncrementally(const std::string& text,
+                                            size_t piece_size) {
+  std::vector<uint32_t> binary;
+  IncrementalAssembler a(SPV_ENV_UNIVERSAL_1_1,
+                         [&binary](const uint32_t* words, size_t num_words) {
+                           binary.insert(binary.end(), words,
+                                         words + num_words);
+                         });
+  for (size_t i = 0; i < text.size(); i += piece_size) {
+    const size_t size = std::min(piece_size, text.size() - i);
+    EXPECT_TRUE(a.Write(text.data() + i, size));
+  }
+  uint32_t bound = 0;
+  EXPECT_TRUE(a.Finish(&bound));
+  EXPECT_LE(5u, binary.size());
+  if (binary.size() >= 5) {
+    EXPECT_EQ(0u, binary[3]);
+    binary[3] = bound;
+  }
+  return binary;
+}
+
+TEST(CppInterface, AssembleIncrementallyMatchesAssemble) {
+  const std::string input_text = R"(OpCapability Shader
+; A comment with "a quote and Op code
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main
+  OriginUpperLeft
+OpName %main "a \"main\"
+OpName %void"
+%void = OpTypeVoid
+%fn
+ = OpTypeFunction %void
+%main =
+OpFunction %void None %fn
+%entry = OpLabel ; OpReturn
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(t.Assemble(input_text, &expected));
+
+  for (size_t piece_size : {size_t(1), size_t(2), size_t(7), size_t(64),
+                            input_text.size()}) {
+    SCOPED_TRACE(piece_size);
+    EXPECT_THAT(AssembleIncrementally(input_text, piece_size),
+                ContainerEq(expected));
+  }
+}
+
+TEST(CppInterface, AssembleIncrementallyEmptyModule) {
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(SpirvTools(SPV_ENV_UNIVERSAL_1_1).Assemble("", &expected));
+  EXPECT_THAT(AssembleIncrementally("", 1), ContainerEq(expected));
+}
+
+TEST(CppInterface, AssembleIncrementallyReportsErrors) {
+  size_t num_words = 0;
+  IncrementalAssembler a(SPV_ENV_UNIVERSAL_1_1,
+                         [&num_words](const uint32_t*, size_t count) {
+                           num_words += count;
+                         });
+  std::stringstream os;
+  size_t line = 0;
+  a.SetMessageConsumer(
+      [&os, &line](spv_message_level_t, const char*,
+                   const spv_position_t& position,
+                   const char* message) {
+        os << message;
+        line = position.line;
+      });
+
+  // Nothing is handed out until an instruction is known to be complete.
+  EXPECT_TRUE(a.Write("OpCapability Shader\n", 20));
+  EXPECT_EQ(0u, num_words);
+  EXPECT_TRUE(a.Write("OpCapability Bogus\n", 19));
+  EXPECT_EQ(5u + 2u, num_words);
+  EXPECT_FALSE(a.Write("OpMemoryModel Logical GLSL450\n", 30));
+  EXPECT_THAT(os.str(), HasSubstr("Invalid capability 'Bogus'"));
+  EXPECT_EQ(1u, line);
+  EXPECT_EQ(5u + 2u, num_words);
+
+  uint32_t bound = 0;
+  EXPECT_FALSE(a.Write("OpNop\n", 6));
+  EXPECT_FALSE(a.Finish(&bound));
+}
+
+TEST(CppInterface, AssembleWithThreadsMatchesAssemble) {
+  // Ids are first seen in different functions, and types of values defined in
+  // one function are needed in another.
+  const std::string input_text = R"(OpCapability Shader
+%ext = OpExtInstImport "GLSL.std.450"
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+OpName %helper "helper"
+%void = OpTypeVoid
+%float = OpTypeFloat 32
+%int = OpTypeInt 32 1
+%fn = OpTypeFunction %void
+%ffn = OpTypeFunction %float
+%one = OpConstant %float 1
+%zero = OpConstant %int 0
+%main = OpFunction %void None %fn
+%entry = OpLabel
+%call = OpFunctionCall %float %helper
+%abs = OpExtInst %float %ext FAbs %call
+OpSelectionMerge %merge None
+OpSwitch %zero %merge 1 %merge
+%merge = OpLabel
+OpReturn
+OpFunctionEnd
+%helper = OpFunction %float None %ffn
+%helper_entry = OpLabel
+%fresh = OpFAdd %float %one %one
+OpReturnValue %fresh
+OpFunctionEnd
+%unused = OpFunction %void None %fn
+%unused_entry = OpLabel
+%negated = OpSNegate %int %zero
+OpReturn
+OpFunctionEnd
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(t.Assemble(input_text, &expected));
+
+  for (uint32_t num_threads : {1u, 2u, 8u}) {
+    SCOPED_TRACE(num_threads);
+    t.SetNumThreads(num_threads);
+    std::vector<uint32_t> binary;
+    EXPECT_TRUE(t.Assemble(input_text, &binary));
+    EXPECT_THAT(binary, ContainerEq(expected));
+  }
+}
+
+TEST(CppInterface, AssembleWithThreadsReportsRedefinedValues) {
+  // %x is defined in two functions, which is only found after the functions
+  // are encoded. The assembler reports it, but still assembles the text.
+  const std::string input_text = R"(%void = OpTypeVoid
+%fn = OpTypeFunction %void
+%bool = OpTypeBool
+%first = OpFunction %void None %fn
+%x = OpConstantTrue %bool
+OpFunctionEnd
+%second = OpFunction %void None %fn
+%x = OpConstantFalse %bool
+OpFunctionEnd
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> expected;
+  ASSERT_TRUE(t.Assemble(input_text, &expected));
+
+  t.SetNumThreads(2);
+  int num_messages = 0;
+  t.SetMessageConsumer([&num_messages](spv_message_level_t, const char*,
+                                       const spv_position_t& position,
+                                       const char* message) {
+    ++num_messages;
+    EXPECT_EQ(7u, position.line);
+    EXPECT_STREQ("Value is being defined a second time", message);
+  });
+  std::vector<uint32_t> binary;
+  EXPECT_TRUE(t.Assemble(input_text, &binary));
+  EXPECT_THAT(binary, ContainerEq(expected));
+  EXPECT_EQ(1, num_messages);
+}
+
+TEST(CppInterface, DisassembleWithThreadsMatchesDisassemble) {
+  const std::string input_text = R"(OpCapability Shader
+OpMemoryModel Logical GLSL450
+OpEntryPoint Fragment %main "main"
+OpExecutionMode %main OriginUpperLeft
+OpName %helper "a \"helper\""
+%void = OpTypeVoid
+%float = OpTypeFloat 32
+%fn = OpTypeFunction %void
+%ffn = OpTypeFunction %float
+%half = OpConstant %float 0.5
+%main = OpFunction %void None %fn
+%entry = OpLabel
+%call = OpFunctionCall %float %helper
+OpReturn
+OpFunctionEnd
+%helper = OpFunction %float None %ffn
+%helper_entry = OpLabel
+%sum = OpFAdd %float %half %half
+OpReturnValue %sum
+OpFunctionEnd
+)";
+  SpirvTools t(SPV_ENV_UNIVERSAL_1_1);
+  std::vector<uint32_t> binary;
+  ASSERT_TRUE(t.Assemble(input_text, &binary));
+
+  for (uint32_t options :
+       {uint32_t(SpirvTools::kDefaultDisassembleOption),
+        uint32_t(SPV_BINARY_TO_TEXT_OPTION_INDENT |
+                 SPV_BINARY_TO_TEXT_OPTION_SHOW_BYTE_OFFSET |
+                 SPV_BINARY_TO_TEXT_OPTION_COLOR)}) {
+    SCOPED_TRACE(options);
+    t.SetNumThreads(1);
+    std::string expected;
+    ASSERT_TRUE(t.Disassemble(binary, &expected, options));
+    for (uint32_t num_threads : {2u, 8u}) {
+      SCOPED_TRACE(num_threads);
+      t.SetNumThreads(num_threads);
+      std::string text;
+      EXPECT_TRUE(t.Disassemble(binary, &text, options));
+      EXPECT_EQ(expected, text);
+    }
+  }
+}
+
 // Checks that after running the given optimizer |opt| on the given |original|
 // source code, we can get the given |optimized| source code.
 void CheckOptimization(const char* original, const char* optimized,
@@ -39,6 +39,36 @@ TEST(FixWord, Reorder) {
   ASSERT_EQ(result, spvFixWord(word, endian));
 }
 
+TEST(FixWords, Default) {
+  spv_endianness_t endian =
+      (I32_ENDIAN_HOST == I32_ENDIAN_LITTLE ? SPV_ENDIANNESS_LITTLE
+                                            : SPV_ENDIANNESS_BIG);
+  const std::vector<uint32_t> words = {0x53780921, 0xdeadbeef, 0};
+  std::vector<uint32_t> result(words.size());
+  spvFixWords(words.data(), words.size(), endian, result.data());
+  EXPECT_EQ(words, result);
+}
+
+TEST(FixWords, Reorder) {
+  spv_endianness_t endian =
+      (I32_ENDIAN_HOST == I32_ENDIAN_LITTLE ? SPV_ENDIANNESS_BIG
+                                            : SPV_ENDIANNESS_LITTLE);
+  // More words than a vector register holds, and not a multiple of it.
+  std::vector<uint32_t> words;
+  std::vector<uint32_t> expected;
+  for (uint32_t i = 0; i < 37; ++i) {
+    words.push_back(0x53780921 + i);
+    expected.push_back(spvFixWord(0x53780921 + i, endian));
+  }
+  std::vector<uint32_t> result(words.size());
+  spvFixWords(words.data(), words.size(), endian, result.data());
+  EXPECT_EQ(expected, result);
+
+  // Converting in place gives the same result.
+  spvFixWords(words.data(), words.size(), endian, words.data());
+  EXPECT_EQ(expected, words);
+}
+
 TEST(FixDoubleWord, Default) {
   spv_endianness_t endian =
       (I32_ENDIAN_HOST == I32_ENDIAN_LITTLE ? SPV_ENDIANNESS_LITTLE
@@ -342,5 +342,33 @@ INSTANTIATE_TEST_CASE_P(
         {"%1 = OpTypeBool\n%2 = OpConstantFalse %1", 2, "false"},
     }), );
 
+using FriendlyNameMapperTest = spvtest::TextToBinaryTestBase<::testing::Test>;
+
+TEST_F(FriendlyNameMapperTest, NamesDoNotDependOnOrderOfRequests) {
+  // The names of later ids depend on the names taken by earlier ones.
+  const std::string assembly = R"(OpName %1 "foo"
+OpName %2 "foo"
+OpName %7 "uint_1"
+%3 = OpTypeInt 32 0
+%4 = OpTypeInt 32 0
+%5 = OpConstant %3 1
+%6 = OpConstant %4 1
+%7 = OpConstant %3 2
+)";
+  const std::vector<std::string> expected = {
+      "", "foo", "foo_0", "uint", "uint_0", "uint_1_0", "uint_0_1", "uint_1"};
+  ScopedContext context(SPV_ENV_UNIVERSAL_1_1);
+  auto words = CompileSuccessfully(assembly, SPV_ENV_UNIVERSAL_1_1);
+
+  FriendlyNameMapper forward(context.context, words.data(), words.size());
+  FriendlyNameMapper backward(context.context, words.data(), words.size());
+  // The module is not needed once the mappers are constructed.
+  words.assign(words.size(), 0);
+  for (uint32_t id = 1; id < 8; ++id) {
+    EXPECT_EQ(expected[id], forward.NameForId(id)) << id;
+    EXPECT_EQ(expected[8 - id], backward.NameForId(8 - id)) << 8 - id;
+  }
+}
+
 }  // namespace
 }  // namespace spvtools
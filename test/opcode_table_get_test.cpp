@@ -14,6 +14,7 @@
 
 #include <gmock/gmock.h>
 
+#include "source/spirv_target_env.h"
 #include "unit_spirv.h"
 
 namespace {
@@ -32,6 +33,36 @@ TEST_P(GetTargetOpcodeTableGetTest, InvalidPointerTable) {
   ASSERT_EQ(SPV_ERROR_INVALID_POINTER, spvOpcodeTableGet(nullptr, GetParam()));
 }
 
+TEST_P(GetTargetOpcodeTableGetTest, NameLookupFindsEveryAvailableEntry) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  for (uint32_t i = 0; i < table->count; ++i) {
+    const spv_opcode_desc_t& entry = table->entries[i];
+    spv_opcode_desc found = nullptr;
+    const spv_result_t result =
+        spvOpcodeTableNameLookup(GetParam(), table, entry.name, &found);
+    if (spvVersionForTargetEnv(GetParam()) < entry.minVersion &&
+        entry.numExtensions == 0u && entry.numCapabilities == 0u) {
+      continue;
+    }
+    ASSERT_EQ(SPV_SUCCESS, result) << entry.name;
+    EXPECT_STREQ(entry.name, found->name);
+    // The first available entry with that name is found.
+    EXPECT_LE(found, &entry) << entry.name;
+  }
+}
+
+TEST_P(GetTargetOpcodeTableGetTest, NameLookupFailsForUnknownNames) {
+  spv_opcode_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOpcodeTableGet(&table, GetParam()));
+  spv_opcode_desc found = nullptr;
+  for (const char* name : {"", "A", "Nopx", "Nop ", "zzz", "OpNop"}) {
+    EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+              spvOpcodeTableNameLookup(GetParam(), table, name, &found))
+        << name;
+  }
+}
+
 INSTANTIATE_TEST_CASE_P(OpcodeTableGet, GetTargetOpcodeTableGetTest,
                         ValuesIn(spvtest::AllTargetEnvironments()));
 
@@ -12,6 +12,10 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstring>
+#include <string>
+
+#include "source/spirv_target_env.h"
 #include "unit_spirv.h"
 
 namespace {
@@ -36,6 +40,51 @@ INSTANTIATE_TEST_CASE_P(OperandTableGet, GetTargetTest,
                                                         SPV_ENV_UNIVERSAL_1_1,
                                                         SPV_ENV_VULKAN_1_0}), );
 
+TEST_P(GetTargetTest, NameLookupFindsEveryAvailableEntry) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table, GetParam()));
+  for (uint32_t t = 0; t < table->count; ++t) {
+    const spv_operand_desc_group_t& group = table->types[t];
+    for (uint32_t i = 0; i < group.count; ++i) {
+      const spv_operand_desc_t& entry = group.entries[i];
+      if (spvVersionForTargetEnv(GetParam()) < entry.minVersion &&
+          entry.numExtensions == 0u && entry.numCapabilities == 0u) {
+        continue;
+      }
+      // Look up the name as a prefix of a longer string, as the assembler
+      // does.
+      const std::string text = std::string(entry.name) + " %1";
+      spv_operand_desc found = nullptr;
+      ASSERT_EQ(SPV_SUCCESS,
+                spvOperandTableNameLookup(GetParam(), table, group.type,
+                                          text.c_str(), strlen(entry.name),
+                                          &found))
+          << entry.name;
+      EXPECT_STREQ(entry.name, found->name);
+      EXPECT_LE(found, &entry) << entry.name;
+    }
+  }
+}
+
+TEST_P(GetTargetTest, NameLookupFailsForPrefixesAndExtensions) {
+  spv_operand_table table;
+  ASSERT_EQ(SPV_SUCCESS, spvOperandTableGet(&table, GetParam()));
+  spv_operand_desc found = nullptr;
+  // "Shader" is a capability, but none of these are.
+  for (const std::string name : {"", "Shade", "Shaderx", "shader"}) {
+    EXPECT_EQ(SPV_ERROR_INVALID_LOOKUP,
+              spvOperandTableNameLookup(GetParam(), table,
+                                        SPV_OPERAND_TYPE_CAPABILITY,
+                                        name.c_str(), name.size(), &found))
+        << name;
+  }
+  EXPECT_EQ(SPV_SUCCESS,
+            spvOperandTableNameLookup(GetParam(), table,
+                                      SPV_OPERAND_TYPE_CAPABILITY, "Shaderx",
+                                      6, &found));
+  EXPECT_STREQ("Shader", found->name);
+}
+
 TEST(OperandString, AllAreDefinedExceptVariable) {
   // None has no string, so don't test it.
   EXPECT_EQ(0u, SPV_OPERAND_TYPE_NONE);
@@ -29,6 +29,7 @@
 namespace {
 
 using ::testing::Contains;
+using ::testing::ElementsAre;
 using ::testing::UnorderedElementsAre;
 using ::testing::UnorderedElementsAreArray;
 
@@ -1705,9 +1706,68 @@ TEST_F(UpdateUsesTest, KeepOldUses) {
   def->SetInOperands({{SPV_OPERAND_TYPE_ID, {25}}});
   context->UpdateDefUse(def);
 
-  auto users = def_use_mgr->id_to_users();
-  opt::analysis::UserEntry entry = {def, use};
-  EXPECT_THAT(users, Contains(entry));
+  std::vector<opt::Instruction*> users;
+  def_use_mgr->ForEachUser(def, [&users](opt::Instruction* user) {
+    users.push_back(user);
+  });
+  EXPECT_THAT(users, Contains(use));
+}
+
+TEST_F(UpdateUsesTest, ReanalyzedUsersKeepTheirOrder) {
+  const std::vector<const char*> text = {
+      // clang-format off
+      "OpCapability Shader",
+      "%1 = OpExtInstImport \"GLSL.std.450\"",
+      "OpMemoryModel Logical GLSL450",
+      "OpEntryPoint Vertex %main \"main\"",
+      "OpName %main \"main\"",
+      "%void = OpTypeVoid",
+      "%4 = OpTypeFunction %void",
+      "%uint = OpTypeInt 32 0",
+      "%uint_5 = OpConstant %uint 5",
+      "%main = OpFunction %void None %4",
+      "%8 = OpLabel",
+      "%9 = OpIMul %uint %uint_5 %uint_5",
+      "%10 = OpIMul %uint %9 %uint_5",
+      "OpReturn",
+      "OpFunctionEnd"
+      // clang-format on
+  };
+
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_1, nullptr, JoinAllInsts(text),
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+
+  DefUseManager* def_use_mgr = context->get_def_use_mgr();
+  opt::Instruction* first = def_use_mgr->GetDef(9);
+  opt::Instruction* second = def_use_mgr->GetDef(10);
+  const uint32_t constant_id = first->GetSingleWordInOperand(0);
+  def_use_mgr->AnalyzeInstUse(first);
+
+  std::vector<opt::Instruction*> users;
+  def_use_mgr->ForEachUser(constant_id, [&users](opt::Instruction* user) {
+    users.push_back(user);
+  });
+  EXPECT_THAT(users, ElementsAre(first, second));
+  EXPECT_EQ(2u, def_use_mgr->NumUsers(constant_id));
+  EXPECT_EQ(3u, def_use_mgr->NumUses(constant_id));
+
+  def_use_mgr->EraseUseRecordsOfOperandIds(first);
+  EXPECT_EQ(1u, def_use_mgr->NumUsers(constant_id));
+  def_use_mgr->AnalyzeInstUse(first);
+  users.clear();
+  def_use_mgr->ForEachUser(constant_id, [&users](opt::Instruction* user) {
+    users.push_back(user);
+  });
+  EXPECT_THAT(users, ElementsAre(first, second));
+
+  context->KillInst(first);
+  users.clear();
+  def_use_mgr->ForEachUser(constant_id, [&users](opt::Instruction* user) {
+    users.push_back(user);
+  });
+  EXPECT_THAT(users, ElementsAre(second));
 }
 // clang-format on
 }  // anonymous namespace
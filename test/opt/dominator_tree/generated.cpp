@@ -905,4 +905,81 @@ TEST_F(PassClassTest, DominatorUnreachableFromEntry) {
   }
 }
 
+// A loop of blocks 13 and 14 which can be entered at either block, so neither
+// block dominates the other.
+TEST_F(PassClassTest, DominatorIrreducibleLoop) {
+  const std::string text = R"(
+               OpCapability Addresses
+               OpCapability Kernel
+               OpMemoryModel Physical64 OpenCL
+               OpEntryPoint Kernel %1 "main"
+          %2 = OpTypeVoid
+          %3 = OpTypeFunction %2
+          %4 = OpTypeBool
+          %8 = OpConstantTrue %4
+          %1 = OpFunction %2 None %3
+         %10 = OpLabel
+               OpBranchConditional %8 %11 %12
+         %11 = OpLabel
+               OpBranch %13
+         %12 = OpLabel
+               OpBranchConditional %8 %13 %14
+         %13 = OpLabel
+               OpBranch %14
+         %14 = OpLabel
+               OpBranchConditional %8 %13 %15
+         %15 = OpLabel
+               OpReturn
+               OpFunctionEnd
+)";
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_0, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  opt::Module* module = context->module();
+  EXPECT_NE(nullptr, module) << "Assembling failed for shader:\n"
+                             << text << std::endl;
+  const opt::Function* fn = spvtest::GetFunction(module, 1);
+
+  // Check normal dominator tree
+  {
+    opt::DominatorAnalysis dom_tree;
+    dom_tree.InitializeTree(fn);
+
+    for (uint32_t id : {11, 12, 13, 14, 15}) {
+      check_dominance(dom_tree, fn, 10, id);
+    }
+    check_dominance(dom_tree, fn, 14, 15);
+    check_no_dominance(dom_tree, fn, 13, 14);
+    check_no_dominance(dom_tree, fn, 11, 12);
+
+    for (uint32_t id : {11, 12, 13, 14}) {
+      EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, id)),
+                spvtest::GetBasicBlock(fn, 10));
+    }
+    EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, 15)),
+              spvtest::GetBasicBlock(fn, 14));
+  }
+
+  // Check post dominator tree
+  {
+    opt::PostDominatorAnalysis dom_tree;
+    dom_tree.InitializeTree(fn);
+
+    for (uint32_t id : {10, 11, 12, 13}) {
+      check_dominance(dom_tree, fn, 14, id);
+    }
+    check_dominance(dom_tree, fn, 13, 11);
+    check_no_dominance(dom_tree, fn, 13, 12);
+
+    EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, 10)),
+              spvtest::GetBasicBlock(fn, 14));
+    EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, 11)),
+              spvtest::GetBasicBlock(fn, 13));
+    EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, 12)),
+              spvtest::GetBasicBlock(fn, 14));
+    EXPECT_EQ(dom_tree.ImmediateDominator(spvtest::GetBasicBlock(fn, 13)),
+              spvtest::GetBasicBlock(fn, 14));
+  }
+}
+
 }  // namespace
@@ -21,10 +21,12 @@
 
 namespace {
 
+using spvtools::BatchOptimizer;
 using spvtools::CreateNullPass;
 using spvtools::CreateStripDebugInfoPass;
 using spvtools::Optimizer;
 using spvtools::SpirvTools;
+using ::testing::ElementsAre;
 using ::testing::Eq;
 
 TEST(Optimizer, CanRunNullPassWithDistinctInputOutputVectors) {
@@ -106,4 +108,30 @@ TEST(Optimizer, CanRunTransformingPassWithAliasedVectors) {
   EXPECT_THAT(disassembly, Eq("%void = OpTypeVoid\n"));
 }
 
+TEST(BatchOptimizer, OptimizesEachModuleAndReportsItsStatus) {
+  SpirvTools tools(SPV_ENV_UNIVERSAL_1_0);
+  std::vector<std::vector<uint32_t>> binaries(4);
+  tools.Assemble("OpName %foo \"foo\"\n%foo = OpTypeVoid", &binaries[0]);
+  tools.Assemble("%foo = OpTypeVoid", &binaries[1]);
+  binaries[2] = {1, 2, 3};
+  tools.Assemble("OpName %bar \"bar\"\n%bar = OpTypeBool", &binaries[3]);
+
+  BatchOptimizer batch(SPV_ENV_UNIVERSAL_1_0, [](Optimizer* opt) {
+    opt->RegisterPass(CreateStripDebugInfoPass());
+  });
+  batch.SetNumThreads(2);
+  std::vector<std::vector<uint32_t>> binaries_out;
+  EXPECT_THAT(batch.Run(binaries, &binaries_out),
+              ElementsAre(true, true, false, true));
+  ASSERT_THAT(binaries_out.size(), Eq(binaries.size()));
+
+  std::string disassembly;
+  tools.Disassemble(binaries_out[0], &disassembly);
+  EXPECT_THAT(disassembly, Eq("%void = OpTypeVoid\n"));
+  tools.Disassemble(binaries_out[1], &disassembly);
+  EXPECT_THAT(disassembly, Eq("%void = OpTypeVoid\n"));
+  tools.Disassemble(binaries_out[3], &disassembly);
+  EXPECT_THAT(disassembly, Eq("%bool = OpTypeBool\n"));
+}
+
 }  // namespace
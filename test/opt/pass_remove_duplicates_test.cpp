@@ -641,4 +641,61 @@ OpFunctionEnd
   EXPECT_EQ(RunPass(spirv), result);
   EXPECT_EQ(GetErrorMessage(), "");
 }
+
+// Exercises the pass on a module with many types and decorations, where only
+// some are duplicates of each other.
+TEST_F(RemoveDuplicatesTest, ManyTypesAndDecorations) {
+  const uint32_t kNumWidths = 4;
+  const uint32_t kWidths[kNumWidths] = {8, 16, 32, 64};
+  const uint32_t kNumCopies = 500;
+  // Ids are numbered in order of first use, as the assembler does.
+  const uint32_t kFirstGroupId = 1;
+  const uint32_t kFirstTypeId = kFirstGroupId + kNumWidths;
+
+  std::string spirv = R"(
+OpCapability Shader
+OpCapability Linkage
+OpCapability Int8
+OpCapability Int16
+OpCapability Int64
+OpMemoryModel Logical GLSL450
+)";
+  std::string after = R"(OpCapability Shader
+OpCapability Linkage
+OpCapability Int8
+OpCapability Int16
+OpCapability Int64
+OpMemoryModel Logical GLSL450
+)";
+
+  // Each decoration group gets the same decoration |kNumCopies| times.
+  for (uint32_t copy = 0; copy < kNumCopies; ++copy) {
+    for (uint32_t w = 0; w < kNumWidths; ++w) {
+      const std::string inst =
+          "OpDecorate %" + std::to_string(kFirstGroupId + w) + " Restrict\n";
+      spirv += inst;
+      if (copy == 0) after += inst;
+    }
+  }
+  for (uint32_t w = 0; w < kNumWidths; ++w) {
+    const std::string inst =
+        "%" + std::to_string(kFirstGroupId + w) + " = OpDecorationGroup\n";
+    spirv += inst;
+    after += inst;
+  }
+
+  // Every integer type is declared |kNumCopies| times.
+  for (uint32_t copy = 0; copy < kNumCopies; ++copy) {
+    for (uint32_t w = 0; w < kNumWidths; ++w) {
+      const uint32_t id = kFirstTypeId + copy * kNumWidths + w;
+      const std::string inst = "%" + std::to_string(id) + " = OpTypeInt " +
+                               std::to_string(kWidths[w]) + " 0\n";
+      spirv += inst;
+      if (copy == 0) after += inst;
+    }
+  }
+
+  EXPECT_EQ(RunPass(spirv), after);
+  EXPECT_EQ(GetErrorMessage(), "");
+}
 }  // namespace
@@ -0,0 +1,140 @@
+// Copyright (c) 2018 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "opt/struct_layout_analysis.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "opt/build_module.h"
+#include "opt/ir_context.h"
+
+namespace {
+
+using namespace spvtools;
+
+using ::testing::ElementsAre;
+
+// %7 is a struct holding a float, an array of 4 floats with a stride of 16,
+// and a row-major 2x2 matrix.  %8 is a struct whose last member is a
+// column-major 4x4 matrix.
+const std::string kModule = R"(
+               OpCapability Shader
+               OpMemoryModel Logical GLSL450
+               OpDecorate %5 ArrayStride 16
+               OpMemberDecorate %7 0 Offset 0
+               OpMemberDecorate %7 1 Offset 16
+               OpMemberDecorate %7 2 RowMajor
+               OpMemberDecorate %7 2 Offset 80
+               OpMemberDecorate %7 2 MatrixStride 16
+               OpMemberDecorate %8 0 Offset 0
+               OpMemberDecorate %8 1 ColMajor
+               OpMemberDecorate %8 1 Offset 16
+               OpMemberDecorate %8 1 MatrixStride 16
+          %1 = OpTypeFloat 32
+          %2 = OpTypeInt 32 0
+          %3 = OpConstant %2 4
+          %4 = OpTypeVector %1 2
+          %5 = OpTypeArray %1 %3
+          %6 = OpTypeMatrix %4 2
+          %7 = OpTypeStruct %1 %5 %6
+         %10 = OpTypeVector %1 4
+         %11 = OpTypeMatrix %10 4
+          %8 = OpTypeStruct %1 %11
+)";
+
+TEST(StructLayoutAnalysisTest, MemberDecorations) {
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, kModule,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  opt::StructLayoutAnalysis* layout = context->GetStructLayoutAnalysis();
+
+  EXPECT_THAT(layout->MemberOffsets(7), ElementsAre(0u, 16u, 80u));
+  EXPECT_EQ(16u, layout->ArrayStride(5));
+  EXPECT_EQ(0u, layout->ArrayStride(7));
+  EXPECT_EQ(kColumnMajor, layout->MemberConstraints(7, 0).majorness);
+  EXPECT_EQ(kRowMajor, layout->MemberConstraints(7, 2).majorness);
+  EXPECT_EQ(16u, layout->MemberConstraints(7, 2).matrix_stride);
+}
+
+TEST(StructLayoutAnalysisTest, AlignmentAndSize) {
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, kModule,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  opt::StructLayoutAnalysis* layout = context->GetStructLayoutAnalysis();
+
+  // Storage buffer rules.
+  EXPECT_EQ(4u, layout->BaseAlignment(1, false));
+  EXPECT_EQ(8u, layout->BaseAlignment(4, false));
+  EXPECT_EQ(4u, layout->BaseAlignment(5, false));
+  EXPECT_EQ(8u, layout->BaseAlignment(7, false));
+  EXPECT_EQ(52u, layout->Size(5, false));
+  // The row-major matrix member is two rows of two floats, 16 bytes apart.
+  EXPECT_EQ(80u + 16u + 8u, layout->Size(7, false));
+
+  // Uniform buffer rules round arrays and structs up to 16 bytes.
+  EXPECT_EQ(16u, layout->BaseAlignment(5, true));
+  EXPECT_EQ(16u, layout->BaseAlignment(7, true));
+}
+
+TEST(StructLayoutAnalysisTest, SizeOfStructEndingInMatrix) {
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, kModule,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  opt::StructLayoutAnalysis* layout = context->GetStructLayoutAnalysis();
+
+  EXPECT_EQ(16u + 4u * 16u, layout->Size(8, false));
+  EXPECT_EQ(16u + 4u * 16u, layout->Size(8, true));
+}
+
+TEST(StructLayoutAnalysisTest, InvalidatedByNewDecorations) {
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, kModule,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  ASSERT_NE(nullptr, context);
+  EXPECT_EQ(16u, context->GetStructLayoutAnalysis()->MemberOffsets(8)[1]);
+  EXPECT_TRUE(
+      context->AreAnalysesValid(opt::IRContext::kAnalysisStructLayout));
+
+  std::unique_ptr<opt::Instruction> decoration(new opt::Instruction(
+      context.get(), SpvOpDecorate, 0, 0,
+      {{SPV_OPERAND_TYPE_ID, {1}},
+       {SPV_OPERAND_TYPE_DECORATION, {SpvDecorationRelaxedPrecision}}}));
+  context->AddAnnotationInst(std::move(decoration));
+  EXPECT_FALSE(
+      context->AreAnalysesValid(opt::IRContext::kAnalysisStructLayout));
+
+  std::vector<opt::Instruction*> offsets;
+  context->module()->ForEachInst([&offsets](opt::Instruction* inst) {
+    if (inst->opcode() == SpvOpMemberDecorate &&
+        inst->GetSingleWordInOperand(0) == 8 &&
+        inst->GetSingleWordInOperand(2) == SpvDecorationOffset) {
+      offsets.push_back(inst);
+    }
+  });
+  ASSERT_EQ(2u, offsets.size());
+  context->GetStructLayoutAnalysis();
+  context->KillInst(offsets[1]);
+  EXPECT_FALSE(
+      context->AreAnalysesValid(opt::IRContext::kAnalysisStructLayout));
+  EXPECT_EQ(0xffffffffu,
+            context->GetStructLayoutAnalysis()->MemberOffsets(8)[1]);
+}
+
+}  // namespace
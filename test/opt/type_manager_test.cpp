@@ -814,6 +814,56 @@ OpMemoryModel Logical GLSL450
   EXPECT_EQ(*type1, *type2);
 }
 
+TEST(TypeManager, DuplicateTypeMapsToLastId) {
+  const std::string text = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+%1 = OpTypeInt 32 0
+%2 = OpTypeStruct %1
+%3 = OpTypeStruct %1
+%4 = OpTypeStruct %1
+  )";
+
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  EXPECT_NE(context, nullptr);
+
+  Integer u32(32, false);
+  Struct st({&u32});
+  EXPECT_EQ(context->get_type_mgr()->GetId(&st), 4u);
+}
+
+TEST(TypeManager, MapTypeToId) {
+  const std::string text = R"(
+OpCapability Shader
+OpMemoryModel Logical GLSL450
+%1 = OpTypeInt 32 0
+%2 = OpTypeStruct %1
+%3 = OpTypeStruct %1
+%4 = OpTypeStruct %1
+  )";
+
+  std::unique_ptr<opt::IRContext> context =
+      BuildModule(SPV_ENV_UNIVERSAL_1_2, nullptr, text,
+                  SPV_TEXT_TO_BINARY_OPTION_PRESERVE_NUMERIC_IDS);
+  EXPECT_NE(context, nullptr);
+
+  Integer u32(32, false);
+  Struct st({&u32});
+  context->get_type_mgr()->MapTypeToId(2u);
+  EXPECT_EQ(context->get_type_mgr()->GetId(&st), 2u);
+
+  // Removing the ids that are not mapped keeps the mapping.
+  context->get_type_mgr()->RemoveId(4u);
+  context->get_type_mgr()->RemoveId(3u);
+  EXPECT_EQ(context->get_type_mgr()->GetId(&st), 2u);
+
+  // Unknown ids are ignored.
+  context->get_type_mgr()->MapTypeToId(5u);
+  EXPECT_EQ(context->get_type_mgr()->GetId(&st), 2u);
+}
+
 TEST(TypeManager, MultipleStructs) {
   const std::string text = R"(
 OpCapability Shader
@@ -0,0 +1,126 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "tools/io.h"
+
+namespace {
+
+using ::testing::ElementsAre;
+
+// A file in the working directory with the given content, removed when the
+// object goes away.
+class TempFile {
+ public:
+  TempFile(const std::string& name, const std::vector<char>& content)
+      : name_(name) {
+    FILE* fp = fopen(name_.c_str(), "wb");
+    EXPECT_NE(nullptr, fp);
+    if (!fp) return;
+    EXPECT_EQ(content.size(), fwrite(content.data(), 1, content.size(), fp));
+    fclose(fp);
+  }
+  ~TempFile() { remove(name_.c_str()); }
+
+  const char* name() const { return name_.c_str(); }
+
+ private:
+  std::string name_;
+};
+
+// Returns the bytes of |words| in the byte order of the host.
+std::vector<char> Bytes(const std::vector<uint32_t>& words) {
+  const char* begin = reinterpret_cast<const char*>(words.data());
+  return std::vector<char>(begin, begin + words.size() * sizeof(uint32_t));
+}
+
+// Makes the standard input read from the file named |name|.
+void RedirectStdin(const char* name) {
+  ASSERT_NE(nullptr, freopen(name, "rb", stdin));
+}
+
+TEST(InputFileTest, ReadsWords) {
+  TempFile file("io_test_words.spv", Bytes({0x07230203, 1, 2}));
+  InputFile<uint32_t> input;
+  ASSERT_TRUE(input.Open(file.name(), "rb"));
+  ASSERT_EQ(3u, input.size());
+  EXPECT_THAT(std::vector<uint32_t>(input.data(), input.data() + input.size()),
+              ElementsAre(0x07230203u, 1u, 2u));
+}
+
+TEST(InputFileTest, EmptyFile) {
+  TempFile file("io_test_empty.spv", {});
+  InputFile<uint32_t> input;
+  ASSERT_TRUE(input.Open(file.name(), "rb"));
+  EXPECT_EQ(0u, input.size());
+}
+
+TEST(InputFileTest, PartialWord) {
+  std::vector<char> content = Bytes({0x07230203, 1});
+  content.pop_back();
+  TempFile file("io_test_partial.spv", content);
+  InputFile<uint32_t> input;
+  EXPECT_FALSE(input.Open(file.name(), "rb"));
+}
+
+TEST(InputFileTest, PartialWordIsFineForBytes) {
+  TempFile file("io_test_text.spvasm", {'O', 'p', 'N', 'o', 'p'});
+  InputFile<char> input;
+  ASSERT_TRUE(input.Open(file.name(), "r"));
+  EXPECT_EQ("OpNop", std::string(input.data(), input.size()));
+}
+
+TEST(InputFileTest, MissingFile) {
+  InputFile<uint32_t> input;
+  EXPECT_FALSE(input.Open("io_test_does_not_exist.spv", "rb"));
+  EXPECT_EQ(0u, input.size());
+}
+
+TEST(InputFileTest, Stdin) {
+  TempFile file("io_test_stdin.spv", Bytes({0x07230203, 1, 2}));
+  for (const char* name : {static_cast<const char*>(nullptr), "-"}) {
+    RedirectStdin(file.name());
+    InputFile<uint32_t> input;
+    ASSERT_TRUE(input.Open(name, "rb"));
+    ASSERT_EQ(3u, input.size());
+    EXPECT_THAT(
+        std::vector<uint32_t>(input.data(), input.data() + input.size()),
+        ElementsAre(0x07230203u, 1u, 2u));
+  }
+}
+
+TEST(InputFileTest, EmptyStdin) {
+  TempFile file("io_test_empty_stdin.spv", {});
+  RedirectStdin(file.name());
+  InputFile<uint32_t> input;
+  ASSERT_TRUE(input.Open("-", "rb"));
+  EXPECT_EQ(0u, input.size());
+}
+
+TEST(InputFileTest, PartialWordFromStdin) {
+  std::vector<char> content = Bytes({0x07230203, 1});
+  content.pop_back();
+  TempFile file("io_test_partial_stdin.spv", content);
+  RedirectStdin(file.name());
+  InputFile<uint32_t> input;
+  EXPECT_FALSE(input.Open("-", "rb"));
+}
+
+}  // namespace
@@ -0,0 +1,105 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "util/id_table.h"
+
+namespace {
+
+using spvtools::utils::IdTable;
+
+TEST(IdTableTest, UnsetIdsHoldDefaultValues) {
+  IdTable<uint32_t> table;
+  table.Reserve(10, 100);
+  EXPECT_EQ(0u, table.Get(0));
+  EXPECT_EQ(0u, table.Get(9));
+  EXPECT_EQ(0u, table.Get(10));
+  EXPECT_EQ(0u, table.Get(0xffffffff));
+}
+
+TEST(IdTableTest, StoresIdsBelowBound) {
+  IdTable<uint32_t> table;
+  table.Reserve(10, 100);
+  for (uint32_t id = 0; id < 10; ++id) table[id] = id * 2;
+  for (uint32_t id = 0; id < 10; ++id) EXPECT_EQ(id * 2, table.Get(id));
+}
+
+TEST(IdTableTest, StoresIdsAtOrAboveBound) {
+  IdTable<uint32_t> table;
+  table.Reserve(10, 100);
+  table[10] = 1;
+  table[5000] = 2;
+  table[0xffffffff] = 3;
+  EXPECT_EQ(1u, table.Get(10));
+  EXPECT_EQ(2u, table.Get(5000));
+  EXPECT_EQ(3u, table.Get(0xffffffff));
+  EXPECT_EQ(0u, table.Get(11));
+}
+
+TEST(IdTableTest, StoresIdsWithHugeBound) {
+  // A bound far beyond the word count must not allocate storage for every id.
+  IdTable<uint32_t> table;
+  table.Reserve(0xffffffff, 5);
+  table[1] = 1;
+  table[0xfffffffe] = 2;
+  EXPECT_EQ(1u, table.Get(1));
+  EXPECT_EQ(2u, table.Get(0xfffffffe));
+  EXPECT_EQ(0u, table.Get(2));
+}
+
+TEST(IdTableTest, StoresIdsWithoutReserve) {
+  IdTable<uint32_t> table;
+  table[3] = 4;
+  EXPECT_EQ(4u, table.Get(3));
+  EXPECT_EQ(0u, table.Get(4));
+}
+
+TEST(IdTableTest, ReferencesStayValid) {
+  IdTable<std::vector<int>> table;
+  table.Reserve(4, 100);
+  std::vector<int>& low = table[1];
+  std::vector<int>& high = table[100];
+  low.push_back(1);
+  for (uint32_t id = 0; id < 100000; ++id) table[id].push_back(2);
+  high.push_back(3);
+  EXPECT_THAT(table.Get(1), ::testing::ElementsAre(1, 2));
+  EXPECT_THAT(table.Get(100), ::testing::ElementsAre(2, 3));
+}
+
+TEST(IdTableTest, MoveKeepsValuesAndReferences) {
+  IdTable<uint32_t> table;
+  table.Reserve(4, 100);
+  table[1] = 2;
+  table[5000] = 3;
+  uint32_t& low = table[1];
+  uint32_t& high = table[5000];
+
+  IdTable<uint32_t> moved(std::move(table));
+  EXPECT_EQ(2u, moved.Get(1));
+  EXPECT_EQ(3u, moved.Get(5000));
+
+  IdTable<uint32_t> assigned;
+  assigned = std::move(moved);
+  low = 4;
+  high = 5;
+  EXPECT_EQ(4u, assigned.Get(1));
+  EXPECT_EQ(5u, assigned.Get(5000));
+  EXPECT_EQ(0u, assigned.Get(2));
+}
+
+}  // namespace
@@ -0,0 +1,46 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "util/opcode_table.h"
+
+namespace {
+
+using spvtools::utils::OpcodeTable;
+using ::testing::ElementsAre;
+
+TEST(OpcodeTableTest, UnsetOpcodesHoldDefaultValues) {
+  OpcodeTable<std::vector<int>> table;
+  EXPECT_TRUE(table.Get(0).empty());
+  table[5].push_back(1);
+  EXPECT_TRUE(table.Get(4).empty());
+  EXPECT_TRUE(table.Get(6).empty());
+  EXPECT_TRUE(table.Get(0xffffffff).empty());
+}
+
+TEST(OpcodeTableTest, KeepsValuesWhenGrowing) {
+  OpcodeTable<std::vector<int>> table;
+  table[12].push_back(1);
+  table[12].push_back(2);
+  table[4421].push_back(3);
+  table[3].push_back(4);
+  EXPECT_THAT(table.Get(12), ElementsAre(1, 2));
+  EXPECT_THAT(table.Get(4421), ElementsAre(3));
+  EXPECT_THAT(table.Get(3), ElementsAre(4));
+}
+
+}  // namespace
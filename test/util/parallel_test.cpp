@@ -0,0 +1,69 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "util/parallel.h"
+
+namespace {
+
+using spvtools::utils::MaxParallelThreads;
+using spvtools::utils::ParallelFor;
+
+TEST(ParallelForTest, OneThreadCallsTasksInOrderOnTheCaller) {
+  const std::thread::id caller = std::this_thread::get_id();
+  std::vector<size_t> calls;
+  ParallelFor(1, 5, [&](size_t i) {
+    EXPECT_EQ(caller, std::this_thread::get_id());
+    calls.push_back(i);
+  });
+  EXPECT_THAT(calls, ::testing::ElementsAre(0, 1, 2, 3, 4));
+}
+
+TEST(ParallelForTest, NoTasks) {
+  bool called = false;
+  ParallelFor(4, 0, [&](size_t) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(ParallelForTest, CallsEveryTaskOnce) {
+  const size_t num_tasks = 1000;
+  std::vector<std::atomic<int>> calls(num_tasks);
+  for (auto& count : calls) count = 0;
+  ParallelFor(4, num_tasks, [&](size_t i) { ++calls[i]; });
+  for (size_t i = 0; i < num_tasks; ++i) EXPECT_EQ(1, calls[i]) << i;
+}
+
+TEST(ParallelForTest, CapsTheNumberOfThreads) {
+  EXPECT_LE(1u, MaxParallelThreads());
+
+  std::mutex mutex;
+  std::vector<std::thread::id> threads;
+  ParallelFor(0xFFFFFFFFu, 10000, [&](size_t) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::thread::id id = std::this_thread::get_id();
+    if (std::find(threads.begin(), threads.end(), id) == threads.end()) {
+      threads.push_back(id);
+    }
+  });
+  EXPECT_LE(threads.size(), MaxParallelThreads());
+}
+
+}  // anonymous namespace
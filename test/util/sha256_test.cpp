@@ -0,0 +1,56 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <string>
+
+#include "gmock/gmock.h"
+
+#include "util/sha256.h"
+
+namespace {
+
+using spvtools::utils::Sha256;
+
+std::string DigestOf(const std::string& message) {
+  Sha256 sha;
+  sha.Update(message.data(), message.size());
+  return Sha256::ToHex(sha.Finish());
+}
+
+TEST(Sha256Test, MatchesStandardExamples) {
+  EXPECT_EQ("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+            DigestOf(""));
+  EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad",
+            DigestOf("abc"));
+  EXPECT_EQ("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1",
+            DigestOf("abcdbcdecdefdefgefghfghighijhijk"
+                     "ijkljklmklmnlmnomnopnopq"));
+  EXPECT_EQ("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0",
+            DigestOf(std::string(1000000, 'a')));
+}
+
+TEST(Sha256Test, PiecesGiveTheSameDigest) {
+  std::string message;
+  for (int i = 0; i < 300; ++i) message.push_back(static_cast<char>(i * 7));
+  for (size_t piece : {1, 3, 63, 64, 65, 200}) {
+    Sha256 sha;
+    for (size_t i = 0; i < message.size(); i += piece) {
+      sha.Update(message.data() + i, std::min(piece, message.size() - i));
+    }
+    EXPECT_EQ(DigestOf(message), Sha256::ToHex(sha.Finish())) << piece;
+  }
+}
+
+}  // namespace
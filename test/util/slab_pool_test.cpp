@@ -0,0 +1,129 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "util/slab_pool.h"
+
+namespace {
+
+using spvtools::utils::PoolAllocator;
+using spvtools::utils::SlabPool;
+using spvtools::utils::SlabPoolPtr;
+
+TEST(SlabPoolTest, BlocksAreAlignedAndDistinct) {
+  SlabPoolPtr pool(SlabPool::Create());
+  std::vector<char*> blocks;
+  for (size_t size = 1; size < 200; ++size) {
+    char* block = static_cast<char*>(pool->Allocate(size));
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(block) % 16);
+    memset(block, static_cast<int>(size), size);
+    blocks.push_back(block);
+  }
+  for (size_t size = 1; size < 200; ++size) {
+    EXPECT_EQ(static_cast<char>(size), blocks[size - 1][size - 1]);
+    pool->Deallocate(blocks[size - 1], size);
+  }
+  EXPECT_EQ(0u, pool->num_live_blocks());
+}
+
+TEST(SlabPoolTest, FreedBlocksAreReused) {
+  SlabPoolPtr pool(SlabPool::Create());
+  std::vector<void*> blocks;
+  for (int i = 0; i < 10000; ++i) blocks.push_back(pool->Allocate(128));
+  const size_t num_slabs = pool->num_slabs();
+  EXPECT_LT(num_slabs, 100u);
+  for (void* block : blocks) pool->Deallocate(block, 128);
+  for (int i = 0; i < 10000; ++i) blocks[i] = pool->Allocate(128);
+  EXPECT_EQ(num_slabs, pool->num_slabs());
+  for (void* block : blocks) pool->Deallocate(block, 128);
+}
+
+TEST(SlabPoolTest, LargeBlocks) {
+  SlabPoolPtr pool(SlabPool::Create());
+  void* block = pool->Allocate(100000);
+  memset(block, 0, 100000);
+  // Large blocks come from the system allocator.
+  EXPECT_EQ(0u, pool->num_live_blocks());
+  pool->Deallocate(block, 100000);
+}
+
+TEST(SlabPoolTest, BlocksOutliveTheOwner) {
+  SlabPoolPtr pool(SlabPool::Create());
+  void* block = SlabPool::AllocateFrom(pool.get(), 40);
+  memset(block, 1, 40);
+  pool.reset();
+  // The pool is still alive until the last block is returned.
+  SlabPool::DeallocateAny(block, 40);
+}
+
+TEST(SlabPoolTest, DeallocateAnyFindsThePool) {
+  SlabPoolPtr pool1(SlabPool::Create());
+  SlabPoolPtr pool2(SlabPool::Create());
+  std::vector<void*> blocks;
+  for (int i = 0; i < 10000; ++i) {
+    blocks.push_back(SlabPool::AllocateFrom(pool1.get(), 48));
+    blocks.push_back(SlabPool::AllocateFrom(pool2.get(), 48));
+  }
+  EXPECT_EQ(10000u, pool1->num_live_blocks());
+  for (void* block : blocks) SlabPool::DeallocateAny(block, 48);
+  EXPECT_EQ(0u, pool1->num_live_blocks());
+  EXPECT_EQ(0u, pool2->num_live_blocks());
+}
+
+TEST(SlabPoolTest, AllocateFromWithoutPool) {
+  // Blocks without a pool come from the system allocator, and can be returned
+  // with |DeallocateAny| like blocks from a pool. Both are aligned to 16
+  // bytes.
+  SlabPoolPtr pool(SlabPool::Create());
+  std::vector<std::pair<char*, size_t>> blocks;
+  for (size_t size = 1; size < 600; size += 7) {
+    for (SlabPool* from : {pool.get(), static_cast<SlabPool*>(nullptr)}) {
+      char* block = static_cast<char*>(SlabPool::AllocateFrom(from, size));
+      EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(block) % 16);
+      memset(block, static_cast<int>(size), size);
+      blocks.emplace_back(block, size);
+    }
+  }
+  EXPECT_EQ(71u, pool->num_live_blocks());
+  for (const auto& block : blocks) {
+    EXPECT_EQ(static_cast<char>(block.second), block.first[block.second - 1]);
+    SlabPool::DeallocateAny(block.first, block.second);
+  }
+  EXPECT_EQ(0u, pool->num_live_blocks());
+}
+
+TEST(SlabPoolTest, PoolAllocator) {
+  SlabPoolPtr pool(SlabPool::Create());
+  {
+    std::vector<uint32_t, PoolAllocator<uint32_t>> words{
+        PoolAllocator<uint32_t>(pool.get())};
+    for (uint32_t i = 0; i < 50; ++i) words.push_back(i);
+    EXPECT_EQ(1u, pool->num_live_blocks());
+    EXPECT_EQ(49u, words.back());
+  }
+  EXPECT_EQ(0u, pool->num_live_blocks());
+
+  // Without a pool the system allocator is used.
+  std::vector<uint32_t, PoolAllocator<uint32_t>> words;
+  words.push_back(1);
+  EXPECT_EQ(nullptr, words.get_allocator().pool());
+}
+
+}  // namespace
@@ -23,6 +23,45 @@ namespace {
 using spvtools::utils::SmallVector;
 using SmallVectorTest = ::testing::Test;
 
+// An allocator that counts the blocks allocated with it that are still in
+// use.
+template <typename T>
+class CountingAllocator {
+ public:
+  using value_type = T;
+
+  explicit CountingAllocator(int* count) : count_(count) {}
+  template <typename U>
+  CountingAllocator(const CountingAllocator<U>& that) : count_(that.count()) {}
+
+  T* allocate(size_t n) {
+    ++*count_;
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* ptr, size_t) {
+    --*count_;
+    ::operator delete(ptr);
+  }
+
+  int* count() const { return count_; }
+
+  template <typename U>
+  bool operator==(const CountingAllocator<U>& that) const {
+    return count_ == that.count();
+  }
+
+  template <typename U>
+  bool operator!=(const CountingAllocator<U>& that) const {
+    return count_ != that.count();
+  }
+
+ private:
+  int* count_;
+};
+
+using CountedVector = SmallVector<uint32_t, 2, CountingAllocator<uint32_t>>;
+
 TEST(SmallVectorTest, Initialize_default) {
   SmallVector<uint32_t, 2> vec;
 
@@ -591,4 +630,49 @@ TEST(SmallVectorTest, Resize6) {
   EXPECT_EQ(vec.size(), 3);
   EXPECT_EQ(vec, result);
 }
+
+TEST(SmallVectorTest, Allocator_LargeDataUsesAllocator) {
+  int count = 0;
+  {
+    CountedVector vec{CountingAllocator<uint32_t>(&count)};
+    vec.push_back(0);
+    vec.push_back(1);
+    EXPECT_EQ(count, 0);
+    vec.push_back(2);
+    EXPECT_GT(count, 0);
+    EXPECT_EQ(vec, std::vector<uint32_t>({0, 1, 2}));
+  }
+  EXPECT_EQ(count, 0);
+}
+
+TEST(SmallVectorTest, Allocator_CopyUsesSameAllocator) {
+  int count = 0;
+  CountedVector vec{CountingAllocator<uint32_t>(&count)};
+  vec.push_back(0);
+  vec.push_back(1);
+  vec.push_back(2);
+  const int count_for_one = count;
+  CountedVector copy(vec);
+  EXPECT_EQ(count, 2 * count_for_one);
+  EXPECT_EQ(copy, vec);
+}
+
+TEST(SmallVectorTest, Allocator_MoveToOtherAllocator) {
+  int count1 = 0;
+  int count2 = 0;
+  CountedVector vec1{CountingAllocator<uint32_t>(&count1)};
+  CountedVector vec2{CountingAllocator<uint32_t>(&count2)};
+  vec1.push_back(0);
+  vec1.push_back(1);
+  vec1.push_back(2);
+  vec2 = std::move(vec1);
+  EXPECT_EQ(count1, 0);
+  EXPECT_GT(count2, 0);
+  EXPECT_EQ(vec2, std::vector<uint32_t>({0, 1, 2}));
+
+  // With the same allocator the large data is handed over as is.
+  CountedVector vec3(std::move(vec2));
+  EXPECT_EQ(vec3, std::vector<uint32_t>({0, 1, 2}));
+  EXPECT_GT(count2, 0);
+}
 }  // namespace
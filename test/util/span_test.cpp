@@ -0,0 +1,64 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include "gmock/gmock.h"
+
+#include "util/span.h"
+
+namespace {
+
+using spvtools::utils::Span;
+using ::testing::ElementsAre;
+
+TEST(SpanTest, DefaultIsEmpty) {
+  Span<const uint32_t> span;
+  EXPECT_TRUE(span.empty());
+  EXPECT_EQ(0u, span.size());
+  EXPECT_EQ(span.begin(), span.end());
+}
+
+TEST(SpanTest, ViewsValuesInPlace) {
+  std::vector<uint32_t> values = {1, 2, 3, 4};
+  Span<const uint32_t> span(values.data() + 1, 2);
+  EXPECT_FALSE(span.empty());
+  EXPECT_EQ(2u, span.size());
+  EXPECT_EQ(values.data() + 1, span.data());
+  EXPECT_EQ(2u, span.front());
+  EXPECT_EQ(3u, span.back());
+  EXPECT_THAT(std::vector<uint32_t>(span.begin(), span.end()),
+              ElementsAre(2, 3));
+
+  values[2] = 7;
+  EXPECT_EQ(7u, span[1]);
+}
+
+TEST(SpanTest, AtReturnsTheSameValuesAsIndexing) {
+  std::vector<uint32_t> values = {5, 6, 7};
+  Span<const uint32_t> span(values.data(), values.size());
+  for (size_t i = 0; i < span.size(); ++i) {
+    EXPECT_EQ(&span[i], &span.at(i));
+  }
+}
+
+TEST(SpanTest, CanModifyNonConstValues) {
+  std::vector<int> values = {1, 2, 3};
+  Span<int> span(values.data(), values.size());
+  for (int& value : span) value *= 2;
+  EXPECT_THAT(values, ElementsAre(2, 4, 6));
+}
+
+}  // anonymous namespace
@@ -0,0 +1,90 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#include "gmock/gmock.h"
+
+#include "util/text_buffer.h"
+
+namespace {
+
+using spvtools::utils::TextBuffer;
+
+TEST(TextBufferTest, AppendsText) {
+  TextBuffer buffer;
+  EXPECT_EQ(0u, buffer.size());
+  buffer.Append("Op");
+  buffer.Append(std::string("Name"));
+  buffer.Append(' ');
+  buffer.Append("%main_", 5);
+  buffer.AppendFill(2, '-');
+  EXPECT_EQ("OpName %main--", buffer.str());
+  EXPECT_EQ(buffer.str().size(), buffer.size());
+
+  buffer.Clear();
+  EXPECT_EQ("", buffer.str());
+}
+
+TEST(TextBufferTest, IntegersMatchStream) {
+  for (int64_t value : {int64_t(0), int64_t(7), int64_t(-1), int64_t(10),
+                        int64_t(-2147483648LL), int64_t(4294967295LL),
+                        std::numeric_limits<int64_t>::min(),
+                        std::numeric_limits<int64_t>::max()}) {
+    TextBuffer buffer;
+    buffer.AppendSigned(value);
+    std::ostringstream stream;
+    stream << value;
+    EXPECT_EQ(stream.str(), buffer.str());
+  }
+  for (uint64_t value :
+       {uint64_t(0), uint64_t(9), uint64_t(1000000), uint64_t(4294967296ULL),
+        std::numeric_limits<uint64_t>::max()}) {
+    TextBuffer buffer;
+    buffer.AppendUnsigned(value);
+    std::ostringstream stream;
+    stream << value;
+    EXPECT_EQ(stream.str(), buffer.str());
+  }
+}
+
+TEST(TextBufferTest, HexIsPadded) {
+  TextBuffer buffer;
+  buffer.AppendHex(0, 8);
+  buffer.Append(' ');
+  buffer.AppendHex(0x14ac, 8);
+  buffer.Append(' ');
+  buffer.AppendHex(0x123456789aULL, 8);
+  buffer.Append(' ');
+  buffer.AppendHex(0xff, 0);
+  EXPECT_EQ("00000000 000014ac 123456789a ff", buffer.str());
+}
+
+TEST(TextBufferTest, FloatsMatchStream) {
+  for (double value : {0.0, -0.0, 1.0, 0.1, -2.5e-300, 1.0 / 3, 1e21,
+                       123456789.0}) {
+    for (int precision : {9, 17}) {
+      TextBuffer buffer;
+      buffer.AppendFloat(value, precision);
+      std::ostringstream stream;
+      stream << std::setprecision(precision) << value;
+      EXPECT_EQ(stream.str(), buffer.str());
+    }
+  }
+}
+
+}  // namespace
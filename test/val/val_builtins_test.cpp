@@ -1757,6 +1757,31 @@ OpDecorate %workgroup_size BuiltIn WorkgroupSize
                         "ID <2> (OpConstantComposite) is not an int vector."));
 }
 
+TEST_F(ValidateBuiltIns, BuiltInsCheckedInIdOrder) {
+  CodeGenerator generator = GetDefaultShaderCodeGenerator();
+  // %defined_last gets the smaller id, so it is checked first even though it
+  // comes last in the binary.
+  generator.before_types_ = R"(
+OpDecorate %defined_last BuiltIn WorkgroupSize
+OpDecorate %defined_first BuiltIn WorkgroupSize
+)";
+
+  generator.after_types_ = R"(
+%defined_first = OpConstant %u32 16
+%defined_last = OpConstantComposite %f32vec3 %f32_1 %f32_1 %f32_1
+)";
+
+  EntryPoint entry_point;
+  entry_point.name = "main";
+  entry_point.execution_model = "GLCompute";
+  generator.entry_points_.push_back(std::move(entry_point));
+
+  CompileSuccessfully(generator.Build(), SPV_ENV_VULKAN_1_0);
+  ASSERT_EQ(SPV_ERROR_INVALID_DATA, ValidateInstructions(SPV_ENV_VULKAN_1_0));
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("ID <2> (OpConstantComposite) is not an int vector."));
+}
+
 TEST_F(ValidateBuiltIns, WorkgroupSizeNotVec3) {
   CodeGenerator generator = GetDefaultShaderCodeGenerator();
   generator.before_types_ = R"(
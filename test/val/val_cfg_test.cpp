@@ -1819,6 +1819,175 @@ OpFunctionEnd
   ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
 }
 
+// Returns a function with |depth| selections nested in each other's true
+// branches. |outer_code| goes in the outermost header block, |inner_code| in
+// the innermost block, and |merge_code| in the outermost merge block.
+string DeeplyNestedSelections(int depth, const string& outer_code,
+                              const string& inner_code,
+                              const string& merge_code) {
+  stringstream ss;
+  ss << R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+%int = OpTypeInt 32 0
+%int1 = OpConstant %int 1
+%func_ty = OpTypeFunction %void
+%func = OpFunction %void None %func_ty
+)";
+  for (int i = 0; i < depth; ++i) {
+    ss << "%header" << i << " = OpLabel\n";
+    if (i == 0) ss << outer_code;
+    ss << "OpSelectionMerge %merge" << i << " None\n";
+    ss << "OpBranchConditional %true %header" << i + 1 << " %merge" << i
+       << "\n";
+  }
+  ss << "%header" << depth << " = OpLabel\n" << inner_code;
+  ss << "OpBranch %merge" << depth - 1 << "\n";
+  for (int i = depth - 1; i > 0; --i) {
+    ss << "%merge" << i << " = OpLabel\n";
+    ss << "OpBranch %merge" << i - 1 << "\n";
+  }
+  ss << "%merge0 = OpLabel\n" << merge_code << "OpReturn\nOpFunctionEnd\n";
+  return ss.str();
+}
+
+TEST_F(ValidateCFG, DeeplyNestedSelectionsUseOuterDefinitionGood) {
+  CompileSuccessfully(
+      DeeplyNestedSelections(200, "%outer = OpIAdd %int %int1 %int1\n",
+                             "%inner = OpIAdd %int %outer %int1\n", ""));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
+TEST_F(ValidateCFG, DeeplyNestedSelectionsUseInnerDefinitionBad) {
+  CompileSuccessfully(
+      DeeplyNestedSelections(200, "", "%inner = OpIAdd %int %int1 %int1\n",
+                             "%use = OpIAdd %int %inner %int1\n"));
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not dominate its use in block"));
+}
+
+TEST_F(ValidateCFG, DefinitionInOtherFunctionDoesNotDominateUseBad) {
+  // Both functions have the same shape, so their blocks would be given the
+  // same dominator intervals if each function were numbered separately.
+  CompileSuccessfully(R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+%int = OpTypeInt 32 0
+%int1 = OpConstant %int 1
+%func_ty = OpTypeFunction %void
+%func1 = OpFunction %void None %func_ty
+%entry1 = OpLabel
+%def = OpIAdd %int %int1 %int1
+OpSelectionMerge %merge1 None
+OpBranchConditional %true %then1 %merge1
+%then1 = OpLabel
+OpBranch %merge1
+%merge1 = OpLabel
+OpReturn
+OpFunctionEnd
+%func2 = OpFunction %void None %func_ty
+%entry2 = OpLabel
+OpSelectionMerge %merge2 None
+OpBranchConditional %true %then2 %merge2
+%then2 = OpLabel
+%use = OpIAdd %int %def %int1
+OpBranch %merge2
+%merge2 = OpLabel
+OpReturn
+OpFunctionEnd
+)");
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not dominate its use in block"));
+}
+
+TEST_F(ValidateCFG, DefinitionInOtherFunctionWithThreadsBad) {
+  // The functions are analyzed on different threads, but must still be
+  // numbered from different ranges.
+  CompileSuccessfully(R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%bool = OpTypeBool
+%true = OpConstantTrue %bool
+%int = OpTypeInt 32 0
+%int1 = OpConstant %int 1
+%func_ty = OpTypeFunction %void
+%func1 = OpFunction %void None %func_ty
+%entry1 = OpLabel
+%def = OpIAdd %int %int1 %int1
+OpSelectionMerge %merge1 None
+OpBranchConditional %true %then1 %merge1
+%then1 = OpLabel
+OpBranch %merge1
+%merge1 = OpLabel
+OpReturn
+OpFunctionEnd
+%func2 = OpFunction %void None %func_ty
+%entry2 = OpLabel
+OpSelectionMerge %merge2 None
+OpBranchConditional %true %then2 %merge2
+%then2 = OpLabel
+%use = OpIAdd %int %def %int1
+OpBranch %merge2
+%merge2 = OpLabel
+OpReturn
+OpFunctionEnd
+)");
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              HasSubstr("does not dominate its use in block"));
+}
+
+TEST_F(ValidateCFG, ThreadedCfgChecksReportFirstFunctionBad) {
+  // Both functions have a block before its dominator. Only the error in the
+  // first function is reported, whichever thread analyzed it.
+  CompileSuccessfully(R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+OpName %late1 "late1"
+OpName %dom1 "dom1"
+OpName %late2 "late2"
+OpName %dom2 "dom2"
+%void = OpTypeVoid
+%func_ty = OpTypeFunction %void
+%func1 = OpFunction %void None %func_ty
+%entry1 = OpLabel
+OpBranch %dom1
+%late1 = OpLabel
+OpReturn
+%dom1 = OpLabel
+OpBranch %late1
+OpFunctionEnd
+%func2 = OpFunction %void None %func_ty
+%entry2 = OpLabel
+OpBranch %dom2
+%late2 = OpLabel
+OpReturn
+%dom2 = OpLabel
+OpBranch %late2
+OpFunctionEnd
+)");
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(SPV_ERROR_INVALID_CFG, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(),
+              MatchesRegex("Block .\\[late1\\] appears in the binary "
+                           "before its dominator .\\[dom1\\]\n"
+                           "  %dom1 = OpLabel\n"));
+}
+
 /// TODO(umar): Nested CFG constructs
 
 }  // namespace
@@ -2334,6 +2334,95 @@ TEST_F(ValidateDecorations, BlockLayoutOffsetOverlapBad) {
           "offset 16 overlaps previous member ending at offset 31"));
 }
 
+TEST_F(ValidateDecorations, SharedStructLayoutCheckedForEachRulesBad) {
+  // %Inner follows the storage buffer layout rules where %Buffer uses it, but
+  // not the uniform buffer rules where %Block uses it.
+  string spirv = R"(
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpMemberDecorate %Inner 0 Offset 0
+               OpMemberDecorate %Inner 1 Offset 4
+               OpMemberDecorate %Buffer 0 Offset 0
+               OpMemberDecorate %Buffer 1 Offset 8
+               OpMemberDecorate %Block 0 Offset 0
+               OpMemberDecorate %Block 1 Offset 8
+               OpDecorate %Buffer BufferBlock
+               OpDecorate %Block Block
+               OpDecorate %B DescriptorSet 0
+               OpDecorate %B Binding 0
+               OpDecorate %U DescriptorSet 0
+               OpDecorate %U Binding 1
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+       %uint = OpTypeInt 32 0
+      %Inner = OpTypeStruct %uint %uint
+     %Buffer = OpTypeStruct %Inner %uint
+      %Block = OpTypeStruct %Inner %uint
+%_ptr_Uniform_Buffer = OpTypePointer Uniform %Buffer
+%_ptr_Uniform_Block = OpTypePointer Uniform %Block
+          %B = OpVariable %_ptr_Uniform_Buffer Uniform
+          %U = OpVariable %_ptr_Uniform_Block Uniform
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateAndRetrieveValidationState());
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr(
+          "Structure id 5 decorated as Block for variable in Uniform storage "
+          "class must follow standard uniform buffer layout rules: member 1 at "
+          "offset 8 overlaps previous member ending at offset 15"));
+}
+
+TEST_F(ValidateDecorations, StructEndingInMatrixSizeUsesMatrixStrideBad) {
+  // %Inner is 64 bytes long because of the MatrixStride of its last member,
+  // so %f overlaps it.
+  string spirv = R"(
+               OpCapability Shader
+          %1 = OpExtInstImport "GLSL.std.450"
+               OpMemoryModel Logical GLSL450
+               OpEntryPoint GLCompute %main "main"
+               OpExecutionMode %main LocalSize 1 1 1
+               OpMemberDecorate %Inner 0 ColMajor
+               OpMemberDecorate %Inner 0 Offset 0
+               OpMemberDecorate %Inner 0 MatrixStride 16
+               OpMemberDecorate %Outer 0 Offset 0
+               OpMemberDecorate %Outer 1 Offset 16
+               OpDecorate %Outer Block
+               OpDecorate %U DescriptorSet 0
+               OpDecorate %U Binding 0
+       %void = OpTypeVoid
+          %3 = OpTypeFunction %void
+      %float = OpTypeFloat 32
+    %v4float = OpTypeVector %float 4
+%mat4v4float = OpTypeMatrix %v4float 4
+      %Inner = OpTypeStruct %mat4v4float
+      %Outer = OpTypeStruct %Inner %float
+%_ptr_Uniform_Outer = OpTypePointer Uniform %Outer
+          %U = OpVariable %_ptr_Uniform_Outer Uniform
+       %main = OpFunction %void None %3
+          %5 = OpLabel
+               OpReturn
+               OpFunctionEnd
+  )";
+
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateAndRetrieveValidationState());
+  EXPECT_THAT(
+      getDiagnosticString(),
+      HasSubstr(
+          "Structure id 4 decorated as Block for variable in Uniform storage "
+          "class must follow standard uniform buffer layout rules: member 1 at "
+          "offset 16 overlaps previous member ending at offset 63"));
+}
+
 TEST_F(ValidateDecorations, BufferBlockEmptyStruct) {
   string spirv = R"(
                OpCapability Shader
@@ -109,6 +109,34 @@ TEST_F(ValidateExtensionCapabilities, DeclCapabilityFailure) {
   EXPECT_THAT(getDiagnosticString(), HasSubstr("SPV_KHR_device_group"));
 }
 
+TEST_F(ValidateExtensionCapabilities, DeclCapabilityByteSwappedSuccess) {
+  const string str =
+      "OpCapability Shader\nOpCapability Linkage\nOpCapability DeviceGroup\n"
+      "OpExtension \"SPV_KHR_device_group\""
+      "\nOpMemoryModel Logical GLSL450";
+  CompileSuccessfully(str.c_str());
+  // Swap the byte order of every word except those of the literal string,
+  // whose bytes are read in order whatever the endianness of the module.
+  const auto swap = [](uint32_t word) {
+    return (word >> 24) | ((word >> 8) & 0xff00) | ((word << 8) & 0xff0000) |
+           (word << 24);
+  };
+  for (size_t i = 0; i < SPV_INDEX_INSTRUCTION; ++i) {
+    binary_->code[i] = swap(binary_->code[i]);
+  }
+  for (size_t index = SPV_INDEX_INSTRUCTION; index < binary_->wordCount;) {
+    const uint32_t first_word = binary_->code[index];
+    const uint32_t word_count = first_word >> 16;
+    const bool is_extension =
+        (first_word & 0xffff) == uint32_t(SpvOpExtension);
+    for (uint32_t i = 0; i < (is_extension ? 1 : word_count); ++i) {
+      binary_->code[index + i] = swap(binary_->code[index + i]);
+    }
+    index += word_count;
+  }
+  ASSERT_EQ(SPV_SUCCESS, ValidateInstructions());
+}
+
 using ValidateAMDShaderBallotCapabilities = spvtest::ValidateBase<string>;
 
 // Returns a vector of strings for the prefix of a SPIR-V assembly shader
@@ -33,6 +33,7 @@ using std::ostringstream;
 using std::string;
 using std::vector;
 using ::testing::HasSubstr;
+using ::testing::Not;
 using ::testing::ValuesIn;
 
 using ValidateIdWithMessage = spvtest::ValidateBase<bool>;
@@ -184,6 +185,27 @@ TEST_F(ValidateIdWithMessage, OpMemberNameMemberBad) {
                 "Type <id> '1[foo]'s member count."));
 }
 
+TEST_F(ValidateIdWithMessage, ThreadedValidationReportsFirstError) {
+  // Spread enough instructions around the two bad ones that they are
+  // checked by different threads.
+  ostringstream spirv;
+  spirv << kGLSL450MemoryModel;
+  for (int i = 0; i < 1500; ++i) spirv << "OpMemberName %ok 0 \"m\"\n";
+  spirv << "OpMemberName %first 1 \"first\"\n";
+  for (int i = 0; i < 3000; ++i) spirv << "OpMemberName %ok 0 \"m\"\n";
+  spirv << "OpMemberName %second 1 \"second\"\n";
+  spirv << R"(
+   %int = OpTypeInt 32 0
+    %ok = OpTypeStruct %int
+ %first = OpTypeStruct %int
+%second = OpTypeStruct %int)";
+  CompileSuccessfully(spirv.str());
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("[first]"));
+  EXPECT_THAT(getDiagnosticString(), Not(HasSubstr("[second]")));
+}
+
 TEST_F(ValidateIdWithMessage, OpLineGood) {
   string spirv = kGLSL450MemoryModel + R"(
 %1 = OpString "/path/to/source.file"
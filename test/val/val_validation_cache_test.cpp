@@ -0,0 +1,185 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests for caching the outcome of validation on disk.
+
+#include <cstdio>
+#include <string>
+
+#if defined(_WIN32)
+#include <direct.h>
+#include <process.h>
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "gmock/gmock.h"
+#include "spirv_validator_options.h"
+#include "unit_spirv.h"
+#include "val/validation_cache.h"
+#include "val_fixtures.h"
+
+namespace {
+
+using spvtools::ValidationCache;
+using ::testing::HasSubstr;
+
+const size_t kCacheSize = 1 << 16;
+
+// Returns the name of a new, empty directory for the cache of the current
+// test, so that tests running at the same time do not share entries.
+std::string MakeCacheDirectory() {
+  const ::testing::TestInfo* test =
+      ::testing::UnitTest::GetInstance()->current_test_info();
+#if defined(_WIN32)
+  const int pid = _getpid();
+#else
+  const int pid = getpid();
+#endif
+  const std::string directory = ::testing::TempDir() + "spirv-val-cache-" +
+                                test->name() + "-" + std::to_string(pid);
+#if defined(_WIN32)
+  _mkdir(directory.c_str());
+#else
+  mkdir(directory.c_str(), 0700);
+#endif
+  return directory;
+}
+
+class ValidationCacheTest : public spvtest::ValidateBase<bool> {
+ public:
+  ValidationCacheTest()
+      : cache_directory_(MakeCacheDirectory()),
+        cache_(cache_directory_, kCacheSize) {
+    spvValidatorOptionsSetCache(getValidatorOptions(),
+                                cache_directory_.c_str(), kCacheSize);
+  }
+
+  // Removes the cache entry of the test and its directory while the module
+  // and the options the entry was recorded for still exist.
+  void TearDown() override {
+    if (binary_) remove(cache_.EntryPath(Key()).c_str());
+#if defined(_WIN32)
+    _rmdir(cache_directory_.c_str());
+#else
+    rmdir(cache_directory_.c_str());
+#endif
+    spvtest::ValidateBase<bool>::TearDown();
+  }
+
+  ValidationCache::Key Key() {
+    return ValidationCache::ComputeKey(SPV_ENV_UNIVERSAL_1_0,
+                                       getValidatorOptions(),
+                                       get_const_binary()->code,
+                                       get_const_binary()->wordCount);
+  }
+
+ protected:
+  const std::string cache_directory_;
+  ValidationCache cache_;
+};
+
+const char kValid[] = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+)";
+
+const char kInvalid[] = R"(
+OpCapability Shader
+OpCapability Linkage
+OpMemoryModel Logical GLSL450
+%void = OpTypeVoid
+%ptr = OpTypePointer Uniform %void
+%var = OpVariable %ptr Uniform
+%load = OpLoad %void %var
+)";
+
+TEST_F(ValidationCacheTest, RecordsOutcome) {
+  CompileSuccessfully(kInvalid);
+  remove(cache_.EntryPath(Key()).c_str());
+  ASSERT_NE(SPV_SUCCESS, ValidateInstructions());
+  const std::string diagnostic = getDiagnosticString();
+
+  ValidationCache::Entry entry;
+  ASSERT_TRUE(cache_.Load(Key(), &entry));
+  EXPECT_NE(SPV_SUCCESS, entry.result);
+  ASSERT_EQ(1u, entry.messages.size());
+  EXPECT_EQ(SPV_MSG_ERROR, entry.messages[0].level);
+  EXPECT_EQ(diagnostic, entry.messages[0].text);
+
+  // Validating again reports the same outcome.
+  spvDiagnosticDestroy(diagnostic_);
+  diagnostic_ = nullptr;
+  EXPECT_EQ(entry.result, ValidateInstructions());
+  EXPECT_EQ(diagnostic, getDiagnosticString());
+}
+
+TEST_F(ValidationCacheTest, ReportsRecordedOutcome) {
+  CompileSuccessfully(kValid);
+  ValidationCache::Entry entry;
+  entry.result = SPV_ERROR_INVALID_ID;
+  entry.messages.push_back(
+      {SPV_MSG_ERROR, "input", spv_position_t{0, 0, 5}, "from the cache"});
+  cache_.Store(Key(), entry);
+
+  EXPECT_EQ(SPV_ERROR_INVALID_ID, ValidateInstructions());
+  EXPECT_THAT(getDiagnosticString(), HasSubstr("from the cache"));
+}
+
+TEST_F(ValidationCacheTest, IgnoresDamagedEntries) {
+  CompileSuccessfully(kValid);
+  FILE* file = fopen(cache_.EntryPath(Key()).c_str(), "wb");
+  ASSERT_NE(nullptr, file);
+  fputs("SPVVAL01 but nothing else", file);
+  fclose(file);
+
+  ValidationCache::Entry entry;
+  EXPECT_FALSE(cache_.Load(Key(), &entry));
+  EXPECT_EQ(SPV_SUCCESS, ValidateInstructions());
+  EXPECT_TRUE(cache_.Load(Key(), &entry));
+  EXPECT_EQ(SPV_SUCCESS, entry.result);
+}
+
+TEST_F(ValidationCacheTest, KeyCoversModuleEnvironmentAndOptions) {
+  CompileSuccessfully(kValid);
+  const ValidationCache::Key key = Key();
+  const spv_const_binary binary = get_const_binary();
+
+  EXPECT_NE(key, ValidationCache::ComputeKey(SPV_ENV_VULKAN_1_0,
+                                             getValidatorOptions(),
+                                             binary->code, binary->wordCount));
+  EXPECT_NE(key, ValidationCache::ComputeKey(SPV_ENV_UNIVERSAL_1_0,
+                                             getValidatorOptions(),
+                                             binary->code,
+                                             binary->wordCount - 1));
+
+  spvValidatorOptionsSetRelaxBlockLayout(getValidatorOptions(), true);
+  EXPECT_NE(key, Key());
+  spvValidatorOptionsSetRelaxBlockLayout(getValidatorOptions(), false);
+  spvValidatorOptionsSetUniversalLimit(
+      getValidatorOptions(), spv_validator_limit_max_struct_depth, 3);
+  EXPECT_NE(key, Key());
+  spvValidatorOptionsSetUniversalLimit(
+      getValidatorOptions(), spv_validator_limit_max_struct_depth, 255);
+  EXPECT_EQ(key, Key());
+
+  // The number of threads does not change the outcome.
+  spvValidatorOptionsSetNumThreads(getValidatorOptions(), 4);
+  EXPECT_EQ(key, Key());
+}
+
+}  // namespace
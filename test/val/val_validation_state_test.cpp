@@ -104,6 +104,42 @@ TEST_F(ValidationStateTest, CheckEntryPoints) {
             vstate_->FindDef(vstate_->entry_points()[0])->opcode());
 }
 
+// Tests that instructions refer to the words of the module.
+TEST_F(ValidationStateTest, InstructionsReferToModuleWords) {
+  string spirv = string(header) + "%int = OpTypeInt 32 0";
+  CompileSuccessfully(spirv);
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  const uint32_t* begin = binary_->code;
+  const uint32_t* end = binary_->code + binary_->wordCount;
+  for (const auto& inst : vstate_->ordered_instructions()) {
+    EXPECT_LE(begin, inst.words().data());
+    EXPECT_GE(end, inst.words().data() + inst.words().size());
+  }
+  const auto& type_int = vstate_->ordered_instructions().back();
+  ASSERT_EQ(SpvOpTypeInt, type_int.opcode());
+  ASSERT_EQ(3u, type_int.operands().size());
+  EXPECT_EQ(32u, type_int.GetOperandAs<uint32_t>(1));
+  EXPECT_EQ(type_int.operands().data(), type_int.c_inst().operands);
+}
+
+// Tests that the instructions of a module in the other byte order hold words
+// in host order.
+TEST_F(ValidationStateTest, InstructionsOfByteSwappedModule) {
+  string spirv = string(header) + "%int = OpTypeInt 32 0" + kVoidFVoid;
+  CompileSuccessfully(spirv);
+  for (size_t i = 0; i < binary_->wordCount; ++i) {
+    const uint32_t word = binary_->code[i];
+    binary_->code[i] = (word >> 24) | ((word >> 8) & 0xff00) |
+                       ((word << 8) & 0xff0000) | (word << 24);
+  }
+  EXPECT_EQ(SPV_SUCCESS, ValidateAndRetrieveValidationState());
+  EXPECT_EQ(size_t(10), vstate_->ordered_instructions().size());
+  const auto& type_int = vstate_->ordered_instructions()[3];
+  ASSERT_EQ(SpvOpTypeInt, type_int.opcode());
+  EXPECT_EQ(32u, type_int.word(2));
+  EXPECT_EQ(SpvOpFunction, vstate_->FindDef(type_int.id() + 3)->opcode());
+}
+
 TEST_F(ValidationStateTest, CheckStructMemberLimitOption) {
   spvValidatorOptionsSetUniversalLimit(
       options_, spv_validator_limit_max_struct_members, 32000u);
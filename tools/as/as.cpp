@@ -19,6 +19,7 @@
 #include "source/spirv_target_env.h"
 #include "spirv-tools/libspirv.h"
 #include "tools/io.h"
+#include "tools/util/threads.h"
 
 void print_usage(char* argv0) {
   printf(
@@ -44,6 +45,11 @@ Options:
   --target-env {vulkan1.0|vulkan1.1|spv1.0|spv1.1|spv1.2|spv1.3}
                   Use Vulkan 1.0, Vulkan 1.1, SPIR-V 1.0, SPIR-V 1.1,
                   SPIR-V 1.2, or SPIR-V 1.3
+  --threads <n>   Use up to <n> threads to assemble the bodies of functions.
+                  The output does not depend on it. Defaults to 1. Threaded
+                  assembly first scans the whole text to assign ids, so it is
+                  slower than the default on a single core, and can only pay
+                  off for large modules with many functions on several cores.
 )",
       argv0, argv0);
 }
@@ -54,6 +60,7 @@ int main(int argc, char** argv) {
   const char* inFile = nullptr;
   const char* outFile = nullptr;
   uint32_t options = 0;
+  uint32_t num_threads = 1;
   spv_target_env target_env = kDefaultEnvironment;
   for (int argi = 1; argi < argc; ++argi) {
     if ('-' == argv[argi][0]) {
@@ -103,6 +110,8 @@ int main(int argc, char** argv) {
               fprintf(stderr, "error: Missing argument to --target-env\n");
               return 1;
             }
+          } else if (0 == strcmp(argv[argi], "--threads")) {
+            if (!ParseThreadsFlag(argc, argv, &argi, &num_threads)) return 1;
           } else {
             fprintf(stderr, "error: Unrecognized option: %s\n\n", argv[argi]);
             print_usage(argv[0]);
@@ -128,14 +137,15 @@ int main(int argc, char** argv) {
     outFile = "out.spv";
   }
 
-  std::vector<char> contents;
-  if (!ReadFile<char>(inFile, "r", &contents)) return 1;
+  InputFile<char> contents;
+  if (!contents.Open(inFile, "r")) return 1;
 
   spv_binary binary;
   spv_diagnostic diagnostic = nullptr;
   spv_context context = spvContextCreate(target_env);
-  spv_result_t error = spvTextToBinaryWithOptions(
-      context, contents.data(), contents.size(), options, &binary, &diagnostic);
+  spv_result_t error =
+      spvTextToBinaryWithThreads(context, contents.data(), contents.size(),
+                                 options, num_threads, &binary, &diagnostic);
   spvContextDestroy(context);
   if (error) {
     spvDiagnosticPrint(diagnostic);
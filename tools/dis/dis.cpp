@@ -24,6 +24,7 @@
 
 #include "spirv-tools/libspirv.h"
 #include "tools/io.h"
+#include "tools/util/threads.h"
 
 static void print_usage(char* argv0) {
   printf(
@@ -56,6 +57,9 @@ Options:
   --raw-id        Show raw Id values instead of friendly names.
 
   --offsets       Show byte offsets for each instruction.
+
+  --threads <n>   Use up to <n> threads to disassemble the bodies of
+                  functions. The output does not depend on it. Defaults to 1.
 )",
       argv0, argv0);
 }
@@ -79,6 +83,7 @@ int main(int argc, char** argv) {
   bool show_byte_offsets = false;
   bool no_header = false;
   bool friendly_names = true;
+  uint32_t num_threads = 1;
 
   for (int argi = 1; argi < argc; ++argi) {
     if ('-' == argv[argi][0]) {
@@ -110,6 +115,8 @@ int main(int argc, char** argv) {
             no_header = true;
           } else if (0 == strcmp(argv[argi], "--raw-id")) {
             friendly_names = false;
+          } else if (0 == strcmp(argv[argi], "--threads")) {
+            if (!ParseThreadsFlag(argc, argv, &argi, &num_threads)) return 1;
           } else if (0 == strcmp(argv[argi], "--help")) {
             print_usage(argv[0]);
             return 0;
@@ -172,8 +179,8 @@ int main(int argc, char** argv) {
   }
 
   // Read the input binary.
-  std::vector<uint32_t> contents;
-  if (!ReadFile<uint32_t>(inFile, "rb", &contents)) return 1;
+  InputFile<uint32_t> contents;
+  if (!contents.Open(inFile, "rb")) return 1;
 
   // If printing to standard output, then spvBinaryToText should
   // do the printing.  In particular, colour printing on Windows is
@@ -187,9 +194,9 @@ int main(int argc, char** argv) {
   spv_text* textOrNull = print_to_stdout ? nullptr : &text;
   spv_diagnostic diagnostic = nullptr;
   spv_context context = spvContextCreate(kDefaultEnvironment);
-  spv_result_t error =
-      spvBinaryToText(context, contents.data(), contents.size(), options,
-                      textOrNull, &diagnostic);
+  spv_result_t error = spvBinaryToTextWithThreads(
+      context, contents.data(), contents.size(), options, num_threads,
+      textOrNull, &diagnostic);
   spvContextDestroy(context);
   if (error) {
     spvDiagnosticPrint(diagnostic);
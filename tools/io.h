@@ -15,8 +15,17 @@
 #ifndef LIBSPIRV_TOOLS_IO_H_
 #define LIBSPIRV_TOOLS_IO_H_
 
+#if defined(__unix__) || (defined(__APPLE__) && defined(__MACH__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPIRV_TOOLS_IO_MMAP 1
+#endif
+
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <vector>
 
 // Appends the content from the file named as |filename| to |data|, assuming
@@ -25,12 +34,19 @@
 // any error occurs, writes error messages to standard error and returns false.
 template <typename T>
 bool ReadFile(const char* filename, const char* mode, std::vector<T>* data) {
-  const int buf_size = 1024;
   const bool use_file = filename && strcmp("-", filename);
   if (FILE* fp = (use_file ? fopen(filename, mode) : stdin)) {
-    T buf[buf_size];
-    while (size_t len = fread(buf, sizeof(T), buf_size, fp)) {
-      data->insert(data->end(), buf, buf + len);
+    // Read straight into |data|, in chunks which double in size, so that a
+    // large file takes few reads and no intermediate copies.
+    size_t chunk_size = 1024;
+    while (true) {
+      const size_t old_size = data->size();
+      data->resize(old_size + chunk_size);
+      const size_t len =
+          fread(data->data() + old_size, sizeof(T), chunk_size, fp);
+      data->resize(old_size + len);
+      if (len < chunk_size) break;
+      if (chunk_size < (size_t(1) << 24)) chunk_size *= 2;
     }
     if (ftell(fp) == -1L) {
       if (ferror(fp)) {
@@ -54,6 +70,82 @@ bool ReadFile(const char* filename, const char* mode, std::vector<T>* data) {
   return true;
 }
 
+// The content of a file, seen as an array of elements of type |T|.
+//
+// Where the platform allows it, a regular file is mapped into memory rather
+// than read, so that large modules are neither copied nor held twice. Other
+// inputs, such as the standard input or a pipe, are read with ReadFile.
+template <typename T>
+class InputFile {
+ public:
+  InputFile() = default;
+  InputFile(const InputFile&) = delete;
+  InputFile& operator=(const InputFile&) = delete;
+  ~InputFile() {
+#if defined(SPIRV_TOOLS_IO_MMAP)
+    if (mapping_) munmap(mapping_, mapping_size_);
+#endif
+  }
+
+  // Opens the file named as |filename| with the given |mode|, as ReadFile
+  // does. If |filename| is nullptr or "-", reads from the standard input. If
+  // any error occurs, writes error messages to standard error and returns
+  // false.
+  bool Open(const char* filename, const char* mode) {
+#if defined(SPIRV_TOOLS_IO_MMAP)
+    if (filename && strcmp("-", filename)) {
+      const int fd = open(filename, O_RDONLY);
+      if (fd == -1) {
+        fprintf(stderr, "error: file does not exist '%s'\n", filename);
+        return false;
+      }
+      struct stat info;
+      // Empty files cannot be mapped, and other kinds of files might not be.
+      if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        const size_t size = static_cast<size_t>(info.st_size);
+        if (sizeof(T) != 1 && (size % sizeof(T))) {
+          fprintf(stderr,
+                  "error: file size should be a multiple of %zd; file '%s' "
+                  "corrupt\n",
+                  sizeof(T), filename);
+          close(fd);
+          return false;
+        }
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping != MAP_FAILED) {
+          mapping_ = mapping;
+          mapping_size_ = size;
+          return true;
+        }
+      } else {
+        close(fd);
+      }
+    }
+#endif
+    return ReadFile(filename, mode, &buffer_);
+  }
+
+  // Returns the elements of the file. They stay valid until the object is
+  // destroyed.
+  const T* data() const {
+    return mapping_ ? static_cast<const T*>(mapping_) : buffer_.data();
+  }
+
+  // Returns the number of elements in the file.
+  size_t size() const {
+    return mapping_ ? mapping_size_ / sizeof(T) : buffer_.size();
+  }
+
+ private:
+  // The mapping of the file, or nullptr if it was read into |buffer_|.
+  void* mapping_ = nullptr;
+  // The size of |mapping_| in bytes.
+  size_t mapping_size_ = 0;
+  // The content of the file, if it was not mapped.
+  std::vector<T> buffer_;
+};
+
 // Writes the given |data| into the file named as |filename| using the given
 // |mode|, assuming |data| is an array of |count| elements of type |T|. If
 // |filename| is nullptr or "-", writes to standard output. If any error occurs,
@@ -64,12 +156,15 @@ bool WriteFile(const char* filename, const char* mode, const T* data,
   const bool use_stdout =
       !filename || (filename[0] == '-' && filename[1] == '\0');
   if (FILE* fp = (use_stdout ? stdout : fopen(filename, mode))) {
+    // Write everything in one call. For a large |data| the standard library
+    // passes it straight to the system without copying it into its buffer.
     size_t written = fwrite(data, sizeof(T), count, fp);
-    if (count != written) {
+    // Errors such as a full disk might only show up when the file is closed.
+    const bool flushed = (use_stdout ? fflush(fp) : fclose(fp)) == 0;
+    if (count != written || !flushed) {
       fprintf(stderr, "error: could not write to file '%s'\n", filename);
       return false;
     }
-    if (!use_stdout) fclose(fp);
   } else {
     fprintf(stderr, "error: could not open file '%s'\n", filename);
     return false;
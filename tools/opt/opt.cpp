@@ -20,6 +20,7 @@
 #include <iostream>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "opt/loop_peeling.h"
@@ -28,6 +29,8 @@
 
 #include "message.h"
 #include "tools/io.h"
+#include "tools/util/flags.h"
+#include "tools/util/threads.h"
 
 using namespace spvtools;
 
@@ -74,13 +77,17 @@ void PrintUsage(const char* program) {
   printf(
       R"(%s - Optimize a SPIR-V binary file.
 
-USAGE: %s [options] [<input>] -o <output>
+USAGE: %s [options] [<input>] -o <output> [<input> -o <output> ...]
 
 The SPIR-V binary is read from <input>. If no file is specified,
 or if <input> is "-", then the binary is read from standard input.
 if <output> is "-", then the optimized output is written to
 standard output.
 
+Several modules can be optimized by one invocation by giving several
+inputs, each followed by its own -o <output>. They are optimized with
+the same passes, on the number of threads given by --threads.
+
 NOTE: The optimizer is a work in progress.
 
 Options (in lexicographical order):
@@ -268,7 +275,8 @@ Options (in lexicographical order):
                -O.
   --print-all
                Print SPIR-V assembly to standard error output before each pass
-               and after the last pass.
+               and after the last pass. Cannot be combined with --threads <n>
+               for <n> above 1 when more than one input is given.
   --private-to-local
                Change the scope of private variables that are used in a single
                function to that function.
@@ -319,13 +327,24 @@ Options (in lexicographical order):
   --strip-reflect
                Remove all reflection information.  For now, this covers
                reflection information defined by SPV_GOOGLE_hlsl_functionality1.
+  --threads <n>
+               Optimize up to <n> of the given modules concurrently. Each
+               module is still optimized on a single thread, so this has no
+               effect with only one input. Defaults to 1.
   --time-report
                Print the resource utilization of each pass (e.g., CPU time,
                RSS) to standard error output. Currently it supports only Unix
                systems. This option is the same as -ftime-report in GCC. It
                prints CPU/WALL/USR/SYS time (and RSS if possible), but note that
                USR/SYS time are returned by getrusage() and can have a small
-               error.
+               error. Cannot be combined with --threads <n> for <n> above 1
+               when more than one input is given.
+  --validation-cache-dir <dir>
+               Cache the results of validating the input in the existing
+               directory <dir>, so that an input which was validated before
+               with the same options is not validated again.
+  --validation-cache-size <n>
+               Keep the validation cache within <n> MiB. Defaults to 64.
   --vector-dce
                This pass looks for components of vectors that are unused, and
                removes them from the vector.  Note this would still leave around
@@ -380,18 +399,25 @@ bool ReadFlagsFromFile(const char* oconfig_flag,
 }
 
 OptStatus ParseFlags(int argc, const char** argv, Optimizer* optimizer,
-                     const char** in_file, const char** out_file,
-                     spv_validator_options options, bool* skip_validator);
+                     std::vector<const char*>* in_files,
+                     std::vector<const char*>* out_files,
+                     std::vector<std::string>* optimizer_flags,
+                     spv_validator_options options, bool* skip_validator,
+                     uint32_t* num_threads);
 
 // Parses and handles the -Oconfig flag. |prog_name| contains the name of
 // the spirv-opt binary (used to build a new argv vector for the recursive
 // invocation to ParseFlags). |opt_flag| contains the -Oconfig=FILENAME flag.
-// |optimizer|, |in_file| and |out_file| are as in ParseFlags.
+// |optimizer|, |in_files|, |out_files|, |optimizer_flags| and |num_threads|
+// are as in ParseFlags.
 //
 // This returns the same OptStatus instance returned by ParseFlags.
 OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
-                           Optimizer* optimizer, const char** in_file,
-                           const char** out_file) {
+                           Optimizer* optimizer,
+                           std::vector<const char*>* in_files,
+                           std::vector<const char*>* out_files,
+                           std::vector<std::string>* optimizer_flags,
+                           uint32_t* num_threads) {
   std::vector<std::string> flags;
   flags.push_back(prog_name);
 
@@ -416,7 +442,8 @@ OptStatus ParseOconfigFlag(const char* prog_name, const char* opt_flag,
 
   bool skip_validator = false;
   return ParseFlags(static_cast<int>(flags.size()), new_argv, optimizer,
-                    in_file, out_file, nullptr, &skip_validator);
+                    in_files, out_files, optimizer_flags, nullptr,
+                    &skip_validator, num_threads);
 }
 
 OptStatus ParseLoopFissionArg(int argc, const char** argv, int argi,
@@ -478,17 +505,196 @@ OptStatus ParseLoopPeelingThresholdArg(int argc, const char** argv, int argi) {
   return {OPT_STOP, 1};
 }
 
+// Parses the flag |argv[*argi]| if it only configures the optimizer, that is
+// if it registers passes or selects what is printed while they run, and
+// applies it to |optimizer|. A flag taking a separate argument consumes it,
+// advancing |*argi|. Sets |*handled| to whether the flag was such a flag. The
+// return value indicates whether optimization should continue and a status
+// code indicating an error or success.
+//
+// This only touches |optimizer|, so it can be called for several optimizers
+// concurrently.
+OptStatus ParseOptimizerFlag(int argc, const char** argv, int* argi,
+                             Optimizer* optimizer, bool* handled) {
+  const char* cur_arg = argv[*argi];
+  *handled = true;
+  if (0 == strcmp(cur_arg, "--strip-debug")) {
+    optimizer->RegisterPass(CreateStripDebugInfoPass());
+  } else if (0 == strcmp(cur_arg, "--strip-reflect")) {
+    optimizer->RegisterPass(CreateStripReflectInfoPass());
+  } else if (0 == strcmp(cur_arg, "--set-spec-const-default-value")) {
+    if (++*argi < argc) {
+      auto spec_ids_vals =
+          opt::SetSpecConstantDefaultValuePass::ParseDefaultValuesString(
+              argv[*argi]);
+      if (!spec_ids_vals) {
+        fprintf(stderr,
+                "error: Invalid argument for "
+                "--set-spec-const-default-value: %s\n",
+                argv[*argi]);
+        return {OPT_STOP, 1};
+      }
+      optimizer->RegisterPass(
+          CreateSetSpecConstantDefaultValuePass(std::move(*spec_ids_vals)));
+    } else {
+      fprintf(
+          stderr,
+          "error: Expected a string of <spec id>:<default value> pairs.");
+      return {OPT_STOP, 1};
+    }
+  } else if (0 == strcmp(cur_arg, "--if-conversion")) {
+    optimizer->RegisterPass(CreateIfConversionPass());
+  } else if (0 == strcmp(cur_arg, "--freeze-spec-const")) {
+    optimizer->RegisterPass(CreateFreezeSpecConstantValuePass());
+  } else if (0 == strcmp(cur_arg, "--inline-entry-points-exhaustive")) {
+    optimizer->RegisterPass(CreateInlineExhaustivePass());
+  } else if (0 == strcmp(cur_arg, "--inline-entry-points-opaque")) {
+    optimizer->RegisterPass(CreateInlineOpaquePass());
+  } else if (0 == strcmp(cur_arg, "--convert-local-access-chains")) {
+    optimizer->RegisterPass(CreateLocalAccessChainConvertPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-code-aggressive")) {
+    optimizer->RegisterPass(CreateAggressiveDCEPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-insert-extract")) {
+    optimizer->RegisterPass(CreateInsertExtractElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-local-single-block")) {
+    optimizer->RegisterPass(CreateLocalSingleBlockLoadStoreElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-local-single-store")) {
+    optimizer->RegisterPass(CreateLocalSingleStoreElimPass());
+  } else if (0 == strcmp(cur_arg, "--merge-blocks")) {
+    optimizer->RegisterPass(CreateBlockMergePass());
+  } else if (0 == strcmp(cur_arg, "--merge-return")) {
+    optimizer->RegisterPass(CreateMergeReturnPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-branches")) {
+    optimizer->RegisterPass(CreateDeadBranchElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-functions")) {
+    optimizer->RegisterPass(CreateEliminateDeadFunctionsPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-local-multi-store")) {
+    optimizer->RegisterPass(CreateLocalMultiStoreElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-common-uniform")) {
+    optimizer->RegisterPass(CreateCommonUniformElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-const")) {
+    optimizer->RegisterPass(CreateEliminateDeadConstantPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-inserts")) {
+    optimizer->RegisterPass(CreateDeadInsertElimPass());
+  } else if (0 == strcmp(cur_arg, "--eliminate-dead-variables")) {
+    optimizer->RegisterPass(CreateDeadVariableEliminationPass());
+  } else if (0 == strcmp(cur_arg, "--fold-spec-const-op-composite")) {
+    optimizer->RegisterPass(CreateFoldSpecConstantOpAndCompositePass());
+  } else if (0 == strcmp(cur_arg, "--loop-unswitch")) {
+    optimizer->RegisterPass(CreateLoopUnswitchPass());
+  } else if (0 == strcmp(cur_arg, "--scalar-replacement")) {
+    optimizer->RegisterPass(CreateScalarReplacementPass());
+  } else if (0 == strncmp(cur_arg, "--scalar-replacement=", 21)) {
+    uint32_t limit = atoi(cur_arg + 21);
+    optimizer->RegisterPass(CreateScalarReplacementPass(limit));
+  } else if (0 == strcmp(cur_arg, "--strength-reduction")) {
+    optimizer->RegisterPass(CreateStrengthReductionPass());
+  } else if (0 == strcmp(cur_arg, "--unify-const")) {
+    optimizer->RegisterPass(CreateUnifyConstantPass());
+  } else if (0 == strcmp(cur_arg, "--flatten-decorations")) {
+    optimizer->RegisterPass(CreateFlattenDecorationPass());
+  } else if (0 == strcmp(cur_arg, "--compact-ids")) {
+    optimizer->RegisterPass(CreateCompactIdsPass());
+  } else if (0 == strcmp(cur_arg, "--cfg-cleanup")) {
+    optimizer->RegisterPass(CreateCFGCleanupPass());
+  } else if (0 == strcmp(cur_arg, "--local-redundancy-elimination")) {
+    optimizer->RegisterPass(CreateLocalRedundancyEliminationPass());
+  } else if (0 == strcmp(cur_arg, "--loop-invariant-code-motion")) {
+    optimizer->RegisterPass(CreateLoopInvariantCodeMotionPass());
+  } else if (0 == strcmp(cur_arg, "--reduce-load-size")) {
+    optimizer->RegisterPass(CreateReduceLoadSizePass());
+  } else if (0 == strcmp(cur_arg, "--redundancy-elimination")) {
+    optimizer->RegisterPass(CreateRedundancyEliminationPass());
+  } else if (0 == strcmp(cur_arg, "--private-to-local")) {
+    optimizer->RegisterPass(CreatePrivateToLocalPass());
+  } else if (0 == strcmp(cur_arg, "--remove-duplicates")) {
+    optimizer->RegisterPass(CreateRemoveDuplicatesPass());
+  } else if (0 == strcmp(cur_arg, "--workaround-1209")) {
+    optimizer->RegisterPass(CreateWorkaround1209Pass());
+  } else if (0 == strcmp(cur_arg, "--replace-invalid-opcode")) {
+    optimizer->RegisterPass(CreateReplaceInvalidOpcodePass());
+  } else if (0 == strcmp(cur_arg, "--simplify-instructions")) {
+    optimizer->RegisterPass(CreateSimplificationPass());
+  } else if (0 == strcmp(cur_arg, "--ssa-rewrite")) {
+    optimizer->RegisterPass(CreateSSARewritePass());
+  } else if (0 == strcmp(cur_arg, "--copy-propagate-arrays")) {
+    optimizer->RegisterPass(CreateCopyPropagateArraysPass());
+  } else if (0 == strcmp(cur_arg, "--loop-fission")) {
+    OptStatus status = ParseLoopFissionArg(argc, argv, ++*argi, optimizer);
+    if (status.action != OPT_CONTINUE) {
+      return status;
+    }
+  } else if (0 == strcmp(cur_arg, "--loop-fusion")) {
+    OptStatus status = ParseLoopFusionArg(argc, argv, ++*argi, optimizer);
+    if (status.action != OPT_CONTINUE) {
+      return status;
+    }
+  } else if (0 == strcmp(cur_arg, "--loop-unroll")) {
+    optimizer->RegisterPass(CreateLoopUnrollPass(true));
+  } else if (0 == strcmp(cur_arg, "--vector-dce")) {
+    optimizer->RegisterPass(CreateVectorDCEPass());
+  } else if (0 == strcmp(cur_arg, "--loop-unroll-partial")) {
+    OptStatus status =
+        ParseLoopUnrollPartialArg(argc, argv, ++*argi, optimizer);
+    if (status.action != OPT_CONTINUE) {
+      return status;
+    }
+  } else if (0 == strcmp(cur_arg, "--loop-peeling")) {
+    optimizer->RegisterPass(CreateLoopPeelingPass());
+  } else if (0 == strcmp(cur_arg, "-O")) {
+    optimizer->RegisterPerformancePasses();
+  } else if (0 == strcmp(cur_arg, "-Os")) {
+    optimizer->RegisterSizePasses();
+  } else if (0 == strcmp(cur_arg, "--legalize-hlsl")) {
+    optimizer->RegisterLegalizationPasses();
+  } else if (0 == strcmp(cur_arg, "--ccp")) {
+    optimizer->RegisterPass(CreateCCPPass());
+  } else if (0 == strcmp(cur_arg, "--print-all")) {
+    optimizer->SetPrintAll(&std::cerr);
+  } else if (0 == strcmp(cur_arg, "--time-report")) {
+    optimizer->SetTimeReport(&std::cerr);
+  } else {
+    *handled = false;
+  }
+  return {OPT_CONTINUE, 0};
+}
+
+// Applies |optimizer_flags|, flags accepted by ParseOptimizerFlag followed by
+// their arguments, to |optimizer|. The flags must have been parsed
+// successfully before.
+void ApplyOptimizerFlags(const std::vector<std::string>& optimizer_flags,
+                         Optimizer* optimizer) {
+  std::vector<const char*> argv;
+  for (const std::string& flag : optimizer_flags) {
+    argv.push_back(flag.c_str());
+  }
+  const int argc = static_cast<int>(argv.size());
+  for (int argi = 0; argi < argc; ++argi) {
+    bool handled = false;
+    OptStatus status =
+        ParseOptimizerFlag(argc, argv.data(), &argi, optimizer, &handled);
+    assert(status.action == OPT_CONTINUE && handled);
+    (void)status;
+  }
+}
+
 // Parses command-line flags. |argc| contains the number of command-line flags.
 // |argv| points to an array of strings holding the flags. |optimizer| is the
 // Optimizer instance used to optimize the program.
 //
-// On return, this function stores the name of the input program in |in_file|.
-// The name of the output file in |out_file|. The return value indicates whether
-// optimization should continue and a status code indicating an error or
-// success.
+// On return, this function appends the names of the input programs to
+// |in_files| and the names of the output files to |out_files|, in the order
+// they were given, and stores the value of --threads in |num_threads|. The
+// flags applied to |optimizer| are appended to |optimizer_flags|, with their
+// arguments, so that other optimizers can be set up the same way. The return
+// value indicates whether optimization should continue and a status code
+// indicating an error or success.
 OptStatus ParseFlags(int argc, const char** argv, Optimizer* optimizer,
-                     const char** in_file, const char** out_file,
-                     spv_validator_options options, bool* skip_validator) {
+                     std::vector<const char*>* in_files,
+                     std::vector<const char*>* out_files,
+                     std::vector<std::string>* optimizer_flags,
+                     spv_validator_options options, bool* skip_validator,
+                     uint32_t* num_threads) {
   for (int argi = 1; argi < argc; ++argi) {
     const char* cur_arg = argv[argi];
     if ('-' == cur_arg[0]) {
@@ -499,137 +705,14 @@ OptStatus ParseFlags(int argc, const char** argv, Optimizer* optimizer,
         PrintUsage(argv[0]);
         return {OPT_STOP, 0};
       } else if (0 == strcmp(cur_arg, "-o")) {
-        if (!*out_file && argi + 1 < argc) {
-          *out_file = argv[++argi];
+        if (argi + 1 < argc) {
+          out_files->push_back(argv[++argi]);
         } else {
           PrintUsage(argv[0]);
           return {OPT_STOP, 1};
         }
-      } else if (0 == strcmp(cur_arg, "--strip-debug")) {
-        optimizer->RegisterPass(CreateStripDebugInfoPass());
-      } else if (0 == strcmp(cur_arg, "--strip-reflect")) {
-        optimizer->RegisterPass(CreateStripReflectInfoPass());
-      } else if (0 == strcmp(cur_arg, "--set-spec-const-default-value")) {
-        if (++argi < argc) {
-          auto spec_ids_vals =
-              opt::SetSpecConstantDefaultValuePass::ParseDefaultValuesString(
-                  argv[argi]);
-          if (!spec_ids_vals) {
-            fprintf(stderr,
-                    "error: Invalid argument for "
-                    "--set-spec-const-default-value: %s\n",
-                    argv[argi]);
-            return {OPT_STOP, 1};
-          }
-          optimizer->RegisterPass(
-              CreateSetSpecConstantDefaultValuePass(std::move(*spec_ids_vals)));
-        } else {
-          fprintf(
-              stderr,
-              "error: Expected a string of <spec id>:<default value> pairs.");
-          return {OPT_STOP, 1};
-        }
-      } else if (0 == strcmp(cur_arg, "--if-conversion")) {
-        optimizer->RegisterPass(CreateIfConversionPass());
-      } else if (0 == strcmp(cur_arg, "--freeze-spec-const")) {
-        optimizer->RegisterPass(CreateFreezeSpecConstantValuePass());
-      } else if (0 == strcmp(cur_arg, "--inline-entry-points-exhaustive")) {
-        optimizer->RegisterPass(CreateInlineExhaustivePass());
-      } else if (0 == strcmp(cur_arg, "--inline-entry-points-opaque")) {
-        optimizer->RegisterPass(CreateInlineOpaquePass());
-      } else if (0 == strcmp(cur_arg, "--convert-local-access-chains")) {
-        optimizer->RegisterPass(CreateLocalAccessChainConvertPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-code-aggressive")) {
-        optimizer->RegisterPass(CreateAggressiveDCEPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-insert-extract")) {
-        optimizer->RegisterPass(CreateInsertExtractElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-local-single-block")) {
-        optimizer->RegisterPass(CreateLocalSingleBlockLoadStoreElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-local-single-store")) {
-        optimizer->RegisterPass(CreateLocalSingleStoreElimPass());
-      } else if (0 == strcmp(cur_arg, "--merge-blocks")) {
-        optimizer->RegisterPass(CreateBlockMergePass());
-      } else if (0 == strcmp(cur_arg, "--merge-return")) {
-        optimizer->RegisterPass(CreateMergeReturnPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-branches")) {
-        optimizer->RegisterPass(CreateDeadBranchElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-functions")) {
-        optimizer->RegisterPass(CreateEliminateDeadFunctionsPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-local-multi-store")) {
-        optimizer->RegisterPass(CreateLocalMultiStoreElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-common-uniform")) {
-        optimizer->RegisterPass(CreateCommonUniformElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-const")) {
-        optimizer->RegisterPass(CreateEliminateDeadConstantPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-inserts")) {
-        optimizer->RegisterPass(CreateDeadInsertElimPass());
-      } else if (0 == strcmp(cur_arg, "--eliminate-dead-variables")) {
-        optimizer->RegisterPass(CreateDeadVariableEliminationPass());
-      } else if (0 == strcmp(cur_arg, "--fold-spec-const-op-composite")) {
-        optimizer->RegisterPass(CreateFoldSpecConstantOpAndCompositePass());
-      } else if (0 == strcmp(cur_arg, "--loop-unswitch")) {
-        optimizer->RegisterPass(CreateLoopUnswitchPass());
-      } else if (0 == strcmp(cur_arg, "--scalar-replacement")) {
-        optimizer->RegisterPass(CreateScalarReplacementPass());
-      } else if (0 == strncmp(cur_arg, "--scalar-replacement=", 21)) {
-        uint32_t limit = atoi(cur_arg + 21);
-        optimizer->RegisterPass(CreateScalarReplacementPass(limit));
-      } else if (0 == strcmp(cur_arg, "--strength-reduction")) {
-        optimizer->RegisterPass(CreateStrengthReductionPass());
-      } else if (0 == strcmp(cur_arg, "--unify-const")) {
-        optimizer->RegisterPass(CreateUnifyConstantPass());
-      } else if (0 == strcmp(cur_arg, "--flatten-decorations")) {
-        optimizer->RegisterPass(CreateFlattenDecorationPass());
-      } else if (0 == strcmp(cur_arg, "--compact-ids")) {
-        optimizer->RegisterPass(CreateCompactIdsPass());
-      } else if (0 == strcmp(cur_arg, "--cfg-cleanup")) {
-        optimizer->RegisterPass(CreateCFGCleanupPass());
-      } else if (0 == strcmp(cur_arg, "--local-redundancy-elimination")) {
-        optimizer->RegisterPass(CreateLocalRedundancyEliminationPass());
-      } else if (0 == strcmp(cur_arg, "--loop-invariant-code-motion")) {
-        optimizer->RegisterPass(CreateLoopInvariantCodeMotionPass());
-      } else if (0 == strcmp(cur_arg, "--reduce-load-size")) {
-        optimizer->RegisterPass(CreateReduceLoadSizePass());
-      } else if (0 == strcmp(cur_arg, "--redundancy-elimination")) {
-        optimizer->RegisterPass(CreateRedundancyEliminationPass());
-      } else if (0 == strcmp(cur_arg, "--private-to-local")) {
-        optimizer->RegisterPass(CreatePrivateToLocalPass());
-      } else if (0 == strcmp(cur_arg, "--remove-duplicates")) {
-        optimizer->RegisterPass(CreateRemoveDuplicatesPass());
-      } else if (0 == strcmp(cur_arg, "--workaround-1209")) {
-        optimizer->RegisterPass(CreateWorkaround1209Pass());
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         options->relax_struct_store = true;
-      } else if (0 == strcmp(cur_arg, "--replace-invalid-opcode")) {
-        optimizer->RegisterPass(CreateReplaceInvalidOpcodePass());
-      } else if (0 == strcmp(cur_arg, "--simplify-instructions")) {
-        optimizer->RegisterPass(CreateSimplificationPass());
-      } else if (0 == strcmp(cur_arg, "--ssa-rewrite")) {
-        optimizer->RegisterPass(CreateSSARewritePass());
-      } else if (0 == strcmp(cur_arg, "--copy-propagate-arrays")) {
-        optimizer->RegisterPass(CreateCopyPropagateArraysPass());
-      } else if (0 == strcmp(cur_arg, "--loop-fission")) {
-        OptStatus status = ParseLoopFissionArg(argc, argv, ++argi, optimizer);
-        if (status.action != OPT_CONTINUE) {
-          return status;
-        }
-      } else if (0 == strcmp(cur_arg, "--loop-fusion")) {
-        OptStatus status = ParseLoopFusionArg(argc, argv, ++argi, optimizer);
-        if (status.action != OPT_CONTINUE) {
-          return status;
-        }
-      } else if (0 == strcmp(cur_arg, "--loop-unroll")) {
-        optimizer->RegisterPass(CreateLoopUnrollPass(true));
-      } else if (0 == strcmp(cur_arg, "--vector-dce")) {
-        optimizer->RegisterPass(CreateVectorDCEPass());
-      } else if (0 == strcmp(cur_arg, "--loop-unroll-partial")) {
-        OptStatus status =
-            ParseLoopUnrollPartialArg(argc, argv, ++argi, optimizer);
-        if (status.action != OPT_CONTINUE) {
-          return status;
-        }
-      } else if (0 == strcmp(cur_arg, "--loop-peeling")) {
-        optimizer->RegisterPass(CreateLoopPeelingPass());
       } else if (0 == strcmp(cur_arg, "--loop-peeling-threshold")) {
         OptStatus status = ParseLoopPeelingThresholdArg(argc, argv, ++argi);
         if (status.action != OPT_CONTINUE) {
@@ -637,59 +720,96 @@ OptStatus ParseFlags(int argc, const char** argv, Optimizer* optimizer,
         }
       } else if (0 == strcmp(cur_arg, "--skip-validation")) {
         *skip_validator = true;
-      } else if (0 == strcmp(cur_arg, "-O")) {
-        optimizer->RegisterPerformancePasses();
-      } else if (0 == strcmp(cur_arg, "-Os")) {
-        optimizer->RegisterSizePasses();
-      } else if (0 == strcmp(cur_arg, "--legalize-hlsl")) {
-        *skip_validator = true;
-        optimizer->RegisterLegalizationPasses();
       } else if (0 == strncmp(cur_arg, "-Oconfig=", sizeof("-Oconfig=") - 1)) {
         OptStatus status =
-            ParseOconfigFlag(argv[0], cur_arg, optimizer, in_file, out_file);
+            ParseOconfigFlag(argv[0], cur_arg, optimizer, in_files, out_files,
+                             optimizer_flags, num_threads);
         if (status.action != OPT_CONTINUE) {
           return status;
         }
-      } else if (0 == strcmp(cur_arg, "--ccp")) {
-        optimizer->RegisterPass(CreateCCPPass());
-      } else if (0 == strcmp(cur_arg, "--print-all")) {
-        optimizer->SetPrintAll(&std::cerr);
-      } else if (0 == strcmp(cur_arg, "--time-report")) {
-        optimizer->SetTimeReport(&std::cerr);
-      } else if ('\0' == cur_arg[1]) {
-        // Setting a filename of "-" to indicate stdin.
-        if (!*in_file) {
-          *in_file = cur_arg;
+      } else if (0 == strcmp(cur_arg, "--validation-cache-dir")) {
+        if (argi + 1 < argc) {
+          options->cache_directory = argv[++argi];
         } else {
-          fprintf(stderr, "error: More than one input file specified\n");
+          fprintf(stderr,
+                  "error: --validation-cache-dir must be followed by a "
+                  "directory\n");
           return {OPT_STOP, 1};
         }
+      } else if (0 == strcmp(cur_arg, "--validation-cache-size")) {
+        uint32_t cache_size_mib = 0;
+        if (argi + 1 < argc &&
+            ParsePositiveNumber(argv[argi + 1], &cache_size_mib)) {
+          ++argi;
+        } else {
+          fprintf(stderr,
+                  "error: --validation-cache-size must be followed by a "
+                  "positive number\n");
+          return {OPT_STOP, 1};
+        }
+        options->cache_max_size = size_t(cache_size_mib) << 20;
+      } else if (0 == strcmp(cur_arg, "--threads")) {
+        if (!ParseThreadsFlag(argc, argv, &argi, num_threads)) {
+          return {OPT_STOP, 1};
+        }
+      } else if ('\0' == cur_arg[1]) {
+        // Setting a filename of "-" to indicate stdin.
+        in_files->push_back(cur_arg);
       } else {
-        fprintf(
-            stderr,
-            "error: Unknown flag '%s'. Use --help for a list of valid flags\n",
-            cur_arg);
-        return {OPT_STOP, 1};
+        const int flag_argi = argi;
+        bool handled = false;
+        OptStatus status =
+            ParseOptimizerFlag(argc, argv, &argi, optimizer, &handled);
+        if (status.action != OPT_CONTINUE) {
+          return status;
+        }
+        if (!handled) {
+          fprintf(stderr,
+                  "error: Unknown flag '%s'. Use --help for a list of valid "
+                  "flags\n",
+                  cur_arg);
+          return {OPT_STOP, 1};
+        }
+        optimizer_flags->insert(optimizer_flags->end(), argv + flag_argi,
+                                argv + argi + 1);
+        if (0 == strcmp(cur_arg, "--legalize-hlsl")) {
+          *skip_validator = true;
+        }
       }
     } else {
-      if (!*in_file) {
-        *in_file = cur_arg;
-      } else {
-        fprintf(stderr, "error: More than one input file specified\n");
-        return {OPT_STOP, 1};
-      }
+      in_files->push_back(cur_arg);
     }
   }
 
   return {OPT_CONTINUE, 0};
 }
 
+// Validates |binary| with |options|, printing any diagnostic. Returns the
+// result of the validation.
+spv_result_t ValidateBinary(spv_target_env target_env,
+                            spv_validator_options options,
+                            const std::vector<uint32_t>& binary) {
+  spv_context context = spvContextCreate(target_env);
+  spv_diagnostic diagnostic = nullptr;
+  spv_const_binary_t binary_struct = {binary.data(), binary.size()};
+  spv_result_t error =
+      spvValidateWithOptions(context, options, &binary_struct, &diagnostic);
+  if (error) {
+    spvDiagnosticPrint(diagnostic);
+  }
+  spvDiagnosticDestroy(diagnostic);
+  spvContextDestroy(context);
+  return error;
+}
+
 }  // namespace
 
 int main(int argc, const char** argv) {
-  const char* in_file = nullptr;
-  const char* out_file = nullptr;
+  std::vector<const char*> in_files;
+  std::vector<const char*> out_files;
+  std::vector<std::string> optimizer_flags;
   bool skip_validator = false;
+  uint32_t num_threads = 1;
 
   spv_target_env target_env = kDefaultEnvironment;
   spv_validator_options options = spvValidatorOptionsCreate();
@@ -702,48 +822,95 @@ int main(int argc, const char** argv) {
               << std::endl;
   });
 
-  OptStatus status = ParseFlags(argc, argv, &optimizer, &in_file, &out_file,
-                                options, &skip_validator);
+  OptStatus status =
+      ParseFlags(argc, argv, &optimizer, &in_files, &out_files,
+                 &optimizer_flags, options, &skip_validator, &num_threads);
 
   if (status.action == OPT_STOP) {
     return status.code;
   }
 
-  if (out_file == nullptr) {
+  if (out_files.empty()) {
     fprintf(stderr, "error: -o required\n");
     return 1;
   }
 
-  std::vector<uint32_t> binary;
-  if (!ReadFile<uint32_t>(in_file, "rb", &binary)) {
+  // With no input file, the module is read from standard input.
+  if (in_files.empty()) in_files.push_back(nullptr);
+
+  if (in_files.size() != out_files.size()) {
+    fprintf(stderr, "error: Each input file needs its own -o <output>\n");
     return 1;
   }
 
-  if (!skip_validator) {
-    // Let's do validation first.
-    spv_context context = spvContextCreate(target_env);
-    spv_diagnostic diagnostic = nullptr;
-    spv_const_binary_t binary_struct = {binary.data(), binary.size()};
-    spv_result_t error =
-        spvValidateWithOptions(context, options, &binary_struct, &diagnostic);
-    if (error) {
-      spvDiagnosticPrint(diagnostic);
-      spvDiagnosticDestroy(diagnostic);
-      spvValidatorOptionsDestroy(options);
-      spvContextDestroy(context);
-      return error;
+  // The per-pass output of concurrently optimized modules would interleave.
+  if (in_files.size() > 1 && num_threads > 1) {
+    for (const std::string& flag : optimizer_flags) {
+      if (flag == "--print-all" || flag == "--time-report") {
+        fprintf(stderr,
+                "error: %s cannot be used with --threads when optimizing more "
+                "than one module\n",
+                flag.c_str());
+        return 1;
+      }
     }
-    spvDiagnosticDestroy(diagnostic);
-    spvValidatorOptionsDestroy(options);
-    spvContextDestroy(context);
   }
 
-  // By using the same vector as input and output, we save time in the case
-  // that there was no change.
-  bool ok = optimizer.Run(binary.data(), binary.size(), &binary);
+  std::vector<std::vector<uint32_t>> binaries(in_files.size());
+  for (size_t i = 0; i < in_files.size(); ++i) {
+    if (!ReadFile<uint32_t>(in_files[i], "rb", &binaries[i])) {
+      return 1;
+    }
 
-  if (!WriteFile<uint32_t>(out_file, "wb", binary.data(), binary.size())) {
-    return 1;
+    if (!skip_validator) {
+      // Let's do validation first.
+      spv_result_t error = ValidateBinary(target_env, options, binaries[i]);
+      if (error) {
+        spvValidatorOptionsDestroy(options);
+        return error;
+      }
+    }
+  }
+  spvValidatorOptionsDestroy(options);
+
+  bool ok = true;
+  if (binaries.size() == 1) {
+    // By using the same vector as input and output, we save time in the case
+    // that there was no change.
+    std::vector<uint32_t>& binary = binaries[0];
+    ok = optimizer.Run(binary.data(), binary.size(), &binary);
+  } else {
+    // Every module needs its own passes, so they are registered from the
+    // optimizer flags collected by ParseFlags.
+    spvtools::BatchOptimizer batch(
+        target_env, [&optimizer_flags](Optimizer* module_opt) {
+          ApplyOptimizerFlags(optimizer_flags, module_opt);
+        });
+    batch.SetMessageConsumer([](spv_message_level_t level, const char* source,
+                                const spv_position_t& position,
+                                const char* message) {
+      std::cerr << StringifyMessage(level, source, position, message)
+                << std::endl;
+    });
+    batch.SetNumThreads(num_threads);
+
+    std::vector<std::vector<uint32_t>> optimized_binaries;
+    std::vector<bool> succeeded = batch.Run(binaries, &optimized_binaries);
+    for (size_t i = 0; i < binaries.size(); ++i) {
+      if (!succeeded[i]) {
+        fprintf(stderr, "error: Failed to optimize %s\n", in_files[i]);
+        ok = false;
+      }
+    }
+    binaries.swap(optimized_binaries);
+  }
+
+  for (size_t i = 0; i < binaries.size(); ++i) {
+    const std::vector<uint32_t>& binary = binaries[i];
+    if (!WriteFile<uint32_t>(out_files[i], "wb", binary.data(),
+                             binary.size())) {
+      return 1;
+    }
   }
 
   return ok ? 0 : 1;
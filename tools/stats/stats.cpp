@@ -194,8 +194,8 @@ int main(int argc, char** argv) {
     }
 
     const char* path = paths[index];
-    std::vector<uint32_t> contents;
-    if (!ReadFile<uint32_t>(path, "rb", &contents)) return 1;
+    InputFile<uint32_t> contents;
+    if (!contents.Open(path, "rb")) return 1;
 
     if (SPV_SUCCESS != spvtools::AggregateStats(*ctx.context, contents.data(),
                                                 contents.size(), nullptr,
@@ -0,0 +1,37 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_TOOLS_UTIL_FLAGS_H_
+#define LIBSPIRV_TOOLS_UTIL_FLAGS_H_
+
+#include <cstdint>
+
+// Parses |arg|, the argument of a numeric command-line option. On success,
+// stores it in |value| and returns true. The argument must be a positive
+// decimal number that fits in 32 bits; signs, spaces and other characters are
+// rejected. Otherwise, returns false and leaves |value| unchanged.
+inline bool ParsePositiveNumber(const char* arg, uint32_t* value) {
+  uint64_t result = 0;
+  const char* digit = arg;
+  for (; *digit >= '0' && *digit <= '9' && result <= UINT32_MAX; ++digit) {
+    result = result * 10 + static_cast<uint64_t>(*digit - '0');
+  }
+  if (digit == arg || *digit != '\0' || result == 0 || result > UINT32_MAX) {
+    return false;
+  }
+  *value = static_cast<uint32_t>(result);
+  return true;
+}
+
+#endif  // LIBSPIRV_TOOLS_UTIL_FLAGS_H_
@@ -0,0 +1,39 @@
+// Copyright (c) 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef LIBSPIRV_TOOLS_UTIL_THREADS_H_
+#define LIBSPIRV_TOOLS_UTIL_THREADS_H_
+
+#include <cstdint>
+#include <cstdio>
+
+#include "tools/util/flags.h"
+
+// Parses the argument of the --threads <n> option, which the tools spell the
+// same way. |argv[*argi]| is the option itself, and its argument is the next
+// of the |argc| command-line arguments. On success, stores the argument in
+// |num_threads|, advances |*argi| past it and returns true. The argument is
+// parsed with |ParsePositiveNumber|. Otherwise, writes an error message to
+// standard error and returns false.
+inline bool ParseThreadsFlag(int argc, const char* const* argv, int* argi,
+                             uint32_t* num_threads) {
+  if (*argi + 1 < argc && ParsePositiveNumber(argv[*argi + 1], num_threads)) {
+    ++*argi;
+    return true;
+  }
+  fprintf(stderr, "error: --threads must be followed by a positive number\n");
+  return false;
+}
+
+#endif  // LIBSPIRV_TOOLS_UTIL_THREADS_H_
@@ -22,6 +22,8 @@
 #include "source/spirv_validator_options.h"
 #include "spirv-tools/libspirv.hpp"
 #include "tools/io.h"
+#include "tools/util/flags.h"
+#include "tools/util/threads.h"
 
 void print_usage(char* argv0) {
   printf(
@@ -50,6 +52,13 @@ Options:
   --relax-struct-store             Allow store from one struct type to a
                                    different type with compatible layout and
                                    members.
+  --threads                        <number of threads to validate with>
+                                   Defaults to 1.
+  --cache-dir                      <existing directory in which to cache validation results>
+                                   Binaries validated before with the same options are not
+                                   validated again.
+  --cache-size                     <maximum size of the cache in MiB>
+                                   Defaults to 64.
   --version                        Display validator version information.
   --target-env                     {vulkan1.0|vulkan1.1|opencl2.2|spv1.0|spv1.1|spv1.2|spv1.3|webgpu0}
                                    Use Vulkan 1.0, Vulkan 1.1, OpenCL 2.2, SPIR-V 1.0,
@@ -62,6 +71,8 @@ int main(int argc, char** argv) {
   const char* inFile = nullptr;
   spv_target_env target_env = SPV_ENV_UNIVERSAL_1_3;
   spvtools::ValidatorOptions options;
+  const char* cache_dir = nullptr;
+  uint32_t cache_size_mib = 64;
   bool continue_processing = true;
   int return_code = 0;
 
@@ -126,6 +137,34 @@ int main(int argc, char** argv) {
         options.SetRelaxBlockLayout(true);
       } else if (0 == strcmp(cur_arg, "--relax-struct-store")) {
         options.SetRelaxStructStore(true);
+      } else if (0 == strcmp(cur_arg, "--threads")) {
+        uint32_t num_threads = 0;
+        if (ParseThreadsFlag(argc, argv, &argi, &num_threads)) {
+          options.SetNumThreads(num_threads);
+        } else {
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--cache-dir")) {
+        if (argi + 1 < argc) {
+          cache_dir = argv[++argi];
+        } else {
+          fprintf(stderr, "error: Missing argument to --cache-dir\n");
+          continue_processing = false;
+          return_code = 1;
+        }
+      } else if (0 == strcmp(cur_arg, "--cache-size")) {
+        if (argi + 1 >= argc) {
+          fprintf(stderr, "error: Missing argument to --cache-size\n");
+          continue_processing = false;
+          return_code = 1;
+        } else if (!ParsePositiveNumber(argv[++argi], &cache_size_mib)) {
+          fprintf(stderr,
+                  "error: --cache-size must be followed by a positive "
+                  "number\n");
+          continue_processing = false;
+          return_code = 1;
+        }
       } else if (0 == cur_arg[1]) {
         // Setting a filename of "-" to indicate stdin.
         if (!inFile) {
@@ -156,8 +195,12 @@ int main(int argc, char** argv) {
     return return_code;
   }
 
-  std::vector<uint32_t> contents;
-  if (!ReadFile<uint32_t>(inFile, "rb", &contents)) return 1;
+  if (cache_dir) {
+    options.SetCache(cache_dir, size_t(cache_size_mib) << 20);
+  }
+
+  InputFile<uint32_t> contents;
+  if (!contents.Open(inFile, "rb")) return 1;
 
   spvtools::SpirvTools tools(target_env);
   tools.SetMessageConsumer([](spv_message_level_t level, const char*,
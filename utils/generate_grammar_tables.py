@@ -324,6 +324,21 @@ def generate_instruction(inst, is_ext_inst):
         return str(InstInitializer(opname, caps, exts, operands, min_version))
 
 
+def generate_name_index(array_name, names):
+    """Returns the C definition of an array of indices into a table, ordered
+    so that the corresponding names are sorted. Entries with the same name
+    keep their relative order in the table.
+
+    Arguments:
+      - array_name: the name of the generated array
+      - names: the names of the table entries, in table order
+    """
+    index = sorted(range(len(names)), key=lambda i: (names[i], i))
+    assert len(index) < 2**16, "Table {} is too large".format(array_name)
+    return 'static const uint16_t {}[] = {{{}}};'.format(
+        array_name, ', '.join([str(i) for i in index]))
+
+
 def generate_instruction_table(inst_table):
     """Returns the info table containing all SPIR-V instructions,
     sorted by opcode, and prefixed by capability arrays.
@@ -346,7 +361,12 @@ def generate_instruction_table(inst_table):
     insts = ['static const spv_opcode_desc_t kOpcodeTableEntries[] = {{\n'
              '  {}\n}};'.format(',\n  '.join(insts))]
 
-    return '{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays, '\n'.join(insts))
+    # Opcode names are stored without their "Op" prefix.
+    name_index = generate_name_index(
+        'kOpcodeTableNameIndex', [inst['opname'][2:] for inst in inst_table])
+
+    return '{}\n\n{}\n\n{}\n\n{}'.format(caps_arrays, exts_arrays,
+                                       '\n'.join(insts), name_index)
 
 
 def generate_extended_instruction_table(inst_table, set_name):
@@ -445,16 +465,20 @@ def generate_enum_operand_kind(enum):
     entries = sorted(enum.get('enumerants', []), key=functor)
 
     name = '{}_{}Entries'.format(PYGEN_VARIABLE_PREFIX, kind)
+    index_name = '{}_{}NameIndex'.format(PYGEN_VARIABLE_PREFIX, kind)
+    name_index = generate_name_index(
+        index_name, [e.get('enumerant') for e in entries])
     entries = ['  {}'.format(generate_enum_operand_kind_entry(e))
                for e in entries]
 
     template = ['static const spv_operand_desc_t {name}[] = {{',
-                '{entries}', '}};']
+                '{entries}', '}};', '{name_index}']
     entries = '\n'.join(template).format(
         name=name,
-        entries=',\n'.join(entries))
+        entries=',\n'.join(entries),
+        name_index=name_index)
 
-    return kind, name, entries
+    return kind, name, index_name, entries
 
 
 def generate_operand_kind_table(enums):
@@ -479,15 +503,15 @@ def generate_operand_kind_table(enums):
     three_optional_enums = [e for e in enums if e[0] in three_optional_enums]
     enums.extend(three_optional_enums)
 
-    enum_kinds, enum_names, enum_entries = zip(*enums)
+    enum_kinds, enum_names, enum_name_indices, enum_entries = zip(*enums)
     # Mark the last three as optional ones.
     enum_quantifiers = [''] * (len(enums) - 3) + ['?'] * 3
     # And we don't want redefinition of them.
     enum_entries = enum_entries[:-3]
     enum_kinds = [convert_operand_kind(e)
                   for e in zip(enum_kinds, enum_quantifiers)]
-    table_entries = zip(enum_kinds, enum_names, enum_names)
-    table_entries = ['  {{{}, ARRAY_SIZE({}), {}}}'.format(*e)
+    table_entries = zip(enum_kinds, enum_names, enum_names, enum_name_indices)
+    table_entries = ['  {{{}, ARRAY_SIZE({}), {}, {}}}'.format(*e)
                      for e in table_entries]
 
     template = [